@@ -182,6 +182,21 @@ typedef struct {
 } md_atom;
 
 
+// A raw (still compressed) .xtc frame. Reading and decoding are separate
+// steps so that frames can be read sequentially and decoded concurrently.
+typedef struct {
+	int natoms;		// Number of atoms
+	int step;		// Simulation step
+	float time;		// Time of simulation
+	float box[9];		// Basis vectors of the box (nm)
+	float precision;	// Compression precision (0 for natoms <= 9)
+	int minint[3], maxint[3];
+	int smallidx;
+	int *buf;		// Bit reader state (3 ints) followed by the data
+	int bufsize;		// Allocated size of buf (ints)
+} xtc_frame;
+
+
 // Open a molecular dynamics file. The second parameter specifies
 // the format of the file. If it is zero, the format is determined
 // from the file extension. the third argument (if given) decides
@@ -196,6 +211,7 @@ static int mdio_close(md_file *);
 // Format-independent file I/O routines
 static int mdio_header(md_file *, md_header *);
 static int mdio_timestep(md_file *, md_ts *);
+static int mdio_skip_timestep(md_file *);
 
 
 // .gro file functions
@@ -228,7 +244,9 @@ static int xtc_receivebits(int *, int);
 static void xtc_receiveints(int *, int, int, const unsigned *, int *);
 */
 static int xtc_timestep(md_file *, md_ts *);
-static int xtc_3dfcoord(md_file *, float *, int *, float *);
+static int xtc_read_frame(md_file *, xtc_frame *);
+static int xtc_decode_frame(xtc_frame *, float *);
+static void xtc_frame_free(xtc_frame *);
 
 
 // Error reporting functions
@@ -595,6 +613,54 @@ static int mdio_timestep(md_file *mf, md_ts *ts) {
 }
 
 
+// Skips a timestep without decoding it (format independent, trX and xtc
+// only). Only the frame header is read, the coordinate data is seeked over.
+static int mdio_skip_timestep(md_file *mf) {
+	int n, natoms;
+	trx_hdr *hdr;
+
+	if (!mf) return mdio_seterror(MDIO_BADPARAMS);
+	if (!mf->f) return mdio_seterror(MDIO_BADPARAMS);
+
+	switch (mf->fmt) {
+	case MDFMT_TRR:
+	case MDFMT_TRJ: /* fallthrough */
+		if (trx_header(mf) < 0) return -1;
+		hdr = mf->trx;
+		n = hdr->box_size + hdr->vir_size + hdr->pres_size +
+		    hdr->x_size + hdr->v_size + hdr->f_size;
+		break;
+
+	case MDFMT_XTC:
+		if (xtc_int(mf, &n) < 0) return -1;
+		if (n != XTC_MAGIC) return mdio_seterror(MDIO_BADFORMAT);
+		if (xtc_int(mf, &natoms) < 0) return -1;
+
+		// step, time, box (9), natoms
+		if (fseek(mf->f, 4 * 12, SEEK_CUR))
+			return mdio_seterror(MDIO_IOERROR);
+
+		if (natoms <= 9) {
+			n = natoms * 3 * 4;
+		} else {
+			// precision, minint (3), maxint (3), smallidx
+			if (fseek(mf->f, 4 * 8, SEEK_CUR))
+				return mdio_seterror(MDIO_IOERROR);
+			if (xtc_int(mf, &n) < 0) return -1;
+			if (n % 4) n += 4 - (n % 4);
+		}
+		break;
+
+	default:
+		return mdio_seterror(MDIO_UNKNOWNFMT);
+	}
+
+	if (fseek(mf->f, n, SEEK_CUR))
+		return mdio_seterror(MDIO_IOERROR);
+
+	return mdio_seterror(MDIO_SUCCESS);
+}
+
 
 static int g96_header(md_file *mf, char *title, int titlelen, float *timeval) {
 	char buf[MAX_G96_LINE + 1];
@@ -1592,53 +1658,38 @@ static int xtc_data(md_file *mf, char *buf, int len) {
 // xtc_timestep() - reads a timestep from an .xtc file.
 static int xtc_timestep(md_file *mf, md_ts *ts) {
 	int n;
-	float f, x[3], y[3], z[3];
-
-	int size = 0; // explicitly initialized to zero.
-	float precision;
+	xtc_frame frame;
 
 	if (!mf || !ts) return mdio_seterror(MDIO_BADPARAMS);
 	if (!mf->f) return mdio_seterror(MDIO_BADPARAMS);
 	if (mf->fmt != MDFMT_XTC) return mdio_seterror(MDIO_WRONGFORMAT);
 
-	// Check magic number
-	if (xtc_int(mf, &n) < 0) return -1;
-	if (n != XTC_MAGIC) return mdio_seterror(MDIO_BADFORMAT);
+	memset(&frame, 0, sizeof(xtc_frame));
+	if (xtc_read_frame(mf, &frame) < 0) {
+		xtc_frame_free(&frame);
+		return -1;
+	}
 
-	// Get number of atoms
-	if (xtc_int(mf, &n) < 0) return -1;
-	ts->natoms = n;
+	ts->natoms = frame.natoms;
+	ts->step = frame.step;
+	ts->time = frame.time;
 
-	// Get the simulation step
-	if (xtc_int(mf, &n) < 0) return -1;
-	ts->step = n;
-
-	// Get the time value
-	if (xtc_float(mf, &f) < 0) return -1;
-	ts->time = f;
-
-	// Read the basis vectors of the box
-  if ( (xtc_float(mf, &x[0]) < 0) ||
-       (xtc_float(mf, &x[1]) < 0) ||
-       (xtc_float(mf, &x[2]) < 0) ||
-       (xtc_float(mf, &y[0]) < 0) ||
-       (xtc_float(mf, &y[1]) < 0) ||
-       (xtc_float(mf, &y[2]) < 0) ||
-       (xtc_float(mf, &z[0]) < 0) ||
-       (xtc_float(mf, &z[1]) < 0) ||
-       (xtc_float(mf, &z[2]) < 0) )
-    return -1;
   // Allocate the box and convert the vectors.
   ts->box = (md_box *) malloc(sizeof(md_box));
-  if (mdio_readbox(ts->box, x, y, z) < 0) {
+  if (mdio_readbox(ts->box, frame.box, frame.box + 3, frame.box + 6) < 0) {
     free(ts->box);
     ts->box = NULL;
+    xtc_frame_free(&frame);
     return -1;
   }
 
 	ts->pos = (float *) malloc(sizeof(float) * 3 * ts->natoms);
-	if (!ts->pos) return mdio_seterror(MDIO_BADMALLOC);
-	n = xtc_3dfcoord(mf, ts->pos, &size, &precision);
+	if (!ts->pos) {
+		xtc_frame_free(&frame);
+		return mdio_seterror(MDIO_BADMALLOC);
+	}
+	n = xtc_decode_frame(&frame, ts->pos);
+	xtc_frame_free(&frame);
 	if (n < 0) return -1;
 
 	/* Now we're left with the job of scaling... */
@@ -1777,69 +1828,109 @@ static void xtc_receiveints(int *buf, const int nints, int nbits,
 	nums[0] = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
 }
 
-// function that actually reads and writes compressed coordinates    
-static int xtc_3dfcoord(md_file *mf, float *fp, int *size, float *precision) {
-	static int *ip = NULL;
-	static int oldsize;
-	static int *buf;
+// xtc_read_frame() - reads the header and the compressed coordinates of
+// the next frame, without decoding them. frame->buf is (re)allocated as
+// needed and can be reused for subsequent frames.
+static int xtc_read_frame(md_file *mf, xtc_frame *frame) {
+	int n, i, lsize, nbytes, nints;
+
+	if (!mf || !frame) return mdio_seterror(MDIO_BADPARAMS);
 
-	int minint[3], maxint[3], *lip;
+	// Check magic number
+	if (xtc_int(mf, &n) < 0) return -1;
+	if (n != XTC_MAGIC) return mdio_seterror(MDIO_BADFORMAT);
+
+	// Number of atoms, simulation step and time
+	if (xtc_int(mf, &frame->natoms) < 0) return -1;
+	if (xtc_int(mf, &frame->step) < 0) return -1;
+	if (xtc_float(mf, &frame->time) < 0) return -1;
+
+	// Basis vectors of the box
+	for (i = 0; i < 9; i++)
+		if (xtc_float(mf, frame->box + i) < 0) return -1;
+
+	if (xtc_int(mf, &lsize) < 0) return -1;
+	if (lsize != frame->natoms) return mdio_seterror(MDIO_BADFORMAT);
+
+	if (lsize <= 9) {
+		// uncompressed, store the floats after the reader state
+		frame->precision = 0.f;
+		nints = 3 + lsize * 3;
+	} else {
+		if (xtc_float(mf, &frame->precision) < 0) return -1;
+		for (i = 0; i < 3; i++)
+			if (xtc_int(mf, frame->minint + i) < 0) return -1;
+		for (i = 0; i < 3; i++)
+			if (xtc_int(mf, frame->maxint + i) < 0) return -1;
+		if (xtc_int(mf, &frame->smallidx) < 0) return -1;
+		if (xtc_int(mf, &nbytes) < 0) return -1;
+		if (nbytes < 0) return mdio_seterror(MDIO_BADFORMAT);
+		nints = 3 + (nbytes + 3) / 4 + 1; // +1 slack for the bit reader
+	}
+
+	if (frame->bufsize < nints) {
+		int *buf = (int *) realloc(frame->buf, nints * sizeof(int));
+		if (!buf) return mdio_seterror(MDIO_BADMALLOC);
+		frame->buf = buf;
+		frame->bufsize = nints;
+	}
+
+	if (lsize <= 9) {
+		float *fp = (float *) (frame->buf + 3);
+		for (i = 0; i < lsize * 3; i++)
+			if (xtc_float(mf, fp + i) < 0) return -1;
+	} else {
+		frame->buf[0] = nbytes;
+		if (nbytes && xtc_data(mf, (char *) &frame->buf[3], nbytes) < 0)
+			return -1;
+	}
+
+	return mdio_seterror(MDIO_SUCCESS);
+}
+
+
+// xtc_frame_free() - releases the buffer of a frame
+static void xtc_frame_free(xtc_frame *frame) {
+	free(frame->buf);
+	frame->buf = NULL;
+	frame->bufsize = 0;
+}
+
+
+// xtc_decode_frame() - decompresses the coordinates of a frame (in nm)
+// into fp (3 * natoms). Only touches the frame's own buffer, so
+// different frames may be decoded concurrently.
+static int xtc_decode_frame(xtc_frame *frame, float *fp) {
+	int *ip, *buf, *lip;
+	int minint[3], maxint[3];
 	int smallidx;
-	unsigned sizeint[3], sizesmall[3], bitsizeint[3], size3;
+	unsigned sizeint[3], sizesmall[3], bitsizeint[3];
 	int flag, k;
 	int small, smaller, i, is_smaller, run;
 	float *lfp;
 	int tmp, *thiscoord,  prevcoord[3];
 
-	int bufsize, lsize;
+	int lsize;
 	unsigned int bitsize;
 	float inv_precision;
 
-        /* avoid uninitialized data compiler warnings */
-        bitsizeint[0] = 0;
-        bitsizeint[1] = 0;
-        bitsizeint[2] = 0;
+	lsize = frame->natoms;
 
-	if (xtc_int(mf, &lsize) < 0) return -1;
+	if (lsize <= 9) {
+		memcpy(fp, frame->buf + 3, sizeof(float) * 3 * lsize);
+		return lsize;
+	}
 
-	if (*size != 0 && lsize != *size) return mdio_seterror(MDIO_BADFORMAT);
+	/* avoid uninitialized data compiler warnings */
+	bitsizeint[0] = 0;
+	bitsizeint[1] = 0;
+	bitsizeint[2] = 0;
 
-	*size = lsize;
-	size3 = *size * 3;
-	if (*size <= 9) {
-		for (i = 0; i < *size; i++) {
-			if (xtc_float(mf, fp + (3 * i)) < 0) return -1;
-			if (xtc_float(mf, fp + (3 * i) + 1) < 0) return -1;
-			if (xtc_float(mf, fp + (3 * i) + 2) < 0) return -1;
-		}
-		return *size;
-	}
-	xtc_float(mf, precision);
-	if (ip == NULL) {
-		ip = (int *)malloc(size3 * sizeof(*ip));
-		if (ip == NULL) return mdio_seterror(MDIO_BADMALLOC);
-		bufsize = (int) (size3 * 1.2);
-		buf = (int *)malloc(bufsize * sizeof(*buf));
-		if (buf == NULL) return mdio_seterror(MDIO_BADMALLOC);
-		oldsize = *size;
-	} else if (*size > oldsize) {
-		ip = (int *)realloc(ip, size3 * sizeof(*ip));
-		if (ip == NULL) return mdio_seterror(MDIO_BADMALLOC);
-		bufsize = (int) (size3 * 1.2);
-		buf = (int *)realloc(buf, bufsize * sizeof(*buf));
-		if (buf == NULL) return mdio_seterror(MDIO_BADMALLOC);
-		oldsize = *size;
+	for (k = 0; k < 3; k++) {
+		minint[k] = frame->minint[k];
+		maxint[k] = frame->maxint[k];
 	}
-	buf[0] = buf[1] = buf[2] = 0;
-
-	xtc_int(mf, &(minint[0]));
-	xtc_int(mf, &(minint[1]));
-	xtc_int(mf, &(minint[2]));
 
-	xtc_int(mf, &(maxint[0]));
-	xtc_int(mf, &(maxint[1]));
-	xtc_int(mf, &(maxint[2]));
-		
 	sizeint[0] = maxint[0] - minint[0]+1;
 	sizeint[1] = maxint[1] - minint[1]+1;
 	sizeint[2] = maxint[2] - minint[2]+1;
@@ -1854,7 +1945,11 @@ static int xtc_3dfcoord(md_file *mf, float *fp, int *size, float *precision) {
 		bitsize = xtc_sizeofints(3, sizeint);
 	}
 
-	xtc_int(mf, &smallidx);
+	smallidx = frame->smallidx;
+	if (smallidx < FIRSTIDX || smallidx >= (int) LASTIDX) {
+		printf("XTC corrupted, smallidx out of range\n");
+		return -1;
+	}
 	smaller = xtc_magicints[FIRSTIDX > smallidx - 1 ? FIRSTIDX : smallidx - 1] / 2;
 	small = xtc_magicints[smallidx] / 2;
 	sizesmall[0] = sizesmall[1] = sizesmall[2] = xtc_magicints[smallidx];
@@ -1865,16 +1960,14 @@ static int xtc_3dfcoord(md_file *mf, float *fp, int *size, float *precision) {
 		return -1;
 	}
 
+	ip = (int *)malloc(lsize * 3 * sizeof(*ip));
+	if (ip == NULL) return mdio_seterror(MDIO_BADMALLOC);
 
-	/* buf[0] holds the length in bytes */
-	if (xtc_int(mf, &(buf[0])) < 0) return -1;
-
-	if (xtc_data(mf, (char *) &buf[3], (int) buf[0]) < 0) return -1;
-
+	buf = frame->buf;
 	buf[0] = buf[1] = buf[2] = 0;
 
 	lfp = fp;
-	inv_precision = 1.0f / (*precision);
+	inv_precision = 1.0f / frame->precision;
 	run = 0;
 	i = 0;
 	lip = ip;
@@ -1931,6 +2024,7 @@ static int xtc_3dfcoord(md_file *mf, float *fp, int *size, float *precision) {
 
 					if ( !sizesmall[0] || !sizesmall[1] || !sizesmall[2] ) {
 						printf("XTC corrupted, sizesmall==0 (case 2)\n");
+						free(ip);
 						return -1;
 					}
 
@@ -1962,6 +2056,196 @@ static int xtc_3dfcoord(md_file *mf, float *fp, int *size, float *precision) {
 		}
 		sizesmall[0] = sizesmall[1] = sizesmall[2] = xtc_magicints[smallidx] ;
 	}
-	return 1;
+	free(ip);
+	return lsize;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Writer counterpart of xtc_decode_frame(). Coordinates are quantized to
+// the given precision and packed with the same large-integer encoding
+// as the reader expects. The run-length "small difference" encoding is
+// not used (every atom is written with its run flag cleared), which
+// still yields a valid .xtc file at roughly half the size of .trr.
+///////////////////////////////////////////////////////////////////////
+
+// MSB-first bit stream, the inverse of xtc_receivebits()
+typedef struct {
+	unsigned char *data;
+	int cnt;
+	int lastbits;
+	unsigned long long lastbyte;
+} xtc_bitbuf;
+
+static void xtc_sendbits(xtc_bitbuf *bb, int nbits, unsigned int num) {
+	// at most 8 bits at a time, so that no shift count reaches the
+	// width of its operand (nbits may exceed 32 for zero padding)
+	while (nbits > 0) {
+		int n = nbits > 8 ? 8 : nbits;
+		unsigned int chunk;
+		nbits -= n;
+		chunk = (nbits >= 32) ? 0u : (num >> nbits) & ((1u << n) - 1);
+		bb->lastbyte = (bb->lastbyte << n) | chunk;
+		bb->lastbits += n;
+		if (bb->lastbits >= 8) {
+			bb->lastbits -= 8;
+			bb->data[bb->cnt++] = (unsigned char) (bb->lastbyte >> bb->lastbits);
+		}
+	}
+}
+
+// flushes the last partial byte (zero padded)
+static void xtc_flushbits(xtc_bitbuf *bb) {
+	if (bb->lastbits > 0) {
+		bb->data[bb->cnt++] =
+			(unsigned char) (bb->lastbyte << (8 - bb->lastbits));
+		bb->lastbits = 0;
+	}
+}
+
+// compresses integers into the buffer, the inverse of xtc_receiveints()
+static void xtc_sendints(xtc_bitbuf *bb, const int nints, int nbits,
+			unsigned int *sizes, unsigned int *nums) {
+	unsigned int bytes[32], tmp;
+	int i, nbytes, bytecnt;
+
+	tmp = nums[0];
+	nbytes = 0;
+	do {
+		bytes[nbytes++] = tmp & 0xff;
+		tmp >>= 8;
+	} while (tmp != 0);
+
+	for (i = 1; i < nints; i++) {
+		tmp = nums[i];
+		for (bytecnt = 0; bytecnt < nbytes; bytecnt++) {
+			tmp = bytes[bytecnt] * sizes[i] + tmp;
+			bytes[bytecnt] = tmp & 0xff;
+			tmp >>= 8;
+		}
+		while (tmp != 0) {
+			bytes[bytecnt++] = tmp & 0xff;
+			tmp >>= 8;
+		}
+		nbytes = bytecnt;
+	}
+
+	if (nbits >= nbytes * 8) {
+		for (i = 0; i < nbytes; i++)
+			xtc_sendbits(bb, 8, bytes[i]);
+		xtc_sendbits(bb, nbits - nbytes * 8, 0);
+	} else {
+		for (i = 0; i < nbytes - 1; i++)
+			xtc_sendbits(bb, 8, bytes[i]);
+		xtc_sendbits(bb, nbits - (nbytes - 1) * 8, bytes[i]);
+	}
+}
+
+// xtc_timestep_write() - writes a timestep to an .xtc file. Box and
+// coordinates are expected in nm, box as 9 floats (row vectors).
+static int xtc_timestep_write(md_file *mf, int natoms, int step, float time,
+		const float *box, const float *pos, float precision) {
+	int i, k, minint[3], maxint[3], *ip;
+	unsigned int sizeint[3], bitsizeint[3], bitsize, nums[3];
+	xtc_bitbuf bb;
+	const float maxabs = 2147483647.0f - 2.0f;
+	static const unsigned char pad[4] = {0, 0, 0, 0};
+
+	if (!mf || !mf->f || !box || !pos) return mdio_seterror(MDIO_BADPARAMS);
+
+	if ( put_trx_int(mf, XTC_MAGIC)
+	     || put_trx_int(mf, natoms)
+	     || put_trx_int(mf, step)
+	     || put_trx_real(mf, time))
+		return -1;
+
+	for (i = 0; i < 9; i++)
+		if (put_trx_real(mf, box[i])) return -1;
+
+	if (put_trx_int(mf, natoms)) return -1;
+
+	// small systems are stored uncompressed
+	if (natoms <= 9) {
+		for (i = 0; i < natoms * 3; i++)
+			if (put_trx_real(mf, pos[i])) return -1;
+		return mdio_seterror(MDIO_SUCCESS);
+	}
+
+	ip = (int *) malloc(sizeof(int) * 3 * natoms);
+	if (!ip) return mdio_seterror(MDIO_BADMALLOC);
+
+	minint[0] = minint[1] = minint[2] = 0x7fffffff;
+	maxint[0] = maxint[1] = maxint[2] = -0x7fffffff;
+
+	for (i = 0; i < natoms * 3; i++) {
+		float f = pos[i] * precision;
+		if (!(fabsf(f) < maxabs)) {
+			free(ip);
+			return mdio_seterror(MDIO_BADFORMAT);
+		}
+		ip[i] = (int) (f >= 0.f ? f + 0.5f : f - 0.5f);
+		k = i % 3;
+		if (ip[i] < minint[k]) minint[k] = ip[i];
+		if (ip[i] > maxint[k]) maxint[k] = ip[i];
+	}
+
+	for (k = 0; k < 3; k++)
+		sizeint[k] = (unsigned int) maxint[k] - (unsigned int) minint[k] + 1;
+
+	// same decision as the reader
+	if ((sizeint[0] | sizeint[1] | sizeint[2]) > 0xffffff) {
+		bitsizeint[0] = xtc_sizeofint(sizeint[0]);
+		bitsizeint[1] = xtc_sizeofint(sizeint[1]);
+		bitsizeint[2] = xtc_sizeofint(sizeint[2]);
+		bitsize = 0;
+	} else {
+		bitsizeint[0] = bitsizeint[1] = bitsizeint[2] = 0;
+		bitsize = xtc_sizeofints(3, sizeint);
+	}
+
+	// at most 32 bits per coordinate plus one flag bit per atom
+	bb.data = (unsigned char *) malloc(natoms * 13 + 8);
+	if (!bb.data) {
+		free(ip);
+		return mdio_seterror(MDIO_BADMALLOC);
+	}
+	bb.cnt = 0;
+	bb.lastbits = 0;
+	bb.lastbyte = 0;
+
+	for (i = 0; i < natoms; i++) {
+		for (k = 0; k < 3; k++)
+			nums[k] = (unsigned int) ip[i * 3 + k] - (unsigned int) minint[k];
+
+		if (bitsize == 0) {
+			for (k = 0; k < 3; k++)
+				xtc_sendbits(&bb, bitsizeint[k], nums[k]);
+		} else {
+			xtc_sendints(&bb, 3, bitsize, sizeint, nums);
+		}
+
+		// no run of small differences follows
+		xtc_sendbits(&bb, 1, 0);
+	}
+	xtc_flushbits(&bb);
+	free(ip);
+
+	if ( put_trx_real(mf, precision)
+	     || put_trx_int(mf, minint[0])
+	     || put_trx_int(mf, minint[1])
+	     || put_trx_int(mf, minint[2])
+	     || put_trx_int(mf, maxint[0])
+	     || put_trx_int(mf, maxint[1])
+	     || put_trx_int(mf, maxint[2])
+	     || put_trx_int(mf, FIRSTIDX)
+	     || put_trx_int(mf, bb.cnt)
+	     || fwrite(bb.data, 1, bb.cnt, mf->f) != (size_t) bb.cnt
+	     || (bb.cnt % 4 && fwrite(pad, 1, 4 - bb.cnt % 4, mf->f)
+	                       != (size_t) (4 - bb.cnt % 4))) {
+		free(bb.data);
+		return mdio_seterror(MDIO_IOERROR);
+	}
+
+	free(bb.data);
+	return mdio_seterror(MDIO_SUCCESS);
 }
 #endif
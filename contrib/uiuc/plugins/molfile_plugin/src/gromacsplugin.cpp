@@ -49,8 +49,20 @@ typedef struct {
   float timeval;
   molfile_atom_t *atomlist;
   molfile_metadata_t *meta;
+
+  // XTC read-ahead batch (see read_xtc_timestep)
+  xtc_frame *xtc_frames;
+  float *xtc_pos;
+  int *xtc_status;
+  int xtc_nframes;
+  int xtc_next;
+  int xtc_readahead;
 } gmxdata;
 
+// maximum number of XTC frames and coordinates decoded per batch
+#define XTC_READAHEAD_MAX 32
+#define XTC_READAHEAD_MAXFLOATS (16 * 1024 * 1024)
+
 static void convert_vmd_box_for_writing(const molfile_timestep_t *ts, float *x, float *y, float *z)
 {
 //     const float sa = sin((double)ts->alpha/180.0*M_PI);
@@ -471,12 +483,129 @@ static void *open_trr_read(const char *filename, const char *filetype,
     return gmx;
 }
 
+// XTC frames are read sequentially but decompressed concurrently, in
+// batches. The batch size doubles with every batch of consecutive reads and
+// drops back to one when a frame gets skipped, so that sparse reads (start,
+// interval) don't decode frames which are not requested.
+static int read_xtc_timestep(gmxdata *gmx, int natoms, molfile_timestep_t *ts) {
+  int i, n;
+
+  if (!ts) {
+    gmx->xtc_readahead = 1;
+    if (gmx->xtc_next < gmx->xtc_nframes) {
+      ++gmx->xtc_next;
+      return MOLFILE_SUCCESS;
+    }
+    if (mdio_skip_timestep(gmx->mf) < 0)
+      return MOLFILE_ERROR;
+    return MOLFILE_SUCCESS;
+  }
+
+  if (natoms <= 0) {
+    fprintf(stderr, "gromacsplugin) XTC file has no atoms\n");
+    return MOLFILE_ERROR;
+  }
+
+  if (gmx->xtc_next == gmx->xtc_nframes) {
+    int maxframes = gmx->xtc_readahead;
+    if (maxframes < 1)
+      maxframes = 1;
+    if (maxframes > XTC_READAHEAD_MAXFLOATS / (3 * natoms))
+      maxframes = XTC_READAHEAD_MAXFLOATS / (3 * natoms);
+    if (maxframes < 1)
+      maxframes = 1;
+
+    if (!gmx->xtc_frames) {
+      gmx->xtc_frames = (xtc_frame *) calloc(XTC_READAHEAD_MAX, sizeof(xtc_frame));
+      gmx->xtc_status = (int *) calloc(XTC_READAHEAD_MAX, sizeof(int));
+      if (!gmx->xtc_frames || !gmx->xtc_status)
+        return MOLFILE_ERROR;
+    }
+
+    // capacity of xtc_pos only ever grows with xtc_readahead
+    float *pos = (float *) realloc(gmx->xtc_pos,
+        sizeof(float) * 3 * natoms * maxframes);
+    if (!pos)
+      return MOLFILE_ERROR;
+    gmx->xtc_pos = pos;
+
+    for (n = 0; n < maxframes; ++n) {
+      if (xtc_read_frame(gmx->mf, gmx->xtc_frames + n) < 0)
+        break;
+    }
+
+    gmx->xtc_nframes = n;
+    gmx->xtc_next = 0;
+
+    if (n == 0) {
+      if (mdio_errno() != MDIO_EOF && mdio_errno() != MDIO_IOERROR) {
+        fprintf(stderr, "gromacsplugin) Error reading timestep, %s\n",
+                mdio_errmsg(mdio_errno()));
+      }
+      return MOLFILE_ERROR;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (n > 1)
+#endif
+    for (i = 0; i < n; ++i) {
+      xtc_frame *frame = gmx->xtc_frames + i;
+      gmx->xtc_status[i] = (frame->natoms != natoms) ? -1 :
+        xtc_decode_frame(frame, gmx->xtc_pos + (size_t) 3 * natoms * i);
+    }
+
+    gmx->xtc_readahead = maxframes * 2;
+    if (gmx->xtc_readahead > XTC_READAHEAD_MAX)
+      gmx->xtc_readahead = XTC_READAHEAD_MAX;
+  }
+
+  i = gmx->xtc_next++;
+  xtc_frame *frame = gmx->xtc_frames + i;
+
+  if (frame->natoms != natoms) {
+    fprintf(stderr, "gromacsplugin) Timestep in file contains wrong number of atoms\n");
+    fprintf(stderr, "gromacsplugin) Found %d, expected %d\n", frame->natoms, natoms);
+    return MOLFILE_ERROR;
+  }
+
+  if (gmx->xtc_status[i] < 0) {
+    fprintf(stderr, "gromacsplugin) Error decoding timestep\n");
+    return MOLFILE_ERROR;
+  }
+
+  const float *pos = gmx->xtc_pos + (size_t) 3 * natoms * i;
+  for (n = 0; n < 3 * natoms; ++n)
+    ts->coords[n] = pos[n] * ANGS_PER_NM;
+
+  md_box box;
+  if (mdio_readbox(&box, frame->box, frame->box + 3, frame->box + 6) == 0) {
+    ts->A = box.A;
+    ts->B = box.B;
+    ts->C = box.C;
+    ts->alpha = box.alpha;
+    ts->beta = box.beta;
+    ts->gamma = box.gamma;
+  }
+
+  return MOLFILE_SUCCESS;
+}
+
 static int read_trr_timestep(void *v, int natoms, molfile_timestep_t *ts) {
   gmxdata *gmx = (gmxdata *)v;
   md_ts mdts;
   memset(&mdts, 0, sizeof(md_ts));
   mdts.natoms = natoms;
 
+  if (gmx->mf->fmt == MDFMT_XTC)
+    return read_xtc_timestep(gmx, natoms, ts);
+
+  // skip the frame without converting it
+  if (!ts && (gmx->mf->fmt == MDFMT_TRR || gmx->mf->fmt == MDFMT_TRJ)) {
+    if (mdio_skip_timestep(gmx->mf) < 0)
+      return MOLFILE_ERROR;
+    return MOLFILE_SUCCESS;
+  }
+
   if (mdio_timestep(gmx->mf, &mdts) < 0) {
     if (mdio_errno() == MDIO_EOF || mdio_errno() == MDIO_IOERROR) {
       // XXX Lame, why does mdio treat IOERROR like EOF?
@@ -510,6 +639,13 @@ static int read_trr_timestep(void *v, int natoms, molfile_timestep_t *ts) {
 
 static void close_trr_read(void *v) {
   gmxdata *gmx = (gmxdata *)v;
+  if (gmx->xtc_frames) {
+    for (int i = 0; i < XTC_READAHEAD_MAX; ++i)
+      xtc_frame_free(gmx->xtc_frames + i);
+    free(gmx->xtc_frames);
+  }
+  free(gmx->xtc_status);
+  free(gmx->xtc_pos);
   mdio_close(gmx->mf);
   delete gmx;
 }
@@ -554,6 +690,21 @@ static int write_trr_timestep(void *mydata, const molfile_timestep_t *ts)
 
   gmxdata *gmx = (gmxdata *)mydata;
 
+  // set up box according to the VMD unitcell conventions.
+  // the a-vector is collinear with the x-axis and
+  // the b-vector is in the xy-plane.
+  const float sa = sin((double)ts->alpha/180.0*M_PI);
+  const float ca = cos((double)ts->alpha/180.0*M_PI);
+  const float cb = cos((double)ts->beta/180.0*M_PI);
+  const float cg = cos((double)ts->gamma/180.0*M_PI);
+  const float sg = sin((double)ts->gamma/180.0*M_PI);
+  float box[9];
+  box[0] = ts->A;    box[1] = 0.0;      box[2] = 0.0;
+  box[3] = ts->B*ca; box[4] = ts->B*sa; box[5] = 0.0;
+  box[6] = ts->C*cb; box[7] = ts->C*(ca - cb*cg)/sg;
+  box[8] = ts->C*sqrt((double)(1.0 + 2.0*ca*cb*cg
+                               - ca*ca - cb*cb - cg*cg)/(1.0 - cg*cg));
+
   // determine and write header from structure info.
   // write trr header. XXX: move this to Gromacs.h ??
   if (gmx->mf->fmt == MDFMT_TRR) {
@@ -578,21 +729,6 @@ static int write_trr_timestep(void *mydata, const molfile_timestep_t *ts)
          || put_trx_real(gmx->mf, 0.0))             // current lambda
       return MOLFILE_ERROR;
 
-    // set up box according to the VMD unitcell conventions.
-    // the a-vector is collinear with the x-axis and
-    // the b-vector is in the xy-plane.
-    const float sa = sin((double)ts->alpha/180.0*M_PI);
-    const float ca = cos((double)ts->alpha/180.0*M_PI);
-    const float cb = cos((double)ts->beta/180.0*M_PI);
-    const float cg = cos((double)ts->gamma/180.0*M_PI);
-    const float sg = sin((double)ts->gamma/180.0*M_PI);
-    float box[9];
-    box[0] = ts->A;    box[1] = 0.0;      box[2] = 0.0;
-    box[3] = ts->B*ca; box[4] = ts->B*sa; box[5] = 0.0;
-    box[6] = ts->C*cb; box[7] = ts->C*(ca - cb*cg)/sg;
-    box[8] = ts->C*sqrt((double)(1.0 + 2.0*ca*cb*cg
-                                 - ca*ca - cb*cb - cg*cg)/(1.0 - cg*cg));
-
     for (i=0; i<9; ++i) {
       if (put_trx_real(gmx->mf, box[i]*nm))
         return MOLFILE_ERROR;
@@ -607,8 +743,25 @@ static int write_trr_timestep(void *mydata, const molfile_timestep_t *ts)
       if (put_trx_real(gmx->mf, ts->coords[i]*nm))
         return MOLFILE_ERROR;
     }
+  } else if (gmx->mf->fmt == MDFMT_XTC) {
+    int i;
+    float *pos = (float *) malloc(sizeof(float) * 3 * gmx->natoms);
+    if (!pos)
+      return MOLFILE_ERROR;
+
+    for (i=0; i<9; ++i)
+      box[i] *= nm;
+    for (i=0; i<(3*gmx->natoms); ++i)
+      pos[i] = ts->coords[i]*nm;
+
+    // precision 1000 is the gromacs default (0.001 nm)
+    i = xtc_timestep_write(gmx->mf, gmx->natoms, gmx->step,
+                           0.1*gmx->step, box, pos, 1000.0f);
+    free(pos);
+    if (i < 0)
+      return MOLFILE_ERROR;
   } else {
-    fprintf(stderr, "gromacsplugin) only .trr is supported for writing\n");
+    fprintf(stderr, "gromacsplugin) only .trr and .xtc are supported for writing\n");
     return MOLFILE_ERROR;
   }
 
@@ -707,6 +860,9 @@ VMDPLUGIN_API int VMDPLUGIN_init() {
   xtc_plugin.open_file_read = open_trr_read;
   xtc_plugin.read_next_timestep = read_trr_timestep;
   xtc_plugin.close_file_read = close_trr_read;
+  xtc_plugin.open_file_write = open_trr_write;
+  xtc_plugin.write_timestep = write_trr_timestep;
+  xtc_plugin.close_file_write = close_trr_write;
 
   // TRJ plugin
   memset(&trj_plugin, 0, sizeof(molfile_plugin_t));
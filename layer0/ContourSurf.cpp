@@ -423,6 +423,20 @@ public:
         m_field->points->get<float>(x, y, z, 2),
     };
   }
+
+  bool mayContain(
+      const size_t* lo, const size_t* hi, float isoLevel) const override
+  {
+    if (!m_field->minmax)
+      return true;
+
+    int abs_lo[3], abs_hi[3];
+    for (int c = 0; c < 3; ++c) {
+      abs_lo[c] = lo[c] + m_offset[c];
+      abs_hi[c] = hi[c] + m_offset[c];
+    }
+    return m_field->minmax->contains(abs_lo, abs_hi, isoLevel);
+  }
 };
 
 /**
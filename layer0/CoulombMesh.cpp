@@ -0,0 +1,196 @@
+/*
+ * Particle-mesh Coulomb potential on a regular grid
+ */
+
+#include "CoulombMesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <vector>
+
+#ifdef PYMOL_OPENMP
+#include <omp.h>
+#endif
+
+#include "pocketfft_hdronly.h"
+
+namespace pymol
+{
+
+namespace
+{
+//! Width (1 / alpha) of the smooth long-range part, in grid spacings
+constexpr float smooth_width = 2.f;
+
+//! alpha * cutoff of the short-range part, erfc(3.2) ~ 6e-6
+constexpr float cutoff_factor = 3.2f;
+
+size_t fft_threads()
+{
+#ifdef PYMOL_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+} // namespace
+
+void coulomb_mesh_potential(const float* coords, const float* charges,
+    size_t n, const float* origin, const float* spacing, const int* dims,
+    float* out, float min_dist)
+{
+  const size_t n_out = size_t(dims[0]) * dims[1] * dims[2];
+  std::fill_n(out, n_out, 0.f);
+
+  if (!n || !n_out)
+    return;
+
+  const float h_max = std::max({spacing[0], spacing[1], spacing[2]});
+  const float alpha = 1.f / (smooth_width * h_max);
+  const float cutoff = cutoff_factor / alpha;
+
+  // extended grid which covers the map and all charges, zero-padded to
+  // twice its size so that the circular convolution has no wrap-around
+  int lo[3];
+  size_t L[3];
+  for (int d = 0; d < 3; ++d) {
+    float mn = coords[d], mx = coords[d];
+    for (size_t i = 1; i < n; ++i) {
+      mn = std::min(mn, coords[3 * i + d]);
+      mx = std::max(mx, coords[3 * i + d]);
+    }
+    lo[d] = std::min(0, int(std::floor((mn - origin[d]) / spacing[d])));
+    int hi = std::max(
+        dims[d] - 1, int(std::floor((mx - origin[d]) / spacing[d])) + 1);
+    L[d] = pocketfft::detail::util::good_size_real(2 * (hi - lo[d]) + 1);
+  }
+
+  const size_t Lc2 = L[2] / 2 + 1;
+  const size_t n_real = L[0] * L[1] * L[2];
+  const size_t n_complex = L[0] * L[1] * Lc2;
+
+  // trilinear charge assignment
+  std::vector<float> rho(n_real, 0.f);
+  for (size_t i = 0; i < n; ++i) {
+    size_t i0[3];
+    float f[3];
+    for (int d = 0; d < 3; ++d) {
+      float g = (coords[3 * i + d] - origin[d]) / spacing[d] - lo[d];
+      float gi = std::floor(g);
+      i0[d] = size_t(gi);
+      f[d] = g - gi;
+    }
+    for (int corner = 0; corner < 8; ++corner) {
+      const int da = (corner >> 2) & 1, db = (corner >> 1) & 1, dc = corner & 1;
+      float w = (da ? f[0] : 1.f - f[0]) * (db ? f[1] : 1.f - f[1]) *
+                (dc ? f[2] : 1.f - f[2]);
+      rho[((i0[0] + da) * L[1] + (i0[1] + db)) * L[2] + (i0[2] + dc)] +=
+          w * charges[i];
+    }
+  }
+
+  // sampled long-range kernel erf(alpha r) / r, wrapped offsets
+  std::vector<float> kernel(n_real);
+  const float kernel_zero = 2.f * alpha / std::sqrt(float(M_PI));
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+  for (long a = 0; a < long(L[0]); ++a) {
+    float dx = (a <= long(L[0] / 2) ? a : a - long(L[0])) * spacing[0];
+    for (size_t b = 0; b < L[1]; ++b) {
+      float dy = (b <= L[1] / 2 ? float(b) : float(b) - L[1]) * spacing[1];
+      float* row = kernel.data() + (a * L[1] + b) * L[2];
+      for (size_t c = 0; c < L[2]; ++c) {
+        float dz = (c <= L[2] / 2 ? float(c) : float(c) - L[2]) * spacing[2];
+        float r = std::sqrt(dx * dx + dy * dy + dz * dz);
+        row[c] = (r > 0.f) ? std::erf(alpha * r) / r : kernel_zero;
+      }
+    }
+  }
+
+  // convolution
+  const pocketfft::shape_t shape{L[0], L[1], L[2]};
+  const pocketfft::shape_t axes{0, 1, 2};
+  const pocketfft::stride_t stride_r{
+      ptrdiff_t(L[1] * L[2] * sizeof(float)),
+      ptrdiff_t(L[2] * sizeof(float)), ptrdiff_t(sizeof(float))};
+  const pocketfft::stride_t stride_c{
+      ptrdiff_t(L[1] * Lc2 * sizeof(std::complex<float>)),
+      ptrdiff_t(Lc2 * sizeof(std::complex<float>)),
+      ptrdiff_t(sizeof(std::complex<float>))};
+
+  std::vector<std::complex<float>> rho_hat(n_complex);
+  std::vector<std::complex<float>> kernel_hat(n_complex);
+  pocketfft::r2c(shape, stride_r, stride_c, axes, pocketfft::FORWARD,
+      rho.data(), rho_hat.data(), 1.f, fft_threads());
+  pocketfft::r2c(shape, stride_r, stride_c, axes, pocketfft::FORWARD,
+      kernel.data(), kernel_hat.data(), 1.f, fft_threads());
+  kernel.clear();
+  kernel.shrink_to_fit();
+
+  for (size_t i = 0; i < n_complex; ++i)
+    rho_hat[i] *= kernel_hat[i];
+  kernel_hat.clear();
+  kernel_hat.shrink_to_fit();
+
+  pocketfft::c2r(shape, stride_c, stride_r, axes, pocketfft::BACKWARD,
+      rho_hat.data(), rho.data(), 1.f / float(n_real), fft_threads());
+
+  for (int a = 0; a < dims[0]; ++a) {
+    for (int b = 0; b < dims[1]; ++b) {
+      const float* src =
+          rho.data() + (size_t(a - lo[0]) * L[1] + (b - lo[1])) * L[2] - lo[2];
+      std::copy_n(src, dims[2], out + (size_t(a) * dims[1] + b) * dims[2]);
+    }
+  }
+
+  // short-range part, each thread owns a slab of the output
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+      [&](size_t i, size_t j) { return coords[3 * i] < coords[3 * j]; });
+  std::vector<float> sorted_x(n);
+  for (size_t i = 0; i < n; ++i)
+    sorted_x[i] = coords[3 * order[i]];
+
+  const float cutoff2 = cutoff * cutoff;
+  const float min_dist2 = min_dist * min_dist;
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int a = 0; a < dims[0]; ++a) {
+    const float x = origin[0] + a * spacing[0];
+    auto first = std::lower_bound(sorted_x.begin(), sorted_x.end(), x - cutoff);
+    auto last = std::upper_bound(first, sorted_x.end(), x + cutoff);
+
+    for (auto it = first; it != last; ++it) {
+      const size_t j = order[it - sorted_x.begin()];
+      const float* p = coords + 3 * j;
+      const float dx = x - p[0];
+
+      int b0 = std::max(0, int(std::ceil((p[1] - cutoff - origin[1]) / spacing[1])));
+      int b1 = std::min(dims[1] - 1, int(std::floor((p[1] + cutoff - origin[1]) / spacing[1])));
+      int c0 = std::max(0, int(std::ceil((p[2] - cutoff - origin[2]) / spacing[2])));
+      int c1 = std::min(dims[2] - 1, int(std::floor((p[2] + cutoff - origin[2]) / spacing[2])));
+
+      for (int b = b0; b <= b1; ++b) {
+        const float dy = origin[1] + b * spacing[1] - p[1];
+        const float dxy2 = dx * dx + dy * dy;
+        float* row = out + (size_t(a) * dims[1] + b) * dims[2];
+        for (int c = c0; c <= c1; ++c) {
+          const float dz = origin[2] + c * spacing[2] - p[2];
+          const float r2 = dxy2 + dz * dz;
+          if (r2 < cutoff2 && r2 > min_dist2) {
+            const float r = std::sqrt(r2);
+            row[c] += charges[j] * std::erfc(alpha * r) / r;
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace pymol
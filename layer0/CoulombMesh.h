@@ -0,0 +1,37 @@
+/*
+ * Particle-mesh Coulomb potential on a regular grid
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace pymol
+{
+
+/**
+ * Coulomb potential sum(q / r) of point charges on a regular orthogonal grid.
+ *
+ * Uses Ewald splitting without periodic images: the smooth long-range part
+ * erf(alpha r) / r is a convolution of the mesh-assigned (trilinear) charges
+ * with a sampled kernel on a zero-padded grid (FFT), the short-range part
+ * erfc(alpha r) / r is summed directly within a cutoff. Cost is
+ * O(M log M + N) instead of O(M N) for M grid points and N charges.
+ *
+ * Grid points closer than `min_dist` to a charge get no short-range
+ * contribution from it (like the direct summation).
+ *
+ * @param coords Charge positions (3 * n)
+ * @param charges Charges (n), including any unit factor
+ * @param n Number of charges
+ * @param origin Position of grid point (0, 0, 0)
+ * @param spacing Grid spacing per axis
+ * @param dims Grid dimensions
+ * @param[out] out Potential, C order (last index fastest)
+ * @param min_dist Minimum distance for short-range contributions
+ */
+void coulomb_mesh_potential(const float* coords, const float* charges,
+    size_t n, const float* origin, const float* spacing, const int* dims,
+    float* out, float min_dist = 1e-4f);
+
+} // namespace pymol
@@ -24,6 +24,7 @@ Z* -------------------------------------------------------------------
 #include"PConv.h"
 
 #include"Field.h"
+#include"FieldQuantize.h"
 #include"Vector.h"
 #include "Setting.h"
 
@@ -94,9 +95,18 @@ PyObject *FieldAsPyList(PyMOLGlobals * G, CField * I)
   int pse_export_version = SettingGetGlobal_f(G, cSetting_pse_export_version) * 1000;
   bool dump_binary = (!pse_export_version || pse_export_version > 1776) && SettingGetGlobal_b(G, cSetting_pse_binary_dump);
 
+  // optional lossy storage of 3D maps. Only 8 and 16 bits are supported,
+  // any other value stores full precision. Older versions can't read the
+  // quantized encoding, so it's also off when exporting for them.
+  int precision = SettingGetGlobal_i(G, cSetting_map_session_precision);
+  bool quantize = (precision == 8 || precision == 16) &&
+                  (!pse_export_version || pse_export_version >= 3200) &&
+                  I->type == cFieldFloat && I->base_size == sizeof(float) &&
+                  I->n_dim() == 3;
+
   /* first, dump the atoms */
 
-  result = PyList_New(7);
+  result = PyList_New(quantize ? 8 : 7);
   PyList_SetItem(result, 0, PyInt_FromLong(I->type));
   PyList_SetItem(result, 1, PyInt_FromLong(I->n_dim()));
   PyList_SetItem(result, 2, PyInt_FromLong(I->base_size));
@@ -104,6 +114,19 @@ PyObject *FieldAsPyList(PyMOLGlobals * G, CField * I)
   PyList_SetItem(result, 4, PConvIntArrayToPyList((int *) I->dim.data(), I->n_dim()));
   PyList_SetItem(result, 5, PConvIntArrayToPyList((int *) I->stride.data(), I->n_dim()));
   n_elem = I->data.size() / I->base_size;
+
+  if (quantize) {
+    auto q = pymol::quantize_floats((const float*) I->data.data(), n_elem, precision);
+    PyList_SetItem(result, 6, PyBytes_FromStringAndSize(
+                                  (const char*) q.codes.data(), q.codes.size()));
+    PyObject* info = PyList_New(3);
+    PyList_SetItem(info, 0, PyInt_FromLong(q.bits));
+    PyList_SetItem(info, 1, PConvToPyObject(q.offsets));
+    PyList_SetItem(info, 2, PConvToPyObject(q.scales));
+    PyList_SetItem(result, 7, info);
+    return (PConvAutoNone(result));
+  }
+
   switch (I->type) {
   case cFieldInt:
     PyList_SetItem(result, 6, PConvIntArrayToPyList((int *) I->data.data(), n_elem, dump_binary));
@@ -156,7 +179,21 @@ CField *FieldNewFromPyList(PyMOLGlobals * G, PyObject * list)
   /* TO SUPPORT BACKWARDS COMPATIBILITY...
      Always check ll when adding new PyList_GetItem's */
 
-  if(ok) {
+  if(ok && PyList_Size(list) > 7) {
+    // block quantized (map_session_precision)
+    pymol::QuantizedFloats q;
+    PyObject *info = PyList_GetItem(list, 7);
+    ok = I->type == cFieldFloat && I->base_size == sizeof(float) &&
+         PyList_Check(info) && PyList_Size(info) == 3 &&
+         PConvFromPyListItem(G, info, 0, q.bits) &&
+         PConvFromPyListItem(G, info, 1, q.offsets) &&
+         PConvFromPyListItem(G, info, 2, q.scales) &&
+         PConvFromPyListItem(G, list, 6, q.codes);
+    if(ok) {
+      I->data.resize(q.size() * sizeof(float));
+      ok = pymol::dequantize_floats(q, (float *) I->data.data());
+    }
+  } else if(ok) {
     switch (I->type) {
     case cFieldInt:
       {
@@ -318,6 +355,59 @@ void FieldInterpolate3f(CField * I, int *locus, float *fract, float *result)
   }
 }
 
+/**
+ * Gradient of a 3D float field at grid point (a, b, c), relative to grid
+ * axis spacing. Central differences inside, one-sided at the borders.
+ */
+void FieldGradient3f(const CField * I, int a, int b, int c, float *result)
+{
+  const int pos[3] = {a, b, c};
+
+  for(int d = 0; d < 3; d++) {
+    int lo[3] = {a, b, c};
+    int hi[3] = {a, b, c};
+    float scale = 1.0F;
+
+    if(pos[d] > 0)
+      lo[d]--;
+    if(pos[d] + 1 < (int) I->dim[d])
+      hi[d]++;
+    if(hi[d] - lo[d] == 2)
+      scale = 0.5F;
+    else if(hi[d] == lo[d]) {
+      result[d] = 0.0F;
+      continue;
+    }
+
+    result[d] = (Ffloat3(I, hi[0], hi[1], hi[2]) -
+                 Ffloat3(I, lo[0], lo[1], lo[2])) * scale;
+  }
+}
+
+/**
+ * Trilinear interpolation of the gradient of a 3D float field. Same result
+ * as FieldInterpolate3f on a precomputed gradient field, without storing it.
+ */
+void FieldInterpolateGradient3f(const CField * I, const int *locus,
+                                const float *fract, float *result)
+{
+  zero3f(result);
+
+  for(int corner = 0; corner < 8; corner++) {
+    const int da = corner & 1, db = (corner >> 1) & 1, dc = (corner >> 2) & 1;
+    const float weight = (da ? fract[0] : 1.0F - fract[0]) *
+                         (db ? fract[1] : 1.0F - fract[1]) *
+                         (dc ? fract[2] : 1.0F - fract[2]);
+    if(weight == 0.0F)
+      continue;
+
+    float grad[3];
+    FieldGradient3f(I, locus[0] + da, locus[1] + db, locus[2] + dc, grad);
+    scale3f(grad, weight, grad);
+    add3f(grad, result, result);
+  }
+}
+
 int FieldSmooth3f(CField * I)
 {
   int a, b, c;
@@ -169,6 +169,9 @@ template <typename T> struct CFieldTyped : CField {
 void FieldZero(CField * I);
 float FieldInterpolatef(CField * I, int a, int b, int c, float x, float y, float z);
 void FieldInterpolate3f(CField * I, int *locus, float *fract, float *result);
+void FieldGradient3f(const CField * I, int a, int b, int c, float *result);
+void FieldInterpolateGradient3f(const CField * I, const int *locus,
+                                const float *fract, float *result);
 
 PyObject *FieldAsNumPyArray(CField * I, short copy);
 PyObject *FieldAsPyList(PyMOLGlobals * G, CField * I);
@@ -0,0 +1,84 @@
+/*
+ * Lossy block quantization of float data
+ */
+
+#include "FieldQuantize.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pymol
+{
+
+QuantizedFloats quantize_floats(const float* values, size_t count, int bits)
+{
+  QuantizedFloats q;
+  q.bits = (bits == 8) ? 8 : 16;
+
+  const int bytes = q.bits / 8;
+  const float max_code = (1 << q.bits) - 1;
+  const size_t n_blocks = (count + q.block_size - 1) / q.block_size;
+
+  q.offsets.resize(n_blocks);
+  q.scales.resize(n_blocks);
+  q.codes.resize(count * bytes);
+
+  for (size_t block = 0; block < n_blocks; ++block) {
+    const size_t begin = block * q.block_size;
+    const size_t end = std::min(begin + q.block_size, count);
+
+    float mn = 0.f, mx = 0.f;
+    bool first = true;
+    for (size_t i = begin; i != end; ++i) {
+      if (!std::isfinite(values[i]))
+        continue;
+      if (first || values[i] < mn)
+        mn = values[i];
+      if (first || values[i] > mx)
+        mx = values[i];
+      first = false;
+    }
+
+    const float scale = (mx - mn) / max_code;
+    q.offsets[block] = mn;
+    q.scales[block] = scale;
+
+    for (size_t i = begin; i != end; ++i) {
+      unsigned code = 0;
+      if (scale > 0.f && std::isfinite(values[i])) {
+        code = unsigned(std::lround((values[i] - mn) / scale));
+        code = std::min(code, unsigned(max_code));
+      }
+      for (int b = 0; b < bytes; ++b)
+        q.codes[i * bytes + b] = uint8_t(code >> (8 * b));
+    }
+  }
+
+  return q;
+}
+
+bool dequantize_floats(const QuantizedFloats& q, float* values)
+{
+  if (q.bits != 8 && q.bits != 16)
+    return false;
+
+  const int bytes = q.bits / 8;
+  const size_t count = q.size();
+  const size_t n_blocks = (count + q.block_size - 1) / q.block_size;
+
+  if (q.codes.size() % bytes || q.offsets.size() != n_blocks ||
+      q.scales.size() != n_blocks)
+    return false;
+
+  for (size_t i = 0; i != count; ++i) {
+    unsigned code = 0;
+    for (int b = 0; b < bytes; ++b)
+      code |= unsigned(q.codes[i * bytes + b]) << (8 * b);
+    const size_t block = i / q.block_size;
+    values[i] = q.offsets[block] + code * q.scales[block];
+  }
+
+  return true;
+}
+
+} // namespace pymol
@@ -0,0 +1,48 @@
+/*
+ * Lossy block quantization of float data
+ *
+ * Used to store maps in sessions with reduced precision.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pymol
+{
+
+/**
+ * Float values stored as 8 or 16 bit codes, with an offset and a scale per
+ * block of consecutive values. The reconstruction error of each value is at
+ * most half a step (range of its block / (2^bits - 1) / 2).
+ */
+struct QuantizedFloats {
+  //! Number of consecutive values which share offset and scale
+  static constexpr size_t block_size = 4096;
+
+  int bits = 16;
+  std::vector<float> offsets;  //!< per block minimum
+  std::vector<float> scales;   //!< per block step size
+  std::vector<uint8_t> codes;  //!< bits / 8 bytes per value, little endian
+
+  //! Number of encoded values
+  size_t size() const { return codes.size() / (bits / 8); }
+};
+
+/**
+ * @param values Input values, non-finite values are not preserved
+ * @param count Number of values
+ * @param bits 8 or 16
+ */
+QuantizedFloats quantize_floats(const float* values, size_t count, int bits);
+
+/**
+ * @param q Quantized data
+ * @param[out] values Output array with q.size() elements
+ * @return False if `q` is inconsistent
+ */
+bool dequantize_floats(const QuantizedFloats& q, float* values);
+
+} // namespace pymol
@@ -0,0 +1,105 @@
+/*
+ * Cached summary statistics and histograms of a scalar field
+ */
+
+#include "FieldStats.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "Field.h"
+
+namespace pymol
+{
+
+namespace
+{
+const float* field_values(const CField& data, size_t& count)
+{
+  count = data.dim[0] * data.dim[1] * data.dim[2];
+  return reinterpret_cast<const float*>(data.data.data());
+}
+} // namespace
+
+FieldStats::FieldStats(const CField& data)
+{
+  size_t count;
+  const float* values = field_values(data, count);
+  const long n = count;
+
+  if (!n)
+    return;
+
+  float mn = FLT_MAX, mx = -FLT_MAX;
+  double sum = 0.0, sumsq = 0.0;
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for reduction(min : mn) reduction(max : mx) \
+    reduction(+ : sum, sumsq)
+#endif
+  for (long i = 0; i < n; ++i) {
+    const float v = values[i];
+    mn = std::min(mn, v);
+    mx = std::max(mx, v);
+    sum += v;
+    sumsq += double(v) * v;
+  }
+
+  m_count = count;
+  m_min = mn;
+  m_max = mx;
+  m_mean = float(sum / n);
+  m_stdev = float(std::sqrt(std::max(0.0, (sumsq - sum * sum / n) / n)));
+}
+
+const std::vector<float>& FieldStats::histogram(
+    const CField& data, int n_bins, float lo, float hi)
+{
+  for (auto it = m_histograms.begin(); it != m_histograms.end(); ++it) {
+    if (it->n_bins == n_bins && it->lo == lo && it->hi == hi) {
+      std::rotate(it, it + 1, m_histograms.end());
+      return m_histograms.back().counts;
+    }
+  }
+
+  if (m_histograms.size() == max_histograms) {
+    m_histograms.erase(m_histograms.begin());
+  }
+
+  size_t count;
+  const float* values = field_values(data, count);
+  const long n = count;
+  const float irange = float(n_bins - 1) / (hi - lo);
+  std::vector<size_t> counts(std::max(n_bins, 0), 0);
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<size_t> local(counts.size(), 0);
+
+#ifdef PYMOL_OPENMP
+#pragma omp for nowait
+#endif
+    for (long i = 0; i < n; ++i) {
+      const int pos = int(irange * (double(values[i]) - lo));
+      if (pos >= 0 && pos < n_bins) {
+        ++local[pos];
+      }
+    }
+
+#ifdef PYMOL_OPENMP
+#pragma omp critical
+#endif
+    for (size_t b = 0; b < counts.size(); ++b) {
+      counts[b] += local[b];
+    }
+  }
+
+  m_histograms.push_back(
+      {n_bins, lo, hi, std::vector<float>(counts.begin(), counts.end())});
+  return m_histograms.back().counts;
+}
+
+} // namespace pymol
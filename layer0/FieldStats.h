@@ -0,0 +1,66 @@
+/*
+ * Cached summary statistics and histograms of a scalar field
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct CField;
+
+namespace pymol
+{
+
+/**
+ * Minimum, maximum, mean and (population) standard deviation of a float
+ * field, computed in one parallel pass, plus memoized histograms.
+ *
+ * Owned by Isofield (see IsofieldGetStats) and discarded with the other
+ * derived data in IsofieldDataChanged.
+ */
+class FieldStats
+{
+public:
+  /**
+   * @param data float field
+   */
+  explicit FieldStats(const CField& data);
+
+  size_t count() const { return m_count; }
+  float min() const { return m_min; }
+  float max() const { return m_max; }
+  float mean() const { return m_mean; }
+  float stdev() const { return m_stdev; }
+
+  /**
+   * Histogram with `n_bins` bins over [lo, hi], a value v goes into bin
+   * `int((n_bins - 1) / (hi - lo) * (v - lo))`, values outside are not
+   * counted. Recently requested histograms are memoized, so switching
+   * between resolutions or ranges doesn't rescan the field. The returned
+   * reference is only valid until the next call.
+   *
+   * @param data The field which was passed to the constructor
+   */
+  const std::vector<float>& histogram(
+      const CField& data, int n_bins, float lo, float hi);
+
+private:
+  //! Number of memoized histograms
+  static constexpr size_t max_histograms = 8;
+
+  struct Histogram {
+    int n_bins;
+    float lo, hi;
+    std::vector<float> counts;
+  };
+
+  size_t m_count = 0;
+  float m_min = 0.f;
+  float m_max = 0.f;
+  float m_mean = 0.f;
+  float m_stdev = 0.f;
+  std::vector<Histogram> m_histograms; //!< most recent last
+};
+
+} // namespace pymol
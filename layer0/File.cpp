@@ -7,6 +7,11 @@
 #ifdef _WIN32
 #include <vector>
 #include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include <stdio.h>
@@ -17,6 +22,7 @@
 #include "MemoryDebug.h"
 
 #include <fstream>
+#include <stdexcept>
 #include <string>
 
 #include "pymol/zstring_view.h"
@@ -91,6 +97,24 @@ char * FileGetContents(const char *filename, long *size) {
   return contents;
 }
 
+/**
+ * Rename `src` to `dst`, replacing `dst` if it exists.
+ * @return false on failure (`src` is left in place)
+ */
+bool FileReplace(const char *src, const char *dst) {
+#ifdef _WIN32
+  try {
+    return MoveFileExW(pymol::utf8_to_utf16(src).c_str(),
+               pymol::utf8_to_utf16(dst).c_str(),
+               MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED) != 0;
+  } catch (...) {
+    return false;
+  }
+#else
+  return rename(src, dst) == 0;
+#endif
+}
+
 namespace pymol
 {
 #ifdef _WIN32
@@ -134,4 +158,43 @@ std::string file_get_contents(pymol::zstring_view filename)
   return istream_get_contents(file);
 }
 
+MappedFile::MappedFile(pymol::zstring_view filename)
+{
+#ifndef _WIN32
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    throw std::runtime_error("Unable to open file");
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      m_data = static_cast<const char*>(addr);
+      m_size = st.st_size;
+      m_mapped = true;
+    }
+  }
+
+  close(fd);
+
+  if (m_mapped) {
+    return;
+  }
+#endif
+
+  m_buffer = file_get_contents(filename);
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+  if (m_mapped) {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+#endif
+}
+
 } // namespace pymol
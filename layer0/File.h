@@ -14,5 +14,6 @@ FILE * pymol_fopen(const char * filename, const char * mode);
 #endif
 
 char * FileGetContents(const char *filename, long *size);
+bool FileReplace(const char *src, const char *dst);
 
 #endif
@@ -20,6 +20,34 @@ namespace pymol
  */
 std::string file_get_contents(pymol::zstring_view filename);
 
+/**
+ * Read-only file contents. Memory-mapped where supported, so pages are only
+ * read from disk when they are accessed. Otherwise (or if mapping fails) the
+ * file is read into memory.
+ */
+class MappedFile
+{
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+  bool m_mapped = false;
+  std::string m_buffer; //!< fallback if not mapped
+
+public:
+  /**
+   * @param filename Path in native filesystem encoding or UTF-8
+   * @throw ... If file cannot be opened
+   */
+  explicit MappedFile(pymol::zstring_view filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  bool mapped() const { return m_mapped; }
+};
+
 #ifdef _WIN32
 /**
  * Convert UTF-8 to UTF-16
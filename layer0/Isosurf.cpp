@@ -16,7 +16,11 @@ I* Additional authors of this source file include:
 Z* -------------------------------------------------------------------
 */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <random>
+#include <vector>
 
 #include"os_python.h"
 #include"os_predef.h"
@@ -30,6 +34,7 @@ Z* -------------------------------------------------------------------
 #include"Feedback.h"
 #include"PConv.h"
 #include"P.h"
+#include"Profiler.h"
 #include"Util.h"
 
 #define Trace_OFF
@@ -67,7 +72,8 @@ struct CIsosurf {
   int Max[3];
   CField *Coord, *Data;
   float Level;
-  int Code[256];
+  const int* Code; //!< shared, see IsosurfCodeTable()
+  const pymol::MinMaxTree* MinMax; //!< optional, for skipping empty blocks
 
   pymol::vla<int>* Num = nullptr;
   int NSeg;
@@ -82,7 +88,7 @@ static int IsosurfCodeVertices(CIsosurf * II);
 static int IsosurfFindActiveEdges(CIsosurf * II);
 static int IsosurfFindLines(CIsosurf * II);
 static int IsosurfDrawLines(CIsosurf * II);
-static void IsosurfCode(CIsosurf * II, const char *bits1, const char *bits2);
+static void IsosurfCode(int* code, const char *bits1, const char *bits2);
 static int IsosurfDrawPoints(CIsosurf * II);
 static int IsosurfPoints(CIsosurf * II);
 static int IsosurfGradients(PyMOLGlobals * G, CSetting * set1, CSetting * set2,
@@ -96,12 +102,6 @@ static void _IsosurfFree(CIsosurf * I)
   FreeP(I);
 }
 
-void IsosurfFree(PyMOLGlobals * G)
-{
-  _IsosurfFree(G->Isosurf);
-  G->Isosurf = nullptr;
-}
-
 
 /*===========================================================================*/
 PyObject *IsosurfAsPyList(PyMOLGlobals * G, Isofield * field)
@@ -177,158 +177,88 @@ Isofield *IsosurfNewFromPyList(PyMOLGlobals * G, PyObject * list)
   return (result);
 }
 
+/*===========================================================================*/
+/**
+ * Builds the min/max block hierarchy of the field data (if missing). The
+ * contouring functions use it to skip blocks which can't contain the level,
+ * so re-contouring at a new level scales with the surface size.
+ */
+void IsofieldComputeMinMax(PyMOLGlobals * G, Isofield * field)
+{
+  if(field->data_shared)
+    field->minmax.reset();
+  if(!field->minmax && field->data) {
+    PYMOL_PROFILE_SCOPE(G, "Map", "IsofieldComputeMinMax");
+    field->minmax.reset(new pymol::MinMaxTree(*field->data));
+  }
+}
+
+/*===========================================================================*/
+/**
+ * Summary statistics of the field data, computed on first use and kept
+ * until the data changes.
+ */
+pymol::FieldStats& IsofieldGetStats(PyMOLGlobals * G, Isofield * field)
+{
+  if(field->data_shared)
+    field->stats.reset();
+  if(!field->stats) {
+    PYMOL_PROFILE_SCOPE(G, "Map", "IsofieldGetStats");
+    field->stats.reset(new pymol::FieldStats(*field->data));
+  }
+  return *field->stats;
+}
+
+/*===========================================================================*/
+/**
+ * Must be called after modifying field->data in place, discards the
+ * derived gradients, min/max hierarchy and statistics.
+ */
+void IsofieldDataChanged(Isofield * field)
+{
+  field->gradients.reset();
+  field->minmax.reset();
+  field->stats.reset();
+}
+
+/*===========================================================================*/
+/**
+ * Must be called when field->data is exposed as a writable view (e.g.
+ * get_volume_field with copy=0). The data may then change at any time, so
+ * the min/max hierarchy, statistics and gradients are recomputed on every
+ * use instead of being kept.
+ */
+void IsofieldDataShared(Isofield * field)
+{
+  field->data_shared = true;
+  IsofieldDataChanged(field);
+}
+
 /*===========================================================================*/
 void IsofieldComputeGradients(PyMOLGlobals * G, Isofield * field)
 {
   int dim[4];
-  int a, b, c;
   CField *data = field->data.get();
 
+  if(field->data_shared)
+    field->gradients.reset();
   if(!field->gradients) {
 
     /* compute gradients relative to grid axis spacing */
 
-    for(a = 0; a < 3; a++)
+    for(int a = 0; a < 3; a++)
       dim[a] = field->dimensions[a];
     dim[3] = 3;
     field->gradients.reset(new CFieldTyped<float>(dim, 4));
     auto gradients = field->gradients.get();
-    dim[3] = 3;
-
-    /* bulk internal */
-
-    for(a = 1; a < (dim[0] - 1); a++) {
-      for(b = 1; b < (dim[1] - 1); b++) {
-        for(c = 1; c < (dim[2] - 1); c++) {
-          F4(gradients, a, b, c, 0) =
-            (F3(data, a + 1, b, c) - F3(data, a - 1, b, c)) / 2.0F;
-          F4(gradients, a, b, c, 1) =
-            (F3(data, a, b + 1, c) - F3(data, a, b - 1, c)) / 2.0F;
-          F4(gradients, a, b, c, 2) =
-            (F3(data, a, b, c + 1) - F3(data, a, b, c - 1)) / 2.0F;
-        }
-      }
-    }
-
-    for(a = 0; a < dim[0]; a += (dim[0] - 1)) {
-
-      /* 'a' faces */
-      for(b = 1; b < (dim[1] - 1); b++) {
-        for(c = 1; c < (dim[2] - 1); c++) {
-          if(!a) {
-            F4(gradients, a, b, c, 0) = (F3(data, a + 1, b, c) - F3(data, a, b, c));
-          } else {
-            F4(gradients, a, b, c, 0) = (F3(data, a, b, c) - F3(data, a - 1, b, c));
-          }
-          F4(gradients, a, b, c, 1) =
-            (F3(data, a, b + 1, c) - F3(data, a, b - 1, c)) / 2.0F;
-          F4(gradients, a, b, c, 2) =
-            (F3(data, a, b, c + 1) - F3(data, a, b, c - 1)) / 2.0F;
-        }
-      }
-
-      /* 'c' edges and all eight corners */
-      for(b = 0; b < dim[1]; b += (dim[1] - 1)) {
-        for(c = 0; c < dim[2]; c++) {
-
-          if(!a) {
-            F4(gradients, a, b, c, 0) = (F3(data, a + 1, b, c) - F3(data, a, b, c));
-          } else {
-            F4(gradients, a, b, c, 0) = (F3(data, a, b, c) - F3(data, a - 1, b, c));
-          }
-
-          if(!b) {
-            F4(gradients, a, b, c, 1) = (F3(data, a, b + 1, c) - F3(data, a, b, c));
-          } else {
-            F4(gradients, a, b, c, 1) = (F3(data, a, b, c) - F3(data, a, b - 1, c));
-          }
-
-          if(!c) {
-            F4(gradients, a, b, c, 2) = (F3(data, a, b, c + 1) - F3(data, a, b, c));
-          } else if(c < (dim[2] - 1)) {
-            F4(gradients, a, b, c, 2) =
-              (F3(data, a, b, c + 1) - F3(data, a, b, c - 1)) / 2.0F;
-          } else {
-            F4(gradients, a, b, c, 2) = (F3(data, a, b, c) - F3(data, a, b, c - 1));
-          }
-        }
-      }
-
-      /* 'b' edges  */
-      for(c = 0; c < dim[2]; c += (dim[2] - 1)) {
-        for(b = 1; b < (dim[1] - 1); b++) {
-          if(!a) {
-            F4(gradients, a, b, c, 0) = (F3(data, a + 1, b, c) - F3(data, a, b, c));
-          } else {
-            F4(gradients, a, b, c, 0) = (F3(data, a, b, c) - F3(data, a - 1, b, c));
-          }
-
-          F4(gradients, a, b, c, 1) =
-            (F3(data, a, b + 1, c) - F3(data, a, b - 1, c)) / 2.0F;
-
-          if(!c) {
-            F4(gradients, a, b, c, 2) = (F3(data, a, b, c + 1) - F3(data, a, b, c));
-          } else if(c < (dim[2] - 1)) {
-            F4(gradients, a, b, c, 2) =
-              (F3(data, a, b, c + 1) - F3(data, a, b, c - 1)) / 2.0F;
-          } else {
-            F4(gradients, a, b, c, 2) = (F3(data, a, b, c) - F3(data, a, b, c - 1));
-          }
-        }
-      }
-    }
-
-    for(b = 0; b < dim[1]; b += (dim[1] - 1)) {
-
-      for(a = 1; a < (dim[0] - 1); a++) {
-
-        /* 'b' faces */
-
-        for(c = 1; c < (dim[2] - 1); c++) {
-          F4(gradients, a, b, c, 0) =
-            (F3(data, a + 1, b, c) - F3(data, a - 1, b, c)) / 2.0F;
-          if(!b) {
-            F4(gradients, a, b, c, 1) = (F3(data, a, b + 1, c) - F3(data, a, b, c));
-          } else {
-            F4(gradients, a, b, c, 1) = (F3(data, a, b, c) - F3(data, a, b - 1, c));
-          }
-          F4(gradients, a, b, c, 2) =
-            (F3(data, a, b, c + 1) - F3(data, a, b, c - 1)) / 2.0F;
-        }
 
-        /* 'a' edges */
-
-        for(c = 0; c < dim[2]; c += (dim[2] - 1)) {
-          F4(gradients, a, b, c, 0) =
-            (F3(data, a + 1, b, c) - F3(data, a - 1, b, c)) / 2.0F;
-          if(!b) {
-            F4(gradients, a, b, c, 1) = (F3(data, a, b + 1, c) - F3(data, a, b, c));
-          } else {
-            F4(gradients, a, b, c, 1) = (F3(data, a, b, c) - F3(data, a, b - 1, c));
-          }
-          if(!c) {
-            F4(gradients, a, b, c, 2) = (F3(data, a, b, c + 1) - F3(data, a, b, c));
-          } else {
-            F4(gradients, a, b, c, 2) = (F3(data, a, b, c) - F3(data, a, b, c - 1));
-          }
-        }
-      }
-    }
-
-    /* 'c' faces */
-
-    for(c = 0; c < dim[2]; c += (dim[2] - 1)) {
-      for(a = 1; a < (dim[0] - 1); a++) {
-        for(b = 1; b < (dim[1] - 1); b++) {
-          F4(gradients, a, b, c, 0) =
-            (F3(data, a + 1, b, c) - F3(data, a - 1, b, c)) / 2.0F;
-          F4(gradients, a, b, c, 1) =
-            (F3(data, a, b + 1, c) - F3(data, a, b - 1, c)) / 2.0F;
-          if(!c) {
-            F4(gradients, a, b, c, 2) = (F3(data, a, b, c + 1) - F3(data, a, b, c));
-          } else {
-            F4(gradients, a, b, c, 2) = (F3(data, a, b, c) - F3(data, a, b, c - 1));
-          }
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+    for(int a = 0; a < dim[0]; a++) {
+      for(int b = 0; b < dim[1]; b++) {
+        for(int c = 0; c < dim[2]; c++) {
+          FieldGradient3f(data, a, b, c, F4Ptr(gradients, a, b, c, 0));
         }
       }
     }
@@ -351,9 +281,8 @@ Isofield::Isofield(PyMOLGlobals * G, const int * const dims)
 }
 
 /*===========================================================================*/
-static void IsosurfCode(CIsosurf * II, const char *bits1, const char *bits2)
+static void IsosurfCode(int* code, const char *bits1, const char *bits2)
 {
-  CIsosurf *I = II;
   int c;
   int b;
   int sum1, sum2;
@@ -384,7 +313,7 @@ static void IsosurfCode(CIsosurf * II, const char *bits1, const char *bits2)
     c--;
   }
 
-  I->Code[sum1] = sum2;
+  code[sum1] = sum2;
 #ifdef Trace
   printf("IsosurfCode: %s (%i) -> %s (%i)\n", bits1, sum1, bits2, sum2);
 #endif
@@ -392,18 +321,14 @@ static void IsosurfCode(CIsosurf * II, const char *bits1, const char *bits2)
 
 
 /*===========================================================================*/
-static CIsosurf *IsosurfNew(PyMOLGlobals * G)
+/**
+ * Line segment codes for the four edges of a square face, indexed by the
+ * active edge bits. Constant, built once and shared by all calls.
+ */
+static std::array<int, 256> IsosurfCodeTableNew()
 {
-  int c;
-  CIsosurf *I = pymol::calloc<CIsosurf>(1);
-  I->G = G;
-  I->VertexCodes = nullptr;
-  I->ActiveEdges = nullptr;
-  I->Point = nullptr;
-  I->Line = nullptr;
-  I->Skip = 0;
-  for(c = 0; c < 256; c++)
-    I->Code[c] = -1;
+  std::array<int, 256> code;
+  code.fill(-1);
 
 
 /*___  
@@ -412,8 +337,8 @@ static CIsosurf *IsosurfNew(PyMOLGlobals * G)
  |___|
  32
 */
-  IsosurfCode(I, "10000010", "100000");
-  IsosurfCode(I, "01000001", "100000");
+  IsosurfCode(code.data(), "10000010", "100000");
+  IsosurfCode(code.data(), "01000001", "100000");
 
 
 /*___  
@@ -422,8 +347,8 @@ static CIsosurf *IsosurfNew(PyMOLGlobals * G)
  |___|
  16
 */
-  IsosurfCode(I, "10010000", "010000");
-  IsosurfCode(I, "01100000", "010000");
+  IsosurfCode(code.data(), "10010000", "010000");
+  IsosurfCode(code.data(), "01100000", "010000");
 
 
 /*___  
@@ -432,8 +357,8 @@ static CIsosurf *IsosurfNew(PyMOLGlobals * G)
  |_/_|
  8
 */
-  IsosurfCode(I, "00101000", "001000");
-  IsosurfCode(I, "00010100", "001000");
+  IsosurfCode(code.data(), "00101000", "001000");
+  IsosurfCode(code.data(), "00010100", "001000");
 
 
 /*___  
@@ -442,8 +367,8 @@ static CIsosurf *IsosurfNew(PyMOLGlobals * G)
  |_\_|
  4
 */
-  IsosurfCode(I, "00001001", "000100");
-  IsosurfCode(I, "00000110", "000100");
+  IsosurfCode(code.data(), "00001001", "000100");
+  IsosurfCode(code.data(), "00000110", "000100");
 
 
 /*___  
@@ -453,7 +378,7 @@ static CIsosurf *IsosurfNew(PyMOLGlobals * G)
  16+4=20
 */
 
-  IsosurfCode(I, "01101001", "010100");
+  IsosurfCode(code.data(), "01101001", "010100");
 
 
 /*___  
@@ -462,7 +387,7 @@ static CIsosurf *IsosurfNew(PyMOLGlobals * G)
  |_/_|
  32+8=40
 */
-  IsosurfCode(I, "10010110", "101000");
+  IsosurfCode(code.data(), "10010110", "101000");
 
 
 /*___  
@@ -471,8 +396,8 @@ static CIsosurf *IsosurfNew(PyMOLGlobals * G)
  |_|_|
  2
 */
-  IsosurfCode(I, "10001000", "000010");
-  IsosurfCode(I, "01000100", "000010");
+  IsosurfCode(code.data(), "10001000", "000010");
+  IsosurfCode(code.data(), "01000100", "000010");
 
 
 /*___  
@@ -481,16 +406,31 @@ static CIsosurf *IsosurfNew(PyMOLGlobals * G)
  |___|
  1
 */
-  IsosurfCode(I, "00100010", "000001");
-  IsosurfCode(I, "00010001", "000001");
+  IsosurfCode(code.data(), "00100010", "000001");
+  IsosurfCode(code.data(), "00010001", "000001");
 
-  return (I);
+  return code;
 }
 
-int IsosurfInit(PyMOLGlobals * G)
+static const int* IsosurfCodeTable()
 {
-  G->Isosurf = IsosurfNew(G);
-  return 1;
+  static const auto table = IsosurfCodeTableNew();
+  return table.data();
+}
+
+/*===========================================================================*/
+static CIsosurf *IsosurfNew(PyMOLGlobals * G)
+{
+  CIsosurf *I = pymol::calloc<CIsosurf>(1);
+  I->G = G;
+  I->VertexCodes = nullptr;
+  I->ActiveEdges = nullptr;
+  I->Point = nullptr;
+  I->Line = nullptr;
+  I->Skip = 0;
+  I->MinMax = nullptr;
+  I->Code = IsosurfCodeTable();
+  return (I);
 }
 
 
@@ -789,22 +729,157 @@ int IsosurfGetRange(PyMOLGlobals * G, Isofield * field,
 
 
 /*===========================================================================*/
+/**
+ * Contours all sub-blocks of `range` (isomesh and isodot modes).
+ *
+ * Blocks only read the shared field, so they are processed in parallel
+ * (PYMOL_OPENMP), each thread with its own scratch fields. Output of each
+ * block is collected separately and appended in block order, so the result
+ * does not depend on the number of threads.
+ */
+static int IsosurfVolumeBlocks(CIsosurf * I, const int *range, const int *Steps,
+                               cIsomeshMode mode)
+{
+  PyMOLGlobals *G = I->G;
+  const int n_block = Steps[0] * Steps[1] * Steps[2];
+
+  std::vector<pymol::vla<float>> block_line(n_block);
+  std::vector<pymol::vla<int>> block_num(n_block);
+  std::vector<int> block_n_line(n_block), block_n_seg(n_block);
+  std::atomic<int> ok(true);
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel
+#endif
+  {
+    /* per-thread copy of the contouring state with private scratch fields */
+    CIsosurf T = *I;
+    int t_ok = IsosurfAlloc(G, &T);
+    if(t_ok) {
+      for(int x = 0; x < T.CurDim[0]; x++)
+        for(int y = 0; y < T.CurDim[1]; y++)
+          for(int z = 0; z < T.CurDim[2]; z++)
+            for(int c = 0; c < 3; c++)
+              EdgePt(T.Point, x, y, z, c).NLink = 0;
+    } else {
+      ok = false;
+    }
+
+#ifdef PYMOL_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for(int b = 0; b < n_block; b++) {
+      if(!ok)
+        continue;
+
+      int step[3] = { b / (Steps[1] * Steps[2]), (b / Steps[2]) % Steps[1],
+                      b % Steps[2] };
+      for(int c = 0; c < 3; c++) {
+        T.CurOff[c] = IsosurfSubSize * step[c] + range[c];
+        T.Max[c] = range[3 + c] - T.CurOff[c];
+        if(T.Max[c] > (IsosurfSubSize + 1))
+          T.Max[c] = (IsosurfSubSize + 1);
+      }
+
+      if(T.MinMax) {
+        /* shrink the block to the bricks which may contain the level */
+        int lo[3], hi[3];
+        for(int c = 0; c < 3; c++) {
+          lo[c] = T.CurOff[c];
+          hi[c] = T.CurOff[c] + T.Max[c] - 1;
+        }
+        if(!T.MinMax->activeBounds(lo, hi, T.Level, lo, hi)) {
+          block_n_line[b] = 0;
+          block_n_seg[b] = 0;
+          continue;
+        }
+        for(int c = 0; c < 3; c++) {
+          /* keep the mesh_skip phase */
+          if(T.Skip > 1)
+            lo[c] -= (lo[c] - T.CurOff[c]) % T.Skip;
+          T.Max[c] = hi[c] - lo[c] + 1;
+          T.CurOff[c] = lo[c];
+        }
+      }
+#ifdef Trace
+      for(int c = 0; c < 3; c++)
+        printf(" IsosurfVolume: c: %i CurOff[c]: %i Max[c] %i\n", c,
+               T.CurOff[c], T.Max[c]);
+#endif
+
+      block_line[b].resize(1000);
+      block_num[b].resize(100);
+      T.Line = std::addressof(block_line[b]);
+      T.Num = std::addressof(block_num[b]);
+      T.NLine = 0;
+      T.NSeg = 0;
+      (*T.Num)[0] = 0;
+
+      int b_ok = true;
+      switch (mode) {
+      case cIsomeshMode::isomesh:      /* standard mode - want lines */
+        b_ok = IsosurfCurrent(&T);
+        break;
+      case cIsomeshMode::isodot:      /* point mode - just want points on the isosurface */
+        b_ok = IsosurfPoints(&T);
+        break;
+      default:
+        break;
+      }
+      if(!b_ok || G->Interrupt) {
+        ok = false;
+      }
+
+      block_n_line[b] = T.NLine;
+      block_n_seg[b] = T.NSeg;
+    }
+
+    IsosurfPurge(&T);
+  }
+
+  if(!ok)
+    return false;
+
+  /* concatenate in block order */
+
+  int n_line = I->NLine, n_seg = I->NSeg;
+  for(int b = 0; b < n_block; b++) {
+    n_line += block_n_line[b];
+    n_seg += block_n_seg[b];
+  }
+  I->Line->check(n_line * 3 + 2);
+  I->Num->check(n_seg + 1);
+
+  for(int b = 0; b < n_block; b++) {
+    if(block_n_line[b]) {
+      std::copy_n(block_line[b].data(), block_n_line[b] * 3,
+                  I->Line->data() + I->NLine * 3);
+    }
+    std::copy_n(block_num[b].data(), block_n_seg[b],
+                I->Num->data() + I->NSeg);
+    I->NLine += block_n_line[b];
+    I->NSeg += block_n_seg[b];
+  }
+  (*I->Num)[I->NSeg] = I->NLine;
+
+  return true;
+}
+
+/*===========================================================================*/
+/**
+ * Contours `field` at `level`. Every call has its own state, so calls may
+ * run concurrently (e.g. for several map objects or states).
+ */
 int IsosurfVolume(PyMOLGlobals* G, CSetting* set1, CSetting* set2,
     Isofield* field, float level, pymol::vla<int>& num, pymol::vla<float>& vert,
     int* range, cIsomeshMode mode, int skip, float alt_level)
 {
   int ok = true;
-  CIsosurf *I;
-  if(PIsGlutThread()) {
-    I = G->Isosurf;
-  } else {
-    I = IsosurfNew(G);
-  }
+  CIsosurf *I = IsosurfNew(G);
   CHECKOK(ok, I);
-  {
+  if(ok) {
     int Steps[3];
-    int c, i, j, k;
-    int x, y, z;
+    int c;
     int range_store[6];
     I->Num = std::addressof(num);
     I->Line = std::addressof(vert);
@@ -829,67 +904,20 @@ int IsosurfVolume(PyMOLGlobals* G, CSetting* set1, CSetting* set2,
     I->Coord = field->points.get();
     I->Data = field->data.get();
     I->Level = level;
-    if(ok)
-      ok = IsosurfAlloc(G, I);
+    I->MinMax = field->minmax.get();
 
     I->NLine = 0;
     I->NSeg = 0;
     I->Num->check(I->NSeg);
     (*I->Num)[I->NSeg] = I->NLine;
 
-    if(ok) {
-      switch (mode) {
-      case cIsomeshMode::gradient:
-        ok = IsosurfGradients(G, set1, set2, I, field, range, level, alt_level);
-        IsosurfPurge(I);
-        break;
-      default:
-        for(i = 0; i < Steps[0]; i++) {
-          for(j = 0; j < Steps[1]; j++) {
-            for(k = 0; k < Steps[2]; k++) {
-              if(ok) {
-                I->CurOff[0] = IsosurfSubSize * i;
-                I->CurOff[1] = IsosurfSubSize * j;
-                I->CurOff[2] = IsosurfSubSize * k;
-                for(c = 0; c < 3; c++)
-                  I->CurOff[c] += range[c];
-                for(c = 0; c < 3; c++) {
-                  I->Max[c] = range[3 + c] - I->CurOff[c];
-                  if(I->Max[c] > (IsosurfSubSize + 1))
-                    I->Max[c] = (IsosurfSubSize + 1);
-                }
-                if(!(i || j || k)) {
-                  for(x = 0; x < I->Max[0]; x++)
-                    for(y = 0; y < I->Max[1]; y++)
-                      for(z = 0; z < I->Max[2]; z++)
-                        for(c = 0; c < 3; c++)
-                          EdgePt(I->Point, x, y, z, c).NLink = 0;
-                }
-#ifdef Trace
-                for(c = 0; c < 3; c++)
-                  printf(" IsosurfVolume: c: %i CurOff[c]: %i Max[c] %i\n", c,
-                         I->CurOff[c], I->Max[c]);
-#endif
-
-                if(ok)
-                  switch (mode) {
-                  case cIsomeshMode::isomesh:      /* standard mode - want lines */
-                    ok = IsosurfCurrent(I);
-                    break;
-                  case cIsomeshMode::isodot:      /* point mode - just want points on the isosurface */
-                    ok = IsosurfPoints(I);
-                    break;
-                  }
-                if(G->Interrupt) {
-                  ok = false;
-                }
-              }
-            }
-          }
-        }
-        IsosurfPurge(I);
-        break;
-      }
+    switch (mode) {
+    case cIsomeshMode::gradient:
+      ok = IsosurfGradients(G, set1, set2, I, field, range, level, alt_level);
+      break;
+    default:
+      ok = IsosurfVolumeBlocks(I, range, Steps, mode);
+      break;
     }
 
     if(mode != cIsomeshMode::isomesh) {
@@ -910,9 +938,7 @@ int IsosurfVolume(PyMOLGlobals* G, CSetting* set1, CSetting* set2,
     I->Num->resize(I->NSeg + 1);
     (*I->Num)[I->NSeg] = 0;        /* important - must terminate the segment list */
 
-    if(!PIsGlutThread()) {
-      _IsosurfFree(I);
-    }
+    _IsosurfFree(I);
   }
   return (ok);
 }
@@ -1027,18 +1053,13 @@ static int IsosurfGradients(PyMOLGlobals * G, CSetting * set1, CSetting * set2,
   if(min_slope < 0.00001F)
     min_slope = 0.00001F;
 
-  /* make sure we have gradients available for map */
-
-  if(!field->gradients)
-    IsofieldComputeGradients(G, field);
-
-  /* and that map has a minimum size */
+  /* gradients are interpolated from the map data on the fly, so that a
+     gradient field (three times the size of the map) is not kept around */
 
-  if(field->gradients) {
+  if(i_data) {
 
     /* locals for performance */
 
-    CField *gradients = field->gradients.get();
     CField *points = field->points.get();
 
     /* flags marking excluded regions to avoid (currently wasteful) */
@@ -1247,7 +1268,7 @@ static int IsosurfGradients(PyMOLGlobals * G, CSetting * set1, CSetting * set2,
 
                 float interp_gradient[3];
 
-                FieldInterpolate3f(gradients, locus, fract, interp_gradient);
+                FieldInterpolateGradient3f(i_data, locus, fract, interp_gradient);
 
                 if(length3f(interp_gradient) < min_slope) {
                   /* if region is too flat, then bail */
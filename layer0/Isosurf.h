@@ -22,6 +22,8 @@ Z* -------------------------------------------------------------------
 #include"MemoryDebug.h"
 #include"Symmetry.h"
 #include"Field.h"
+#include"FieldStats.h"
+#include"MinMaxTree.h"
 #include"os_python.h"
 #include"PyMOLGlobals.h"
 #include"PyMOLEnums.h"
@@ -33,6 +35,9 @@ struct Isofield {
   pymol::copyable_ptr<CField> points;
   pymol::copyable_ptr<CField> data;
   pymol::cache_ptr<CField> gradients;
+  pymol::cache_ptr<pymol::MinMaxTree> minmax; //!< see IsofieldComputeMinMax
+  pymol::cache_ptr<pymol::FieldStats> stats;  //!< see IsofieldGetStats
+  bool data_shared = false; //!< see IsofieldDataShared
   Isofield() = default;
   Isofield(PyMOLGlobals * G, const int * const dims);
 };
@@ -46,13 +51,15 @@ int IsosurfGetRange(PyMOLGlobals * G, Isofield * field, CCrystal * cryst,
 int IsosurfExpand(Isofield * field1, Isofield * field2,
                   CCrystal * cryst, CSymmetry * sym, int *range);
 
-int IsosurfInit(PyMOLGlobals * G);
-void IsosurfFree(PyMOLGlobals * G);
 
 
 /* isofield operations -- not part of Isosurf */
 
 void IsofieldComputeGradients(PyMOLGlobals * G, Isofield * field);
+void IsofieldComputeMinMax(PyMOLGlobals * G, Isofield * field);
+pymol::FieldStats& IsofieldGetStats(PyMOLGlobals * G, Isofield * field);
+void IsofieldDataChanged(Isofield * field);
+void IsofieldDataShared(Isofield * field);
 PyObject *IsosurfAsPyList(PyMOLGlobals *G, Isofield * I);
 Isofield *IsosurfNewFromPyList(PyMOLGlobals * G, PyObject * list);
 
@@ -0,0 +1,130 @@
+/*
+ * Fused element-wise arithmetic between maps on a common grid
+ */
+
+#include "MapOperation.h"
+
+#include <algorithm>
+
+namespace pymol
+{
+
+namespace
+{
+//! Don't spin up threads for tiny maps
+constexpr long parallel_threshold = 1 << 15;
+} // namespace
+
+MapAccumulator::MapAccumulator(MapOperator op, size_t n)
+    : m_op(op)
+    , m_value(n, 0.f)
+{
+  switch (op) {
+  case MapOperator::Minimum:
+  case MapOperator::Maximum:
+  case MapOperator::Average:
+    m_count.resize(n, 0);
+    break;
+  default:
+    break;
+  }
+}
+
+void MapAccumulator::add(
+    const float* values, const std::uint8_t* inside, bool first)
+{
+  const long n = m_value.size();
+  float* value = m_value.data();
+  int* count = m_count.data();
+
+  auto is_inside = [inside](long i) { return !inside || inside[i]; };
+
+  switch (m_op) {
+  case MapOperator::Copy:
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for if (n > parallel_threshold)
+#endif
+    for (long i = 0; i < n; ++i) {
+      if (is_inside(i))
+        value[i] = values[i];
+    }
+    break;
+  case MapOperator::Minimum:
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for if (n > parallel_threshold)
+#endif
+    for (long i = 0; i < n; ++i) {
+      if (is_inside(i)) {
+        value[i] = count[i] ? std::min(value[i], values[i]) : values[i];
+        count[i] = 1;
+      }
+    }
+    break;
+  case MapOperator::Maximum:
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for if (n > parallel_threshold)
+#endif
+    for (long i = 0; i < n; ++i) {
+      if (is_inside(i)) {
+        value[i] = count[i] ? std::max(value[i], values[i]) : values[i];
+        count[i] = 1;
+      }
+    }
+    break;
+  case MapOperator::Sum:
+  case MapOperator::Average:
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for if (n > parallel_threshold)
+#endif
+    for (long i = 0; i < n; ++i) {
+      if (is_inside(i)) {
+        value[i] += values[i];
+        if (count)
+          ++count[i];
+      }
+    }
+    break;
+  case MapOperator::Difference:
+  case MapOperator::Unique: {
+    const float sign = first ? 1.f : -1.f;
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for if (n > parallel_threshold)
+#endif
+    for (long i = 0; i < n; ++i) {
+      if (is_inside(i))
+        value[i] += sign * values[i];
+    }
+  } break;
+  }
+}
+
+void MapAccumulator::finish(float* out) const
+{
+  const long n = m_value.size();
+  const float* value = m_value.data();
+  const int* count = m_count.data();
+
+  switch (m_op) {
+  case MapOperator::Average:
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for if (n > parallel_threshold)
+#endif
+    for (long i = 0; i < n; ++i) {
+      out[i] = count[i] ? value[i] / count[i] : value[i];
+    }
+    break;
+  case MapOperator::Unique:
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for if (n > parallel_threshold)
+#endif
+    for (long i = 0; i < n; ++i) {
+      out[i] = std::max(value[i], 0.f);
+    }
+    break;
+  default:
+    std::copy_n(value, n, out);
+    break;
+  }
+}
+
+} // namespace pymol
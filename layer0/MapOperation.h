@@ -0,0 +1,63 @@
+/*
+ * Fused element-wise arithmetic between maps on a common grid
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pymol
+{
+
+/**
+ * Map operators, values match cmd.map_set operator indices
+ */
+enum class MapOperator {
+  Minimum = 0,
+  Maximum = 1,
+  Sum = 2,
+  Average = 3,
+  Difference = 4,
+  Copy = 5,
+  Unique = 6,
+};
+
+/**
+ * Accumulates operand values (sampled on the target grid) in a single pass
+ * per operand. Points which are outside of an operand map are masked out
+ * and don't contribute.
+ */
+class MapAccumulator
+{
+  MapOperator m_op;
+  std::vector<float> m_value;
+  std::vector<int> m_count;
+
+public:
+  /**
+   * @param op Operator
+   * @param n Number of target grid points
+   */
+  MapAccumulator(MapOperator op, size_t n);
+
+  /**
+   * @param values Operand values at target grid points
+   * @param inside Per-point flags for points within the operand map, or
+   * nullptr if all points are inside
+   * @param first True for the first operand (minuend for Difference and
+   * Unique)
+   */
+  void add(const float* values, const std::uint8_t* inside, bool first);
+
+  /**
+   * Finalize (Average, Unique) and write the result.
+   * @param[out] out Result array with `size()` elements
+   */
+  void finish(float* out) const;
+
+  size_t size() const { return m_value.size(); }
+};
+
+} // namespace pymol
@@ -0,0 +1,162 @@
+/*
+ * Min/max block hierarchy over a 3D scalar field
+ */
+
+#include "MinMaxTree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "Field.h"
+
+namespace pymol
+{
+
+MinMaxTree::MinMaxTree(const CField& data)
+{
+  assert(data.n_dim() == 3);
+  assert(data.base_size == sizeof(float));
+
+  Level leaves;
+  for (int c = 0; c < 3; ++c) {
+    m_dim[c] = data.dim[c];
+    leaves.dim[c] = std::max(1, (m_dim[c] - 2) / brick_size + 1);
+  }
+
+  size_t n_leaves = size_t(leaves.dim[0]) * leaves.dim[1] * leaves.dim[2];
+  leaves.min.resize(n_leaves);
+  leaves.max.resize(n_leaves);
+
+  // bricks share their boundary points, so that every cell (and every edge)
+  // is entirely inside at least one brick
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+  for (int bx = 0; bx < leaves.dim[0]; ++bx) {
+    for (int by = 0; by < leaves.dim[1]; ++by) {
+      for (int bz = 0; bz < leaves.dim[2]; ++bz) {
+        int lo[3] = {bx * brick_size, by * brick_size, bz * brick_size};
+        int hi[3];
+        for (int c = 0; c < 3; ++c)
+          hi[c] = std::min(lo[c] + brick_size, m_dim[c] - 1);
+
+        float mn = std::numeric_limits<float>::infinity();
+        float mx = -mn;
+        for (int x = lo[0]; x <= hi[0]; ++x) {
+          for (int y = lo[1]; y <= hi[1]; ++y) {
+            for (int z = lo[2]; z <= hi[2]; ++z) {
+              float v = data.get<float>(x, y, z);
+              if (v < mn)
+                mn = v;
+              if (v > mx)
+                mx = v;
+            }
+          }
+        }
+
+        auto i = leaves.index(bx, by, bz);
+        leaves.min[i] = mn;
+        leaves.max[i] = mx;
+      }
+    }
+  }
+
+  m_levels.push_back(std::move(leaves));
+
+  // coarser levels, each node covers 2x2x2 nodes of the level below
+  while (m_levels.back().min.size() > 1) {
+    const Level& fine = m_levels.back();
+    Level coarse;
+    for (int c = 0; c < 3; ++c)
+      coarse.dim[c] = (fine.dim[c] + 1) / 2;
+
+    size_t n = size_t(coarse.dim[0]) * coarse.dim[1] * coarse.dim[2];
+    coarse.min.assign(n, std::numeric_limits<float>::infinity());
+    coarse.max.assign(n, -std::numeric_limits<float>::infinity());
+
+    for (int x = 0; x < fine.dim[0]; ++x) {
+      for (int y = 0; y < fine.dim[1]; ++y) {
+        for (int z = 0; z < fine.dim[2]; ++z) {
+          auto i = fine.index(x, y, z);
+          auto j = coarse.index(x / 2, y / 2, z / 2);
+          coarse.min[j] = std::min(coarse.min[j], fine.min[i]);
+          coarse.max[j] = std::max(coarse.max[j], fine.max[i]);
+        }
+      }
+    }
+
+    m_levels.push_back(std::move(coarse));
+  }
+}
+
+/**
+ * Depth-first traversal of all nodes which overlap `lo`, `hi` and contain
+ * `value`. Calls `leaf(x, y, z, brick_lo, brick_hi)` for matching leaf
+ * bricks, traversal stops when it returns true.
+ */
+template <typename Visit>
+bool MinMaxTree::visit(int level, int x, int y, int z, const int* lo,
+    const int* hi, float value, Visit& leaf) const
+{
+  const Level& L = m_levels[level];
+  const int xyz[3] = {x, y, z};
+  int node_lo[3], node_hi[3];
+
+  for (int c = 0; c < 3; ++c) {
+    node_lo[c] = (xyz[c] << level) * brick_size;
+    node_hi[c] = std::min(((xyz[c] + 1) << level) * brick_size, m_dim[c] - 1);
+    if (node_lo[c] > hi[c] || node_hi[c] < lo[c])
+      return false;
+  }
+
+  auto i = L.index(x, y, z);
+  if (!(L.min[i] <= value && value <= L.max[i]))
+    return false;
+
+  if (level == 0)
+    return leaf(node_lo, node_hi);
+
+  const Level& F = m_levels[level - 1];
+  for (int cx = 2 * x; cx < std::min(2 * x + 2, F.dim[0]); ++cx)
+    for (int cy = 2 * y; cy < std::min(2 * y + 2, F.dim[1]); ++cy)
+      for (int cz = 2 * z; cz < std::min(2 * z + 2, F.dim[2]); ++cz)
+        if (visit(level - 1, cx, cy, cz, lo, hi, value, leaf))
+          return true;
+
+  return false;
+}
+
+bool MinMaxTree::contains(const int* lo, const int* hi, float level) const
+{
+  auto leaf = [](const int*, const int*) { return true; };
+  return visit(m_levels.size() - 1, 0, 0, 0, lo, hi, level, leaf);
+}
+
+bool MinMaxTree::activeBounds(const int* lo, const int* hi, float level,
+    int* out_lo, int* out_hi) const
+{
+  int bounds_lo[3] = {hi[0] + 1, hi[1] + 1, hi[2] + 1};
+  int bounds_hi[3] = {lo[0] - 1, lo[1] - 1, lo[2] - 1};
+  bool found = false;
+
+  auto leaf = [&](const int* brick_lo, const int* brick_hi) {
+    for (int c = 0; c < 3; ++c) {
+      bounds_lo[c] = std::min(bounds_lo[c], std::max(brick_lo[c], lo[c]));
+      bounds_hi[c] = std::max(bounds_hi[c], std::min(brick_hi[c], hi[c]));
+    }
+    found = true;
+    return false;
+  };
+
+  visit(m_levels.size() - 1, 0, 0, 0, lo, hi, level, leaf);
+
+  if (found) {
+    std::copy_n(bounds_lo, 3, out_lo);
+    std::copy_n(bounds_hi, 3, out_hi);
+  }
+
+  return found;
+}
+
+} // namespace pymol
@@ -0,0 +1,71 @@
+/*
+ * Min/max block hierarchy over a 3D scalar field
+ *
+ * Answers "can the iso-level cross this region?" without touching the
+ * voxels, so contouring can skip empty blocks when the level changes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct CField;
+
+namespace pymol
+{
+
+class MinMaxTree
+{
+public:
+  //! Number of cells per leaf brick edge
+  static constexpr int brick_size = 8;
+
+  /**
+   * @param data 3D float field
+   */
+  explicit MinMaxTree(const CField& data);
+
+  /**
+   * True if `level` lies within the value range of any leaf brick which
+   * overlaps the point range `lo` to `hi` (inclusive). Conservative, a
+   * true result does not guarantee that the level is crossed.
+   */
+  bool contains(const int* lo, const int* hi, float level) const;
+
+  /**
+   * Bounding box (inclusive, clipped to `lo`, `hi`) of all leaf bricks
+   * which may contain the level. Every grid edge crossed by the
+   * iso-surface inside `lo`, `hi` is inside the returned box.
+   *
+   * @param[out] out_lo lower corner
+   * @param[out] out_hi upper corner
+   * @return False if no brick contains the level
+   */
+  bool activeBounds(const int* lo, const int* hi, float level, int* out_lo,
+      int* out_hi) const;
+
+  //! Value range of the entire field
+  float min() const { return m_levels.back().min[0]; }
+  float max() const { return m_levels.back().max[0]; }
+
+private:
+  struct Level {
+    int dim[3];
+    std::vector<float> min;
+    std::vector<float> max;
+    size_t index(int x, int y, int z) const
+    {
+      return (size_t(x) * dim[1] + y) * dim[2] + z;
+    }
+  };
+
+  int m_dim[3]; //!< field dimensions
+  std::vector<Level> m_levels; //!< finest first, coarsest (1x1x1) last
+
+  template <typename Visit>
+  bool visit(int level, int x, int y, int z, const int* lo, const int* hi,
+      float value, Visit& leaf) const;
+};
+
+} // namespace pymol
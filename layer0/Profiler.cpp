@@ -0,0 +1,214 @@
+/*
+ * Hierarchical profiler with scoped timers
+ */
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+
+#include "File.h"
+
+namespace pymol
+{
+
+namespace
+{
+std::atomic<int> s_thread_count{0};
+thread_local int t_thread = -1;
+thread_local int t_depth = 0;
+
+int current_thread()
+{
+  if (t_thread < 0)
+    t_thread = s_thread_count++;
+  return t_thread;
+}
+
+double seconds(Profiler::clock::duration d)
+{
+  return std::chrono::duration<double>(d).count();
+}
+
+void append_json_string(std::string& out, const char* s)
+{
+  out += '"';
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      out += '\\';
+    out += *s;
+  }
+  out += '"';
+}
+} // namespace
+
+void ProfileScope::begin()
+{
+  m_depth = t_depth++;
+  m_start = Profiler::clock::now();
+}
+
+void ProfileScope::end()
+{
+  auto stop = Profiler::clock::now();
+  --t_depth;
+  m_profiler->record(
+      {m_category, m_name, m_start, stop - m_start, current_thread(), m_depth});
+}
+
+void Profiler::start()
+{
+  m_enabled = true;
+}
+
+void Profiler::stop()
+{
+  m_enabled = false;
+}
+
+void Profiler::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.clear();
+  m_dropped = 0;
+  m_origin = clock::now();
+}
+
+void Profiler::record(const Event& event)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_events.size() < max_events) {
+    m_events.push_back(event);
+  } else {
+    ++m_dropped;
+  }
+}
+
+size_t Profiler::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_events.size();
+}
+
+size_t Profiler::dropped() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_dropped;
+}
+
+/**
+ * Aggregate events by scope path. Events are recorded when a scope exits,
+ * so the nesting is reconstructed per thread from start times and depths.
+ * Scopes on worker threads (e.g. OpenMP loops) appear as separate roots.
+ */
+std::vector<Profiler::Node> Profiler::summary() const
+{
+  std::vector<Event> events;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    events = m_events;
+  }
+
+  std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+    if (a.thread != b.thread)
+      return a.thread < b.thread;
+    if (a.start != b.start)
+      return a.start < b.start;
+    return a.depth < b.depth;
+  });
+
+  std::vector<Node> nodes;
+  std::unordered_map<std::string, size_t> index;
+  std::vector<size_t> stack;
+  int thread = -1;
+
+  for (const auto& event : events) {
+    if (event.thread != thread) {
+      thread = event.thread;
+      stack.clear();
+    }
+
+    // scopes entered before recording started have no event, attach to
+    // the innermost recorded one
+    stack.resize(std::min<size_t>(event.depth, stack.size()));
+
+    std::string path;
+    if (!stack.empty()) {
+      path = nodes[stack.back()].path;
+      path += '/';
+    }
+    path += event.name;
+
+    auto it = index.find(path);
+    if (it == index.end()) {
+      it = index.emplace(path, nodes.size()).first;
+      nodes.push_back({path, event.category, int(stack.size()), 0, 0.0, 0.0});
+    }
+
+    auto& node = nodes[it->second];
+    auto duration = seconds(event.duration);
+    node.count += 1;
+    node.total += duration;
+    node.self += duration;
+
+    if (!stack.empty())
+      nodes[stack.back()].self -= duration;
+
+    stack.push_back(it->second);
+  }
+
+  return nodes;
+}
+
+/**
+ * Events in the Chrome trace event format ("complete" events), for
+ * chrome://tracing, Perfetto or speedscope.
+ */
+std::string Profiler::chromeTrace() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::string out = "{\"traceEvents\":[";
+  char buf[128];
+  bool first = true;
+
+  for (const auto& event : m_events) {
+    if (!first)
+      out += ",\n";
+    first = false;
+    out += "{\"name\":";
+    append_json_string(out, event.name);
+    out += ",\"cat\":";
+    append_json_string(out, event.category);
+    snprintf(buf, sizeof(buf),
+        ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+        seconds(event.start - m_origin) * 1e6, seconds(event.duration) * 1e6,
+        event.thread);
+    out += buf;
+  }
+
+  out += "],\"displayTimeUnit\":\"ms\"}\n";
+  return out;
+}
+
+pymol::Result<> Profiler::saveChromeTrace(const char* filename) const
+{
+  auto json = chromeTrace();
+
+  FILE* fp = pymol_fopen(filename, "wb");
+  if (!fp) {
+    return pymol::make_error("Cannot open '", filename, "' for writing");
+  }
+
+  bool ok = fwrite(json.data(), 1, json.size(), fp) == json.size();
+  ok = (fclose(fp) == 0) && ok;
+
+  if (!ok) {
+    return pymol::make_error("Failed to write '", filename, "'");
+  }
+
+  return {};
+}
+
+} // namespace pymol
@@ -0,0 +1,120 @@
+/*
+ * Hierarchical profiler with scoped timers
+ *
+ * Instrument a block with
+ *
+ *     PYMOL_PROFILE_SCOPE(G, "Scene", "SceneUpdate");
+ *
+ * Recording is off by default. A disabled scope costs one relaxed atomic
+ * load. Category and name must be string literals (or otherwise outlive the
+ * profiler), they are stored by pointer.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "PyMOLGlobals.h"
+#include "Result.h"
+
+namespace pymol
+{
+
+class Profiler
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  struct Event {
+    const char* category;
+    const char* name;
+    clock::time_point start;
+    clock::duration duration;
+    int thread;
+    int depth; //!< nesting level on the recording thread
+  };
+
+  /**
+   * Timings aggregated over all events with the same scope path
+   */
+  struct Node {
+    std::string path; //!< slash-separated names, outermost first
+    const char* category;
+    int depth;
+    int count;
+    double total; //!< inclusive, seconds
+    double self;  //!< exclusive of nested scopes, seconds
+  };
+
+  //! Upper limit for stored events, further events are counted as dropped
+  static constexpr size_t max_events = 4000000;
+
+  bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+  void start();
+  void stop();
+  void clear();
+
+  void record(const Event& event);
+
+  size_t size() const;
+  size_t dropped() const;
+
+  std::vector<Node> summary() const;
+  std::string chromeTrace() const;
+  pymol::Result<> saveChromeTrace(const char* filename) const;
+
+private:
+  std::atomic<bool> m_enabled{false};
+  mutable std::mutex m_mutex;
+  std::vector<Event> m_events;
+  size_t m_dropped = 0;
+  clock::time_point m_origin = clock::now();
+};
+
+/**
+ * RAII timer, records an event into G->Profiler if it was enabled when the
+ * scope was entered.
+ */
+class ProfileScope
+{
+  Profiler* m_profiler = nullptr;
+  const char* m_category;
+  const char* m_name;
+  Profiler::clock::time_point m_start;
+  int m_depth = 0;
+
+  void begin();
+  void end();
+
+public:
+  ProfileScope(PyMOLGlobals* G, const char* category, const char* name)
+      : m_category(category)
+      , m_name(name)
+  {
+    if (G && G->Profiler && G->Profiler->enabled()) {
+      m_profiler = G->Profiler;
+      begin();
+    }
+  }
+
+  ~ProfileScope()
+  {
+    if (m_profiler)
+      end();
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+} // namespace pymol
+
+#define PYMOL_PROFILE_CONCAT_(a, b) a##b
+#define PYMOL_PROFILE_CONCAT(a, b) PYMOL_PROFILE_CONCAT_(a, b)
+#define PYMOL_PROFILE_SCOPE(G, category, name)                                 \
+  pymol::ProfileScope PYMOL_PROFILE_CONCAT(_profile_scope_, __LINE__)(         \
+      G, category, name)
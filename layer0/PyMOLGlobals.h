@@ -55,7 +55,6 @@ constexpr StateIndex_t cStateAll = -1;
 constexpr StateIndex_t cStateCurrent = -2;
 
 typedef struct _CMemoryCache CMemoryCache;
-struct CIsosurf;
 typedef struct _CTetsurf CTetsurf;
 typedef struct _CSphere CSphere;
 class CFeedback;
@@ -109,6 +108,11 @@ class CGO;
 
 class GFXManager;
 
+namespace pymol
+{
+class Profiler;
+}
+
 #define cPyMOLGlobals_LaunchStatus_StereoFailed 0x1
 #define cPyMOLGlobals_LaunchStatus_MultisampleFailed 0x2
 
@@ -117,7 +121,6 @@ struct PyMOLGlobals {
   /* singleton objects */
 
   CMemoryCache *MemoryCache;    /* could probably eliminate this... */
-  CIsosurf *Isosurf;
   CTetsurf *Tetsurf;
   CSphere *Sphere;
   CFeedback *Feedback;
@@ -157,6 +160,7 @@ struct PyMOLGlobals {
   CShaderMgr* ShaderMgr;
   COpenVR* OpenVR;
   GFXManager* GFXMgr;
+  pymol::Profiler* Profiler;
 #ifndef _PYMOL_NOPY
   CP_inst *P_inst;
 #endif
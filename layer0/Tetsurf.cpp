@@ -71,7 +71,7 @@ struct _CTetsurf {
 
   int AbsDim[3], CurDim[3], CurOff[3];
   int Max[3];
-  CField *Coord, *Data, *Grad;
+  CField *Coord, *Data;
   float Level;
   int Edge[6020];               /* 6017 */
   int EdgeStart[256];
@@ -514,8 +514,9 @@ void TetsurfGetRange(PyMOLGlobals * G,
 /**
  * Compute an isosurface using the "marching tetrahedra" algorithm.
  *
- * @param[in,out] field     Map data (field->gradients will be generated if
- *                          missing for cIsosurfaceMode::triangles_grad_normals)
+ * @param[in,out] field     Map data (gradients for
+ *                          cIsosurfaceMode::triangles_grad_normals are derived
+ *                          from the data on the fly)
  * @param[in] level         Contour level
  * @param[out] num          Number of vertices + normals per strip (e.g. 6 for
  *                          triangle strip with a single triangle)
@@ -554,9 +555,6 @@ int TetsurfVolume(PyMOLGlobals* G, Isofield* field, float level,
     int n_vert = 0;
     int tot_prim = 0;
 
-    if(mode == cIsosurfaceMode::triangles_grad_normals)
-      IsofieldComputeGradients(G, field);
-
     I->TotPrim = 0;
     if(range) {
       for(c = 0; c < 3; c++) {
@@ -582,7 +580,6 @@ int TetsurfVolume(PyMOLGlobals* G, Isofield* field, float level,
      */
 
     I->Coord = field->points.get();
-    I->Grad = field->gradients.get();
     I->Data = field->data.get();
     I->Level = level;
     if(ok)
@@ -608,6 +605,21 @@ int TetsurfVolume(PyMOLGlobals* G, Isofield* field, float level,
                printf(" TetsurfVolume: c: %i I->CurOff[c]: %i I->Max[c] %i\n",c,I->CurOff[c],I->Max[c]); 
              */
 
+            if(field->minmax) {
+              /* shrink the block to the bricks which may contain the level */
+              int lo[3], hi[3];
+              for(c = 0; c < 3; c++) {
+                lo[c] = I->CurOff[c];
+                hi[c] = I->CurOff[c] + I->Max[c] - 1;
+              }
+              if(!field->minmax->activeBounds(lo, hi, level, lo, hi))
+                continue;
+              for(c = 0; c < 3; c++) {
+                I->CurOff[c] = lo[c];
+                I->Max[c] = hi[c] - lo[c] + 1;
+              }
+            }
+
             if(ok) {
               if(TetsurfCodeVertices(I))
                 n_vert = TetsurfFindActiveBoxes(I, mode, n_strip, n_vert, num, vert,
@@ -768,8 +780,9 @@ static int TetsurfFindActiveBoxes(CTetsurf * II, cIsosurfaceMode mode, int &n_st
   int i000, i001, i010, i011, i100, i101, i110, i111;
   float *c000, *c001, *c010, *c011, *c100, *c101, *c110, *c111;
   float d000, d001, d010, d011, d100, d101, d110, d111;
-  float *g000 = nullptr, *g001 = nullptr, *g010 = nullptr, *g011 = nullptr, *g100 = nullptr, *g101 =
-    nullptr, *g110 = nullptr, *g111 = nullptr;
+  float grad[8][3];             /* corner gradients, computed on the fly */
+  float *g000 = grad[0], *g001 = grad[1], *g010 = grad[2], *g011 = grad[3],
+    *g100 = grad[4], *g101 = grad[5], *g110 = grad[6], *g111 = grad[7];
 
   int active;
   int n_active = 0;
@@ -811,14 +824,12 @@ static int TetsurfFindActiveBoxes(CTetsurf * II, cIsosurfaceMode mode, int &n_st
           c111 = O4Ptr(I->Coord, i + 1, j + 1, k + 1, 0, I->CurOff);
 
           if (mode == cIsosurfaceMode::triangles_grad_normals) {
-            g000 = O4Ptr(I->Grad, i, j, k, 0, I->CurOff);
-            g001 = O4Ptr(I->Grad, i, j, k + 1, 0, I->CurOff);
-            g010 = O4Ptr(I->Grad, i, j + 1, k, 0, I->CurOff);
-            g011 = O4Ptr(I->Grad, i, j + 1, k + 1, 0, I->CurOff);
-            g100 = O4Ptr(I->Grad, i + 1, j, k, 0, I->CurOff);
-            g101 = O4Ptr(I->Grad, i + 1, j, k + 1, 0, I->CurOff);
-            g110 = O4Ptr(I->Grad, i + 1, j + 1, k, 0, I->CurOff);
-            g111 = O4Ptr(I->Grad, i + 1, j + 1, k + 1, 0, I->CurOff);
+            for(int corner = 0; corner < 8; corner++) {
+              FieldGradient3f(I->Data,
+                              i + ((corner >> 2) & 1) + I->CurOff[0],
+                              j + ((corner >> 1) & 1) + I->CurOff[1],
+                              k + (corner & 1) + I->CurOff[2], grad[corner]);
+            }
           }
 
           d000 = O3(I->Data, i, j, k, I->CurOff);
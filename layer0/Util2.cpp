@@ -118,6 +118,63 @@ double pretty_f2d(float f)
   return std::round(f * factor) / factor;
 }
 
+/**
+ * Fast equivalent of `sprintf(dest, "%*.*f", width, precision, value)`.
+ *
+ * The output is identical to printf: The product of a float and a power of
+ * ten up to 1e6 is exact in double precision, so rounding it with the current
+ * rounding mode (round-half-to-even by default) matches the decimal rounding
+ * of the exact binary value. Falls back to sprintf for large or non-finite
+ * values and for unsupported precisions.
+ *
+ * @param dest Output buffer, must hold at least max(width, 32) characters
+ * @return Number of characters written (excluding the null byte)
+ */
+int format_fixed(char* dest, float value, int width, int precision)
+{
+  static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+
+  if (precision < 0 || precision > 6 || !std::isfinite(value) ||
+      std::fabs(value) >= 1e9f) {
+    return sprintf(dest, "%*.*f", width, precision, value);
+  }
+
+  auto digits = static_cast<unsigned long long>(
+      std::fabs(std::nearbyint(double(value) * pow10[precision])));
+
+  char buf[32];
+  char* const end = buf + sizeof(buf);
+  char* p = end;
+
+  for (int i = 0; i < precision; ++i) {
+    *--p = '0' + digits % 10;
+    digits /= 10;
+  }
+
+  if (precision) {
+    *--p = '.';
+  }
+
+  do {
+    *--p = '0' + digits % 10;
+    digits /= 10;
+  } while (digits);
+
+  // printf keeps the sign of values which round to (negative) zero
+  if (std::signbit(value)) {
+    *--p = '-';
+  }
+
+  int const len = end - p;
+  int const pad = std::max(0, width - len);
+
+  std::fill_n(dest, pad, ' ');
+  std::copy(p, end, dest + pad);
+  dest[pad + len] = '\0';
+
+  return pad + len;
+}
+
 bool string_equal_case(
     pymol::zstring_view str1, pymol::zstring_view str2, bool case_insensitive)
 {
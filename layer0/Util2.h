@@ -128,6 +128,8 @@ inline bool starts_with(pymol::zstring_view str, pymol::zstring_view pre)
 
 double pretty_f2d(float v);
 
+int format_fixed(char* dest, float value, int width, int precision);
+
 /**
  * Compares two strings with consideration of case sensitivity
  * @param str1 first string
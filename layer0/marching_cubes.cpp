@@ -503,36 +503,20 @@ Mesh march(const Field& volume, float isoLevel, bool gradient_normals)
   auto const yDim = volume.yDim();
   auto const zDim = volume.zDim();
 
-#ifndef PYMOL_OPENMP
-  using isocheck_bool_t = bool;
-#else
-  // writes to std::vector<bool> are not thread-safe
-  using isocheck_bool_t = char;
-#endif
-
-  // pre-compute isovalue check for better performance
-  std::vector<isocheck_bool_t> isocheck(xDim * yDim * zDim);
-
-#pragma omp parallel for
-  for (int z = 0; z < zDim; ++z) {
-    for (size_t y = 0; y < yDim; ++y) {
-      auto const offset = xDim * y + xDim * yDim * z;
-      for (size_t x = 0; x < xDim; ++x) {
-        isocheck[x + offset] = volume.get(x, y, z) < isoLevel;
-      }
-    }
-  }
-
-  auto const get_isocheck = [&](size_t x, size_t y, size_t z) -> bool {
-    return isocheck[x + xDim * y + xDim * yDim * z];
-  };
-
   auto const xEnd = xDim - 1;
   auto const yEnd = yDim - 1;
   auto const zEnd = zDim - 1;
 
+  // Cells are processed in tiles, tiles which can't contain the iso-level
+  // (according to Field::mayContain) are skipped entirely.
+  constexpr size_t tileSize = 8;
+  constexpr size_t tilePoints = tileSize + 1;
+  auto const xTiles = (xEnd + tileSize - 1) / tileSize;
+  auto const yTiles = (yEnd + tileSize - 1) / tileSize;
+  auto const zTiles = (zEnd + tileSize - 1) / tileSize;
+
   // With OpenMP, we use one triangles vector per thread, and one vertexMap per
-  // z-index, and let OpenMP distribute the z-index runs across threads.
+  // z-index, and let OpenMP distribute the z-tile runs across threads.
   std::vector<std::vector<Triangle>> trianglesVec(1);
   std::vector<std::unordered_map<size_t, IdPoint>> vertexMapVec(1);
 
@@ -545,82 +529,117 @@ Mesh march(const Field& volume, float isoLevel, bool gradient_normals)
   trianglesVec.resize(omp_get_max_threads());
   vertexMapVec.resize(zDim);
 
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic)
 #endif
-  for (int z = 0; z < zEnd; ++z) {
+  for (int tz = 0; tz < zTiles; ++tz) {
     auto& triangles = trianglesVec[omp_get_thread_num()];
 
-    for (size_t y = 0; y < yEnd; ++y) {
-      for (size_t x = 0; x < xEnd; ++x) {
-        size_t tableIndex = 0;
-        if (get_isocheck(x, y, z))
-          tableIndex |= 1;
-        if (get_isocheck(x, y + 1, z))
-          tableIndex |= 2;
-        if (get_isocheck(x + 1, y + 1, z))
-          tableIndex |= 4;
-        if (get_isocheck(x + 1, y, z))
-          tableIndex |= 8;
-        if (get_isocheck(x, y, z + 1))
-          tableIndex |= 16;
-        if (get_isocheck(x, y + 1, z + 1))
-          tableIndex |= 32;
-        if (get_isocheck(x + 1, y + 1, z + 1))
-          tableIndex |= 64;
-        if (get_isocheck(x + 1, y, z + 1))
-          tableIndex |= 128;
-
-        if (EDGE_TABLE[tableIndex] == 0) {
-          continue;
-        }
-
-        auto const storeEdgeVertex = [&](size_t edgeNumber) {
-          if ((EDGE_TABLE[tableIndex] & (1 << edgeNumber)) != 0) {
-            auto eid = edgeId(x, y, z, edgeNumber, xDim, yDim);
-            auto& edge = vertexMappingGet(eid);
-            edge.point = calculateIntersection(volume, isoLevel, x, y, z,
-                edgeNumber, gradient_normals ? &edge.normal : nullptr);
-          }
-        };
+    // isovalue check of the current tile's points
+    bool isocheck[tilePoints * tilePoints * tilePoints];
+    size_t lo[3], hi[3];
 
-        storeEdgeVertex(3);
-        storeEdgeVertex(0);
-        storeEdgeVertex(8);
+    auto const get_isocheck = [&](size_t x, size_t y, size_t z) -> bool {
+      return isocheck[(x - lo[0]) +
+                      tilePoints * ((y - lo[1]) + tilePoints * (z - lo[2]))];
+    };
 
-        if (x == xEnd - 1) {
-          storeEdgeVertex(2);
-          storeEdgeVertex(11);
+    for (size_t t = 0; t < xTiles * yTiles; ++t) {
+      lo[0] = (t % xTiles) * tileSize;
+      lo[1] = (t / xTiles) * tileSize;
+      lo[2] = tz * tileSize;
+      hi[0] = std::min(lo[0] + tileSize, xEnd);
+      hi[1] = std::min(lo[1] + tileSize, yEnd);
+      hi[2] = std::min(lo[2] + tileSize, zEnd);
 
-          if (y == yEnd - 1) {
-            storeEdgeVertex(10);
-          }
-        }
-
-        if (y == yEnd - 1) {
-          storeEdgeVertex(1);
-          storeEdgeVertex(9);
+      if (!volume.mayContain(lo, hi, isoLevel)) {
+        continue;
+      }
 
-          if (z == zEnd - 1) {
-            storeEdgeVertex(5);
+      // pre-compute isovalue check for better performance
+      for (size_t z = lo[2]; z <= hi[2]; ++z) {
+        for (size_t y = lo[1]; y <= hi[1]; ++y) {
+          for (size_t x = lo[0]; x <= hi[0]; ++x) {
+            isocheck[(x - lo[0]) +
+                     tilePoints * ((y - lo[1]) + tilePoints * (z - lo[2]))] =
+                volume.get(x, y, z) < isoLevel;
           }
         }
+      }
 
-        if (z == zEnd - 1) {
-          storeEdgeVertex(4);
-          storeEdgeVertex(7);
-
-          if (x == xEnd - 1) {
-            storeEdgeVertex(6);
+      for (size_t z = lo[2]; z < hi[2]; ++z) {
+        for (size_t y = lo[1]; y < hi[1]; ++y) {
+          for (size_t x = lo[0]; x < hi[0]; ++x) {
+            size_t tableIndex = 0;
+            if (get_isocheck(x, y, z))
+              tableIndex |= 1;
+            if (get_isocheck(x, y + 1, z))
+              tableIndex |= 2;
+            if (get_isocheck(x + 1, y + 1, z))
+              tableIndex |= 4;
+            if (get_isocheck(x + 1, y, z))
+              tableIndex |= 8;
+            if (get_isocheck(x, y, z + 1))
+              tableIndex |= 16;
+            if (get_isocheck(x, y + 1, z + 1))
+              tableIndex |= 32;
+            if (get_isocheck(x + 1, y + 1, z + 1))
+              tableIndex |= 64;
+            if (get_isocheck(x + 1, y, z + 1))
+              tableIndex |= 128;
+
+            if (EDGE_TABLE[tableIndex] == 0) {
+              continue;
+            }
+
+            auto const storeEdgeVertex = [&](size_t edgeNumber) {
+              if ((EDGE_TABLE[tableIndex] & (1 << edgeNumber)) != 0) {
+                auto eid = edgeId(x, y, z, edgeNumber, xDim, yDim);
+                auto& edge = vertexMappingGet(eid);
+                edge.point = calculateIntersection(volume, isoLevel, x, y, z,
+                    edgeNumber, gradient_normals ? &edge.normal : nullptr);
+              }
+            };
+
+            storeEdgeVertex(3);
+            storeEdgeVertex(0);
+            storeEdgeVertex(8);
+
+            if (x == xEnd - 1) {
+              storeEdgeVertex(2);
+              storeEdgeVertex(11);
+
+              if (y == yEnd - 1) {
+                storeEdgeVertex(10);
+              }
+            }
+
+            if (y == yEnd - 1) {
+              storeEdgeVertex(1);
+              storeEdgeVertex(9);
+
+              if (z == zEnd - 1) {
+                storeEdgeVertex(5);
+              }
+            }
+
+            if (z == zEnd - 1) {
+              storeEdgeVertex(4);
+              storeEdgeVertex(7);
+
+              if (x == xEnd - 1) {
+                storeEdgeVertex(6);
+              }
+            }
+
+            auto const* tri_table_row = TRIANGLE_TABLE[tableIndex];
+            for (size_t i = 0; tri_table_row[i] != -1; i += 3) {
+              auto pointId0 = edgeId(x, y, z, tri_table_row[i], xDim, yDim);
+              auto pointId1 = edgeId(x, y, z, tri_table_row[i + 1], xDim, yDim);
+              auto pointId2 = edgeId(x, y, z, tri_table_row[i + 2], xDim, yDim);
+              triangles.push_back({pointId0, pointId1, pointId2});
+            }
           }
         }
-
-        auto const* tri_table_row = TRIANGLE_TABLE[tableIndex];
-        for (size_t i = 0; tri_table_row[i] != -1; i += 3) {
-          auto pointId0 = edgeId(x, y, z, tri_table_row[i], xDim, yDim);
-          auto pointId1 = edgeId(x, y, z, tri_table_row[i + 1], xDim, yDim);
-          auto pointId2 = edgeId(x, y, z, tri_table_row[i + 2], xDim, yDim);
-          triangles.push_back({pointId0, pointId1, pointId2});
-        }
       }
     }
   }
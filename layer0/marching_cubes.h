@@ -33,6 +33,16 @@ public:
   virtual float get(size_t x, size_t y, size_t z) const = 0;
   virtual Point get_point(size_t x, size_t y, size_t z) const = 0;
   Point get_gradient(size_t x, size_t y, size_t z) const;
+
+  /**
+   * False if the iso-level is certainly not crossed in the (inclusive)
+   * point range `lo` to `hi`, which then gets skipped.
+   */
+  virtual bool mayContain(
+      const size_t* lo, const size_t* hi, float isoLevel) const
+  {
+    return true;
+  }
 };
 
 /**
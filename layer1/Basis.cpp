@@ -23,6 +23,7 @@ Z* -------------------------------------------------------------------
 #include"Basis.h"
 #include"Err.h"
 #include"Feedback.h"
+#include"Profiler.h"
 #include"Util.h"
 #include"Character.h"
 
@@ -2816,6 +2817,7 @@ int BasisHitShadow(BasisCallRec * BC)
 int BasisMakeMap(CBasis* I, int* vert2prim, CPrimitive* prim, int n_prim,
     float* volume, int perspective, float front, float size_hint)
 {
+  PYMOL_PROFILE_SCOPE(I->G, "Ray", "BasisMakeMap");
   float *v;
   float ll;
   CPrimitive *prm;
@@ -48,6 +48,7 @@ Z* -------------------------------------------------------------------
 #include "Vector.h"
 #include "GraphicsUtil.h"
 #include "GLVertexBuffer.h"
+#include "Profiler.h"
 
 #include "pymol/algorithm.h"
 
@@ -236,10 +237,17 @@ int CGOSimpleCone(CGO* I, const cgo::draw::cone& cone);
  *
  * I: (input) Primitive CGO (may contain CGO_DRAW_ARRAYS)
  *
- * Return: All-float Python list primitive CGO
+ * Return: All-float Python list primitive CGO, or the same floats packed
+ * into a bytes object with pse_binary_dump
  */
 static PyObject* CGOArrayAsPyList(const CGO* I)
 {
+  auto G = I->G;
+  int pse_export_version =
+      SettingGet<float>(G, cSetting_pse_export_version) * 1000;
+  bool dump_binary = SettingGet<bool>(G, cSetting_pse_binary_dump) &&
+                     (!pse_export_version || pse_export_version >= 3200);
+
   std::vector<float> flat;
   flat.reserve(I->c);
 
@@ -278,9 +286,12 @@ static PyObject* CGOArrayAsPyList(const CGO* I)
     }
 
     // float members
-    for (; sz; --sz) {
-      flat.push_back(*(pc++));
-    }
+    flat.insert(flat.end(), pc, pc + sz);
+  }
+
+  if (dump_binary) {
+    return PyBytes_FromStringAndSize(
+        reinterpret_cast<const char*>(flat.data()), flat.size() * sizeof(float));
   }
 
   return PConvToPyObject(flat);
@@ -291,7 +302,10 @@ PyObject* CGOAsPyList(CGO* I)
   PyObject* result;
   result = PyList_New(2);
   PyObject* list = CGOArrayAsPyList(I);
-  PyList_SetItem(result, 0, PyInt_FromLong(PyList_Size(list)));
+  auto const size = PyBytes_Check(list)
+                        ? PyBytes_Size(list) / sizeof(float)
+                        : PyList_Size(list);
+  PyList_SetItem(result, 0, PyInt_FromLong(size));
   PyList_SetItem(result, 1, list);
   return (result);
 }
@@ -305,24 +319,21 @@ static float CPythonVal_PyFloat_AsDouble_From_List(
 }
 
 /**
- * Inverse function of CGOArrayAsPyList
+ * Parse a flat primitive CGO
  *
- * list: (input) All-float Python list primitive CGO (may contain
- * CGO_DRAW_ARRAYS) I: (output) empty CGO
+ * get_float: (input) Accessor for the i-th float
+ * l: (input) Number of floats
+ * I: (output) empty CGO
  */
-static int CGOArrayFromPyListInPlace(PyObject* list, CGO* I)
+template <typename GetFloat>
+static int CGOArrayFromFlatInPlace(GetFloat&& get_float, int l, CGO* I)
 {
-  // sanity check
-  if (!list || !PyList_Check(list))
-    return false;
-
   auto G = I->G;
 
-#define GET_FLOAT(i)                                                           \
-  ((float) CPythonVal_PyFloat_AsDouble_From_List(I->G, list, i))
-#define GET_INT(i) ((int) CPythonVal_PyFloat_AsDouble_From_List(I->G, list, i))
+#define GET_FLOAT(i) ((float) get_float(i))
+#define GET_INT(i) ((int) get_float(i))
 
-  for (int i = 0, l = PyList_Size(list); i < l;) {
+  for (int i = 0; i < l;) {
     unsigned op = GET_INT(i++);
     ok_assert(1, op < CGO_sz_size());
     int sz = CGO_sz[op];
@@ -389,6 +400,34 @@ ok_except1:
   return false;
 }
 
+/**
+ * Inverse function of CGOArrayAsPyList
+ *
+ * list: (input) All-float Python list or bytes primitive CGO (may contain
+ * CGO_DRAW_ARRAYS) I: (output) empty CGO
+ */
+static int CGOArrayFromPyListInPlace(PyObject* list, CGO* I)
+{
+  if (list && PyBytes_Check(list)) {
+    auto const* data =
+        reinterpret_cast<const float*>(PyBytes_AsString(list));
+    int const l = PyBytes_Size(list) / sizeof(float);
+    VLACheck(I->op, float, I->c + l);
+    return CGOArrayFromFlatInPlace(
+        [data](size_t i) { return data[i]; }, l, I);
+  }
+
+  // sanity check
+  if (!list || !PyList_Check(list))
+    return false;
+
+  return CGOArrayFromFlatInPlace(
+      [I, list](size_t i) {
+        return CPythonVal_PyFloat_AsDouble_From_List(I->G, list, i);
+      },
+      PyList_Size(list), I);
+}
+
 CGO* CGONewFromPyList(
     PyMOLGlobals* G, PyObject* list, int version, bool shouldCombine)
 {
@@ -1519,6 +1558,38 @@ static void CGOAddVertexToDrawArrays(CGO* cgo, int pl, int plc, int pla,
   copy3f(vertex, &vertexVals[pl]);
 }
 
+CGODrawArraysData CGODrawArraysGetData(float* data, int arrays, int nverts)
+{
+  CGODrawArraysData ptrs;
+
+  if (arrays & CGO_VERTEX_ARRAY) {
+    ptrs.vertex = data;
+    data += nverts * VERTEX_POS_SIZE;
+  }
+
+  if (arrays & CGO_NORMAL_ARRAY) {
+    ptrs.normal = data;
+    data += nverts * VERTEX_NORMAL_SIZE;
+  }
+
+  if (arrays & CGO_COLOR_ARRAY) {
+    ptrs.color = data;
+    data += nverts * VERTEX_COLOR_SIZE;
+  }
+
+  if (arrays & CGO_PICK_COLOR_ARRAY) {
+    // RGBA part is filled in at render time
+    ptrs.pick_color = data + VERTEX_PICKCOLOR_RGBA_SIZE * nverts;
+    data += nverts * VERTEX_PICKCOLOR_SIZE;
+  }
+
+  if (arrays & CGO_ACCESSIBILITY_ARRAY) {
+    ptrs.accessibility = data;
+  }
+
+  return ptrs;
+}
+
 bool CGOCombineBeginEnd(CGO** I, bool do_not_split_lines)
 {
   CGO* cgo = CGOCombineBeginEnd(*I, 0, do_not_split_lines);
@@ -1543,6 +1614,7 @@ CGO* CGOCombineBeginEnd(const CGO* I, int est, bool do_not_split_lines)
   int ok = true;
   if (!I)
     return nullptr;
+  PYMOL_PROFILE_SCOPE(I->G, "CGO", "CGOCombineBeginEnd");
   cgo = CGONewSized(I->G, 0);
   ok &= cgo ? true : false;
 
@@ -1648,28 +1720,12 @@ CGO* CGOCombineBeginEnd(const CGO* I, int est, bool do_not_split_lines)
           continue;
 
         assert(damode & CGO_VERTEX_ARRAY);
-        vertexVals = nxtVals;
-        nxtVals += VERTEX_POS_SIZE * nverts;
-
-        if (damode & CGO_NORMAL_ARRAY) {
-          normalVals = nxtVals;
-          nxtVals += nverts * VERTEX_NORMAL_SIZE;
-        }
-
-        if (damode & CGO_COLOR_ARRAY) {
-          colorVals = nxtVals;
-          nxtVals += nverts * VERTEX_COLOR_SIZE;
-        }
-
-        if (damode & CGO_PICK_COLOR_ARRAY) {
-          pickColorVals = nxtVals + VERTEX_PICKCOLOR_RGBA_SIZE * nverts;
-          nxtVals += nverts * VERTEX_PICKCOLOR_SIZE;
-        }
-
-        if (damode & CGO_ACCESSIBILITY_ARRAY) {
-          accessibilityVals = nxtVals;
-          nxtVals += nverts * VERTEX_ACCESSIBILITY_SIZE;
-        }
+        auto const arrays = CGODrawArraysGetData(nxtVals, damode, nverts);
+        vertexVals = arrays.vertex;
+        normalVals = arrays.normal;
+        colorVals = arrays.color;
+        pickColorVals = arrays.pick_color;
+        accessibilityVals = arrays.accessibility;
 
         auto notHaveValue = damode;
 
@@ -3327,6 +3383,7 @@ bool CGOOptimizeToVBONotIndexed(CGO** I)
 CGO* CGOOptimizeToVBONotIndexed(const CGO* I, int est, bool addshaders)
 {
   auto G = I->G;
+  PYMOL_PROFILE_SCOPE(G, "CGO", "CGOOptimizeToVBONotIndexed");
 
   std::unique_ptr<CGO> I_begin_end_combined;
   if (I->has_begin_end) {
@@ -4002,6 +4059,7 @@ static bool OptimizeLinesToVBOIndexed(const CGO* I, CGO* cgo,
 CGO* CGOOptimizeToVBOIndexed(const CGO* I, int est, const float* color,
     bool addshaders, bool embedTransparencyInfo)
 {
+  PYMOL_PROFILE_SCOPE(I->G, "CGO", "CGOOptimizeToVBOIndexed");
   CGO* cgo;
 
   std::unique_ptr<CGO> I_begin_end_combined;
@@ -4357,6 +4415,7 @@ static bool PopulateBufferOptimizedSphereData(const CGO* I, CGO* cgo,
 CGO* CGOOptimizeSpheresToVBONonIndexed(
     const CGO* I, int est, bool addshaders, CGO* leftOverCGO)
 {
+  PYMOL_PROFILE_SCOPE(I->G, "CGO", "CGOOptimizeSpheresToVBONonIndexed");
   bool ok = true;
   int num_total_spheres = CGOCountNumberOfOperationsOfType(I, CGO_SPHERE);
 
@@ -4445,6 +4504,7 @@ CGO* CGOSimplify(
     const CGO* I, int est, short sphere_quality, bool stick_round_nub)
 {
   auto G = I->G;
+  PYMOL_PROFILE_SCOPE(G, "CGO", "CGOSimplify");
   int ok = true;
   if (sphere_quality < 0) {
     sphere_quality =
@@ -5772,6 +5832,26 @@ int CGORenderRay(CGO* I, CRay* ray, RenderInfo* info, const float* color,
     c0 = white;
   ray->transparentf(1.0F - I->G->CGORenderer->alpha);
 
+  // ramp colors of all vertices, looked up in one batch
+  std::vector<float> ramp_color;
+  const float* next_ramp_color = nullptr;
+  if (ramp) {
+    std::vector<float> ramp_pos;
+    for (auto it = I->begin(); !it.is_stop(); ++it) {
+      const auto op = it.op_code();
+      if (op == CGO_VERTEX || op == CGO_VERTEX_BEGIN_LINE_STRIP)
+        ramp_pos.insert(ramp_pos.end(), it.data(), it.data() + 3);
+    }
+    const int n_ramp = ramp_pos.size() / 3;
+    ramp_color.resize(ramp_pos.size());
+    if (!ObjectGadgetRampInterVertices(
+            ramp, ramp_pos.data(), ramp_color.data(), n_ramp, -1)) {
+      for (int i = 0; i < n_ramp; ++i)
+        copy3f(white, ramp_color.data() + 3 * i);
+    }
+    next_ramp_color = ramp_color.data();
+  }
+
   for (auto it = I->begin(); ok && !it.is_stop(); ++it) {
     const auto pc = it.data();
     const auto op = it.op_code();
@@ -5903,9 +5983,8 @@ int CGORenderRay(CGO* I, CRay* ray, RenderInfo* info, const float* color,
       v0 = pc;
 
       if (ramp) {
-        if (!ObjectGadgetRampInterVertex(ramp, v0, rampc0, -1)) {
-          copy3f(white, rampc0);
-        }
+        copy3f(next_ramp_color, rampc0);
+        next_ramp_color += 3;
         c0 = rampc0;
       }
       switch (mode) {
@@ -6972,7 +7051,8 @@ bool CGO::append(const CGO& source_, bool stopAtEnd)
 
 /**
  * Appends `src` to the end of this CGO. Takes ownership of data
- * (incl. VBOs) and leaves `src` as a valid but empty CGO.
+ * (incl. VBOs) and leaves `src` as a valid but empty CGO. If this CGO is
+ * empty, the op buffers are swapped instead of copied.
  */
 void CGO::move_append(CGO&& src_)
 {
@@ -6980,9 +7060,13 @@ void CGO::move_append(CGO&& src_)
   if (!src->c)
     return;
 
-  // copy buffer
-  VLACheck(op, float, c + src->c);
-  memcpy(op + c, src->op, src->c * sizeof(float));
+  if (!c) {
+    std::swap(op, src->op);
+  } else {
+    // copy buffer
+    VLACheck(op, float, c + src->c);
+    memcpy(op + c, src->op, src->c * sizeof(float));
+  }
 
   // update sizes
   c += src->c;
@@ -6992,11 +7076,14 @@ void CGO::move_append(CGO&& src_)
   *(op + c) = 0;
   *(src->op) = 0;
 
-  // move heap data
+  // move heap data (blocks don't move in memory, so our current block
+  // stays valid)
   for (auto& ref : src->_data_heap) {
     _data_heap.emplace_back(std::move(ref));
   }
   src->_data_heap.clear();
+  src->_data_heap_next = nullptr;
+  src->_data_heap_free = 0;
 
   // copy boolean flags
   has_draw_buffers |= src->has_draw_buffers;
@@ -7623,6 +7710,36 @@ CGO* CGOColorByRamp(PyMOLGlobals* G, const CGO* I, ObjectGadgetRamp* ramp,
   int ramp_above =
       SettingGet_i(G, set1, nullptr, cSetting_surface_ramp_above_mode) == 1;
 
+  // ramp positions of all vertices, looked up in one batch
+  std::vector<float> ramp_pos;
+  for (auto it = I->begin(); !it.is_stop(); ++it) {
+    const auto pc = it.data();
+    switch (it.op_code()) {
+    case CGO_NORMAL:
+      copy3f(pc, n0);
+      break;
+    case CGO_VERTEX:
+      if (ramp_above) {
+        copy3f(n0, v_above);
+        scale3f(v_above, probe_radius, v_above);
+        add3f(pc, v_above, v_above);
+      } else {
+        copy3f(pc, v_above);
+      }
+      ramp_pos.insert(ramp_pos.end(), v_above, v_above + 3);
+      break;
+    }
+  }
+
+  const int n_ramp = ramp_pos.size() / 3;
+  std::vector<float> ramp_color(ramp_pos.size());
+  if (!ObjectGadgetRampInterVertices(
+          ramp, ramp_pos.data(), ramp_color.data(), n_ramp, state)) {
+    for (int i = 0; i < n_ramp; ++i)
+      copy3f(white, ramp_color.data() + 3 * i);
+  }
+  const float* next_color = ramp_color.data();
+
   for (auto it = I->begin(); ok && !it.is_stop(); ++it) {
     const auto op = it.op_code();
     const auto pc = it.data();
@@ -7639,25 +7756,10 @@ CGO* CGOColorByRamp(PyMOLGlobals* G, const CGO* I, ObjectGadgetRamp* ramp,
         memcpy(vals, sp->floatdata, nvals);
       skipCopy = true;
     } break;
-    case CGO_NORMAL:
-      copy3f(pc, n0);
+    case CGO_VERTEX:
+      CGOColorv(cgo, next_color);
+      next_color += 3;
       break;
-    case CGO_VERTEX: {
-      float color[3];
-      copy3f(white, color);
-      if (ramp_above) {
-        copy3f(n0, v_above);
-        scale3f(v_above, probe_radius, v_above);
-        add3f(pc, v_above, v_above);
-      } else {
-        copy3f(pc, v_above);
-      }
-      if (ObjectGadgetRampInterVertex(ramp, v_above, color, state)) {
-        CGOColorv(cgo, color);
-      } else {
-        CGOColorv(cgo, white);
-      }
-    } break;
     }
     if (!skipCopy) {
       cgo->add_to_cgo(op, pc);
@@ -9054,6 +9156,7 @@ CGO* CGOConvertToShader(const CGO* I, AttribDataDesc& attrData,
     bool check_attr_for_data, int* idx_array, int nvertsperfrag,
     int nfragspergroup)
 {
+  PYMOL_PROFILE_SCOPE(I->G, "CGO", "CGOConvertToShader");
   CGO* cgo;
   int ok = true;
   bool isInterleaved = (layout == VertexBufferLayout::Interleaved);
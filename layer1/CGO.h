@@ -882,11 +882,30 @@ public:
   void free_append(CGO * &&source);
   void free_append(CGO * &source);
 
-  // Allocates in our CGO data pool
+  // Allocates in our CGO data pool. Small allocations are carved out of
+  // shared blocks, large ones get a block of their own. The first block is
+  // small and later blocks grow geometrically, so CGOs with little data
+  // don't pay for a large block.
   float * allocate_in_data_heap(size_t size) {
-    std::unique_ptr<float[]> uni(new float[size]);
-    float * ptr = uni.get();
-    _data_heap.emplace_back(std::move(uni));
+    if (size > _data_heap_free) {
+      if (size > DATA_HEAP_MAX_BLOCK_SIZE / 4) {
+        std::unique_ptr<float[]> uni(new float[size]);
+        float * ptr = uni.get();
+        _data_heap.emplace_back(std::move(uni));
+        return ptr;
+      }
+      size_t block_size = _data_heap_block_size;
+      if (block_size < size)
+        block_size = size;
+      _data_heap.emplace_back(new float[block_size]);
+      _data_heap_next = _data_heap.back().get();
+      _data_heap_free = block_size;
+      if (_data_heap_block_size < DATA_HEAP_MAX_BLOCK_SIZE)
+        _data_heap_block_size *= 2;
+    }
+    float * ptr = _data_heap_next;
+    _data_heap_next += size;
+    _data_heap_free -= size;
     return ptr;
   }
 
@@ -937,7 +956,12 @@ public:
   void print_table() const;
 
 private:
+  static constexpr size_t DATA_HEAP_MIN_BLOCK_SIZE = 256;
+  static constexpr size_t DATA_HEAP_MAX_BLOCK_SIZE = 64 * 1024;
   std::vector<std::unique_ptr<float[]>> _data_heap;
+  float * _data_heap_next = nullptr; //!< unused tail of the current block
+  size_t _data_heap_free = 0;
+  size_t _data_heap_block_size = DATA_HEAP_MIN_BLOCK_SIZE; //!< next block
 };
 
 #define CGONew new CGO
@@ -1045,6 +1069,20 @@ int CGOWriteLeft(CGO * I, const char *str);
 int CGOWriteIndent(CGO * I, const char *str, float indent);
 
 #define CGODrawArrays(this, ...) (this)->add<cgo::draw::arrays>(__VA_ARGS__)
+
+/**
+ * Pointers into the data of a CGO_DRAW_ARRAYS op, nullptr for arrays which
+ * are not present. Colors are RGBA, pick colors are (index, bond) pairs.
+ */
+struct CGODrawArraysData {
+  float* vertex = nullptr;
+  float* normal = nullptr;
+  float* color = nullptr;
+  float* pick_color = nullptr;
+  float* accessibility = nullptr;
+};
+
+CGODrawArraysData CGODrawArraysGetData(float* data, int arrays, int nverts);
 #define CGOCustomCylinderv(this, ...) (this)->add<cgo::draw::custom_cylinder>(__VA_ARGS__)
 #define CGOShaderCylinder(this, ...) (this)->add<cgo::draw::shadercylinder>(__VA_ARGS__)
 #define CGOCylinderv(this, ...) (this)->add<cgo::draw::cylinder>(__VA_ARGS__)
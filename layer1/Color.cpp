@@ -32,6 +32,10 @@ Z* -------------------------------------------------------------------
 #include"Scene.h"
 #include "Feedback.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 static int AutoColor[] = {
   26,                           /* carbon */
   5,                            /* cyan */
@@ -203,6 +207,66 @@ int ColorGetRamped(PyMOLGlobals * G, int index, const float *vertex, float *colo
   return (ok);
 }
 
+/**
+ * ColorGetRamped for `n` vertices which use the same ramp, with one batched
+ * ramp lookup.
+ * @param vertex Vertex coordinates (3 * n)
+ * @param[out] color RGB colors (3 * n), white if the ramp is missing
+ */
+int ColorGetRampedVertices(PyMOLGlobals * G, int index, const float *vertex,
+                           float *color, int n, int state)
+{
+  CColor *I = G->Color;
+  int ok = false;
+  if (auto* ptr = ColorGetRamp(G, index)) {
+    ok = ObjectGadgetRampInterVertices(ptr, vertex, color, n, state);
+  }
+  for (int i = 0; i < n; ++i, color += 3) {
+    if(!ok) {
+      color[0] = 1.0;
+      color[1] = 1.0;
+      color[2] = 1.0;
+    } else if(I->LUTActive) {
+      lookup_color(I, color, color, I->BigEndian);
+    }
+  }
+  return (ok);
+}
+
+/**
+ * Evaluate all collected lookups, grouped by ramp, with one batched lookup
+ * per ramp
+ */
+void ColorRampedBatch::apply(PyMOLGlobals * G, int state)
+{
+  const int n = index.size();
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+      [this](int a, int b) { return index[a] < index[b]; });
+
+  std::vector<float> pos, col;
+  for (int begin = 0, end = 0; begin < n; begin = end) {
+    while (end < n && index[order[end]] == index[order[begin]])
+      ++end;
+
+    pos.resize(3 * (end - begin));
+    col.resize(pos.size());
+    for (int i = begin; i < end; ++i)
+      copy3f(vertex.data() + 3 * order[i], pos.data() + 3 * (i - begin));
+
+    ColorGetRampedVertices(G, index[order[begin]], pos.data(), col.data(),
+        end - begin, state);
+
+    for (int i = begin; i < end; ++i)
+      copy3f(col.data() + 3 * (i - begin), color[order[i]]);
+  }
+
+  index.clear();
+  vertex.clear();
+  color.clear();
+}
+
 /**
  * Gets a color as 3 floats from an index and writes it into
  * the color argument.  If the index is a ramp, then it uses the vertex and state arguments to lookup the
@@ -1786,16 +1850,19 @@ void ColorUpdateFrontFromSettings(PyMOLGlobals * G){
 
 
 /*========================================================================*/
+/* storage for returning (float*) of computed colors, per thread since colors
+ * are looked up from parallel rep generation */
+static thread_local float s_RGBColor[3];
+
 const float *ColorGetSpecial(PyMOLGlobals * G, int index)
 {
   if(index >= 0)
     return ColorGet(G, index);
   else {
-    CColor *I = G->Color;
-    I->RGBColor[0] = (float) index;
-    I->RGBColor[1] = -1.0F;
-    I->RGBColor[2] = -1.0F;
-    return I->RGBColor;
+    s_RGBColor[0] = (float) index;
+    s_RGBColor[1] = -1.0F;
+    s_RGBColor[2] = -1.0F;
+    return s_RGBColor;
   }
 }
 
@@ -1810,12 +1877,12 @@ const float *ColorGet(PyMOLGlobals * G, int index)
       ptr = I->Color[index].Color;
     return (ptr);
   } else if((index & cColor_TRGB_Mask) == cColor_TRGB_Bits) {   /* a 24-bit RGB color */
-    I->RGBColor[0] = ((index & 0x00FF0000) >> 16) / 255.0F;
-    I->RGBColor[1] = ((index & 0x0000FF00) >> 8) / 255.0F;
-    I->RGBColor[2] = ((index & 0x000000FF)) / 255.0F;
+    s_RGBColor[0] = ((index & 0x00FF0000) >> 16) / 255.0F;
+    s_RGBColor[1] = ((index & 0x0000FF00) >> 8) / 255.0F;
+    s_RGBColor[2] = ((index & 0x000000FF)) / 255.0F;
     if(I->LUTActive)
-      lookup_color(I, I->RGBColor, I->RGBColor, I->BigEndian);
-    return I->RGBColor;
+      lookup_color(I, s_RGBColor, s_RGBColor, I->BigEndian);
+    return s_RGBColor;
   } else if(index == cColorFront) {
     return I->Front;
   } else if(index == cColorBack) {
@@ -1834,10 +1901,10 @@ const float *ColorGetRaw(PyMOLGlobals * G, int index)
     ptr = I->Color[index].Color;
     return (ptr);
   } else if((index & cColor_TRGB_Mask) == cColor_TRGB_Bits) {   /* a 24-bit RGB color */
-    I->RGBColor[0] = ((index & 0x00FF0000) >> 16) / 255.0F;
-    I->RGBColor[1] = ((index & 0x0000FF00) >> 8) / 255.0F;
-    I->RGBColor[2] = ((index & 0x000000FF)) / 255.0F;
-    return I->RGBColor;
+    s_RGBColor[0] = ((index & 0x00FF0000) >> 16) / 255.0F;
+    s_RGBColor[1] = ((index & 0x0000FF00) >> 8) / 255.0F;
+    s_RGBColor[2] = ((index & 0x000000FF)) / 255.0F;
+    return s_RGBColor;
   } else {
     /* invalid color id, then simply return white */
     return (I->Color[0].Color);
@@ -19,6 +19,7 @@ Z* -------------------------------------------------------------------
 
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include "pymol/zstring_view.h"
 
@@ -83,7 +84,6 @@ struct CColor {
   float Gamma = 1.0f;
   int BigEndian{};
   std::unordered_map<std::string, ColorIdx> Idx;
-  float RGBColor[3]{};            /* save global float for returning (float*) */
   char RGBName[11]{}; // "0xTTRRGGBB"
   /* not stored */
   bool HaveOldSessionColors = false;
@@ -114,6 +114,32 @@ int ColorGetStatus(PyMOLGlobals * G, int index);
 void ColorReset(PyMOLGlobals * G);
 
 int ColorGetRamped(PyMOLGlobals * G, int index, const float *vertex, float *color, int state);
+int ColorGetRampedVertices(PyMOLGlobals * G, int index, const float *vertex,
+                           float *color, int n, int state);
+
+/**
+ * Collects ColorGetRamped lookups of a vertex loop, for batched evaluation
+ * after the loop. Vertices may use different ramps.
+ */
+struct ColorRampedBatch {
+  std::vector<int> index;
+  std::vector<float> vertex;
+  std::vector<float*> color;
+
+  /**
+   * @param[out] dest RGB color, written by apply()
+   */
+  void add(int ramp_index, const float* v, float* dest)
+  {
+    index.push_back(ramp_index);
+    vertex.insert(vertex.end(), v, v + 3);
+    color.push_back(dest);
+  }
+
+  bool empty() const { return index.empty(); }
+
+  void apply(PyMOLGlobals * G, int state);
+};
 int ColorCheckRamped(PyMOLGlobals * G, int index);
 bool ColorGetCheckRamped(PyMOLGlobals * G, int index, const float *vertex, float *color, int state);
 
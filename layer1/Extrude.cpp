@@ -521,7 +521,12 @@ void ExtrudeBuildNormals2f(CExtrude * I)
   if(I->N) {
     v = I->n;
     for(a = 0; a < I->N; a++) {
-      get_system2f3f(v, v + 3, v + 6);
+      // get_system2f3f, inlined
+      cross_product3f(v, v + 3, v + 6);
+      normalize3f(v + 6);
+      cross_product3f(v + 6, v, v + 3);
+      normalize3f(v + 3);
+      normalize3f(v);
       v += 9;
     }
   }
@@ -810,6 +815,107 @@ void ExtrudeCGOTraceFrame(CExtrude * I, CGO * cgo)
 }
 #endif
 
+/**
+ * Same as transform33Tf3f, but inlined for the per-point kernels below
+ */
+static inline void ExtrudeFrameTransform(
+    const float* m, const float* v, float* out)
+{
+  float const v0 = v[0], v1 = v[1], v2 = v[2];
+  out[0] = m[0] * v0 + m[3] * v1 + m[6] * v2;
+  out[1] = m[1] * v0 + m[4] * v1 + m[7] * v2;
+  out[2] = m[2] * v0 + m[5] * v1 + m[8] * v2;
+}
+
+/**
+ * Transform all shape vertices and normals into the frames of all points.
+ * Ring `b` (N points each) starts at TV + 3 * N * b, ring Ns repeats ring 0
+ * to close the surface.
+ *
+ * TV, TN: output arrays of size 3 * N * (Ns + 1)
+ */
+static void ExtrudeTransformRings(const CExtrude* I, float* TV, float* TN)
+{
+  int const N = I->N;
+  const float* const p = I->p;
+  const float* const n = I->n;
+
+  for (int b = 0; b < I->Ns; ++b) {
+    const float* const sv = I->sv + 3 * b;
+    const float* const sn = I->sn + 3 * b;
+    float* const tv = TV + 3 * N * b;
+    float* const tn = TN + 3 * N * b;
+
+#ifdef PYMOL_OPENMP
+#pragma omp simd
+#endif
+    for (int a = 0; a < N; ++a) {
+      ExtrudeFrameTransform(n + 9 * a, sv, tv + 3 * a);
+      tv[3 * a + 0] += p[3 * a + 0];
+      tv[3 * a + 1] += p[3 * a + 1];
+      tv[3 * a + 2] += p[3 * a + 2];
+      ExtrudeFrameTransform(n + 9 * a, sn, tn + 3 * a);
+    }
+  }
+
+  std::copy_n(TV, 3 * N, TV + 3 * N * I->Ns);
+  std::copy_n(TN, 3 * N, TN + 3 * N * I->Ns);
+}
+
+/**
+ * Add the surface strip between two rings as one CGO_DRAW_ARRAYS op with
+ * vertex, normal, color and pick color arrays. This is what
+ * CGOCombineBeginEnd makes of the equivalent BEGIN/END block, without
+ * emitting and parsing one op per vertex.
+ *
+ * tv, tn: first ring
+ * tv1, tn1: second ring
+ * a_begin, a_end: range of points
+ * color: RGB color or nullptr to use color from `I`
+ */
+static int ExtrudeStripToCGO(const CExtrude* I, CGO* cgo, const float* tv,
+    const float* tn, const float* tv1, const float* tn1, int a_begin,
+    int a_end, const float* color)
+{
+  int const nverts = 2 * (a_end - a_begin);
+  if (nverts <= 0)
+    return true;
+
+  int const mode = (SettingGetGlobal_i(I->G, cSetting_cartoon_debug) < 1.5)
+                       ? GL_TRIANGLE_STRIP
+                       : GL_LINE_STRIP;
+  int const arrays = CGO_VERTEX_ARRAY | CGO_NORMAL_ARRAY | CGO_COLOR_ARRAY |
+                     CGO_PICK_COLOR_ARRAY;
+
+  float* const data = CGODrawArrays(cgo, mode, arrays, nverts);
+  if (!data)
+    return false;
+
+  auto const ptrs = CGODrawArraysGetData(data, arrays, nverts);
+
+  for (int a = a_begin, k = 0; a < a_end; ++a, k += 2) {
+    const float* const rgb = color ? color : (I->c + 3 * a);
+
+    copy3f(tv + 3 * a, ptrs.vertex + 3 * k);
+    copy3f(tv1 + 3 * a, ptrs.vertex + 3 * (k + 1));
+    copy3f(tn + 3 * a, ptrs.normal + 3 * k);
+    copy3f(tn1 + 3 * a, ptrs.normal + 3 * (k + 1));
+
+    for (int j = k; j != k + 2; ++j) {
+      copy3f(rgb, ptrs.color + 4 * j);
+      ptrs.color[4 * j + 3] = I->alpha[a];
+      CGO_put_uint(ptrs.pick_color + 2 * j, I->i[a]);
+      CGO_put_int(ptrs.pick_color + 2 * j + 1, cPickableAtom);
+    }
+  }
+
+  // same state as after the per-vertex CGOPickColor calls
+  cgo->current_pick_color_index = I->i[a_end - 1];
+  cgo->current_pick_color_bond = cPickableAtom;
+
+  return true;
+}
+
 /**
  * Draw flat cap on a tube cartoon (loop, oval, etc.)
  *
@@ -866,13 +972,10 @@ void TubeCapFlat(const CExtrude * I, CGO * cgo, int index, bool inv_dir, const f
 int ExtrudeCGOSurfaceTube(const CExtrude* I, CGO* cgo, cCylCap cap,
     const float* color_override, bool use_spheres, int dash)
 {
-  int a, b;
-  unsigned int *i;
+  int b;
   float *v;
   float *n;
-  float *c;
-  const float *alpha;
-  float *sv, *sn, *tv, *tn, *tv1, *tn1, *TV = nullptr, *TN = nullptr;
+  float *sv, *tv, *tn, *TV = nullptr, *TN = nullptr;
   int start, stop;
   int ok = true;
   PRINTFD(I->G, FB_Extrude)
@@ -887,32 +990,8 @@ int ExtrudeCGOSurfaceTube(const CExtrude* I, CGO* cgo, cCylCap cap,
     /* compute transformed shape vertices */
 
     if (ok){
-      tn = TN;
-      tv = TV;
-      
-      sv = I->sv;
-      sn = I->sn;
-      for(b = 0; b <= I->Ns; b++) {
-	if(b == I->Ns) {
-	  sv = I->sv;
-	  sn = I->sn;
-	}
-	v = I->p;
-	n = I->n;
-	
-	for(a = 0; a < I->N; a++) {
-	  transform33Tf3f(n, sv, tv);
-	  add3f(v, tv, tv);
-	  tv += 3;
-	  transform33Tf3f(n, sn, tn);
-	  tn += 3;
-	  n += 9;
-	  v += 3;
-	}
-	sv += 3;
-	sn += 3;
-      }
-      
+      ExtrudeTransformRings(I, TV, TN);
+
       start = I->Ns / 4;
       stop = 3 * I->Ns / 4;
     }
@@ -926,54 +1005,15 @@ int ExtrudeCGOSurfaceTube(const CExtrude* I, CGO* cgo, cCylCap cap,
       if (a_end > I->N)
         a_end = I->N;
 
-      // second loop: circumferential, setting up axial triangle strips
+      // second loop: circumferential, axial triangle strips
       for(b = 0; ok && b < I->Ns; b++) {
-	if(SettingGetGlobal_i(I->G, cSetting_cartoon_debug) < 1.5)
-	  ok &= CGOBegin(cgo, GL_TRIANGLE_STRIP);
-	else {
-	  ok &= CGOBegin(cgo, GL_LINE_STRIP);
-	}
-	if (ok){
-          c = I->c + a_start * 3;
-          alpha = I->alpha + a_start;
-          i = I->i + a_start;
-
-          tv = TV + 3 * (a_start + b * I->N);
-          tn = TN + 3 * (a_start + b * I->N);
-
-          tv1 = tv + 3 * I->N;
-          tn1 = tn + 3 * I->N;
-
-          // third loop: axial, segments within one "dash"
-          for(a = a_start; ok && a < a_end; ++a) {
-	    if(color_override && (b > start) && (b < stop))
-	      ok &= CGOColorv(cgo, color_override);
-	    else
-	      ok &= CGOColorv(cgo, c);
-        if (ok){
-          ok &= CGOAlpha(cgo, *alpha);
-        }
-	    if (ok)
-	      ok &= CGOPickColor(cgo, *i, cPickableAtom);
-	    if (ok)
-	      ok &= CGONormalv(cgo, tn);
-	    if (ok)
-	      ok &= CGOVertexv(cgo, tv);
-	    tn += 3;
-	    tv += 3;
-	    if (ok)
-	      ok &= CGONormalv(cgo, tn1);
-	    if (ok)
-	      ok &= CGOVertexv(cgo, tv1);
-	    tn1 += 3;
-	    tv1 += 3;
-	    c += 3;
-        alpha++;
-	    i++;
-	  }
-	}
-	if (ok)
-	  ok &= CGOEnd(cgo);
+        tv = TV + 3 * b * I->N;
+        tn = TN + 3 * b * I->N;
+
+        ok &= ExtrudeStripToCGO(I, cgo, tv, tn, tv + 3 * I->N, tn + 3 * I->N,
+            a_start, a_end,
+            (color_override && (b > start) && (b < stop)) ? color_override
+                                                          : nullptr);
 	if (ok)
 	  ok &= CGOPickColor(cgo, -1, cPickableNoPick);
       }
@@ -1507,13 +1547,10 @@ int ExtrudeCGOSurfaceVariableTube(const CExtrude* I, CGO* cgo, cCylCap cap)
 
 int ExtrudeCGOSurfacePolygon(const CExtrude * I, CGO * cgo, cCylCap cap, const float *color_override)
 {
-  int a, b;
-  unsigned int *i;
+  int b;
   float *v;
   float *n;
-  float *c;
-  const float *alpha;
-  float *sv, *sn, *tv, *tn, *tv1, *tn1, *TV = nullptr, *TN = nullptr;
+  float *sv, *tv, *tn, *TV = nullptr, *TN = nullptr;
   float v0[3];
   int ok = true;
 
@@ -1530,81 +1567,16 @@ int ExtrudeCGOSurfacePolygon(const CExtrude * I, CGO * cgo, cCylCap cap, const f
     /* compute transformed shape vertices */
 
     if (ok){
-      tn = TN;
-      tv = TV;
-      
-      sv = I->sv;
-      sn = I->sn;
-      for(b = 0; b <= I->Ns; b++) {
-	if(b == I->Ns) {
-	  sv = I->sv;
-	  sn = I->sn;
-	}
-	v = I->p;
-	n = I->n;
-	
-	for(a = 0; a < I->N; a++) {
-	  transform33Tf3f(n, sv, tv);
-	  add3f(v, tv, tv);
-	  tv += 3;
-	  transform33Tf3f(n, sn, tn);
-	  tn += 3;
-	  n += 9;
-	  v += 3;
-	}
-	sv += 3;
-	sn += 3;
-      }
-      
-      /* fill in each strip separately */
-      
-      tv = TV;
-      tn = TN;
-      
-      tv1 = TV + 3 * I->N;
-      tn1 = TN + 3 * I->N;
+      ExtrudeTransformRings(I, TV, TN);
     }
+
+    /* fill in each strip separately */
     for(b = 0; ok && b < I->Ns; b += 2) {
-      if(SettingGetGlobal_i(I->G, cSetting_cartoon_debug) < 1.5)
-        ok &= CGOBegin(cgo, GL_TRIANGLE_STRIP);
-      else {
-        ok &= CGOBegin(cgo, GL_LINE_STRIP);
-      }
-      if(ok && color_override)
-        ok &= CGOColorv(cgo, color_override);
-      c = I->c;
-      alpha = I->alpha;
-      i = I->i;
-      for(a = 0; ok && a < I->N; a++) {
-        if(!color_override)
-          ok &= CGOColorv(cgo, c);
-        if (ok){
-          ok &= CGOAlpha(cgo, *alpha);
-        }
-        if (ok)
-	  ok &= CGOPickColor(cgo, *i, cPickableAtom);
-	if (ok)
-	  ok &= CGONormalv(cgo, tn);
-	if (ok)
-	  ok &= CGOVertexv(cgo, tv);
-        tn += 3;
-        tv += 3;
-	if (ok)
-	  ok &= CGONormalv(cgo, tn1);
-	if (ok)
-	  ok &= CGOVertexv(cgo, tv1);
-        tn1 += 3;
-        tv1 += 3;
-        c += 3;
-        alpha++;
-        i++;
-      }
-      tv += 3 * I->N;
-      tn += 3 * I->N;
-      tv1 += 3 * I->N;
-      tn1 += 3 * I->N;
-      if (ok)
-	ok &= CGOEnd(cgo);
+      tv = TV + 3 * b * I->N;
+      tn = TN + 3 * b * I->N;
+
+      ok &= ExtrudeStripToCGO(I, cgo, tv, tn, tv + 3 * I->N, tn + 3 * I->N,
+          0, I->N, color_override);
       if (ok)
 	ok &= CGOPickColor(cgo, -1, cPickableNoPick);
     }
@@ -1846,12 +1818,9 @@ int ExtrudeCGOSurfacePolygonTaper(const CExtrude * I, CGO * cgo, int sampling,
 int ExtrudeCGOSurfaceStrand(const CExtrude * I, CGO * cgo, int sampling, const float *color_override)
 {
   int a, b;
-  unsigned int *i;
   float *v;
   float *n;
-  float *c;
-  const float *alpha;
-  float *sv, *sn, *tv, *tn, *tv1, *tn1, *TV = nullptr, *TN = nullptr;
+  float *sv, *sn, *tv, *tn, *TV = nullptr, *TN = nullptr;
   float v0[3], n0[3], s0[3], z[3] = { 1.0, 0.0, 1.0 };
   int subN;
   int ok = true;
@@ -1870,87 +1839,20 @@ int ExtrudeCGOSurfaceStrand(const CExtrude * I, CGO * cgo, int sampling, const f
     /* compute transformed shape vertices */
 
     if (ok){
-      tn = TN;
-      tv = TV;
-      sv = I->sv;
-      sn = I->sn;
-      for(b = 0; b <= I->Ns; b++) {
-	if(b == I->Ns) {
-	  sv = I->sv;
-	  sn = I->sn;
-	}
-	v = I->p;
-	n = I->n;
-	for(a = 0; a < I->N; a++) {
-	  copy3f(sv, s0);
-	  if(a == subN) {
-	    scale3f(s0, 0.50F, s0);
-	  }
-	  transform33Tf3f(n, s0, tv);
-	  add3f(v, tv, tv);
-	  tv += 3;
-	  transform33Tf3f(n, sn, tn);
-	  tn += 3;
-	  n += 9;
-	  v += 3;
-	}
-	sv += 3;
-	sn += 3;
-      }
-
-      /* fill in each strip of arrow separately */
-      
-      tv = TV;
-      tn = TN;
-      
-      tv1 = TV + 3 * I->N;
-      tn1 = TN + 3 * I->N;
+      // (the arrow head part, a >= subN, is transformed below)
+      ExtrudeTransformRings(I, TV, TN);
     }
 
+    /* fill in each strip of arrow separately */
     for(b = 0; ok && b < I->Ns; b += 2) {
-      if(SettingGetGlobal_i(I->G, cSetting_cartoon_debug) < 1.5)
-        ok &= CGOBegin(cgo, GL_TRIANGLE_STRIP);
-      else {
-        ok &= CGOBegin(cgo, GL_LINE_STRIP);
-      }
-      c = I->c;
-      alpha = I->alpha;
-      i = I->i;
-      for(a = 0; ok && a < I->N; a++) {
-        if(a < subN) {
-	  if(color_override && ((b == 2) || (b == 3) || (b == 6) || (b == 7)))
-	    ok &= CGOColorv(cgo, color_override);
-	  else
-	    ok &= CGOColorv(cgo, c);
-      if (ok){
-        ok &= CGOAlpha(cgo, *alpha);
-      }
-	  if (ok)
-	    ok &= CGOPickColor(cgo, *i, cPickableAtom);
-	  if (ok)
-	    ok &= CGONormalv(cgo, tn);
-	  if (ok)
-	    ok &= CGOVertexv(cgo, tv);
-        }
-        tn += 3;
-        tv += 3;
-        if(ok && a < subN) {
-          ok &= CGONormalv(cgo, tn1);
-	  if (ok)
-	    ok &= CGOVertexv(cgo, tv1);
-        }
-        tn1 += 3;
-        tv1 += 3;
-        c += 3;
-        alpha++;
-        i++;
-      }
-      tv += 3 * I->N;
-      tn += 3 * I->N;
-      tv1 += 3 * I->N;
-      tn1 += 3 * I->N;
-      if (ok)
-	ok &= CGOEnd(cgo);
+      tv = TV + 3 * b * I->N;
+      tn = TN + 3 * b * I->N;
+
+      ok &= ExtrudeStripToCGO(I, cgo, tv, tn, tv + 3 * I->N, tn + 3 * I->N,
+          0, std::min(subN, I->N),
+          (color_override && ((b == 2) || (b == 3) || (b == 6) || (b == 7)))
+              ? color_override
+              : nullptr);
       if (ok)
 	ok &= CGOPickColor(cgo, -1, cPickableNoPick);
     }
@@ -2014,18 +1916,18 @@ int ExtrudeCGOSurfaceStrand(const CExtrude * I, CGO * cgo, int sampling, const f
 	v = I->p;
 	n = I->n;
 	
+	copy3f(sn, n0);
+	if(fabs(dot_product3f(sn, z)) > R_SMALL4) {
+	  n0[0] += 0.4F;
+	  normalize3f(n0);
+	}
 	for(a = 0; a < I->N; a++) {
 	  copy3f(sv, s0);
 	  s0[2] = s0[2] * ((1.5F * ((I->N - 1) - a)) / sampling);
-	  transform33Tf3f(n, s0, tv);
+	  ExtrudeFrameTransform(n, s0, tv);
 	  add3f(v, tv, tv);
 	  tv += 3;
-	  copy3f(sn, n0);
-	  if(fabs(dot_product3f(sn, z)) > R_SMALL4) {
-	    n0[0] += 0.4F;
-	    normalize3f(n0);
-	  }
-	  transform33Tf3f(n, n0, tn);
+	  ExtrudeFrameTransform(n, n0, tn);
 	  tn += 3;
 	  n += 9;
 	  v += 3;
@@ -2035,58 +1937,15 @@ int ExtrudeCGOSurfaceStrand(const CExtrude * I, CGO * cgo, int sampling, const f
       }
     }
 
-    tv = TV;
-    tn = TN;
-
-    tv1 = TV + 3 * I->N;
-    tn1 = TN + 3 * I->N;
-
     for(b = 0; ok && b < I->Ns; b += 2) {
-      if (ok){
-	if(SettingGetGlobal_i(I->G, cSetting_cartoon_debug) < 1.5)
-	  ok &= CGOBegin(cgo, GL_TRIANGLE_STRIP);
-	else {
-	  ok &= CGOBegin(cgo, GL_LINE_STRIP);
-	}
-      }
-      c = I->c;
-      alpha = I->alpha;
-      i = I->i;
-      for(a = 0; ok && a < I->N; a++) {
-        if(a >= (subN - 1)) {
-          if(color_override && ((b == 2) || (b == 3) || (b == 6) || (b == 7)))
-            ok &= CGOColorv(cgo, color_override);
-          else
-            ok &= CGOColorv(cgo, c);
-        if (ok){
-          ok &= CGOAlpha(cgo, *alpha);
-        }
-	  if (ok)
-	    ok &= CGOPickColor(cgo, *i, cPickableAtom);
-          if (ok)
-	    ok &= CGONormalv(cgo, tn);
-	  if (ok)
-	    ok &= CGOVertexv(cgo, tv);
-        }
-        tn += 3;
-        tv += 3;
-        if(ok && a >= (subN - 1)) {
-          ok &= CGONormalv(cgo, tn1);
-	  if (ok)
-	    ok &= CGOVertexv(cgo, tv1);
-        }
-        tn1 += 3;
-        tv1 += 3;
-        c += 3;
-        alpha++;
-        i++;
-      }
-      tv += 3 * I->N;
-      tn += 3 * I->N;
-      tv1 += 3 * I->N;
-      tn1 += 3 * I->N;
-      if (ok)
-	ok &= CGOEnd(cgo);
+      tv = TV + 3 * b * I->N;
+      tn = TN + 3 * b * I->N;
+
+      ok &= ExtrudeStripToCGO(I, cgo, tv, tn, tv + 3 * I->N, tn + 3 * I->N,
+          std::max(subN - 1, 0), I->N,
+          (color_override && ((b == 2) || (b == 3) || (b == 6) || (b == 7)))
+              ? color_override
+              : nullptr);
       if (ok)
 	ok &= CGOPickColor(cgo, -1, cPickableNoPick);
     }
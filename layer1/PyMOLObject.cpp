@@ -41,6 +41,8 @@ Z* -------------------------------------------------------------------
 #include"vla.h"
 #include"pymol/type_traits.h"
 
+#include <atomic>
+
 void ObjectPurgeSettings(pymol::CObject * I)
 {
   I->Setting.reset();
@@ -600,14 +602,17 @@ void ObjectMakeValidName(PyMOLGlobals * G, char *name, bool quiet)
     return;
   }
 
-  static bool once_protein = false;
-  static bool once_nucleic = false;
+  static std::atomic<bool> once_protein{false};
+  static std::atomic<bool> once_nucleic{false};
 
-  if (!once_protein && strcmp(name, "protein") == 0) {
-    once_protein = true;
-  } else if (!once_nucleic && strcmp(name, "nucleic") == 0) {
-    once_nucleic = true;
-  } else {
+  std::atomic<bool>* once = nullptr;
+  if (strcmp(name, "protein") == 0) {
+    once = &once_protein;
+  } else if (strcmp(name, "nucleic") == 0) {
+    once = &once_nucleic;
+  }
+
+  if (!once || once->exchange(true)) {
     return;
   }
 
@@ -1319,12 +1324,20 @@ void ObjectStateTransformMatrix(CObjectState * I, const double *matrix)
 
 int ObjectStatePushAndApplyMatrix(CObjectState * I, RenderInfo * info)
 {
-  PyMOLGlobals *G = I->G;
-  float matrix[16];
-  const double *i_matrix = nullptr;
-  if(!I->Matrix.empty()) {
-    i_matrix = I->Matrix.data();
+  if (I->Matrix.empty()) {
+    return false;
   }
+  return ObjectPushAndApplyMatrix(I->G, info, I->Matrix.data());
+}
+
+/**
+ * Push the current model view (or ray TTT) matrix and right-multiply it
+ * with `i_matrix` (row-major 4x4). Pop with ObjectStatePopMatrix.
+ * @return false if nothing was pushed
+ */
+int ObjectPushAndApplyMatrix(PyMOLGlobals* G, RenderInfo* info, const double* i_matrix)
+{
+  float matrix[16];
   int result = false;
   if(i_matrix) {
     if(info->ray) {
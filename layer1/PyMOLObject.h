@@ -179,6 +179,7 @@ void ObjectStateResetMatrix(CObjectState * I);
 PyObject *ObjectStateAsPyList(CObjectState * I);
 int ObjectStateFromPyList(PyMOLGlobals * G, PyObject * list, CObjectState * I);
 int ObjectStatePushAndApplyMatrix(CObjectState * I, RenderInfo * info);
+int ObjectPushAndApplyMatrix(PyMOLGlobals* G, RenderInfo* info, const double* matrix);
 void ObjectStatePopMatrix(CObjectState * I, RenderInfo * info);
 void ObjectStateRightCombineMatrixR44d(CObjectState * I, const double *matrix);
 void ObjectStateLeftCombineMatrixR44d(CObjectState * I, const double *matrix);
@@ -39,6 +39,7 @@ Z* -------------------------------------------------------------------
 #include"MyPNG.h"
 #include"CGO.h"
 #include "Feedback.h"
+#include "Profiler.h"
 
 #define SettingGetfv SettingGetGlobal_3fv
 
@@ -560,6 +561,7 @@ static void RayReflectAndTexture(CRay * I, RayInfo * r, int perspective)
 /*========================================================================*/
 int RayExpandPrimitives(CRay * I)
 {
+  PYMOL_PROFILE_SCOPE(I->G, "Ray", "RayExpandPrimitives");
   int a;
   float *v0, *v1, *n0, *n1;
   CBasis *basis;
@@ -821,6 +823,7 @@ void RayComputeBox(CRay * I)
 
 int RayTransformFirst(CRay * I, int perspective, int identity)
 {
+  PYMOL_PROFILE_SCOPE(I->G, "Ray", "RayTransformFirst");
   CBasis *basis0, *basis1;
   CPrimitive *prm;
   int a;
@@ -3157,6 +3160,7 @@ static void RayPrimGetColorRamped(PyMOLGlobals * G, float *matrix, RayInfo * r,
 int RayTraceThread(CRayThreadInfo * T)
 {
   CRay *I = T->ray;
+  PYMOL_PROFILE_SCOPE(I->G, "Ray", "RayTraceThread");
   int x, y, yy;
   float excess = 0.0F;
   float dotgle;
@@ -4611,6 +4615,7 @@ int RayAntiThread(CRayAntiThreadInfo * T)
   unsigned int *p;
   int offset = 0;
   CRay *I = T->ray;
+  PYMOL_PROFILE_SCOPE(I->G, "Ray", "RayAntiThread");
 
   OrthoBusyFast(I->G, 9, 10);
   width = (T->width / T->mag) - 2;
@@ -5508,6 +5513,7 @@ int rayVolume = 0, rayWidth = 0, rayHeight = 0;
 void RayRender(CRay * I, unsigned int *image, double timing,
                float angle, int antialias, unsigned int *return_bg)
 {
+  PYMOL_PROFILE_SCOPE(I->G, "Ray", "RayRender");
   int a, x, y;
   unsigned int *image_copy = nullptr;
   unsigned int back_mask, fore_mask = 0, trace_word = 0;
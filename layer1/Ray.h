@@ -46,6 +46,8 @@ void RayPrepare(CRay * I, float v0, float v1, float v2,
                 float back_ratio, float magnified);
 void RayRender(CRay * I, unsigned int *image,
                double timing, float angle, int antialias, unsigned int *return_bg);
+void RayRenderRaster(CRay * I, unsigned int *image,
+                     float angle, int antialias, unsigned int *return_bg);
 void RayRenderPOV(CRay * I, int width, int height, char **headerVLA,
                   char **charVLA, float front, float back, float fov, float angle,
                   int antialias);
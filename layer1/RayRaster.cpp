@@ -0,0 +1,789 @@
+/* 
+A* -------------------------------------------------------------------
+B* This file contains source code for the PyMOL computer program
+C* Copyright (c) Schrodinger, LLC. 
+D* -------------------------------------------------------------------
+E* It is unlawful to modify or remove this copyright notice.
+F* -------------------------------------------------------------------
+G* Please see the accompanying LICENSE file for further information. 
+H* -------------------------------------------------------------------
+I* Additional authors of this source file include:
+-* 
+-* 
+-*
+Z* -------------------------------------------------------------------
+*/
+
+/*
+ * CPU rasterizer for the ray primitive stream
+ *
+ * Renders the primitives which the representations emit through
+ * CGORenderRay (spheres, cylinders, sausages, cones, ellipsoids and
+ * triangles) into a z-buffer without OpenGL and without building the
+ * voxel maps of the ray tracer. Quadrics are intersected analytically for
+ * every pixel, like the impostor shaders do on the GPU. Lighting follows
+ * the light, ambient, direct, reflect and specular settings; there are no
+ * shadows, and only the nearest transparent layer is blended.
+ */
+
+#include "os_predef.h"
+#include "os_std.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+#include "Ray.h"
+#include "Basis.h"
+#include "Vector.h"
+#include "Matrix.h"
+#include "Setting.h"
+#include "Scene.h"
+#include "Color.h"
+#include "Feedback.h"
+#include "Profiler.h"
+
+/* edge length of a screen tile in output pixels */
+#define cRasterTileSize 32
+
+namespace
+{
+
+/*
+ * Maps output pixels to rays in camera space (the eye looks down -Z).
+ * Ortho rays start on the Z=0 plane, perspective rays start at the eye
+ * with an unnormalized direction which reaches the front plane at t=1.
+ */
+struct RasterView {
+  int width, height;
+  bool perspective;
+  float front, back;
+  float x0, y0;       /* lower left corner (volume or front plane) */
+  float sx, sy;       /* extent of one output pixel */
+
+  RasterView(const CRay* I, bool persp)
+  {
+    width = I->Width;
+    height = I->Height;
+    perspective = persp;
+    front = I->Volume[4];
+    back = I->Volume[5];
+    if (perspective) {
+      float height_range =
+          front * 2 * ((float) tan((I->Fov / 2.0F) * PI / 180.0F));
+      float width_range = height_range * (I->Range[0] / I->Range[1]);
+      x0 = -width_range / 2.0F;
+      y0 = -height_range / 2.0F;
+      sx = width_range / width;
+      sy = height_range / height;
+    } else {
+      x0 = I->Volume[0];
+      y0 = I->Volume[2];
+      sx = I->Range[0] / width;
+      sy = I->Range[1] / height;
+    }
+  }
+
+  void ray(float u, float v, float* org, float* dir) const
+  {
+    float bx = x0 + u * sx;
+    float by = y0 + v * sy;
+    if (perspective) {
+      zero3f(org);
+      set3f(dir, bx, by, -front);
+    } else {
+      set3f(org, bx, by, 0.0F);
+      set3f(dir, 0.0F, 0.0F, -1.0F);
+    }
+  }
+
+  /* depth of the point org + t * dir along the view axis */
+  float depth(const float* org, const float* dir, float t) const
+  {
+    return -(org[2] + t * dir[2]);
+  }
+
+  /*
+   * Screen rectangle (output pixels) covered by a camera space box, or
+   * false if the box lies outside of the viewing volume.
+   */
+  bool project(const float* mn, const float* mx, float* rect) const
+  {
+    if (-mx[2] > back || -mn[2] < front)
+      return false;
+    if (!perspective) {
+      rect[0] = (mn[0] - x0) / sx;
+      rect[1] = (mn[1] - y0) / sy;
+      rect[2] = (mx[0] - x0) / sx;
+      rect[3] = (mx[1] - y0) / sy;
+      return true;
+    }
+    if (mx[2] > -R_SMALL4) {
+      /* reaches behind the eye, don't bother */
+      rect[0] = rect[1] = 0.0F;
+      rect[2] = (float) width;
+      rect[3] = (float) height;
+      return true;
+    }
+    rect[0] = rect[1] = FLT_MAX;
+    rect[2] = rect[3] = -FLT_MAX;
+    for (int c = 0; c < 8; ++c) {
+      float x = (c & 1) ? mx[0] : mn[0];
+      float y = (c & 2) ? mx[1] : mn[1];
+      float z = (c & 4) ? mx[2] : mn[2];
+      float px = (x * front / -z - x0) / sx;
+      float py = (y * front / -z - y0) / sy;
+      rect[0] = std::min(rect[0], px);
+      rect[1] = std::min(rect[1], py);
+      rect[2] = std::max(rect[2], px);
+      rect[3] = std::max(rect[3], py);
+    }
+    return true;
+  }
+};
+
+/* nearest ray/primitive intersection */
+struct RasterHit {
+  float t;
+  float normal[3];
+  float param;        /* cylinder axis fraction, or first barycentric */
+  float bary[2];      /* triangle barycentrics of vertex 2 and 3 */
+};
+
+/* one surface sample kept per sub-pixel */
+struct RasterSample {
+  float depth;
+  float normal[3];
+  float color[3];
+  float trans;
+  bool lit;
+};
+
+struct RasterLights {
+  int n_light;
+  int spec_count;
+  float light[9][3];
+  float spec[9][3];
+  float ambient, direct, lreflect, legacy, ray_scatter;
+  float power, reflect_power;
+  float spec_reflect, spec_power, spec_direct, spec_direct_power;
+};
+
+/* both roots of a t^2 + 2 b t + c = 0 in ascending order */
+bool solve_quadratic(float a, float b, float c, float* roots)
+{
+  if (fabs(a) < R_SMALL8)
+    return false;
+  float disc = b * b - a * c;
+  if (disc < 0.0F)
+    return false;
+  float s = sqrtf(disc);
+  roots[0] = (-b - s) / a;
+  roots[1] = (-b + s) / a;
+  if (roots[0] > roots[1])
+    std::swap(roots[0], roots[1]);
+  return true;
+}
+
+bool hit_sphere(const float* org, const float* dir, const float* center,
+    float r, const RasterView& view, RasterHit& hit)
+{
+  float m[3], roots[2];
+  subtract3f(org, center, m);
+  if (!solve_quadratic(dot_product3f(dir, dir), dot_product3f(m, dir),
+          dot_product3f(m, m) - r * r, roots))
+    return false;
+  for (float t : roots) {
+    float d = view.depth(org, dir, t);
+    if (t > 0.0F && d >= view.front && d <= view.back && t < hit.t) {
+      float q[3];
+      hit.t = t;
+      scale3f(dir, t, q);
+      add3f(org, q, q);
+      subtract3f(q, center, hit.normal);
+      normalize3f(hit.normal);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool hit_disk(const float* org, const float* dir, const float* center,
+    const float* normal, float r, const RasterView& view, RasterHit& hit)
+{
+  float denom = dot_product3f(dir, normal);
+  if (fabs(denom) < R_SMALL8)
+    return false;
+  float diff[3], q[3];
+  subtract3f(center, org, diff);
+  float t = dot_product3f(diff, normal) / denom;
+  if (t <= 0.0F || t >= hit.t)
+    return false;
+  float d = view.depth(org, dir, t);
+  if (d < view.front || d > view.back)
+    return false;
+  scale3f(dir, t, q);
+  add3f(org, q, q);
+  subtract3f(q, center, diff);
+  if (lengthsq3f(diff) > r * r)
+    return false;
+  hit.t = t;
+  copy3f(normal, hit.normal);
+  return true;
+}
+
+/*
+ * Truncated cone from p0 (radius r0) along the unit axis a to p0 + l a
+ * (radius r1), with flat or round end caps. A cylinder has r0 == r1.
+ */
+bool hit_cone(const float* org, const float* dir, const float* p0,
+    const float* a, float l, float r0, float r1, cCylCap cap1, cCylCap cap2,
+    const RasterView& view, RasterHit& hit)
+{
+  bool found = false;
+  float k = (l > R_SMALL8) ? (r1 - r0) / l : 0.0F;
+  float m[3], roots[2];
+  subtract3f(org, p0, m);
+  float hm = dot_product3f(m, a);
+  float hd = dot_product3f(dir, a);
+  float rm = r0 + k * hm;
+  float qa = dot_product3f(dir, dir) - (1.0F + k * k) * hd * hd;
+  float qb = dot_product3f(m, dir) - hm * hd - k * hd * rm;
+  float qc = dot_product3f(m, m) - hm * hm - rm * rm;
+
+  if (solve_quadratic(qa, qb, qc, roots)) {
+    for (float t : roots) {
+      float h = hm + t * hd;
+      float d = view.depth(org, dir, t);
+      if (t > 0.0F && t < hit.t && h >= 0.0F && h <= l && r0 + k * h >= 0.0F &&
+          d >= view.front && d <= view.back) {
+        float q[3], radial[3], axial[3];
+        scale3f(dir, t, q);
+        add3f(m, q, q);
+        scale3f(a, h, axial);
+        subtract3f(q, axial, radial);
+        normalize3f(radial);
+        scale3f(a, k, axial);
+        subtract3f(radial, axial, hit.normal);
+        normalize3f(hit.normal);
+        hit.t = t;
+        hit.param = (l > R_SMALL8) ? h / l : 0.0F;
+        found = true;
+        break;
+      }
+    }
+  }
+
+  float p1[3], na[3];
+  scale3f(a, l, p1);
+  add3f(p0, p1, p1);
+  scale3f(a, -1.0F, na);
+
+  if (cap1 == cCylCap::Round) {
+    if (hit_sphere(org, dir, p0, r0, view, hit)) {
+      hit.param = 0.0F;
+      found = true;
+    }
+  } else if (cap1 == cCylCap::Flat) {
+    if (hit_disk(org, dir, p0, na, r0, view, hit)) {
+      hit.param = 0.0F;
+      found = true;
+    }
+  }
+  if (cap2 == cCylCap::Round) {
+    if (hit_sphere(org, dir, p1, r1, view, hit)) {
+      hit.param = 1.0F;
+      found = true;
+    }
+  } else if (cap2 == cCylCap::Flat) {
+    if (hit_disk(org, dir, p1, a, r1, view, hit)) {
+      hit.param = 1.0F;
+      found = true;
+    }
+  }
+  return found;
+}
+
+/* ellipsoid with unit axes n1..n3 and semi-axes r * scale[0..2] */
+bool hit_ellipsoid(const float* org, const float* dir, const float* center,
+    float r, const float* scale, const float* n1, const float* n2,
+    const float* n3, const RasterView& view, RasterHit& hit)
+{
+  const float* axes[3] = {n1, n2, n3};
+  float m[3], so[3], sd[3], roots[2];
+  subtract3f(org, center, m);
+  for (int i = 0; i < 3; ++i) {
+    float s = r * scale[i];
+    if (s < R_SMALL8)
+      return false;
+    so[i] = dot_product3f(m, axes[i]) / s;
+    sd[i] = dot_product3f(dir, axes[i]) / s;
+  }
+  if (!solve_quadratic(dot_product3f(sd, sd), dot_product3f(so, sd),
+          dot_product3f(so, so) - 1.0F, roots))
+    return false;
+  for (float t : roots) {
+    float d = view.depth(org, dir, t);
+    if (t > 0.0F && d >= view.front && d <= view.back && t < hit.t) {
+      hit.t = t;
+      zero3f(hit.normal);
+      for (int i = 0; i < 3; ++i) {
+        float s = r * scale[i];
+        float comp[3];
+        scale3f(axes[i], (so[i] + t * sd[i]) / s, comp);
+        add3f(comp, hit.normal, hit.normal);
+      }
+      normalize3f(hit.normal);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool hit_triangle(const float* org, const float* dir, const float* v0,
+    const float* v1, const float* v2, const float* n0, const float* n1,
+    const float* n2, const RasterView& view, RasterHit& hit)
+{
+  float e1[3], e2[3], p[3], s[3], q[3];
+  subtract3f(v1, v0, e1);
+  subtract3f(v2, v0, e2);
+  cross_product3f(dir, e2, p);
+  float det = dot_product3f(e1, p);
+  if (fabs(det) < R_SMALL8 * R_SMALL8)
+    return false;
+  float inv = 1.0F / det;
+  subtract3f(org, v0, s);
+  float u = dot_product3f(s, p) * inv;
+  if (u < 0.0F || u > 1.0F)
+    return false;
+  cross_product3f(s, e1, q);
+  float v = dot_product3f(dir, q) * inv;
+  if (v < 0.0F || u + v > 1.0F)
+    return false;
+  float t = dot_product3f(e2, q) * inv;
+  if (t <= 0.0F || t >= hit.t)
+    return false;
+  float d = view.depth(org, dir, t);
+  if (d < view.front || d > view.back)
+    return false;
+  float w = 1.0F - u - v;
+  for (int i = 0; i < 3; ++i)
+    hit.normal[i] = w * n0[i] + u * n1[i] + v * n2[i];
+  normalize3f(hit.normal);
+  hit.t = t;
+  hit.param = w;
+  hit.bary[0] = u;
+  hit.bary[1] = v;
+  return true;
+}
+
+/* intersects the ray with one primitive, updating hit if it is closer */
+bool hit_primitive(const CRay* I, const CPrimitive* prm, const float* org,
+    const float* dir, const RasterView& view, RasterHit& hit)
+{
+  const CBasis* base = I->Basis + 1;
+  const float* v = base->Vertex + 3 * prm->vert;
+  switch (prm->type) {
+  case cPrimSphere:
+    return hit_sphere(org, dir, v, prm->r1, view, hit);
+  case cPrimEllipsoid: {
+    const float* n = base->Normal + 3 * base->Vert2Normal[prm->vert];
+    return hit_ellipsoid(
+        org, dir, v, prm->r1, prm->n0, n, n + 3, n + 6, view, hit);
+  }
+  case cPrimCylinder:
+  case cPrimCone:
+  case cPrimSausage: {
+    const float* a = base->Normal + 3 * base->Vert2Normal[prm->vert];
+    float r2 = (prm->type == cPrimCone) ? prm->r2 : prm->r1;
+    cCylCap cap1 = prm->cap1, cap2 = prm->cap2;
+    if (prm->type == cPrimSausage)
+      cap1 = cap2 = cCylCap::Round;
+    return hit_cone(
+        org, dir, v, a, prm->l1, prm->r1, r2, cap1, cap2, view, hit);
+  }
+  case cPrimTriangle: {
+    if (prm->cull)
+      return false;
+    const float* n = base->Normal + 3 * base->Vert2Normal[prm->vert] + 3;
+    return hit_triangle(
+        org, dir, v, v + 3, v + 6, n, n + 3, n + 6, view, hit);
+  }
+  }
+  return false;
+}
+
+/* camera space bounding box of a primitive */
+bool primitive_box(const CRay* I, const CPrimitive* prm, float* mn, float* mx)
+{
+  const CBasis* base = I->Basis + 1;
+  const float* v = base->Vertex + 3 * prm->vert;
+  switch (prm->type) {
+  case cPrimSphere:
+  case cPrimEllipsoid:
+    for (int i = 0; i < 3; ++i) {
+      mn[i] = v[i] - prm->r1;
+      mx[i] = v[i] + prm->r1;
+    }
+    return true;
+  case cPrimCylinder:
+  case cPrimCone:
+  case cPrimSausage: {
+    const float* a = base->Normal + 3 * base->Vert2Normal[prm->vert];
+    float r = (prm->type == cPrimCone) ? std::max(prm->r1, prm->r2) : prm->r1;
+    for (int i = 0; i < 3; ++i) {
+      float e = v[i] + a[i] * prm->l1;
+      mn[i] = std::min(v[i], e) - r;
+      mx[i] = std::max(v[i], e) + r;
+    }
+    return true;
+  }
+  case cPrimTriangle:
+    for (int i = 0; i < 3; ++i) {
+      mn[i] = std::min(std::min(v[i], v[i + 3]), v[i + 6]);
+      mx[i] = std::max(std::max(v[i], v[i + 3]), v[i + 6]);
+    }
+    return true;
+  }
+  return false;   /* labels are not rasterized */
+}
+
+void primitive_color(PyMOLGlobals* G, const CRay* I, const CPrimitive* prm,
+    const RasterHit& hit, const float* impact, float* color)
+{
+  switch (prm->type) {
+  case cPrimCylinder:
+  case cPrimCone:
+  case cPrimSausage:
+    for (int i = 0; i < 3; ++i)
+      color[i] = prm->c1[i] * (1.0F - hit.param) + prm->c2[i] * hit.param;
+    break;
+  case cPrimTriangle:
+    for (int i = 0; i < 3; ++i)
+      color[i] = prm->c1[i] * hit.param + prm->c2[i] * hit.bary[0] +
+                 prm->c3[i] * hit.bary[1];
+    break;
+  default:
+    copy3f(prm->c1, color);
+    break;
+  }
+  if (prm->ramped || prm->c1[0] <= ((float) cColorExtCutoff)) {
+    float world[3];
+    inverse_transformC44f3f(I->ModelView, impact, world);
+    ColorGetRamped(G, (int) (prm->c1[0] - 0.1F), world, color, -1);
+  }
+}
+
+void shade(const RasterLights& L, const RasterSample& s, const float* dir,
+    float* fc)
+{
+  if (!s.lit) {
+    copy3f(s.color, fc);
+    return;
+  }
+  const float* n = s.normal;
+  float legacy_1m = 1.0F - L.legacy;
+  float dotgle = std::max(0.0F, -dot_product3f(dir, n));
+  float nz = std::max(0.0F, n[2]);
+  float pow_dotgle = (L.power != 1.0F) ? powf(dotgle, L.power) : dotgle;
+  float pow_nz = (L.power != 1.0F) ? powf(nz, L.power) : nz;
+  float direct_cmp =
+      legacy_1m * pow_nz + L.legacy * ((dotgle + pow_dotgle) * 0.5F);
+  float reflect_cmp = 0.0F;
+  float excess = 0.0F;
+
+  if (L.spec_direct != 0.0F && nz > 0.0F)
+    excess = powf(nz, L.spec_direct_power) * L.spec_direct;
+
+  if (L.n_light < 1) {
+    reflect_cmp = direct_cmp;
+  } else {
+    for (int bc = 0; bc < L.n_light; ++bc) {
+      float dl = std::max(0.0F, -dot_product3f(n, L.light[bc]));
+      float pow_dl =
+          (L.reflect_power != 1.0F) ? powf(dl, L.reflect_power) : dl;
+      reflect_cmp += legacy_1m * pow_dl + L.legacy * ((dl + pow_dl) * 0.5F);
+      if (bc < L.spec_count) {
+        if (L.ray_scatter != 0.0F)
+          excess += L.ray_scatter * dl;
+        float ds = std::max(0.0F, -dot_product3f(n, L.spec[bc]));
+        excess += powf(ds, L.spec_power) * L.spec_reflect;
+      }
+    }
+  }
+
+  float bright = L.ambient + L.direct * direct_cmp +
+                 L.lreflect * reflect_cmp * (legacy_1m + L.legacy * direct_cmp);
+  bright = std::min(1.0F, std::max(0.0F, bright));
+  excess = std::min(1.0F, excess);
+  for (int i = 0; i < 3; ++i)
+    fc[i] = bright * s.color[i] + excess;
+}
+
+/* offsets a background color for the gamma correction applied later on */
+void gamma_adjust(float gamma, float* rgb)
+{
+  float inp = (rgb[0] + rgb[1] + rgb[2]) / 3.0F;
+  float sig = (inp < R_SMALL4) ? 1.0F : (float) pow(inp, gamma) / inp;
+  for (int i = 0; i < 3; ++i)
+    rgb[i] = std::min(1.0F, rgb[i] * sig);
+}
+
+unsigned int pack_color(const CRay* I, const float* rgb, float alpha)
+{
+  const float _p499 = 0.499F;
+  unsigned int c[4];
+  for (int i = 0; i < 4; ++i) {
+    float v = std::min(1.0F, std::max(0.0F, (i < 3) ? rgb[i] : alpha));
+    c[i] = 0xFF & ((unsigned int) (v * 255 + _p499));
+  }
+  if (I->BigEndian)
+    return (c[0] << 24) | (c[1] << 16) | (c[2] << 8) | c[3];
+  return (c[3] << 24) | (c[2] << 16) | (c[1] << 8) | c[0];
+}
+
+} // namespace
+
+/*========================================================================*/
+void RayRenderRaster(CRay * I, unsigned int *image, float angle,
+                     int antialias, unsigned int *return_bg)
+{
+  PyMOLGlobals *G = I->G;
+  PYMOL_PROFILE_SCOPE(G, "Ray", "RayRenderRaster");
+  int perspective = SettingGetGlobal_i(G, cSetting_ray_orthoscopic);
+  if(perspective < 0)
+    perspective = SettingGetGlobal_b(G, cSetting_ortho);
+  perspective = !perspective;
+
+  /* supersampling factor per axis */
+  if(antialias < 0)
+    antialias = SettingGetGlobal_i(G, cSetting_antialias);
+  int mag = std::max(1, std::min(antialias + 1, 4));
+
+  /* background */
+  int opaque_back = SettingGetGlobal_i(G, cSetting_ray_opaque_background);
+  if(opaque_back < 0)
+    opaque_back = SettingGetGlobal_i(G, cSetting_opaque_background);
+  bool gradient = opaque_back && SettingGetGlobal_b(G, cSetting_bg_gradient);
+  float bkrd_top[3], bkrd_bottom[3];
+  float gamma = SettingGetGlobal_f(G, cSetting_gamma);
+  if(gradient) {
+    copy3f(ColorGet(G, SettingGet_color(G, nullptr, nullptr, cSetting_bg_rgb_top)), bkrd_top);
+    copy3f(ColorGet(G, SettingGet_color(G, nullptr, nullptr, cSetting_bg_rgb_bottom)), bkrd_bottom);
+    gamma_adjust(gamma, bkrd_bottom);
+  } else {
+    copy3f(ColorGet(G, SettingGet_color(G, nullptr, nullptr, cSetting_bg_rgb)), bkrd_top);
+  }
+  gamma_adjust(gamma, bkrd_top);
+  if(!gradient)
+    copy3f(bkrd_top, bkrd_bottom);
+  float back_alpha = opaque_back ? 1.0F : 0.0F;
+  unsigned int background = pack_color(I, bkrd_top, back_alpha);
+  if(return_bg)
+    *return_bg = background;
+
+  /* depth cue */
+  float fog = SettingGetGlobal_f(G, cSetting_ray_trace_fog);
+  if(fog < 0.0F)
+    fog = SettingGetGlobal_b(G, cSetting_depth_cue) ?
+      SettingGetGlobal_f(G, cSetting_fog) : 0.0F;
+  fog = std::min(fog, 1.0F);
+  float fog_start = SettingGetGlobal_f(G, cSetting_ray_trace_fog_start);
+  if(fog_start < 0.0F)
+    fog_start = SettingGetGlobal_f(G, cSetting_fog_start);
+  fog_start = std::min(fog_start, 1.0F);
+  if(fabs(fog_start - 1.0F) < R_SMALL4)
+    fog = 0.0F;
+
+  /* lights */
+  RasterLights L;
+  {
+    static const int light_setting[] = {
+      cSetting_light, cSetting_light2, cSetting_light3, cSetting_light4,
+      cSetting_light5, cSetting_light6, cSetting_light7, cSetting_light8,
+      cSetting_light9
+    };
+    int light_count = std::min(SettingGetGlobal_i(G, cSetting_light_count), 10);
+    L.n_light = std::max(0, light_count - 1);
+    L.spec_count = SettingGetGlobal_i(G, cSetting_spec_count);
+    if(L.spec_count < 0)
+      L.spec_count = light_count;
+    for(int bc = 0; bc < L.n_light; ++bc) {
+      float *light = L.light[bc];
+      copy3f(SettingGetGlobal_3fv(G, light_setting[bc]), light);
+      normalize3f(light);
+      if(angle) {
+        float temp[16];
+        identity44f(temp);
+        MatrixRotateC44f(temp, (float) -PI * angle / 180, 0.0F, 1.0F, 0.0F);
+        MatrixTransformC44fAs33f3f(temp, light, light);
+      }
+      copy3f(light, L.spec[bc]);
+      L.spec[bc][2]--;
+      normalize3f(L.spec[bc]);
+    }
+    L.legacy = SettingGetGlobal_f(G, cSetting_ray_legacy_lighting);
+    L.ray_scatter = SettingGetGlobal_f(G, cSetting_ray_scatter);
+    float reflect_scale = SceneGetReflectScaleValue(G, 10);
+    L.lreflect = std::max(0.0F, reflect_scale *
+        (SettingGetGlobal_f(G, cSetting_reflect) - L.ray_scatter));
+    L.ray_scatter *= reflect_scale;
+    L.ambient = SettingGetGlobal_f(G, cSetting_ambient);
+    L.direct = SettingGetGlobal_f(G, cSetting_direct);
+    L.ambient *= (1.0F - L.legacy) + (L.legacy * (0.22F / 0.12F));
+    L.lreflect *= (1.0F - L.legacy) + (L.legacy * (0.72F / 0.45F));
+    L.direct *= (1.0F - L.legacy) + (L.legacy * (0.24F / 0.45F));
+    L.power = SettingGetGlobal_f(G, cSetting_power);
+    L.reflect_power = SettingGetGlobal_f(G, cSetting_reflect_power);
+    SceneGetAdjustedLightValues(G, &L.spec_reflect, &L.spec_power,
+        &L.spec_direct, &L.spec_direct_power, 10);
+  }
+
+  const int width = I->Width;
+  const int height = I->Height;
+
+  VLASize2<CPrimitive>(I->Primitive, I->NPrimitive);
+  if(I->NPrimitive) {
+    RayExpandPrimitives(I);
+    RayTransformFirst(I, perspective, false);
+  }
+
+  RasterView view(I, perspective);
+
+  /* bin the primitives into screen tiles */
+  const int n_tile_x = (width + cRasterTileSize - 1) / cRasterTileSize;
+  const int n_tile_y = (height + cRasterTileSize - 1) / cRasterTileSize;
+  std::vector<std::vector<int>> bins(n_tile_x * n_tile_y);
+  for(int a = 0; a < I->NPrimitive; ++a) {
+    float mn[3], mx[3], rect[4];
+    if(!primitive_box(I, I->Primitive + a, mn, mx) ||
+       !view.project(mn, mx, rect))
+      continue;
+    int tx0 = std::max(0, (int) floorf(rect[0]) / cRasterTileSize);
+    int ty0 = std::max(0, (int) floorf(rect[1]) / cRasterTileSize);
+    int tx1 = std::min(n_tile_x - 1, (int) floorf(rect[2]) / cRasterTileSize);
+    int ty1 = std::min(n_tile_y - 1, (int) floorf(rect[3]) / cRasterTileSize);
+    if(rect[2] < 0.0F || rect[3] < 0.0F)
+      continue;
+    for(int ty = ty0; ty <= ty1; ++ty)
+      for(int tx = tx0; tx <= tx1; ++tx)
+        bins[ty * n_tile_x + tx].push_back(a);
+  }
+
+  const float inv_range = 1.0F / (view.back - view.front);
+  const float inv_samples = 1.0F / (mag * mag);
+  const int n_tile = n_tile_x * n_tile_y;
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(int tile = 0; tile < n_tile; ++tile) {
+    if(G->Interrupt)
+      continue;
+    const int x0 = (tile % n_tile_x) * cRasterTileSize;
+    const int y0 = (tile / n_tile_x) * cRasterTileSize;
+    const int tw = std::min(cRasterTileSize, width - x0);
+    const int th = std::min(cRasterTileSize, height - y0);
+    const int sw = tw * mag, sh = th * mag;
+
+    std::vector<RasterSample> opaque(sw * sh), trans(sw * sh);
+    for(int i = 0; i < sw * sh; ++i) {
+      opaque[i].depth = FLT_MAX;
+      trans[i].depth = FLT_MAX;
+    }
+
+    for(int a : bins[tile]) {
+      const CPrimitive *prm = I->Primitive + a;
+      float mn[3], mx[3], rect[4];
+      primitive_box(I, prm, mn, mx);
+      view.project(mn, mx, rect);
+      int sx0 = std::max(0, (int) floorf((rect[0] - x0) * mag));
+      int sy0 = std::max(0, (int) floorf((rect[1] - y0) * mag));
+      int sx1 = std::min(sw - 1, (int) ceilf((rect[2] - x0) * mag));
+      int sy1 = std::min(sh - 1, (int) ceilf((rect[3] - y0) * mag));
+      bool is_trans = prm->trans > R_SMALL4;
+
+      for(int sy = sy0; sy <= sy1; ++sy) {
+        for(int sx = sx0; sx <= sx1; ++sx) {
+          float org[3], dir[3];
+          view.ray(x0 + (sx + 0.5F) / mag, y0 + (sy + 0.5F) / mag, org, dir);
+          RasterHit hit;
+          hit.t = FLT_MAX;
+          if(!hit_primitive(I, prm, org, dir, view, hit))
+            continue;
+          float depth = view.depth(org, dir, hit.t);
+          RasterSample &o = opaque[sy * sw + sx];
+          if(depth >= o.depth)
+            continue;
+          RasterSample &s = is_trans ? trans[sy * sw + sx] : o;
+          if(is_trans && depth >= s.depth)
+            continue;
+          float impact[3];
+          scale3f(dir, hit.t, impact);
+          add3f(org, impact, impact);
+          s.depth = depth;
+          copy3f(hit.normal, s.normal);
+          /* two-sided lighting */
+          if(dot_product3f(s.normal, dir) > 0.0F)
+            invert3f(s.normal);
+          primitive_color(G, I, prm, hit, impact, s.color);
+          s.trans = prm->trans;
+          s.lit = !prm->no_lighting;
+        }
+      }
+    }
+
+    /* shade, fog, blend and downsample */
+    for(int y = 0; y < th; ++y) {
+      float perc = (y0 + y) / (float) height;
+      float bkrd[3];
+      for(int i = 0; i < 3; ++i)
+        bkrd[i] = bkrd_bottom[i] + perc * (bkrd_top[i] - bkrd_bottom[i]);
+      for(int x = 0; x < tw; ++x) {
+        float acc[4] = {0.0F, 0.0F, 0.0F, 0.0F};
+        for(int j = 0; j < mag; ++j) {
+          for(int i = 0; i < mag; ++i) {
+            int si = (y * mag + j) * sw + (x * mag + i);
+            float org[3], dir[3], fc[4];
+            view.ray(x0 + x + (i + 0.5F) / mag, y0 + y + (j + 0.5F) / mag, org, dir);
+            normalize3f(dir);
+            copy3f(bkrd, fc);
+            fc[3] = back_alpha;
+            const RasterSample *layers[2] = {&opaque[si], &trans[si]};
+            for(const RasterSample *s : layers) {
+              if(s->depth == FLT_MAX || (s == &trans[si] && s->depth >= opaque[si].depth))
+                continue;
+              float c[3];
+              shade(L, *s, dir, c);
+              float alpha = 1.0F - s->trans;
+              if(fog != 0.0F) {
+                float ffact = (s->depth - view.front) * inv_range;
+                if(fog_start > R_SMALL4)
+                  ffact = (ffact - fog_start) / (1.0F - fog_start);
+                ffact = std::min(1.0F, std::max(0.0F, ffact * fog));
+                if(opaque_back) {
+                  for(int k = 0; k < 3; ++k)
+                    c[k] = ffact * bkrd[k] + (1.0F - ffact) * c[k];
+                } else {
+                  alpha *= 1.0F - ffact;
+                }
+              }
+              for(int k = 0; k < 3; ++k)
+                fc[k] = alpha * c[k] + (1.0F - alpha) * fc[k];
+              fc[3] = alpha + (1.0F - alpha) * fc[3];
+            }
+            for(int k = 0; k < 4; ++k)
+              acc[k] += fc[k];
+          }
+        }
+        for(int k = 0; k < 4; ++k)
+          acc[k] *= inv_samples;
+        image[(size_t) (y0 + y) * width + (x0 + x)] = pack_color(I, acc, acc[3]);
+      }
+    }
+  }
+
+  PRINTFB(G, FB_Ray, FB_Blather)
+    " RayRenderRaster: rasterized %d primitives into %d tiles.\n",
+    I->NPrimitive, n_tile ENDFB(G);
+}
@@ -28,6 +28,8 @@ Z* -------------------------------------------------------------------
 #include"P.h"
 #include"Util.h"
 #include"Scene.h"
+#include"CGO.h"
+#include"Profiler.h"
 
 /*========================================================================*/
 /**
@@ -43,6 +45,7 @@ Rep* Rep::rebuild()
 {
   assert(cs);
   assert(fNew);
+  PYMOL_PROFILE_SCOPE(G, "Rep", "Rep::rebuild");
   Rep* tmp = fNew(cs, getState());
   if (tmp) {
     tmp->fNew = fNew;
@@ -94,6 +97,9 @@ Rep* Rep::update()
     // nothing to do
   } else if (MaxInvalid == cRepInvColor) {
     I = recolor();
+  } else if (MaxInvalid == cRepInvCoord &&
+             MaxInvalidNonCoord < cRepInvColor && recoord()) {
+    // patched in place
   } else if (MaxInvalid > cRepInvVisib || !sameVis()) {
     I = rebuild();
   } else if (!sameColor()) {
@@ -107,6 +113,7 @@ Rep* Rep::update()
 
   if (I) {
     I->MaxInvalid = cRepInvNone;
+    I->MaxInvalidNonCoord = cRepInvNone;
   }
 
   return I;
@@ -124,6 +131,70 @@ void Rep::invalidate(cRepInv_t level)
   SceneInvalidatePicking(I->G); // for now, if anything invalidated, then invalidate picking
   if(level > I->MaxInvalid)
     I->MaxInvalid = level;
+  if (level != cRepInvCoord && level > I->MaxInvalidNonCoord)
+    I->MaxInvalidNonCoord = level;
+}
+
+/*========================================================================*/
+/**
+ * Overwrite the positions of the sphere, cylinder and line primitives in
+ * `cgo` from the current coordinates of `cs`. Primitives are matched with
+ * `patches` in order.
+ *
+ * @return false if the CGO does not match the patch list
+ */
+bool RepPatchCoords(CGO* cgo, const std::vector<RepCoordPatch>& patches,
+    const CoordSet* cs)
+{
+  auto patch = patches.begin();
+
+  for (auto it = cgo->begin(); !it.is_stop(); ++it) {
+    float* pc;
+
+    switch (it.op_code()) {
+    case CGO_SPHERE:
+    case CGO_SHADER_CYLINDER:
+    case CGO_SHADER_CYLINDER_WITH_2ND_COLOR:
+    case CGO_LINE:
+    case CGO_SPLITLINE:
+      pc = it.data();
+      break;
+    default:
+      continue;
+    }
+
+    if (patch == patches.end())
+      return false;
+
+    const float* v1 = cs->coordPtr(patch->idx1);
+    const float* v2 = cs->coordPtr(patch->idx2);
+    float d[3], p1[3], p2[3];
+    subtract3f(v2, v1, d);
+    scale3f(d, patch->t1, p1);
+    scale3f(d, patch->t2, p2);
+    add3f(v1, p1, p1);
+    add3f(v1, p2, p2);
+
+    switch (it.op_code()) {
+    case CGO_SPHERE:
+      copy3f(p1, pc);
+      break;
+    case CGO_SHADER_CYLINDER:
+    case CGO_SHADER_CYLINDER_WITH_2ND_COLOR:
+      // origin, axis
+      copy3f(p1, pc);
+      subtract3f(p2, p1, pc + 3);
+      break;
+    default:
+      // vertex1, vertex2
+      copy3f(p1, pc);
+      copy3f(p2, pc + 3);
+    }
+
+    ++patch;
+  }
+
+  return patch == patches.end();
 }
 
 /**
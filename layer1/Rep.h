@@ -18,6 +18,7 @@ Z* -------------------------------------------------------------------
 #define _H_Rep
 
 #include <cassert>
+#include <vector>
 
 #include "Picking.h"
 
@@ -184,6 +185,7 @@ enum cRepInv_t {
 };
 
 struct CoordSet;
+class CGO;
 namespace pymol
 {
   struct CObject;
@@ -218,10 +220,17 @@ struct Rep {
 
 protected:
   cRepInv_t MaxInvalid = cRepInvNone;
+  //! Highest level other than cRepInvCoord since the last update()
+  cRepInv_t MaxInvalidNonCoord = cRepInvNone;
 
 private:
   Rep* rebuild();
   virtual Rep* recolor() { return rebuild(); }
+  /**
+   * Update coordinates in place after a coordinate-only invalidation.
+   * @return false if the rep needs to be rebuilt instead
+   */
+  virtual bool recoord() { return false; }
   virtual bool sameVis() const { return false; }
   virtual bool sameColor() const { return false; }
 
@@ -242,6 +251,19 @@ public:
 
 cRepBitmask_t RepGetAutoShowMask(PyMOLGlobals * G);
 
+/**
+ * Maps a CGO primitive to the coordinates it was generated from. The
+ * primitive spans from t1 to t2 along the idx1 -> idx2 vector (t1 = t2 = 0
+ * for spheres).
+ */
+struct RepCoordPatch {
+  int idx1, idx2; //!< coordinate set indices
+  float t1, t2;
+};
+
+bool RepPatchCoords(CGO* cgo, const std::vector<RepCoordPatch>& patches,
+    const CoordSet* cs);
+
 class RepIterator {
   int end;
 
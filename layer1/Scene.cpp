@@ -63,6 +63,7 @@ Z* -------------------------------------------------------------------
 #include "Feedback.h"
 #include "GFXManager.h"
 #include "Util2.h"
+#include "Profiler.h"
 
 #ifdef _PYMOL_OPENVR
 #include"OpenVRMode.h"
@@ -509,10 +510,6 @@ const char *SceneGetSeleModeKeyword(PyMOLGlobals * G)
   return (char *) SelModeKW[0];
 }
 
-#ifdef _PYMOL_OPENVR
-static float s_oldFov = -1.0f;
-#endif
-
 void SceneToViewElem(PyMOLGlobals * G, CViewElem * elem, const char *scene_name)
 {
   double *dp;
@@ -528,7 +525,7 @@ void SceneToViewElem(PyMOLGlobals * G, CViewElem * elem, const char *scene_name)
   if (I->StereoMode == cStereo_openvr) {
     float dist = fabsf(pos.z);
     float fovVR = fov;
-    fov = s_oldFov;
+    fov = I->OpenVROldFov;
     dY = scale * 1.0f;
     dZ = scale * dist * (tanf(fovVR * PI / 360.f) / tanf(fov * PI / 360.f) - 1.0f);
   }
@@ -883,7 +880,7 @@ void SceneGetView(PyMOLGlobals * G, SceneViewType view)
   if (I->StereoMode == cStereo_openvr) {
     float dist = fabsf(pos.z);
     float fovVR = fov;
-    fov = s_oldFov;
+    fov = I->OpenVROldFov;
     dY = scale * 1.0f;
     dZ = scale * dist * (tanf(fovVR * PI / 360.f) / tanf(fov * PI / 360.f) - 1.0f);
   }
@@ -1077,18 +1074,18 @@ void SceneResetOpenVRSettings(PyMOLGlobals * G, bool enableOpenVR) {
   float openVRFov = 110.0 * 0.5;
 
   // old camera props
-  static bool commonCorrect = false;
-  if (s_oldFov < 0.0f)
-    s_oldFov = SettingGetGlobal_f(G, cSetting_field_of_view);
+  CScene *I = G->Scene;
+  if (I->OpenVROldFov < 0.0f)
+    I->OpenVROldFov = SettingGetGlobal_f(G, cSetting_field_of_view);
 
   if (enableOpenVR) {
-    s_oldFov =  SettingGetGlobal_f(G, cSetting_field_of_view);
+    I->OpenVROldFov =  SettingGetGlobal_f(G, cSetting_field_of_view);
     ResetFovWidth(G, enableOpenVR, openVRFov);
-    commonCorrect = true;
+    I->OpenVRFovCorrected = true;
     SettingSetGlobal_f(G, cSetting_dynamic_width_factor, 0.004f); // for correct line width in lines mode
-  } else if (commonCorrect){
-    ResetFovWidth(G, enableOpenVR, s_oldFov);
-    commonCorrect = false;
+  } else if (I->OpenVRFovCorrected){
+    ResetFovWidth(G, enableOpenVR, I->OpenVROldFov);
+    I->OpenVRFovCorrected = false;
     SettingSetGlobal_f(G, cSetting_dynamic_width_factor, 0.06f);
   }
 }
@@ -4663,6 +4660,7 @@ static void SceneStencilCheck(PyMOLGlobals *G)
 /*========================================================================*/
 void SceneUpdate(PyMOLGlobals * G, int force)
 {
+  PYMOL_PROFILE_SCOPE(G, "Scene", "SceneUpdate");
   CScene *I = G->Scene;
 
   int cur_state = SettingGetGlobal_i(G, cSetting_state) - 1;
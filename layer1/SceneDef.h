@@ -132,6 +132,13 @@ class CScene : public Block {
   double AnimationLagTime{};
   int AnimationStartFrame{};
   double ApproxRenderTime{};
+  double RayAccumTiming{}; //!< total ray tracing time, for feedback
+  //! EXPERIMENTAL volume ray tracing, last ray traced image
+  std::shared_ptr<pymol::Image> RayVolumeImage;
+#ifdef _PYMOL_OPENVR
+  float OpenVROldFov{-1.0f}; //!< field_of_view before switching to OpenVR
+  bool OpenVRFovCorrected{};
+#endif
   float VertexScale{0.01F};
   float FogStart{};
   float FogEnd{};
@@ -11,10 +11,7 @@
 #include"P.h"
 #include "Feedback.h"
 
-static double accumTiming = 0.0;
-
 /* EXPERIMENTAL VOLUME RAYTRACING DATA */
-static std::shared_ptr<pymol::Image> rayVolumeImage;
 extern float *rayDepthPixels;
 extern int rayVolume, rayWidth, rayHeight;
 
@@ -119,12 +116,15 @@ bool SceneRay(PyMOLGlobals * G,
   if(ortho < 0)
     ortho = SettingGetGlobal_b(G, cSetting_ortho);
 
-  if(mode != 0)
+  /* modes which produce an image */
+  const bool image_mode = (mode == 0 || mode == cSceneRay_MODE_RASTER);
+
+  if(!image_mode)
     grid_mode = GridMode::NoGrid; /* only allow grid mode with PyMOL renderer */
 
   SceneUpdateAnimation(G);
 
-  if(mode == 0)
+  if(image_mode)
     SceneInvalidateCopy(G, true);
 
   if(antialias < 0) {
@@ -335,11 +335,16 @@ bool SceneRay(PyMOLGlobals * G,
       }
       switch (mode) {
       case 0:                  /* mode 0 is built-in */
+      case cSceneRay_MODE_RASTER: /* CPU rasterizer, no shadows */
         {
           auto image = std::make_unique<pymol::Image>(ray_width, ray_height);
           std::uint32_t background;
 
-          RayRender(ray, image->pixels(), timing, angle, antialias, &background);
+          if(mode == cSceneRay_MODE_RASTER) {
+            RayRenderRaster(ray, image->pixels(), angle, antialias, &background);
+          } else {
+            RayRender(ray, image->pixels(), timing, angle, antialias, &background);
+          }
 
           /*    RayRenderColorTable(ray,ray_width,ray_height,buffer); */
           if(!I->grid.active) {
@@ -381,9 +386,9 @@ bool SceneRay(PyMOLGlobals * G,
           I->CopyForced = true;
 
           if (SettingGet<bool>(G, cSetting_ray_volume) && !I->Image->empty()) {
-            rayVolumeImage = I->Image;
+            I->RayVolumeImage = I->Image;
           } else {
-            rayVolumeImage = nullptr;
+            I->RayVolumeImage = nullptr;
           }
         }
         break;
@@ -499,7 +504,7 @@ bool SceneRay(PyMOLGlobals * G,
       ray_height = ray_rect.extent.height;
     }
 
-    if((mode == 0) && I->Image && !I->Image->empty()) {
+    if(image_mode && I->Image && !I->Image->empty()) {
       SceneApplyImageGamma(G, I->Image->pixels(), I->Image->getWidth(),
                            I->Image->getHeight());
     }
@@ -715,13 +720,13 @@ bool SceneRay(PyMOLGlobals * G,
   }
   timing = UtilGetSeconds(G) - timing;
   if(mode != 2) {               /* don't show timings for tests */
-    accumTiming += timing;
+    I->RayAccumTiming += timing;
 
     if(show_timing && !quiet) {
       if(!G->Interrupt) {
         PRINTFB(G, FB_Ray, FB_Details)
           " Ray: render time: %4.2f sec. = %3.1f frames/hour (%4.2f sec. accum.).\n",
-          timing, 3600 / timing, accumTiming ENDFB(G);
+          timing, 3600 / timing, I->RayAccumTiming ENDFB(G);
       } else {
         PRINTFB(G, FB_Ray, FB_Details)
           " Ray: render aborted.\n" ENDFB(G);
@@ -786,10 +791,10 @@ void SceneRenderRayVolume(PyMOLGlobals * G, CScene *I){
 #endif
   glDepthMask(GL_FALSE);
 #ifndef PURE_OPENGL_ES_2
-  if (PIsGlutThread() && rayVolumeImage) {
+  if (PIsGlutThread() && I->RayVolumeImage) {
     if (rayWidth == I->Width && rayHeight == I->Height){
-      glDrawPixels(rayVolumeImage->getWidth(), rayVolumeImage->getHeight(),
-          GL_RGBA, GL_UNSIGNED_BYTE, rayVolumeImage->bits());
+      glDrawPixels(I->RayVolumeImage->getWidth(), I->RayVolumeImage->getHeight(),
+          GL_RGBA, GL_UNSIGNED_BYTE, I->RayVolumeImage->bits());
     } else {
       SceneDrawImageOverlay(G, 1, nullptr);
     }
@@ -14,6 +14,7 @@
 #include "P.h"
 #include "Picking.h"
 #include "PyMOLOptions.h"
+#include "Profiler.h"
 #include "Scene.h"
 #include "ScenePicking.h"
 #include "SceneRay.h"
@@ -196,6 +197,7 @@ void SceneProjectionMatrix(PyMOLGlobals* G, float front, float back, float aspRa
  */
 void SceneRender(PyMOLGlobals* G, const SceneRenderInfo& renderInfo)
 {
+  PYMOL_PROFILE_SCOPE(G, "Scene", "SceneRender");
   /* think in terms of the camera's world */
   CScene* I = G->Scene;
   float normal[4] = {0.0, 0.0, 1.0, 0.0};
@@ -775,6 +777,10 @@ void SceneRenderAll(PyMOLGlobals* G, SceneUnitContext* context, float* normal,
     PickColorManager* pickmgr, RenderPass pass, int fat, float width_scale,
     GridInfo* grid, int dynamic_pass, SceneRenderWhich which_objects, SceneRenderOrder render_order)
 {
+  PYMOL_PROFILE_SCOPE(G, "Scene",
+      pass == RenderPass::Opaque      ? "SceneRenderAll(opaque)"
+      : pass == RenderPass::Antialias ? "SceneRenderAll(antialias)"
+                                      : "SceneRenderAll(transparent)");
   CScene* I = G->Scene;
   int state = SceneGetState(G);
   RenderInfo info;
@@ -2489,6 +2489,15 @@ void SettingGenerateSideEffects(PyMOLGlobals * G, int index, const char *sele, i
     ExecutiveInvalidateRep(G, inv_sele, cRepSphere, cRepInvRep);
     SceneInvalidate(G);
     break;
+  case cSetting_lod_atom_count:
+    ExecutiveInvalidateRep(G, inv_sele, cRepCyl, cRepInvRep);
+    ExecutiveInvalidateRep(G, inv_sele, cRepSphere, cRepInvRep);
+    ExecutiveInvalidateRep(G, inv_sele, cRepCartoon, cRepInvRep);
+    SceneInvalidate(G);
+    break;
+  case cSetting_lod_pixel_size:
+    SceneInvalidate(G);
+    break;
   case cSetting_sphere_quality:
     ExecutiveInvalidateRep(G, inv_sele, cRepCyl, cRepInvRep);
     ExecutiveInvalidateRep(G, inv_sele, cRepNonbondedSphere, cRepInvRep);
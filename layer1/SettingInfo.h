@@ -905,6 +905,10 @@ enum {
   REC_f( 795, salt_bridge_distance                        , global    , 5.0f ),
   REC_b( 796, use_tessellation_shaders                , global    , true ),
   REC_c( 797, cell_color                              , ostate    , "-1" ),
+  REC_i( 798, lod_atom_count                          , ostate    , 5000000 ),
+  REC_f( 799, lod_pixel_size                          , ostate    , 2.0f ),
+  REC_b( 800, symmetry_instancing                     , global    , false ),
+  REC_i( 801, map_session_precision                   , global    , 0, 0, 16 ),
 
 #ifdef SETTINGINFO_IMPLEMENTATION
 #undef SETTINGINFO_IMPLEMENTATION
@@ -10,6 +10,8 @@
 
 #include "AssemblyHelpers.h"
 #include "MemoryDebug.h"
+#include "Setting.h"
+#include "Vector.h"
 
 /**
  * Create a coordset for a segi (chain) selection
@@ -70,3 +72,69 @@ void ObjectMoleculeSetAssemblyCSets(
     SettingSet(cSetting_all_states, true, I);
   }
 }
+
+AssemblyCSetCollector::AssemblyCSetCollector(PyMOLGlobals* G)
+    : m_instancing(SettingGet<bool>(G, cSetting_symmetry_instancing))
+{
+}
+
+AssemblyCSetCollector::~AssemblyCSetCollector()
+{
+  for (auto* cs : m_csets)
+    delete cs;
+
+  if (!m_instancing) {
+    for (auto& item : m_templates)
+      delete item.second;
+  }
+}
+
+void AssemblyCSetCollector::add(const CoordSet* cset,
+    const AtomInfoType* atInfo, const std::set<lexborrow_t>& chains_set,
+    const float* matrix)
+{
+  CoordSet* tmpl = nullptr;
+
+  for (auto& item : m_templates) {
+    if (item.first == chains_set) {
+      tmpl = item.second;
+      break;
+    }
+  }
+
+  if (!tmpl) {
+    tmpl = CoordSetCopyFilterChains(cset, atInfo, chains_set);
+    m_templates.emplace_back(chains_set, tmpl);
+
+    if (m_instancing) {
+      m_csets.push_back(tmpl);
+    }
+  }
+
+  if (m_instancing) {
+    auto& instances = tmpl->InstanceMatrices;
+    instances.resize(instances.size() + 16);
+    copy44f44d(matrix, instances.data() + instances.size() - 16);
+  } else {
+    auto* copy = CoordSetCopy(tmpl);
+    CoordSetTransform44f(copy, matrix);
+    m_csets.push_back(copy);
+  }
+}
+
+CoordSet** AssemblyCSetCollector::release()
+{
+  if (m_csets.empty())
+    return nullptr;
+
+  auto csets = VLACalloc(CoordSet*, m_csets.size());
+  std::copy(m_csets.begin(), m_csets.end(), csets);
+  m_csets.clear();
+
+  if (m_instancing) {
+    // owned by the returned VLA
+    m_templates.clear();
+  }
+
+  return csets;
+}
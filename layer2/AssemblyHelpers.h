@@ -7,6 +7,8 @@
 #pragma once
 
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "AtomInfo.h"
 #include "CoordSet.h"
@@ -21,3 +23,36 @@ CoordSet * CoordSetCopyFilterChains(
 void ObjectMoleculeSetAssemblyCSets(
     ObjectMolecule * I,
     CoordSet ** assembly_csets);
+
+/**
+ * Collects the coordinate sets of a biological assembly.
+ *
+ * Every copy gets its own transformed coordinate set, unless
+ * `symmetry_instancing` is on: Then all copies of the same set of chains
+ * become instances of a single untransformed coordinate set, so they share
+ * the representation geometry.
+ */
+class AssemblyCSetCollector
+{
+  bool m_instancing;
+  // chain-filtered templates
+  std::vector<std::pair<std::set<lexborrow_t>, CoordSet*>> m_templates;
+  std::vector<CoordSet*> m_csets;
+
+public:
+  explicit AssemblyCSetCollector(PyMOLGlobals* G);
+  ~AssemblyCSetCollector();
+
+  /**
+   * Add a copy of the `chains_set` subset of `cset`, transformed by
+   * `matrix` (row-major 4x4)
+   */
+  void add(const CoordSet* cset, const AtomInfoType* atInfo,
+      const std::set<lexborrow_t>& chains_set, const float* matrix);
+
+  /**
+   * Release the collected coordinate sets
+   * @return VLA of coordinate sets, or nullptr if empty
+   */
+  CoordSet** release();
+};
@@ -1036,6 +1036,24 @@ void AtomInfoBondCopy(PyMOLGlobals * G, const BondType * src, BondType * dst)
   }
 }
 
+/**
+ * Gather the hot fields of `n` atoms into the column arrays.
+ */
+void AtomInfoHotColumns::assign(const AtomInfoType* ai, size_t n)
+{
+  visRep.resize(n);
+  color.resize(n);
+  flags.resize(n);
+  protons.resize(n);
+
+  for (size_t i = 0; i < n; ++i, ++ai) {
+    visRep[i] = ai->visRep;
+    color[i] = ai->color;
+    flags[i] = ai->flags;
+    protons[i] = ai->protons;
+  }
+}
+
 void AtomInfoPurgeBond(PyMOLGlobals * G, BondType * bi)
 {
   CAtomInfo *I = G->AtomInfo;
@@ -2286,15 +2304,16 @@ int AtomInfoGetExpectedValence(PyMOLGlobals * G, const AtomInfoType * I)
 static int get_protons(const char * symbol)
 {
   char titleized[4];
-  static std::map<pymol::zstring_view, int> lookup;
-
-  if (lookup.empty()) {
+  // initialized once (thread-safe), instances may load concurrently
+  static const auto lookup = [] {
+    std::map<pymol::zstring_view, int> lookup;
     for (int i = 0; i < ElementTableSize; i++)
       lookup[ElementTable[i].symbol] = i;
 
     lookup["Q"] = cAN_H;
     lookup["D"] = cAN_H;
-  }
+    return lookup;
+  }();
 
   // check second letter for lower case
   if (symbol[0] && isupper(symbol[1]) && strcmp(symbol, "LP") != 0) {
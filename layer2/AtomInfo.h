@@ -24,6 +24,8 @@ Z* -------------------------------------------------------------------
 #include"SymOp.h"
 #include"Version.h"
 
+#include <vector>
+
 #if _PyMOL_VERSION_int < 1770
 #define AtomInfoVERSION  176
 #define BondInfoVERSION  176
@@ -381,6 +383,24 @@ typedef struct AtomInfoType {
   bool has_anisou() const { return anisou; }
 } AtomInfoType;
 
+/**
+ * Contiguous copies of the AtomInfoType fields which are read in tight loops
+ * over all atoms of an object (selection evaluation, rep visibility checks,
+ * coloring). The AtomInfoType array remains the authoritative storage, this
+ * is a read-only view which must be rebuilt after the atoms were modified.
+ *
+ * @see ObjectMolecule::getHotColumns
+ */
+struct AtomInfoHotColumns {
+  std::vector<int> visRep;
+  std::vector<int> color;
+  std::vector<unsigned int> flags;
+  std::vector<signed char> protons;
+
+  void assign(const AtomInfoType* ai, size_t n);
+  size_t size() const { return visRep.size(); }
+};
+
 void AtomInfoFree(PyMOLGlobals * G);
 int AtomInfoInit(PyMOLGlobals * G);
 void BondTypeInit(BondType *bt);
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <complex>
+#include <cstdint>
 #include <string>
 #include <map>
 #include <set>
@@ -758,8 +759,7 @@ CoordSet ** read_pdbx_struct_assembly(PyMOLGlobals * G,
     }
   }
 
-  CoordSet ** csets = nullptr;
-  int csetbeginidx = 0;
+  AssemblyCSetCollector csets(G);
 
   // assembly
   for (unsigned i = 0, nrows = arr_oper_expr->size(); i < nrows; ++i) {
@@ -779,57 +779,35 @@ CoordSet ** read_pdbx_struct_assembly(PyMOLGlobals * G,
       }
     }
 
-    // new coord set VLA
-    int ncsets = 1;
-    for (const auto& c_item : collection) {
-      ncsets *= c_item.size();
-    }
-
-    if (!csets) {
-      csets = VLACalloc(CoordSet*, ncsets);
-    } else {
-      csetbeginidx = VLAGetSize(csets);
-      VLASize(csets, CoordSet*, csetbeginidx + ncsets);
-    }
+    // cartesian product of the operations
+    // Note: currently, "1m4x" seems to be the only structure in the PDB
+    // which uses a cartesian product expression
+    std::vector<std::array<float, 16>> matrices(1);
+    identity44f(matrices[0].data());
 
-    // for cartesian product
-    int c_src_len = 1;
-
-    // coord set for subset of atoms
-    CoordSet ** c_csets = csets + csetbeginidx;
-    c_csets[0] = CoordSetCopyFilterChains(cset, atInfo, chains_set);
-
-    // build new coord sets
     for (auto c_it = collection.rbegin(); c_it != collection.rend(); ++c_it) {
-      // copy
-      int j = c_src_len;
-      while (j < c_src_len * c_it->size()) {
-        // cartesian product
-        for (int k = 0; k < c_src_len; ++k, ++j) {
-          c_csets[j] = CoordSetCopy(c_csets[k]);
-        }
-      }
+      std::vector<std::array<float, 16>> product;
+      product.reserve(matrices.size() * c_it->size());
 
-      // transform
-      j = 0;
       for (auto& s_item : *c_it) {
         const float * matrix = oper_list[s_item].data();
 
-        // cartesian product
-        for (int k = 0; k < c_src_len; ++k, ++j) {
-          CoordSetTransform44f(c_csets[j], matrix);
+        for (auto m : matrices) {
+          left_multiply44f44f(matrix, m.data());
+          product.push_back(m);
         }
       }
 
-      // cartesian product
-      // Note: currently, "1m4x" seems to be the only structure in the PDB
-      // which uses a cartesian product expression
-      c_src_len *= c_it->size();
+      matrices = std::move(product);
+    }
+
+    for (auto& m : matrices) {
+      csets.add(cset, atInfo, chains_set, m.data());
     }
   }
 
   // return assembly coordsets
-  return csets;
+  return csets.release();
 }
 
 /**
@@ -2320,16 +2298,6 @@ float CalculateReciprocalSpaceDistanceSquared(
           2 * k * l * b_star * c_star * cos_alpha_star);
 }
 
-/**
- * @brief Structure to hold reflection information
- */
-struct ReflectionInfo {
-  glm::ivec3 hkl{};
-  float fwt{};
-  float phwt{};
-  float fom{};
-};
-
 /**
  * @brief Class to handle the reflection data from a CIF data block
  */
@@ -2369,6 +2337,28 @@ public:
         fwt->as_f(index), phwt->as_f(index), fom->as_f(index)};
   }
 
+  /**
+   * @brief Get the reflection information for all reflections
+   * @return The reflections, in file order
+   */
+  std::vector<ReflectionInfo> getReflections() const
+  {
+    auto* millerH = m_datablock->get_arr("_refln.index_h");
+    auto* millerK = m_datablock->get_arr("_refln.index_k");
+    auto* millerL = m_datablock->get_arr("_refln.index_l");
+    auto* fwt = m_datablock->get_arr("_refln.pdbx_fwt");
+    auto* phwt = m_datablock->get_arr("_refln.pdbx_phwt");
+    auto* fom = m_datablock->get_arr("_refln.fom");
+
+    std::vector<ReflectionInfo> reflections(m_size);
+    for (std::size_t i = 0; i < m_size; ++i) {
+      reflections[i] = ReflectionInfo{glm::ivec3(millerH->as_i(i),
+                                          millerK->as_i(i), millerL->as_i(i)),
+          fwt->as_f(i), phwt->as_f(i), fom->as_f(i)};
+    }
+    return reflections;
+  }
+
   /**
    * @return The number of reflections in the block
    */
@@ -2409,45 +2399,14 @@ static glm::ivec3 FlatIndexToHKL(
 }
 
 #ifdef TRACE
-/**
- * @brief Print statistics for the reciprocal grid
- * @param recip_map The reciprocal map to analyze
- */
-static void PrintReciprocalGridStatistics(
-    const CFieldTyped<std::complex<float>>& recip_map)
-{
-  double sum_abs_real_for_scale = 0.0;
-  double max_abs_imag = 0.0;
-  auto* map_flat_data = recip_map.ptr(0, 0, 0);
-  auto total_map_elements = recip_map.size() / sizeof(std::complex<float>);
-  for (std::size_t i = 0; i < total_map_elements; ++i) {
-    auto val = map_flat_data[i];
-    sum_abs_real_for_scale += std::abs(val.real());
-    max_abs_imag = std::max(max_abs_imag, std::abs((double)val.imag()));
-  }
-
-  std::cout << "Reciprocal Map - Max absolute imaginary part: "
-            << max_abs_imag << "\n";
-  std::cout << "Average absolute real part (for scale): "
-            << sum_abs_real_for_scale / total_map_elements << "\n";
-  if (sum_abs_real_for_scale > EPSILON &&
-      (max_abs_imag / sum_abs_real_for_scale > 1e-5)) {
-    std::cerr << "Warning: Significant imaginary components found in c2c FFT "
-                 "output! Max abs imag: "
-              << max_abs_imag << "\n";
-  } else {
-    std::cout << "c2c FFT output seems valid. Max abs imag: " << max_abs_imag
-              << "\n";
-  }
-}
-
 /**
  * @brief Print statistics for the raw map
- * @param refln_block The reflection block containing reflection data
+ * @param reflections The reflection data
  * @param map The map to analyze
  */
 static void PrintRawMapStatistics(
-    const ReflnBlock& refln_block, const CFieldTyped<float>& map)
+    const std::vector<ReflectionInfo>& reflections,
+    const CFieldTyped<float>& map)
 {
   double sum_scaled_rho = 0.0;
   double sum_sq_scaled_rho = 0.0;
@@ -2489,11 +2448,10 @@ static void PrintRawMapStatistics(
 
   float max_fwt = 0.0;
   glm::ivec3 hkl_strong{};
-  for (std::size_t i = 0; i < refln_block.size(); ++i) {
-    auto refl_info = refln_block.getReflectionInfo(i);
-    if (refl_info && refl_info->fwt > max_fwt) {
-      max_fwt = refl_info->fwt;
-      hkl_strong = refl_info->hkl;
+  for (const auto& refl_info : reflections) {
+    if (refl_info.fwt > max_fwt) {
+      max_fwt = refl_info.fwt;
+      hkl_strong = refl_info.hkl;
     }
   }
   std::cout << "Strongest reflection: F(" << hkl_strong.x << "," << hkl_strong.y
@@ -2839,23 +2797,17 @@ ObjectMapState ObjectMapStateFromField(PyMOLGlobals* G,
 
 /**
  * @brief Find the optimal grid size for the FFT
- * @param refln_block The reflection block containing reflection data
+ * @param reflections The reflection data
  * @param reciprocal_space_params The parameters for reciprocal space
  * @return The optimal grid size as a glm::ivec3
  */
-glm::ivec3 FindOptimalGridSize(const ReflnBlock& refln_block,
+glm::ivec3 FindOptimalGridSize(const std::vector<ReflectionInfo>& reflections,
     const ReciprocalSpaceParams& reciprocal_space_params)
 {
-  std::array<int, 3> dimensions{};
   float inv_dist_sq{};
-  for (std::size_t i = 0; i < refln_block.size(); ++i) {
-    auto refl_info = refln_block.getReflectionInfo(i);
-    if (!refl_info) {
-      continue;
-    }
-
+  for (const auto& refl_info : reflections) {
     auto cand_inv_dist_sq = CalculateReciprocalSpaceDistanceSquared(
-        reciprocal_space_params, refl_info->hkl);
+        reciprocal_space_params, refl_info.hkl);
     inv_dist_sq = std::max(inv_dist_sq, cand_inv_dist_sq);
   }
   double inv_dist = std::sqrt(inv_dist_sq);
@@ -2889,16 +2841,14 @@ double CalculatePhaseShift(
 }
 
 /**
- * @brief Normalizes the complex map to float density map
+ * @brief Scales the map by the cell volume and optionally normalizes it
  * @param reciprocal_space_params The parameters for reciprocal space
- * @param recip_grid The reciprocal grid data
- * @return Density Map as Float Field
+ * @param[in,out] map The density map
  */
-static CFieldTyped<float> NormalizeComplexMapToFloat(PyMOLGlobals* G,
+static void NormalizeDensityMap(PyMOLGlobals* G,
     const ReciprocalSpaceParams& reciprocal_space_params,
-    const CFieldTyped<std::complex<float>>& recip_grid)
+    CFieldTyped<float>& map)
 {
-  CFieldTyped<float> map(reinterpret_cast<const int*>(recip_grid.dim.data()), 3);
   auto total_map_elements = map.size() / sizeof(float);
 
   float inv_Vcell = 1.0f;
@@ -2906,20 +2856,19 @@ static CFieldTyped<float> NormalizeComplexMapToFloat(PyMOLGlobals* G,
     inv_Vcell = 1.0f / static_cast<float>(reciprocal_space_params.volume);
   }
 
-  auto* flat_recip_data = recip_grid.ptr(0, 0, 0);
   auto* map_flat_data = map.ptr(0, 0, 0);
 
   if (!SettingGet<bool>(G, cSetting_normalize_ccp4_maps)) {
     for (std::size_t i = 0; i < total_map_elements; ++i) {
-      map_flat_data[i] = flat_recip_data[i].real() * inv_Vcell;
+      map_flat_data[i] *= inv_Vcell;
     }
-    return map;
+    return;
   }
 
   double sum_rho_scaled = 0.0;
   double sum_sq_rho_scaled = 0.0;
   for (std::size_t i = 0; i < total_map_elements; ++i) {
-    map_flat_data[i] = flat_recip_data[i].real() * inv_Vcell;
+    map_flat_data[i] *= inv_Vcell;
     sum_rho_scaled += map_flat_data[i];
     sum_sq_rho_scaled +=
         static_cast<double>(map_flat_data[i]) * map_flat_data[i];
@@ -2949,7 +2898,6 @@ static CFieldTyped<float> NormalizeComplexMapToFloat(PyMOLGlobals* G,
       }
     }
   }
-  return map;
 }
 
 /**
@@ -2997,49 +2945,20 @@ static bool IsHKLWithinShape(const glm::ivec3& idx, const glm::ivec3& shape)
 }
 
 /**
- * @brief Apply symmetry matrices to the reflections and store the results in
- * the reciprocal space data.
- * @param sym_matrices The symmetry matrices to apply.
- * @param hkl_orig The original Miller indices.
- * @param shape The shape of the reciprocal space grid.
- * @param f_amp_weighted The weighted amplitude of the reflection.
- * @param phase_rad_orig The original phase in radians.
- * @param recip_1D_total_elements The total number of elements in the 1D
- * reciprocal space data.
- * @param[out] flat_recip_data The flat reciprocal space data array.
- * @param[out] is_grid_point_set A vector indicating whether a grid point has been
- * set.
+ * @brief Fourier coefficient of a symmetry equivalent reflection, placed on
+ * the half-complex grid (l < shape.z / 2 + 1) of the real transform.
  */
-void ApplySymMatricesToReflections(
-    const std::vector<SymMatsGLM>& sym_matrices, const glm::ivec3& hkl_orig,
-    const glm::ivec3& shape,
-    float f_amp_weighted, float phase_rad_orig, int recip_1D_total_elements,
-    std::complex<float>* flat_recip_data,
-    std::vector<bool>& is_grid_point_set)
-{
-  for (auto& sym_mat : sym_matrices) {
-    glm::ivec3 hkl_symm = glm::round(sym_mat.rot * hkl_orig);
-    auto phase_shift_rad = CalculatePhaseShift(hkl_orig, sym_mat.trans);
-
-    auto F_symm_complex = std::polar(
-        f_amp_weighted, phase_rad_orig + static_cast<float>(phase_shift_rad));
-
-    int idx_h_s = (hkl_symm.x >= 0) ? hkl_symm.x : hkl_symm.x + shape[0];
-    int idx_k_s = (hkl_symm.y >= 0) ? hkl_symm.y : hkl_symm.y + shape[1];
-    int idx_l_s = (hkl_symm.z >= 0) ? hkl_symm.z : hkl_symm.z + shape[2];
-    auto idx_hkl_s = glm::ivec3(idx_h_s, idx_k_s, idx_l_s);
-
-    if (IsHKLWithinShape(idx_hkl_s, shape)) {
-      auto flat_idx_s =
-          HKLToFlatIndex(idx_hkl_s, shape);
-      if (flat_idx_s < recip_1D_total_elements &&
-          !is_grid_point_set[flat_idx_s]) {
-        flat_recip_data[flat_idx_s] = F_symm_complex;
-        is_grid_point_set[flat_idx_s] = true;
-      }
-    }
-  }
-}
+struct HalfGridCoefficient {
+  static constexpr auto npos = std::numeric_limits<std::size_t>::max();
+  std::size_t flat_idx = npos; //!< npos if outside the grid
+  std::complex<float> value{};
+  bool friedel{}; //!< value is the Friedel mate of the equivalent
+};
+
+/**
+ * @brief Which coefficient was stored at a grid point
+ */
+enum class CoefficientSource : std::uint8_t { None, Friedel, Direct };
 
 /**
  * @brief Calculate inverse Friedel mate indices for a given HKL and shape.
@@ -3074,158 +2993,232 @@ glm::ivec3 CalculateFriedelMateIndex(
 }
 
 /**
- * @brief Add friedel pair to the reciprocal space data.
- * @param symmetry The symmetry object.
- * @param refln_block The reflection block containing reflection data.
- * @param reciprocal_space_params The parameters for reciprocal space.
- * @return A CFieldTyped<float> object representing the Fourier transformed map.
+ * @brief Apply a symmetry matrix to a reflection and place the result on the
+ * half-complex grid. Equivalents outside the stored half are stored as the
+ * complex conjugate at their Friedel mate.
+ * @param sym_mat The symmetry matrix to apply.
+ * @param hkl_orig The original Miller indices.
+ * @param shape The shape of the full reciprocal space grid.
+ * @param f_amp_weighted The weighted amplitude of the reflection.
+ * @param phase_rad_orig The original phase in radians.
+ * @return The coefficient and its flat index on the half-complex grid
  */
-void AddFriedelMate(const glm::ivec3& hkl_orig,
-    std::size_t recip_1D_total_elements, const glm::ivec3& shape,
-    std::complex<float>* flat_recip_data, std::vector<bool>& is_grid_point_set)
+static HalfGridCoefficient ApplySymMatrixToReflection(
+    const SymMatsGLM& sym_mat, const glm::ivec3& hkl_orig,
+    const glm::ivec3& shape, float f_amp_weighted, float phase_rad_orig)
 {
-  auto flat_idx_hkl = HKLToFlatIndex(hkl_orig, shape);
-
-  auto idx_bar = CalculateFriedelMateIndex(hkl_orig, shape);
-
-  if (IsHKLWithinShape(idx_bar, shape)) {
-    auto flat_idx_bar = HKLToFlatIndex(idx_bar, shape);
-
-    if (flat_idx_bar < recip_1D_total_elements &&
-        !is_grid_point_set[flat_idx_bar]) {
-      flat_recip_data[flat_idx_bar] =
-          std::conj(flat_recip_data[flat_idx_hkl]);
-      is_grid_point_set[flat_idx_bar] = true;
-    }
-    // If flat_idx_hkl == flat_idx_bar (centrosymmetric FFT point),
-    // ensure it's real
-    bool centrosymmetric = flat_idx_hkl == flat_idx_bar;
-    if (centrosymmetric) {
-      auto& recip_data = flat_recip_data[flat_idx_hkl];
-      bool around_zero_and_much_less_than_real =
-          std::abs(recip_data.imag()) > 1e-5f * std::abs(recip_data.real()) &&
-          std::abs(recip_data.imag()) > 1e-5f;
-      if (around_zero_and_much_less_than_real) {
-        recip_data.imag(0.0f);
+  HalfGridCoefficient coef;
+
+  glm::ivec3 hkl_symm = glm::round(sym_mat.rot * hkl_orig);
+  auto phase_shift_rad = CalculatePhaseShift(hkl_orig, sym_mat.trans);
+
+  int idx_h_s = (hkl_symm.x >= 0) ? hkl_symm.x : hkl_symm.x + shape[0];
+  int idx_k_s = (hkl_symm.y >= 0) ? hkl_symm.y : hkl_symm.y + shape[1];
+  int idx_l_s = (hkl_symm.z >= 0) ? hkl_symm.z : hkl_symm.z + shape[2];
+  auto idx_hkl_s = glm::ivec3(idx_h_s, idx_k_s, idx_l_s);
+
+  if (!IsHKLWithinShape(idx_hkl_s, shape)) {
+    return coef;
+  }
+
+  coef.value = std::polar(
+      f_amp_weighted, phase_rad_orig + static_cast<float>(phase_shift_rad));
+
+  if (idx_hkl_s.z > shape[2] / 2) {
+    idx_hkl_s = CalculateFriedelMateIndex(idx_hkl_s, shape);
+    coef.value = std::conj(coef.value);
+    coef.friedel = true;
+  }
+
+  coef.flat_idx = HKLToFlatIndex(
+      idx_hkl_s, glm::ivec3(shape[0], shape[1], shape[2] / 2 + 1));
+  return coef;
+}
+
+/**
+ * @brief Store a coefficient on the half-complex grid. The first direct
+ * equivalent wins, Friedel mates only fill grid points which are still unset.
+ * @param coef The coefficient to store
+ * @param[out] flat_recip_data The flat half-complex grid
+ * @param[in,out] source What has been stored at each grid point
+ */
+static void ScatterCoefficient(const HalfGridCoefficient& coef,
+    std::complex<float>* flat_recip_data,
+    std::vector<CoefficientSource>& source)
+{
+  if (coef.flat_idx == HalfGridCoefficient::npos) {
+    return;
+  }
+
+  auto& src = source[coef.flat_idx];
+  if (coef.friedel ? src != CoefficientSource::None
+                   : src == CoefficientSource::Direct) {
+    return;
+  }
+
+  flat_recip_data[coef.flat_idx] = coef.value;
+  src = coef.friedel ? CoefficientSource::Friedel : CoefficientSource::Direct;
+}
+
+/**
+ * @brief Add Friedel mates in the planes l = 0 and l = shape.z / 2 (even
+ * shape), where both hkl and -hkl are on the half-complex grid.
+ * @param shape The shape of the full reciprocal space grid.
+ * @param[in,out] flat_recip_data The flat half-complex grid
+ * @param[in,out] source What has been stored at each grid point
+ */
+static void AddFriedelMatesInSelfConjugatePlanes(const glm::ivec3& shape,
+    std::complex<float>* flat_recip_data,
+    std::vector<CoefficientSource>& source)
+{
+  glm::ivec3 half_shape(shape[0], shape[1], shape[2] / 2 + 1);
+  int planes[2] = {0, (shape[2] % 2 == 0) ? shape[2] / 2 : 0};
+
+  for (int l_idx : planes) {
+    for (int h_idx = 0; h_idx < shape[0]; ++h_idx) {
+      for (int k_idx = 0; k_idx < shape[1]; ++k_idx) {
+        glm::ivec3 idx_hkl(h_idx, k_idx, l_idx);
+        auto flat_idx_hkl = HKLToFlatIndex(idx_hkl, half_shape);
+        if (source[flat_idx_hkl] != CoefficientSource::Direct) {
+          continue;
+        }
+
+        auto flat_idx_bar = HKLToFlatIndex(
+            CalculateFriedelMateIndex(idx_hkl, shape), half_shape);
+
+        if (flat_idx_bar == flat_idx_hkl) {
+          // centrosymmetric FFT point, must be real
+          flat_recip_data[flat_idx_hkl].imag(0.0f);
+        } else if (source[flat_idx_bar] == CoefficientSource::None) {
+          flat_recip_data[flat_idx_bar] = std::conj(flat_recip_data[flat_idx_hkl]);
+          source[flat_idx_bar] = CoefficientSource::Friedel;
+        }
       }
     }
   }
 }
 
 /**
- * @brief Perform a Fast Fourier Transform in place on the reciprocal grid.
- * @param grid The reciprocal grid data.
+ * @brief Complex-to-real Fast Fourier Transform of the half-complex
+ * reciprocal grid.
+ * @param recip_grid The reciprocal grid data (l < shape.z / 2 + 1)
+ * @param[out] map The real space map, defines the full shape
  */
-static void PerformFastFourierTransformInPlace(
-    CFieldTyped<std::complex<float>>& grid)
+static void PerformFastFourierTransform(PyMOLGlobals* G,
+    const CFieldTyped<std::complex<float>>& recip_grid,
+    CFieldTyped<float>& map)
 {
-  auto* flat_grid = grid.ptr(0, 0, 0);
-  pocketfft::shape_t pocket_shape{static_cast<std::size_t>(grid.dim[0]),
-      static_cast<std::size_t>(grid.dim[1]),
-      static_cast<std::size_t>(grid.dim[2])};
-  auto base_size = grid.base_size;
-
-  // CField is internally a 1D array, so we need to calculate the strides
-  // for the 3D data. Z is contiguous; thus the axis order is ZYX.
-  glm::uvec3 u_strides = {base_size * pocket_shape[2] * pocket_shape[1],
-      base_size * pocket_shape[2], base_size};
-  pocketfft::stride_t stride_in(3);
+  pocketfft::shape_t pocket_shape{static_cast<std::size_t>(map.dim[0]),
+      static_cast<std::size_t>(map.dim[1]),
+      static_cast<std::size_t>(map.dim[2])};
 
+  // CField strides are in bytes, Z is contiguous
+  pocketfft::stride_t stride_in(3), stride_out(3);
   for (int i = 0; i < 3; ++i) {
-    stride_in[i] = static_cast<pocketfft::stride_t::value_type>(u_strides[i]);
+    stride_in[i] = static_cast<std::ptrdiff_t>(recip_grid.stride[i]);
+    stride_out[i] = static_cast<std::ptrdiff_t>(map.stride[i]);
   }
-  auto stride_out = stride_in;
-  pocketfft::shape_t axes{2, 1, 0}; // ZYX
+
+  // Z last, it is the halved axis of the real transform
+  pocketfft::shape_t axes{0, 1, 2};
   bool direction = pocketfft::BACKWARD;
   float norm = 1.0f;
+  auto nthreads = std::max(1, SettingGet<int>(G, cSetting_max_threads));
 
-  pocketfft::c2c<float>(pocket_shape, stride_in, stride_out, axes, direction,
-      flat_grid, flat_grid, norm);
+  pocketfft::c2r<float>(pocket_shape, stride_in, stride_out, axes, direction,
+      recip_grid.ptr(0, 0, 0), map.ptr(0, 0, 0), norm, nthreads);
 }
 
 /**
  * @brief Fourier transform structure factors to a map.
  * @param symmetry The symmetry object.
- * @param refln_block The reflection block containing reflection data.
+ * @param reflections The reflection data.
  * @param reciprocal_space_params The parameters for reciprocal space.
  * @return A CFieldTyped<float> object representing the Fourier transformed map.
  */
 CFieldTyped<float> FourierTransformStructureFactorsToMap(PyMOLGlobals* G,
     const CSymmetry& symmetry,
-    const ReflnBlock& refln_block,
+    const std::vector<ReflectionInfo>& reflections,
     const ReciprocalSpaceParams& reciprocal_space_params)
 {
-  auto shape = FindOptimalGridSize(refln_block, reciprocal_space_params);
-  CFieldTyped<std::complex<float>> recip_grid(glm::value_ptr(shape), 3);
+  auto shape = FindOptimalGridSize(reflections, reciprocal_space_params);
 
-  auto recip_1D_total_elements = shape[0] * shape[1] * shape[2];
-  std::vector<bool> is_grid_point_set(recip_1D_total_elements, false);
+  // only half of the Hermitian reciprocal grid is stored
+  glm::ivec3 half_shape(shape[0], shape[1], shape[2] / 2 + 1);
+  CFieldTyped<std::complex<float>> recip_grid(glm::value_ptr(half_shape), 3);
+  std::vector<CoefficientSource> source(
+      recip_grid.size() / sizeof(std::complex<float>), CoefficientSource::None);
 
   auto* flat_recip_data = recip_grid.ptr(0, 0, 0);
 
   auto sym_matrices = CalculateSymMatricesGLM(symmetry);
+  const std::size_t n_sym = sym_matrices.size();
 
-  for (std::size_t i = 0; i < refln_block.size(); ++i) {
-    auto refl_info = refln_block.getReflectionInfo(i);
-    if (!refl_info) {
-      continue;
-    }
+  // Symmetry expansion runs in parallel in chunks of reflections. Storing
+  // the coefficients follows the reflection order, so the first equivalent
+  // wins independent of the number of threads.
+  const std::size_t chunk_size =
+      std::max<std::size_t>(1, (std::size_t(1) << 20) / std::max<std::size_t>(1, n_sym));
+  std::vector<HalfGridCoefficient> coefs;
 
-    auto hkl_orig = refl_info->hkl;
-    auto f_amp_raw = refl_info->fwt;
-    auto ph_deg_orig = refl_info->phwt;
-    auto fom_val = refl_info->fom;
+  for (std::size_t start = 0; start < reflections.size(); start += chunk_size) {
+    auto stop = std::min(start + chunk_size, reflections.size());
+    coefs.assign((stop - start) * n_sym, HalfGridCoefficient{});
 
-    auto f_amp_weighted = f_amp_raw * fom_val;
-    if (f_amp_weighted == 0.0f &&
-        !(hkl_orig.x == 0 && hkl_orig.y == 0 &&
-            hkl_orig.z == 0)) { // Skip zero amplitude reflections unless F000
-      continue;
-    }
-
-    auto phase_rad_orig = glm::radians(ph_deg_orig);
-    auto F_orig_complex = std::polar(f_amp_weighted, phase_rad_orig);
-
-    ApplySymMatricesToReflections(
-        sym_matrices, hkl_orig, shape, f_amp_weighted, phase_rad_orig,
-        recip_1D_total_elements, flat_recip_data, is_grid_point_set);
-  } // End loop over reflections from CIF
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+    for (long i = start; i < long(stop); ++i) {
+      const auto& refl_info = reflections[i];
+      auto f_amp_weighted = refl_info.fwt * refl_info.fom;
+      if (f_amp_weighted == 0.0f &&
+          refl_info.hkl != glm::ivec3(0)) { // Skip zero amplitude reflections unless F000
+        continue;
+      }
 
-  for (std::size_t h_idx = 0; h_idx < shape[0]; ++h_idx) {
-    for (std::size_t k_idx = 0; k_idx < shape[1]; ++k_idx) {
-      for (std::size_t l_idx = 0; l_idx < shape[2]; ++l_idx) {
-        auto flat_idx_hkl =
-            HKLToFlatIndex(glm::ivec3(h_idx, k_idx, l_idx), shape);
-        if (is_grid_point_set[flat_idx_hkl]) {
-          AddFriedelMate(glm::ivec3(h_idx, k_idx, l_idx), recip_1D_total_elements,
-              shape, flat_recip_data, is_grid_point_set);
-        }
+      auto phase_rad_orig = glm::radians(refl_info.phwt);
+      auto* coefs_i = coefs.data() + (i - start) * n_sym;
+      for (std::size_t j = 0; j < n_sym; ++j) {
+        coefs_i[j] = ApplySymMatrixToReflection(sym_matrices[j], refl_info.hkl,
+            shape, f_amp_weighted, phase_rad_orig);
       }
     }
-  }
 
-  PerformFastFourierTransformInPlace(recip_grid);
-  auto map = NormalizeComplexMapToFloat(G, reciprocal_space_params, recip_grid);
+    for (const auto& coef : coefs) {
+      ScatterCoefficient(coef, flat_recip_data, source);
+    }
+  } // End loop over reflections
+
+  AddFriedelMatesInSelfConjugatePlanes(shape, flat_recip_data, source);
+
+  CFieldTyped<float> map(glm::value_ptr(shape), 3);
+  PerformFastFourierTransform(G, recip_grid, map);
+  NormalizeDensityMap(G, reciprocal_space_params, map);
 #ifdef TRACE
-  PrintReciprocalGridStatistics(recip_grid);
-  PrintRawMapStatistics(refln_block, map);
+  PrintRawMapStatistics(reflections, map);
 #endif // TRACE
   return map;
 }
 
-pymol::Result<ObjectMap*> ObjectMapReadCifStr(
-    PyMOLGlobals* G, const pymol::cif_data& datablock)
+pymol::Result<ObjectMap*> ObjectMapReadReflections(PyMOLGlobals* G,
+    std::unique_ptr<CSymmetry> sym,
+    const std::vector<ReflectionInfo>& reflections)
 {
-  auto I = new ObjectMap(G);
-  initializeTTT44f(I->TTT);
-  I->TTTFlag = false;
+  if (!sym || sym->getNSymMat() < 1) {
+    return pymol::make_error("Unknown space group");
+  }
 
-  ReflnBlock refln_block(datablock);
-  std::unique_ptr<CSymmetry> sym(read_symmetry(G, &datablock));
+  if (reflections.empty()) {
+    return pymol::make_error("No reflections");
+  }
 
   auto reciprocal_space_params = CalculateReciprocalSpaceParam(sym->Crystal);
   auto map = FourierTransformStructureFactorsToMap(
-      G, *sym, refln_block, reciprocal_space_params);
+      G, *sym, reflections, reciprocal_space_params);
+
+  auto I = new ObjectMap(G);
+  initializeTTT44f(I->TTT);
+  I->TTTFlag = false;
 
   I->State.push_back(ObjectMapStateFromField(G, map, std::move(sym)));
   ObjectMapUpdateExtents(I);
@@ -3233,6 +3226,16 @@ pymol::Result<ObjectMap*> ObjectMapReadCifStr(
   return I;
 }
 
+pymol::Result<ObjectMap*> ObjectMapReadCifStr(
+    PyMOLGlobals* G, const pymol::cif_data& datablock)
+{
+  ReflnBlock refln_block(datablock);
+  std::unique_ptr<CSymmetry> sym(read_symmetry(G, &datablock));
+
+  return ObjectMapReadReflections(
+      G, std::move(sym), refln_block.getReflections());
+}
+
 /**
  * Read one or multiple object-molecules from a CIF file. If there is only one
  * or multiplex=0, then return the object-molecule. Otherwise, create each
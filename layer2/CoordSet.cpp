@@ -52,6 +52,8 @@ Z* -------------------------------------------------------------------
 #include"PyMOLObject.h"
 #include "Executive.h"
 #include "Lex.h"
+#include "Util2.h"
+#include "Profiler.h"
 
 #ifdef _PYMOL_IP_PROPERTIES
 #include "Property.h"
@@ -309,6 +311,14 @@ int CoordSetFromPyList(PyMOLGlobals * G, PyObject * list, CoordSet ** cs)
       CPythonVal_Free(val);
     }
 
+    if (ll > 13) {
+      CPythonVal* val = CPythonVal_PyList_GetItem(G, list, 13);
+      if (!CPythonVal_IsNone(val)) {
+        ok = PConvFromPyObject(G, val, I->InstanceMatrices);
+      }
+      CPythonVal_Free(val);
+    }
+
     if(!ok) {
       delete I;
       *cs = nullptr;
@@ -368,7 +378,7 @@ PyObject *CoordSetAsPyList(CoordSet * I)
     auto G = I->G;
     int pse_export_version = SettingGet<float>(G, cSetting_pse_export_version) * 1000;
     bool dump_binary = SettingGet<bool>(G, cSetting_pse_binary_dump) && (!pse_export_version || pse_export_version >= 1765);
-    result = PyList_New(13);
+    result = PyList_New(14);
     PyList_SetItem(result, 0, PyInt_FromLong(I->NIndex));
     int const NAtIndex = I->AtmToIdx.size();
     PyList_SetItem(result, 1, PyInt_FromLong(NAtIndex ? NAtIndex : I->Obj->NAtom)); // legacy
@@ -410,6 +420,7 @@ PyObject *CoordSetAsPyList(CoordSet * I)
       PyList_SetItem(result, 11, PConvAutoNone(nullptr));
     }
     PyList_SetItem(result, 12, SymmetryAsPyList(I->Symmetry.get()));
+    PyList_SetItem(result, 13, PConvToPyObject(I->InstanceMatrices));
     /* TODO spheroid, periodic box ... */
   }
   return (PConvAutoNone(result));
@@ -981,11 +992,11 @@ void CoordSetAtomToPDBStrVLA(PyMOLGlobals * G, char **charVLA, int *c,
 
   if((!pdb_info) || (!pdb_info->is_pqr_file())) { /* relying upon short-circuit */
     short linelen;
-    sprintf(x, "%8.3f", v[0]);
+    pymol::format_fixed(x, v[0], 8, 3);
     x[8] = 0;
-    sprintf(y, "%8.3f", v[1]);
+    pymol::format_fixed(y, v[1], 8, 3);
     y[8] = 0;
-    sprintf(z, "%8.3f", v[2]);
+    pymol::format_fixed(z, v[2], 8, 3);
     z[8] = 0;
     linelen =
       sprintf((*charVLA) + (*c),
@@ -1147,8 +1158,10 @@ PyObject *CoordSetAtomToChemPyAtom(PyMOLGlobals * G, AtomInfoType * ai, ObjectMo
 void CoordSet::invalidateRep(cRep_t type, cRepInv_t level)
 {
   if(level >= cRepInvVisib) {
-    if (Obj)
+    if (Obj) {
       Obj->RepVisCacheValid = false;
+      Obj->invalidateHotColumns();
+    }
   }
   /* graphical representations need redrawing */
   if(level == cRepInvVisib) {
@@ -1245,8 +1258,10 @@ void CoordSet::invalidateRep(cRep_t type, cRepInv_t level)
       if (Rep[rep]) {                                                          \
         assert(Rep[rep]->cs == this);                                          \
         assert(Rep[rep]->getState() == state);                                 \
+        PYMOL_PROFILE_SCOPE(G, "Rep", "Rep::update");                          \
         Rep[rep] = Rep[rep]->update();                                         \
       } else {                                                                 \
+        PYMOL_PROFILE_SCOPE(G, "Rep", #new_fn);                                \
         Rep[rep] = new_fn(this, state);                                        \
         if (Rep[rep]) {                                                        \
           Rep[rep]->fNew = new_fn;                                             \
@@ -1263,6 +1278,7 @@ void CoordSet::invalidateRep(cRep_t type, cRepInv_t level)
 void CoordSet::update(int state)
 {
   assert(G == Obj->G);
+  PYMOL_PROFILE_SCOPE(G, "Object", "CoordSet::update");
 
   OrthoBusyFast(G, 0, cRepCnt);
   RepUpdateMacro(cRepLine, RepWireBondNew, state);
@@ -1519,6 +1535,7 @@ CoordSet::CoordSet(const CoordSet& cs)
   std::copy(std::begin(cs.Name), std::end(cs.Name), std::begin(this->Name));
   this->PeriodicBoxType = cs.PeriodicBoxType;
   this->tmp_index = cs.tmp_index;
+  this->InstanceMatrices = cs.InstanceMatrices;
   this->Coord2IdxReq = cs.Coord2IdxReq;
   this->Coord2IdxDiv = cs.Coord2IdxDiv;
   this->objMolOpInvalidated = cs.objMolOpInvalidated;
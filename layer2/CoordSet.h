@@ -86,13 +86,23 @@ struct CoordSet : CObjectState {
 
   // true if any atom in this coord set has any of the reps in "bitmask" shown
   bool hasRep(int bitmask) {
-    if (Obj->RepVisCache & bitmask)
+    if (Obj->RepVisCache & bitmask) {
+      auto const& visRep = Obj->getHotColumns().visRep;
       for (int idx = 0; idx < NIndex; idx++)
-        if (getAtomInfo(idx)->visRep & bitmask)
+        if (visRep[IdxToAtm[idx]] & bitmask)
           return true;
+    }
     return false;
   }
 
+  /// Number of instances, 0 if not instanced
+  int getNInstance() const { return InstanceMatrices.size() / 16; }
+
+  const double* getInstanceMatrix(int i) const
+  {
+    return InstanceMatrices.data() + i * 16;
+  }
+
   //! Get symmetry if defined, otherwise get it from parent object.
   CSymmetry const* getSymmetry() const
   {
@@ -118,6 +128,10 @@ struct CoordSet : CObjectState {
   int PeriodicBoxType = NoPeriodicity;
   int tmp_index = 0;                /* for saving */
 
+  /* Instancing: if not empty, the coordinate set is rendered once per
+   * transformation (16 doubles each, row-major) instead of in place */
+  std::vector<double> InstanceMatrices;
+
   /* not saved in state */
 
   pymol::vla<RefPosType> RefPos;
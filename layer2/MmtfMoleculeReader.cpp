@@ -76,7 +76,7 @@ CoordSet ** get_assembly_csets(PyMOLGlobals * G,
     " ExecutiveLoad-Detail: Creating assembly '%s'\n", assembly_id ENDFB(G);
 
   int ncsets = assembly->transformListCount;
-  CoordSet ** csets = VLACalloc(CoordSet *, ncsets);
+  AssemblyCSetCollector csets(G);
 
   for (int state = 0; state < ncsets; ++state) {
     auto trans = assembly->transformList + state;
@@ -94,11 +94,10 @@ CoordSet ** get_assembly_csets(PyMOLGlobals * G,
     }
 
     // copy and transform
-    csets[state] = CoordSetCopyFilterChains(cset, atInfo, chains_set);
-    CoordSetTransform44f(csets[state], trans->matrix);
+    csets.add(cset, atInfo, chains_set, trans->matrix);
   }
 
-  return csets;
+  return csets.release();
 }
 #endif
 
@@ -15,6 +15,7 @@ I* Additional authors of this source file include:
 Z* -------------------------------------------------------------------
 */
 #include "os_python.h"
+#include "os_numpy.h"
 
 #include "os_gl.h"
 #include "os_predef.h"
@@ -30,6 +31,7 @@ Z* -------------------------------------------------------------------
 #include "PConv.h"
 #include "Scene.h"
 #include "Setting.h"
+#include "Profiler.h"
 #include "ShaderMgr.h"
 #include "VFont.h"
 #include "main.h"
@@ -216,6 +218,7 @@ void ObjectCGO::invalidate(cRep_t rep, cRepInv_t level, int state)
 
 void ObjectCGO::update()
 {
+  PYMOL_PROFILE_SCOPE(G, "Object", "ObjectCGO::update");
   for (auto& state : State) {
     state.renderCGO = nullptr;
   }
@@ -601,6 +604,44 @@ static CGO* ObjectCGOPyListFloatToCGO(PyMOLGlobals* G, PyObject* list)
 
 /*========================================================================*/
 
+/**
+ * Bulk load a CGO from a NumPy array (any shape, flattened in C order).
+ * A contiguous float32 array is parsed in place, without a Python list.
+ *
+ * @return nullptr if `array` is not a NumPy array
+ */
+static CGO* ObjectCGONumPyToCGO(PyMOLGlobals* G, PyObject* array)
+{
+#ifndef _PYMOL_NUMPY
+  return nullptr;
+#else
+  import_array1(nullptr);
+
+  if (!PyArray_Check(array))
+    return nullptr;
+
+  auto flat = reinterpret_cast<PyArrayObject*>(
+      PyArray_ContiguousFromAny(array, NPY_FLOAT32, 0, 0));
+  if (!flat) {
+    PyErr_Clear();
+    return nullptr;
+  }
+
+  auto const* raw = static_cast<const float*>(PyArray_DATA(flat));
+  int len = PyArray_SIZE(flat);
+  CGO* cgo = CGONewSized(G, len);
+  int result = CGOFromFloatArray(cgo, raw, len);
+  if (result) {
+    PRINTF " FloatToCGO: error encountered on element %d\n", result ENDF(G);
+  }
+  CGOStop(cgo);
+  Py_DECREF(flat);
+  return cgo;
+#endif
+}
+
+/*========================================================================*/
+
 static CGO* ObjectCGOFloatArrayToCGO(
     PyMOLGlobals* G, float* raw, int len, int quiet)
 {
@@ -714,25 +755,33 @@ ObjectCGO* ObjectCGODefine(
 
   I->State[state].origCGO = nullptr;
 
+  cgo = nullptr;
   if (PyList_Check(pycgo)) {
     if (PyList_Size(pycgo)) {
       if (PyFloat_Check(PyList_GetItem(pycgo, 0))) {
         cgo = ObjectCGOPyListFloatToCGO(G, pycgo);
-        if (cgo) {
-          est = CGOCheckForText(cgo);
-          if (est) {
-            CGOPreloadFonts(cgo);
-            font_cgo = CGODrawText(cgo, est, nullptr);
-            CGOFree(cgo);
-            cgo = font_cgo;
-          }
-          est = CGOCheckComplex(cgo);
-          I->State[state].origCGO.reset(cgo);
-        } else {
+        if (!cgo) {
           ErrMessage(G, "ObjectCGO", "could not parse CGO List.");
         }
       }
     }
+  } else {
+    cgo = ObjectCGONumPyToCGO(G, pycgo);
+    if (!cgo) {
+      ErrMessage(G, "ObjectCGO", "could not parse CGO array.");
+    }
+  }
+
+  if (cgo) {
+    est = CGOCheckForText(cgo);
+    if (est) {
+      CGOPreloadFonts(cgo);
+      font_cgo = CGODrawText(cgo, est, nullptr);
+      CGOFree(cgo);
+      cgo = font_cgo;
+    }
+    est = CGOCheckComplex(cgo);
+    I->State[state].origCGO.reset(cgo);
   }
   if (I) {
     ObjectCGORecomputeExtent(I);
@@ -38,6 +38,8 @@ Z* -------------------------------------------------------------------
 #include"PyMOLObject.h"
 #include "Feedback.h"
 
+#include <vector>
+
 static void ObjectGadgetRampBuild(ObjectGadgetRamp *);
 static int ObjectGadgetRampHandleInputColors(ObjectGadgetRamp *);
 
@@ -467,28 +469,39 @@ int ObjectGadgetRampNewFromPyList(PyMOLGlobals * G, PyObject * list,
   return (ok);
 }
 
+/**
+ * Source map of a map ramp and the map state to use for `state`
+ * @return nullptr if the map is gone
+ */
+static ObjectMap* ObjectGadgetRampGetMap(
+    ObjectGadgetRamp* I, int state, int* src_state)
+{
+  if(!I->Map)
+    I->Map = ExecutiveFindObjectMapByName(I->G, I->SrcName);
+  if(!ExecutiveValidateObjectPtr(I->G, I->Map, cObjectMap))
+    return nullptr;
+
+  if(I->SrcState >= 0)
+    *src_state = I->SrcState;
+  else
+    *src_state = state;
+  if(*src_state < 0)
+    *src_state = SceneGetState(I->G);
+  return I->Map;
+}
+
 int ObjectGadgetRampInterVertex(ObjectGadgetRamp * I, const float *pos, float *color, int state)
 {
   float level;
   int ok = true;
   switch (I->RampType) {
   case cRampMap:
-    if(!I->Map)
-      I->Map = ExecutiveFindObjectMapByName(I->G, I->SrcName);
-    if(!ExecutiveValidateObjectPtr(I->G, I->Map, cObjectMap))
-      ok = false;
-    else {
+    {
       int src_state;
-      if(I->SrcState >= 0)
-        src_state = I->SrcState;
-      else
-        src_state = state;
-      if(src_state < 0)
-        src_state = SceneGetState(I->G);
+      ObjectMap* map = ObjectGadgetRampGetMap(I, state, &src_state);
+      ok = (map != nullptr);
       if(ok)
-        ok = (I->Map != nullptr);
-      if(ok)
-        ok = ObjectMapInterpolate(I->Map, src_state, pos, &level, nullptr, 1);
+        ok = ObjectMapInterpolate(map, src_state, pos, &level, nullptr, 1);
       if(ok)
         ok = ObjectGadgetRampInterpolate(I, level, color);
     }
@@ -580,6 +593,42 @@ int ObjectGadgetRampInterVertex(ObjectGadgetRamp * I, const float *pos, float *c
   return (ok);
 }
 
+/**
+ * Ramp colors for `n` vertices. For map ramps, all vertices are looked up
+ * with a single batched map interpolation.
+ * @param pos Vertex coordinates (3 * n)
+ * @param[out] color RGB colors (3 * n)
+ * @return False if the ramp source is missing (`color` is not written then)
+ */
+int ObjectGadgetRampInterVertices(ObjectGadgetRamp * I, const float *pos, float *color,
+                                  int n, int state)
+{
+  if(n < 1)
+    return true;
+
+  if(I->RampType != cRampMap) {
+    for(int i = 0; i < n; ++i) {
+      if(!ObjectGadgetRampInterVertex(I, pos + 3 * i, color + 3 * i, state))
+        return false;
+    }
+    return true;
+  }
+
+  int src_state;
+  ObjectMap* map = ObjectGadgetRampGetMap(I, state, &src_state);
+  if(!map)
+    return false;
+
+  std::vector<float> level(n);
+  if(!ObjectMapInterpolate(map, src_state, pos, level.data(), nullptr, n))
+    return false;
+
+  for(int i = 0; i < n; ++i)
+    ObjectGadgetRampInterpolate(I, level[i], color + 3 * i);
+
+  return true;
+}
+
 static void ObjectGadgetRampUpdateCGO(ObjectGadgetRamp * I, GadgetSet * gs)
 {
   CGO *cgo;
@@ -94,6 +94,8 @@ ObjectGadgetRamp *ObjectGadgetRampMolNewAsDefined(PyMOLGlobals * G,
 int ObjectGadgetRampInterpolate(ObjectGadgetRamp * I, float level, float *color);
 int ObjectGadgetRampInterVertex(ObjectGadgetRamp * I, const float *pos, float *color,
                                 int state);
+int ObjectGadgetRampInterVertices(ObjectGadgetRamp * I, const float *pos, float *color,
+                                  int n, int state);
 
 PyObject *ObjectGadgetRampAsPyList(ObjectGadgetRamp * I);
 int ObjectGadgetRampNewFromPyList(PyMOLGlobals * G, PyObject * list,
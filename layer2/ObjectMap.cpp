@@ -43,10 +43,12 @@ Z* -------------------------------------------------------------------
 #include"ShaderMgr.h"
 #include"CGO.h"
 #include"File.h"
+#include "FileStream.h"
 #include"Executive.h"
 #include"Field.h"
 #include "Feedback.h"
 #include "Util2.h"
+#include "Profiler.h"
 
 #define n_space_group_numbers 231
 static const char * space_group_numbers[] = {
@@ -170,6 +172,17 @@ int ObjectMapStateGetExcludedStats(PyMOLGlobals * G, ObjectMapState * ms, float
   if(cutoff < within)
     cutoff = within;
 
+  if(!list_size) {
+    /* whole map, use the cached statistics */
+    const auto& stats = IsofieldGetStats(G, ms->Field.get());
+    if(stats.count()) {
+      level[1] = stats.mean();
+      level[0] = stats.mean() - stats.stdev();
+      level[2] = stats.mean() + stats.stdev();
+    }
+    return stats.count();
+  }
+
   /* make a new map from the VLA .............. */
   if(list_size)
     voxelmap = new MapType(G, -cutoff, vert_vla, list_size, nullptr);
@@ -252,24 +265,10 @@ int ObjectMapStateGetExcludedStats(PyMOLGlobals * G, ObjectMapState * ms, float
 int ObjectMapStateGetDataRange(PyMOLGlobals * G, ObjectMapState * ms, float *min,
                                float *max)
 {
-float max_val = 0.0F, min_val = 0.0F;
-  CField *data = ms->Field->data.get();
-  int cnt = data->dim[0] * data->dim[1] * data->dim[2];
-  float *raw_data = (float *) data->data.data();
-  if(cnt) {
-    int a;
-    min_val = (max_val = *(raw_data++));
-    for(a = 1; a < cnt; a++) {
-      double f_val = *(raw_data++);
-      if(min_val > f_val)
-        min_val = f_val;
-      if(max_val < f_val)
-        max_val = f_val;
-    }
-  }
-  *min = min_val;
-  *max = max_val;
-  return cnt;
+  const auto& stats = IsofieldGetStats(G, ms->Field.get());
+  *min = stats.min();
+  *max = stats.max();
+  return stats.count();
 }
 
 /* MapState::ObjectMapStateGetHistogram -- compute a map histogram
@@ -292,60 +291,29 @@ int ObjectMapStateGetHistogram(PyMOLGlobals * G, ObjectMapState * ms,
                                int n_points, float limit, float *histogram,
                                float min_arg, float max_arg)
 {
-  float max_val = 0.0f, min_val = 0.0f;
-  float sum = 0.0f, sumsq = 0.0f;
-  float min_his, max_his, irange, mean, stdev;
-  int pos;
-  CField *data = ms->Field->data.get();
-  int cnt = data->dim[0] * data->dim[1] * data->dim[2];
-  float *raw_data = (float *) data->data.data();
+  auto& stats = IsofieldGetStats(G, ms->Field.get());
+  int cnt = stats.count();
   if(cnt) {
-    int a;
-
-    // compute min/max/mean/stdev
-    sum = min_val = (max_val = *(raw_data++));
-    sumsq = sum*sum;
-    for(a = 1; a < cnt; a++) {
-      double f_val = *(raw_data++);
-      if(min_val > f_val)
-        min_val = f_val;
-      if(max_val < f_val)
-        max_val = f_val;
-      sum += f_val;
-      sumsq += f_val*f_val;
-    }
-    mean = (float) (sum / cnt);
-    stdev = (float) sqrt1d((sumsq - (sum * sum / cnt)) / (cnt));
+    float min_his, max_his;
+    const float mean = stats.mean();
+    const float stdev = stats.stdev();
 
     // adjust min/max to limit
     if (min_arg != max_arg) {
       min_his = min_arg;
       max_his = max_arg;
     } else if (limit > 0.0F) {
-      min_his = mean - limit*stdev;
-      if (min_his < min_val)
-        min_his = min_val;
-      max_his = mean + limit*stdev;
-      if (max_his > max_val)
-        max_his = max_val;
+      min_his = std::max(mean - limit * stdev, stats.min());
+      max_his = std::min(mean + limit * stdev, stats.max());
     } else {
-      min_his = min_val;
-      max_his = max_val;
+      min_his = stats.min();
+      max_his = stats.max();
     }
 
-    // Compute the histogram
     if(n_points > 0) {
-      irange = (float)(n_points-1) / (max_his - min_his);
-      for (a = 0; a < n_points; a++)
-        histogram[a+4] = 0.0f;
-      raw_data = (float *) data->data.data();
-      for (a = 0; a < cnt; a++) {
-        double f_val = *(raw_data++);
-        pos = (int)(irange * (f_val-min_his));
-        if (pos >= 0 && pos < n_points) {
-          histogram[pos+4] += 1.0;
-        }
-      }
+      const auto& counts =
+          stats.histogram(*ms->Field->data, n_points, min_his, max_his);
+      std::copy(counts.begin(), counts.end(), histogram + 4);
     }
     histogram[0] = min_his;
     histogram[1] = max_his;
@@ -360,6 +328,162 @@ int ObjectMapStateGetHistogram(PyMOLGlobals * G, ObjectMapState * ms,
   return cnt;
 }
 
+/**
+ * True if both states sample the same points in the same memory layout,
+ * i.e. values can be used without interpolation.
+ */
+bool ObjectMapStateSameGrid(ObjectMapState* a, ObjectMapState* b)
+{
+  if(a == b)
+    return true;
+
+  if(ObjectStateGetMatrix(a) || ObjectStateGetMatrix(b))
+    return false;
+
+  for (int d = 0; d < 3; ++d) {
+    if(a->Min[d] != b->Min[d] || a->FDim[d] != b->FDim[d])
+      return false;
+  }
+
+  const bool xtal = ObjectMapStateValidXtal(a);
+  if(xtal != bool(ObjectMapStateValidXtal(b)))
+    return false;
+
+  const float tol = R_SMALL4;
+
+  if(xtal) {
+    const float* m1 = a->Symmetry->Crystal.realToFrac();
+    const float* m2 = b->Symmetry->Crystal.realToFrac();
+    for (int d = 0; d < 3; ++d) {
+      if(a->Div[d] != b->Div[d])
+        return false;
+    }
+    for (int i = 0; i < 9; ++i) {
+      if(fabsf(m1[i] - m2[i]) > tol * (fabsf(m1[i]) + tol))
+        return false;
+    }
+  } else {
+    for (int d = 0; d < 3; ++d) {
+      if(fabsf(a->Grid[d] - b->Grid[d]) > tol * a->Grid[d] ||
+          fabsf(a->Origin[d] - b->Origin[d]) > tol * a->Grid[d])
+        return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Affine transform (3x4, row-major) from model space coordinates to
+ * continuous grid indices, i.e. fractional coordinates times Div for
+ * crystallographic maps and (v - Origin) / Grid otherwise.
+ */
+static void ObjectMapStateGetGridTransform(ObjectMapState* ms, float* m)
+{
+  if(ObjectMapStateValidXtal(ms)) {
+    const float* realToFrac = ms->Symmetry->Crystal.realToFrac();
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j)
+        m[4 * i + j] = ms->Div[i] * realToFrac[3 * i + j];
+      m[4 * i + 3] = 0.0F;
+    }
+  } else {
+    for (int i = 0; i < 3; ++i) {
+      m[4 * i + 0] = m[4 * i + 1] = m[4 * i + 2] = 0.0F;
+      m[4 * i + i] = 1.0F / ms->Grid[i];
+      m[4 * i + 3] = -ms->Origin[i] / ms->Grid[i];
+    }
+  }
+}
+
+/**
+ * Batched trilinear interpolation with grid transform `m` (see
+ * ObjectMapStateGetGridTransform). Points are independent, large batches
+ * are split across threads.
+ *
+ * Out of bounds handling: Crystallographic maps accept points within 0.01
+ * grid units of the edges, other maps clamp to the edge value.
+ *
+ * @see ObjectMapStateInterpolate for parameter description
+ */
+static int ObjectMapStateInterpolateGrid(ObjectMapState* ms, const float* m,
+    const float* array, float* result, std::uint8_t* flag, int n)
+{
+  const bool xtal = ObjectMapStateValidXtal(ms);
+  const CField* field = ms->Field->data.get();
+  const char* data = field->data.data();
+  int stride[3], fdim[3], hi[3];
+
+  for (int d = 0; d < 3; ++d) {
+    stride[d] = field->stride[d];
+    fdim[d] = field->dim[d];
+    hi[d] = xtal ? (ms->FDim[d] + ms->Min[d] - 1) : ms->Max[d];
+  }
+
+  int ok = true;
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for reduction(&&:ok) if(n > 4096)
+#endif
+  for (int i = 0; i < n; ++i) {
+    const float* v = array + 3 * i;
+    int index[3];
+    float fract[3];
+    bool inside = true;
+
+    for (int d = 0; d < 3; ++d) {
+      float x = m[4 * d] * v[0] + m[4 * d + 1] * v[1] + m[4 * d + 2] * v[2] +
+                m[4 * d + 3];
+      int a = (int) floorf(x + R_SMALL8);
+      x -= a;
+
+      if(a < ms->Min[d]) {
+        if(!xtal || x < 0.99F)
+          inside = false;
+        x = 0.0F;
+        a = ms->Min[d];
+      } else if(a >= hi[d]) {
+        if(!xtal || x > 0.01F)
+          inside = false;
+        if(xtal) {
+          x = 0.0F;
+          a = hi[d];
+        } else {
+          x = 1.0F;
+          a = hi[d] - 1;
+        }
+      }
+
+      index[d] = a - ms->Min[d];
+      fract[d] = x;
+    }
+
+    /* neighbor offsets, zero on the last grid plane (where weight is zero) */
+    const int sa = (index[0] + 1 < fdim[0]) ? stride[0] : 0;
+    const int sb = (index[1] + 1 < fdim[1]) ? stride[1] : 0;
+    const int sc = (index[2] + 1 < fdim[2]) ? stride[2] : 0;
+    const char* p = data + index[0] * stride[0] + index[1] * stride[1] +
+                    index[2] * stride[2];
+    auto at = [p](int offset) { return *(const float*) (p + offset); };
+
+    const float x = fract[0], y = fract[1], z = fract[2];
+    const float c00 = at(0) * (1.0F - z) + at(sc) * z;
+    const float c01 = at(sb) * (1.0F - z) + at(sb + sc) * z;
+    const float c10 = at(sa) * (1.0F - z) + at(sa + sc) * z;
+    const float c11 = at(sa + sb) * (1.0F - z) + at(sa + sb + sc) * z;
+
+    result[i] = (c00 * (1.0F - y) + c01 * y) * (1.0F - x) +
+                (c10 * (1.0F - y) + c11 * y) * x;
+
+    if(flag)
+      flag[i] = inside;
+    if(!inside)
+      ok = false;
+  }
+
+  return ok;
+}
+
 /**
  * @see ObjectMapStateInterpolate for parameter description
  * @param state Object state (can be -2 for current state)
@@ -368,38 +492,61 @@ int ObjectMapStateGetHistogram(PyMOLGlobals * G, ObjectMapState * ms,
 int ObjectMapInterpolate(ObjectMap* I, int state, const float* array,
     float* result, std::uint8_t* flag, int n)
 {
-  int ok = false;
-  float txf_buffer[3];
-  float *txf = txf_buffer;
-
   ObjectMapState *ms = ObjectMapGetState(I, state);
 
-  if(ms) {
-    const double *matrix = ObjectStateGetInvMatrix(ms);
-
-    if(matrix) {
-      /* we have to back-transform points */
-      if(n > 1) {
-        txf = pymol::malloc<float>(3 * n);
-      }
-
-      const float *src = array;
-      float *dst = txf;
-      array = txf;
+  if(!ms)
+    return false;
 
-      for (int nn = n; nn--; src += 3, dst += 3) {
-        transform44d3f(matrix, src, dst);
+  float m[12];
+  ObjectMapStateGetGridTransform(ms, m);
+
+  const double *matrix = ObjectStateGetInvMatrix(ms);
+
+  if(matrix && n == 1) {
+    /* single point: back-transforming it is cheaper than the fold below */
+    float txf[3];
+    transform44d3f(matrix, array, txf);
+    ObjectMapStateInterpolateGrid(ms, m, txf, result, flag, 1);
+  } else if(matrix) {
+    /* fold the back-transformation of points into the grid transform */
+    float combined[12];
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        double sum = (j == 3) ? m[4 * i + 3] : 0.0;
+        for (int k = 0; k < 3; ++k)
+          sum += m[4 * i + k] * matrix[4 * k + j];
+        combined[4 * i + j] = (float) sum;
       }
     }
-
-    ok = ObjectMapStateInterpolate(ms, array, result, flag, n);
-    ok = true;
+    ObjectMapStateInterpolateGrid(ms, combined, array, result, flag, n);
+  } else {
+    ObjectMapStateInterpolateGrid(ms, m, array, result, flag, n);
   }
 
-  if(txf != txf_buffer)
-    FreeP(txf);
+  return true;
+}
 
-  return (ok);
+/**
+ * Copy points and data of the sub-block of `src` which starts at `offset`
+ * and has the dimensions of `dst`. Rows along the fastest axis are copied
+ * as a whole.
+ */
+static void IsofieldCopyRegion(
+    Isofield* dst, const Isofield* src, const int* offset)
+{
+  const int* dim = dst->dimensions;
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+  for(int a = 0; a < dim[0]; a++) {
+    for(int b = 0; b < dim[1]; b++) {
+      const int d = a + offset[0], e = b + offset[1], f = offset[2];
+      std::copy_n(F4Ptr(src->points, d, e, f, 0), 3 * dim[2],
+          F4Ptr(dst->points, a, b, 0, 0));
+      std::copy_n(F3Ptr(src->data, d, e, f), dim[2], F3Ptr(dst->data, a, b, 0));
+    }
+  }
 }
 
 static void ObjectMapStateTrim(PyMOLGlobals * G, ObjectMapState * ms,
@@ -409,8 +556,8 @@ static void ObjectMapStateTrim(PyMOLGlobals * G, ObjectMapState * ms,
   int min[3];
   int fdim[4];
   int new_min[3], new_max[3], new_fdim[3];
-  int a, b, c, d, e, f;
-  float *vt, *vr;
+  int offset[3];
+  int a, b, c, d, e;
   float v[3];
   float grid[3];
   Isofield *field;
@@ -485,19 +632,9 @@ static void ObjectMapStateTrim(PyMOLGlobals * G, ObjectMapState * ms,
       field = new Isofield(G, new_fdim);
       field->save_points = ms->Field->save_points;
 
-      for(c = 0; c < new_fdim[2]; c++) {
-        f = c + (new_min[2] - min[2]);
-        for(b = 0; b < new_fdim[1]; b++) {
-          e = b + (new_min[1] - min[1]);
-          for(a = 0; a < new_fdim[0]; a++) {
-            d = a + (new_min[0] - min[0]);
-            vt = F4Ptr(field->points, a, b, c, 0);
-            vr = F4Ptr(ms->Field->points, d, e, f, 0);
-            copy3f(vr, vt);
-            F3(field->data, a, b, c) = F3(ms->Field->data, d, e, f);
-          }
-        }
-      }
+      for(a = 0; a < 3; a++)
+        offset[a] = new_min[a] - min[a];
+      IsofieldCopyRegion(field, ms->Field.get(), offset);
       for(a = 0; a < 3; a++) {
         ms->Min[a] = new_min[a];
         ms->Max[a] = new_max[a];
@@ -589,19 +726,9 @@ static void ObjectMapStateTrim(PyMOLGlobals * G, ObjectMapState * ms,
       field = new Isofield(G, new_fdim);
       field->save_points = ms->Field->save_points;
 
-      for(c = 0; c < new_fdim[2]; c++) {
-        f = c + (new_min[2] - min[2]);
-        for(b = 0; b < new_fdim[1]; b++) {
-          e = b + (new_min[1] - min[1]);
-          for(a = 0; a < new_fdim[0]; a++) {
-            d = a + (new_min[0] - min[0]);
-            vt = F4Ptr(field->points, a, b, c, 0);
-            vr = F4Ptr(ms->Field->points, d, e, f, 0);
-            copy3f(vr, vt);
-            F3(field->data, a, b, c) = F3(ms->Field->data, d, e, f);
-          }
-        }
-      }
+      for(a = 0; a < 3; a++)
+        offset[a] = new_min[a] - min[a];
+      IsofieldCopyRegion(field, ms->Field.get(), offset);
       for(a = 0; a < 3; a++) {
         ms->Min[a] = new_min[a];
         ms->Max[a] = new_max[a];
@@ -640,16 +767,25 @@ static void ObjectMapStateTrim(PyMOLGlobals * G, ObjectMapState * ms,
   }
 }
 
+/**
+ * Value at point (a, b, c) of a grid with half the spacing of `field`
+ */
+static float ObjectMapDoubledValue(CField* field, int a, int b, int c)
+{
+  if((a & 0x1) || (b & 0x1) || (c & 0x1)) {
+    return FieldInterpolatef(field, a / 2, b / 2, c / 2, (a & 0x1) ? 0.5F : 0.0F,
+        (b & 0x1) ? 0.5F : 0.0F, (c & 0x1) ? 0.5F : 0.0F);
+  }
+  return F3(field, a / 2, b / 2, c / 2);
+}
+
 static void ObjectMapStateDouble(PyMOLGlobals * G, ObjectMapState * ms)
 {
   int div[3];
   int min[3];
   int max[3];
   int fdim[4];
-  int a, b, c;
-  float v[3], vr[3];
-  float *vt;
-  float x, y, z;
+  int a;
   float grid[3];
 
   Isofield *field;
@@ -664,24 +800,20 @@ static void ObjectMapStateDouble(PyMOLGlobals * G, ObjectMapState * ms)
     fdim[3] = 3;
     field = new Isofield(G, fdim);
     field->save_points = ms->Field->save_points;
-    for(c = 0; c < fdim[2]; c++) {
-      v[2] = (c + min[2]) / ((float) div[2]);
-      z = (c & 0x1) ? 0.5F : 0.0F;
-      for(b = 0; b < fdim[1]; b++) {
+    const float* fracToReal = ms->Symmetry->Crystal.fracToReal();
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+    for(int a = 0; a < fdim[0]; a++) {
+      float v[3], vr[3];
+      v[0] = (a + min[0]) / ((float) div[0]);
+      for(int b = 0; b < fdim[1]; b++) {
         v[1] = (b + min[1]) / ((float) div[1]);
-        y = (b & 0x1) ? 0.5F : 0.0F;
-        for(a = 0; a < fdim[0]; a++) {
-          v[0] = (a + min[0]) / ((float) div[0]);
-          transform33f3f(ms->Symmetry->Crystal.fracToReal(), v, vr);
-          x = (a & 0x1) ? 0.5F : 0.0F;
-          vt = F4Ptr(field->points, a, b, c, 0);
-          copy3f(vr, vt);
-          if((a & 0x1) || (b & 0x1) || (c & 0x1)) {
-            F3(field->data, a, b, c) = FieldInterpolatef(ms->Field->data.get(),
-                                                         a / 2, b / 2, c / 2, x, y, z);
-          } else {
-            F3(field->data, a, b, c) = F3(ms->Field->data, a / 2, b / 2, c / 2);
-          }
+        for(int c = 0; c < fdim[2]; c++) {
+          v[2] = (c + min[2]) / ((float) div[2]);
+          transform33f3f(fracToReal, v, vr);
+          copy3f(vr, F4Ptr(field->points, a, b, c, 0));
+          F3(field->data, a, b, c) = ObjectMapDoubledValue(ms->Field->data.get(), a, b, c);
         }
       }
     }
@@ -705,23 +837,18 @@ static void ObjectMapStateDouble(PyMOLGlobals * G, ObjectMapState * ms)
     field = new Isofield(G, fdim);
     field->save_points = ms->Field->save_points;
 
-    for(c = 0; c < fdim[2]; c++) {
-      v[2] = ms->Origin[2] + grid[2] * (c + min[2]);
-      z = (c & 0x1) ? 0.5F : 0.0F;
-      for(b = 0; b < fdim[1]; b++) {
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+    for(int a = 0; a < fdim[0]; a++) {
+      float v[3];
+      v[0] = ms->Origin[0] + grid[0] * (a + min[0]);
+      for(int b = 0; b < fdim[1]; b++) {
         v[1] = ms->Origin[1] + grid[1] * (b + min[1]);
-        y = (b & 0x1) ? 0.5F : 0.0F;
-        for(a = 0; a < fdim[0]; a++) {
-          v[0] = ms->Origin[0] + grid[0] * (a + min[0]);
-          x = (a & 0x1) ? 0.5F : 0.0F;
-          vt = F4Ptr(field->points, a, b, c, 0);
-          copy3f(v, vt);
-          if((a & 0x1) || (b & 0x1) || (c & 0x1)) {
-            F3(field->data, a, b, c) = FieldInterpolatef(ms->Field->data.get(),
-                                                         a / 2, b / 2, c / 2, x, y, z);
-          } else {
-            F3(field->data, a, b, c) = F3(ms->Field->data, a / 2, b / 2, c / 2);
-          }
+        for(int c = 0; c < fdim[2]; c++) {
+          v[2] = ms->Origin[2] + grid[2] * (c + min[2]);
+          copy3f(v, F4Ptr(field->points, a, b, c, 0));
+          F3(field->data, a, b, c) = ObjectMapDoubledValue(ms->Field->data.get(), a, b, c);
         }
       }
     }
@@ -745,16 +872,13 @@ static void ObjectMapStateHalve(PyMOLGlobals * G, ObjectMapState * ms, int smoot
   int max[3];
   int fdim[4];
   int a, b, c;
-  float v[3], vr[3];
-  float *vt;
-  float x, y, z;
+  float v[3];
   float grid[3];
 
   Isofield *field;
 
   if(ObjectMapStateValidXtal(ms)) {
     int *old_div, *old_min, *old_max;
-    int a_2, b_2, c_2;
 
     for(a = 0; a < 3; a++) {
       div[a] = ms->Div[a] / 2;
@@ -776,8 +900,10 @@ static void ObjectMapStateHalve(PyMOLGlobals * G, ObjectMapState * ms, int smoot
     old_min = ms->Min;
     old_max = ms->Max;
 
-    if(smooth)
+    if(smooth) {
       FieldSmooth3f(ms->Field->data.get());
+      IsofieldDataChanged(ms->Field.get());
+    }
 
     field = new Isofield(G, fdim);
     field->save_points = ms->Field->save_points;
@@ -789,35 +915,38 @@ static void ObjectMapStateHalve(PyMOLGlobals * G, ObjectMapState * ms, int smoot
        printf("%d %d %d\n",ms->FDim[0],ms->FDim[1],ms->FDim[2]);
      */
 
-    for(c = 0; c < fdim[2]; c++) {
-      v[2] = (c + min[2]) / ((float) div[2]);
-      c_2 = (c + min[2]) * 2 - old_min[2];
-      z = (v[2] - ((c_2 + old_min[2]) / (float) old_div[2])) * old_div[2];
-      if(c_2 >= old_max[2]) {
-        c_2 = old_max[2] - 1;
-        z = (v[2] - ((c_2 + old_min[2]) / (float) old_div[2])) * old_div[2];
+    /* per-axis fractional coordinates and source cells */
+    std::vector<float> frac[3], fract[3];
+    std::vector<int> index[3];
+    for(int d = 0; d < 3; d++) {
+      frac[d].resize(fdim[d]);
+      fract[d].resize(fdim[d]);
+      index[d].resize(fdim[d]);
+      for(int i = 0; i < fdim[d]; i++) {
+        float f = (i + min[d]) / ((float) div[d]);
+        int i_2 = (i + min[d]) * 2 - old_min[d];
+        if(i_2 >= old_max[d])
+          i_2 = old_max[d] - 1;
+        frac[d][i] = f;
+        index[d][i] = i_2;
+        fract[d][i] = (f - ((i_2 + old_min[d]) / (float) old_div[d])) * old_div[d];
       }
-      for(b = 0; b < fdim[1]; b++) {
-        v[1] = (b + min[1]) / ((float) div[1]);
-        b_2 = (b + min[1]) * 2 - old_min[1];
-        y = (v[1] - ((b_2 + old_min[1]) / (float) old_div[1])) * old_div[1];
-        if(b_2 >= old_max[1]) {
-          b_2 = old_max[1] - 1;
-          y = (v[1] - ((b_2 + old_min[1]) / (float) old_div[1])) * old_div[1];
-        }
-        for(a = 0; a < fdim[0]; a++) {
-          v[0] = (a + min[0]) / ((float) div[0]);
-          a_2 = (a + min[0]) * 2 - old_min[0];
-          x = (v[0] - ((a_2 + old_min[0]) / (float) old_div[0])) * old_div[0];
-          if(a_2 >= old_max[0]) {
-            a_2 = old_max[0] - 1;
-            x = (v[0] - ((a_2 + old_min[0]) / (float) old_div[0])) * old_div[0];
-          }
-          transform33f3f(ms->Symmetry->Crystal.fracToReal(), v, vr);
-          vt = F4Ptr(field->points, a, b, c, 0);
-          copy3f(vr, vt);
-          F3(field->data, a, b, c) = FieldInterpolatef(ms->Field->data.get(),
-                                                       a_2, b_2, c_2, x, y, z);
+    }
+
+    const float* fracToReal = ms->Symmetry->Crystal.fracToReal();
+    CField* old_data = ms->Field->data.get();
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+    for(int a = 0; a < fdim[0]; a++) {
+      for(int b = 0; b < fdim[1]; b++) {
+        for(int c = 0; c < fdim[2]; c++) {
+          const float fv[3] = {frac[0][a], frac[1][b], frac[2][c]};
+          transform33f3f(fracToReal, fv, F4Ptr(field->points, a, b, c, 0));
+          F3(field->data, a, b, c) = FieldInterpolatef(old_data,
+              index[0][a], index[1][b], index[2][c],
+              fract[0][a], fract[1][b], fract[2][c]);
         }
       }
     }
@@ -873,14 +1002,17 @@ static void ObjectMapStateHalve(PyMOLGlobals * G, ObjectMapState * ms, int smoot
     field = new Isofield(G, fdim);
     field->save_points = ms->Field->save_points;
 
-    for(c = 0; c < fdim[2]; c++) {
-      v[2] = ms->Origin[2] + grid[2] * (c + min[2]);
-      for(b = 0; b < fdim[1]; b++) {
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for
+#endif
+    for(int a = 0; a < fdim[0]; a++) {
+      float v[3];
+      v[0] = ms->Origin[0] + grid[0] * (a + min[0]);
+      for(int b = 0; b < fdim[1]; b++) {
         v[1] = ms->Origin[1] + grid[1] * (b + min[1]);
-        for(a = 0; a < fdim[0]; a++) {
-          v[0] = ms->Origin[0] + grid[0] * (a + min[0]);
-          vt = F4Ptr(field->points, a, b, c, 0);
-          copy3f(v, vt);
+        for(int c = 0; c < fdim[2]; c++) {
+          v[2] = ms->Origin[2] + grid[2] * (c + min[2]);
+          copy3f(v, F4Ptr(field->points, a, b, c, 0));
           F3(field->data, a, b, c) = F3(ms->Field->data, a * 2, b * 2, c * 2);
         }
       }
@@ -1016,169 +1148,9 @@ int ObjectMapStateContainsPoint(ObjectMapState * ms, float *point)
 int ObjectMapStateInterpolate(
     ObjectMapState* ms, const float* array, float* result, std::uint8_t* flag, int n)
 {
-  int ok = true;
-  const float *inp;
-  int a, b, c;
-  float x, y, z;
-  inp = array;
-
-  if(ObjectMapStateValidXtal(ms)) {
-    float frac[3];
-
-    while(n--) {
-      /* get the fractional coordinate */
-      transform33f3f(ms->Symmetry->Crystal.realToFrac(), inp, frac);
-
-      inp += 3;
-
-      /* compute the effective lattice offset as a function of cell spacing */
-
-      x = (ms->Div[0] * frac[0]);
-      y = (ms->Div[1] * frac[1]);
-      z = (ms->Div[2] * frac[2]);
-
-      /* now separate the integral and fractional parts for interpolation */
-
-      a = (int) floor(x + R_SMALL8);
-      b = (int) floor(y + R_SMALL8);
-      c = (int) floor(z + R_SMALL8);
-      x -= a;
-      y -= b;
-      z -= c;
-
-      if(flag)
-        *flag = 1;
-      /* wrap into the map */
-
-      if(a < ms->Min[0]) {
-        if(x < 0.99F) {
-          ok = false;
-          if(flag)
-            *flag = 0;
-        }
-        x = 0.0F;
-        a = ms->Min[0];
-      } else if(a >= ms->FDim[0] + ms->Min[0] - 1) {
-        if(x > 0.01F) {
-          ok = false;
-          if(flag)
-            *flag = 0;
-        }
-        x = 0.0F;
-        a = ms->FDim[0] + ms->Min[0] - 1;
-      }
-
-      if(b < ms->Min[1]) {
-        if(y < 0.99F) {
-          ok = false;
-          if(flag)
-            *flag = 0;
-        }
-        y = 0.0F;
-        b = ms->Min[1];
-      } else if(b >= ms->FDim[1] + ms->Min[1] - 1) {
-        if(y > 0.01F) {
-          ok = false;
-          if(flag)
-            *flag = 0;
-        }
-        y = 0.0F;
-        b = ms->FDim[1] + ms->Min[1] - 1;
-      }
-
-      if(c < ms->Min[2]) {
-        if(z < 0.99F) {
-          ok = false;
-          if(flag)
-            *flag = 0;
-        }
-        z = 0.0F;
-        c = ms->Min[2];
-      } else if(c >= ms->FDim[2] + ms->Min[2] - 1) {
-        if(z > 0.01) {
-          ok = false;
-          if(flag)
-            *flag = 0;
-        }
-        z = 0.0F;
-        c = ms->FDim[2] + ms->Min[2] - 1;
-      }
-      /*      printf("%d %d %d %8.3f %8.3f %8.3f\n",a,b,c,x,y,z); */
-      *(result++) = FieldInterpolatef(ms->Field->data.get(),
-                                      a - ms->Min[0],
-                                      b - ms->Min[1], c - ms->Min[2], x, y, z);
-      if(flag)
-        flag++;
-
-    }
-  } else {
-
-    while(n--) {
-
-      x = (inp[0] - ms->Origin[0]) / ms->Grid[0];
-      y = (inp[1] - ms->Origin[1]) / ms->Grid[1];
-      z = (inp[2] - ms->Origin[2]) / ms->Grid[2];
-      inp += 3;
-
-      a = (int) floor(x + R_SMALL8);
-      b = (int) floor(y + R_SMALL8);
-      c = (int) floor(z + R_SMALL8);
-      x -= a;
-      y -= b;
-      z -= c;
-
-      if(flag)
-        *flag = 1;
-      if(a < ms->Min[0]) {
-        x = 0.0F;
-        a = ms->Min[0];
-        ok = false;
-        if(flag)
-          *flag = 0;
-      } else if(a >= ms->Max[0]) {
-        x = 1.0F;
-        a = ms->Max[0] - 1;
-        ok = false;
-        if(flag)
-          *flag = 0;
-      }
-
-      if(b < ms->Min[1]) {
-        y = 0.0F;
-        b = ms->Min[1];
-        ok = false;
-        if(flag)
-          *flag = 0;
-      } else if(b >= ms->Max[1]) {
-        y = 1.0F;
-        b = ms->Max[1] - 1;
-        ok = false;
-        if(flag)
-          *flag = 0;
-      }
-
-      if(c < ms->Min[2]) {
-        z = 0.0F;
-        c = ms->Min[2];
-        ok = false;
-        if(flag)
-          *flag = 0;
-      } else if(c >= ms->Max[2]) {
-        z = 1.0F;
-        c = ms->Max[2] - 1;
-        ok = false;
-        if(flag)
-          *flag = 0;
-      }
-      /*      printf("%d %d %d %8.3f %8.3f %8.3f\n",a,b,c,x,y,z); */
-      *(result++) = FieldInterpolatef(ms->Field->data.get(),
-                                      a - ms->Min[0],
-                                      b - ms->Min[1], c - ms->Min[2], x, y, z);
-      if(flag)
-        flag++;
-    }
-  }
-  return (ok);
+  float m[12];
+  ObjectMapStateGetGridTransform(ms, m);
+  return ObjectMapStateInterpolateGrid(ms, m, array, result, flag, n);
 }
 
 #ifndef _PYMOL_NOPY
@@ -1610,6 +1582,7 @@ void ObjectMapStateClamp(ObjectMapState * I, float clamp_floor, float clamp_ceil
         else if(*fp > clamp_ceiling)
           *fp = clamp_ceiling;
       }
+  IsofieldDataChanged(I->Field.get());
 }
 
 int ObjectMapStateSetBorder(ObjectMapState * I, float level)
@@ -1637,6 +1610,7 @@ int ObjectMapStateSetBorder(ObjectMapState * I, float level)
       F3(I->Field->data, a, 0, c) = level;
       F3(I->Field->data, a, b, c) = level;
     }
+  IsofieldDataChanged(I->Field.get());
   return (result);
 }
 
@@ -1657,6 +1631,7 @@ void ObjectMapStatePurge(PyMOLGlobals * G, ObjectMapState * I)
 
 void ObjectMap::update()
 {
+  PYMOL_PROFILE_SCOPE(G, "Object", "ObjectMap::update");
   auto I = this;
   if(!I->ExtentFlag) {
     ObjectMapUpdateExtents(I);
@@ -2213,23 +2188,6 @@ ObjectMapState *ObjectMapNewStateFromDesc(PyMOLGlobals * G, ObjectMap * I,
 
 
 /*========================================================================*/
-static float ccp4_next_value(char ** pp, int mode) {
-  char * p = *pp;
-  switch(mode) {
-    case 0:
-      *pp += 1;
-      return (float) *((int8_t *) p);
-    case 1:
-      *pp += 2;
-      return (float) *((int16_t *) p);
-    case 2:
-      *pp += 4;
-      return *((float *) p);
-  }
-  printf("ERROR unsupported mode\n");
-  return 0.f;
-}
-
 /* swaps n*width bytes in memory starting at p */
 static void swap_endian(char * p, int n, int width) {
   char tmp, *q, *pstop = p + (n - 1) * width + 1;
@@ -2241,6 +2199,81 @@ static void swap_endian(char * p, int n, int width) {
   }
 }
 
+/**
+ * Converts `n` consecutive mode 0-2 values at `src` to float. Byte swapping
+ * is done on the copy, `src` (possibly a read-only file mapping) is not
+ * modified.
+ */
+static void ccp4_read_values(const char* src, int n, int mode, bool swap,
+    float* dst)
+{
+  switch (mode) {
+  case 0:
+    for (int k = 0; k < n; ++k)
+      dst[k] = (float) ((const int8_t*) src)[k];
+    break;
+  case 1:
+    for (int k = 0; k < n; ++k) {
+      int16_t value;
+      memcpy(&value, src + k * sizeof(int16_t), sizeof(int16_t));
+      if (swap)
+        swap_endian((char*) &value, 1, sizeof(int16_t));
+      dst[k] = (float) value;
+    }
+    break;
+  case 2:
+    memcpy(dst, src, n * sizeof(float));
+    if (swap)
+      swap_endian((char*) dst, n, sizeof(float));
+    break;
+  }
+}
+
+/**
+ * Grid index range of `ms` which covers the world space box `mn`, `mx`.
+ * Only meaningful for crystallographic maps with a valid crystal.
+ *
+ * @param[out] new_min lower grid index (clipped to ms->Min)
+ * @param[out] new_max upper grid index (clipped to ms->Max)
+ * @return False if the box does not overlap the map
+ */
+static bool ObjectMapStateGetRegion(const ObjectMapState* ms, const float* mn,
+    const float* mx, int* new_min, int* new_max)
+{
+  float tmp_min[3], tmp_max[3], frac_min[3], frac_max[3];
+
+  if (ms->Matrix.empty() ||
+      !MatrixInvTransformExtentsR44d3f(ms->Matrix.data(), mn, mx, tmp_min, tmp_max)) {
+    copy3f(mn, tmp_min);
+    copy3f(mx, tmp_max);
+  }
+
+  // extents of the (possibly skewed) box in fractional space
+  for (int a = 0; a < 8; ++a) {
+    float v[3] = {
+        (a & 1) ? tmp_max[0] : tmp_min[0],
+        (a & 2) ? tmp_max[1] : tmp_min[1],
+        (a & 4) ? tmp_max[2] : tmp_min[2]};
+    float f[3];
+    transform33f3f(ms->Symmetry->Crystal.realToFrac(), v, f);
+    for (int c = 0; c < 3; ++c) {
+      if (!a || f[c] < frac_min[c])
+        frac_min[c] = f[c];
+      if (!a || f[c] > frac_max[c])
+        frac_max[c] = f[c];
+    }
+  }
+
+  for (int c = 0; c < 3; ++c) {
+    new_min[c] = std::max(ms->Min[c], (int) floor(frac_min[c] * ms->Div[c]));
+    new_max[c] = std::min(ms->Max[c], (int) ceil(frac_max[c] * ms->Div[c]));
+    if (new_min[c] > new_max[c])
+      return false;
+  }
+
+  return true;
+}
+
 static bool validateCCP4LoadType(int& format)
 {
   switch (format) {
@@ -2261,14 +2294,23 @@ static bool validateCCP4LoadType(int& format)
   }
 }
 
-static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int state,
-                                 int quiet, int format)
+/**
+ * @param CCP4Str File contents, not modified (may be a read-only mapping)
+ * @param region_mn Optional world space box, only the covered part of the
+ * map is read
+ * @param region_mx Optional world space box (requires region_mn)
+ */
+static int ObjectMapCCP4StrToMap(ObjectMap * I, const char *CCP4Str, size_t bytes,
+                                 int state, int quiet, int format,
+                                 const float *region_mn = nullptr,
+                                 const float *region_mx = nullptr)
 {
   auto G = I->G;
+  int header[256];
   char *p;
   int *i;
   size_t bytes_per_pt;
-  char *q;
+  const char *q;
   float dens;
   int a, b, c, d, e;
   float v[3], vr[3], maxd, mind;
@@ -2284,12 +2326,12 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
   int sym_skip;
   int mapc, mapr, maps;
   int cc[3];
-  int n_pts;
+  size_t n_pts;
   double sum, sumsq;
   float mean, stdev;
   int normalize;
   ObjectMapState *ms;
-  int expectation;
+  size_t expectation;
 
   if (!validateCCP4LoadType(format)) {
     ErrMessage(G, __func__, "wrong format");
@@ -2305,15 +2347,15 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
   /* state check */
   if(state < 0)
     state = I->State.size();
-  /* alloc/init a new MapState */
-  if(I->State.size() <= state) {
-    VecCheckEmplace(I->State, state, I->G);
-  }
-  ms = &I->State[state];
+  /* read into a new MapState, which only replaces the object's state on
+     success, so a failed (region) read leaves an existing object intact */
+  ObjectMapState new_ms(I->G);
+  ms = &new_ms;
 
   normalize = SettingGetGlobal_b(I->G, cSetting_normalize_ccp4_maps);
 
-  p = CCP4Str;
+  memcpy(header, CCP4Str, sizeof(header));
+  p = (char *) header;
   little_endian = *((char *) &little_endian);
   map_endian = (*p || *(p + 1)); // NOTE: this assumes 0x0 < NC < 0x10000
 
@@ -2481,7 +2523,7 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
       " ObjectMapCCP4: AMIN %f AMAX %f AMEAN %f ARMS %f\n", mind, maxd, mean, stdev ENDFB(I->G);
   }
 
-  n_pts = nc * ns * nr;
+  n_pts = (size_t) nc * ns * nr;
 
   /* at least one EM map encountered lacks NZ, so we'll try to guess it */
 
@@ -2499,7 +2541,7 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
 
   if(!quiet) {
     PRINTFB(I->G, FB_ObjectMap, FB_Blather)
-      " ObjectMapCCP4: sym_skip %d bytes %d expectation %d\n",
+      " ObjectMapCCP4: sym_skip %d bytes %zu expectation %zu\n",
       sym_skip, bytes, expectation ENDFB(I->G);
   }
 
@@ -2522,29 +2564,9 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
     }
   }
 
-  q = p + (sizeof(int) * 256) + sym_skip;
-
-  if(little_endian != map_endian && bytes_per_pt > 1) {
-    swap_endian(q, n_pts, bytes_per_pt);
-  }
-
-  // with normalize == 2, use mean and stdev from file header
-  if(normalize == 1 && n_pts > 1) {
-    c = n_pts;
-    sum = 0.0;
-    sumsq = 0.0;
-    while(c--) {
-      dens = ccp4_next_value(&q, map_mode);
-      sumsq += dens * dens;
-      sum += dens;
-    }
-    mean = (float) (sum / n_pts);
-    stdev = (float) sqrt1d((sumsq - (sum * sum / n_pts)) / (n_pts - 1));
-    if(stdev < 0.000001)
-      stdev = 1.0;
-  }
+  q = CCP4Str + (sizeof(int) * 256) + sym_skip;
+  bool swap = (little_endian != map_endian);
 
-  q = p + (sizeof(int) * 256) + sym_skip;
   mapc--;                       /* convert to C indexing... */
   mapr--;
   maps--;
@@ -2565,6 +2587,44 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
   ms->Min[maps] = nsstart;
   ms->Max[maps] = ns + nsstart - 1;
 
+  ms->Symmetry->Crystal.setDims(xlen, ylen, zlen);
+  ms->Symmetry->Crystal.setAngles(alpha, beta, gamma);
+
+  if(ispg < n_space_group_numbers) {
+    ms->Symmetry->setSpaceGroup(space_group_numbers[ispg]);
+  }
+
+  /* file offsets (columns, rows, sections) of the part which gets read */
+  int read_min[3] = {0, 0, 0};
+  int read_max[3] = {nc - 1, nr - 1, ns - 1};
+
+  if(region_mn && region_mx) {
+    const int file_axis[3] = {mapc, mapr, maps};
+    int new_min[3], new_max[3];
+
+    if(!ObjectMapStateGetRegion(ms, region_mn, region_mx, new_min, new_max)) {
+      PRINTFB(G, FB_ObjectMap, FB_Errors)
+        " ObjectMapCCP4: Region does not overlap the map -- aborting.\n" ENDFB(G);
+      return (0);
+    }
+
+    for(a = 0; a < 3; a++) {
+      int axis = file_axis[a];
+      read_min[a] = new_min[axis] - ms->Min[axis];
+      read_max[a] = new_max[axis] - ms->Min[axis];
+      ms->Min[axis] = new_min[axis];
+      ms->Max[axis] = new_max[axis];
+      ms->FDim[axis] = new_max[axis] - new_min[axis] + 1;
+    }
+
+    if(!quiet) {
+      PRINTFB(G, FB_ObjectMap, FB_Details)
+        " ObjectMapCCP4: Reading region %d x %d x %d of %d x %d x %d\n",
+        read_max[0] - read_min[0] + 1, read_max[1] - read_min[1] + 1,
+        read_max[2] - read_min[2] + 1, nc, nr, ns ENDFB(G);
+    }
+  }
+
   if(!quiet) {
     if(Feedback(I->G, FB_ObjectMap, FB_Blather)) {
       dump3i(ms->Div, " ObjectMapCCP4: ms->Div");
@@ -2574,11 +2634,45 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
     }
   }
 
-  ms->Symmetry->Crystal.setDims(xlen, ylen, zlen);
-  ms->Symmetry->Crystal.setAngles(alpha, beta, gamma);
+  const int row_len = read_max[0] - read_min[0] + 1;
+  const size_t row_bytes = bytes_per_pt * nc;
+  const size_t section_bytes = row_bytes * nr;
+  std::vector<float> row(row_len);
 
-  if(ispg < n_space_group_numbers) {
-    ms->Symmetry->setSpaceGroup(space_group_numbers[ispg]);
+  /* only the rows which are read get paged in (if memory-mapped) */
+  auto read_row = [&](int r, int s) {
+    ccp4_read_values(q + s * section_bytes + r * row_bytes +
+                         read_min[0] * bytes_per_pt,
+        row_len, map_mode, swap, row.data());
+  };
+
+  const size_t n_read = (size_t) row_len * (read_max[1] - read_min[1] + 1) *
+                        (read_max[2] - read_min[2] + 1);
+
+  // with normalize == 2, use mean and stdev from file header. For partial
+  // reads the header statistics describe the full map, prefer them.
+  if(normalize == 1 && n_read < n_pts && stdev > R_SMALL8) {
+    if(!quiet) {
+      PRINTFB(G, FB_ObjectMap, FB_Details)
+        " ObjectMapCCP4: Partial map, using header statistics.\n" ENDFB(G);
+    }
+  } else if(normalize == 1 && n_read > 1) {
+    sum = 0.0;
+    sumsq = 0.0;
+    for(int s = read_min[2]; s <= read_max[2]; s++) {
+      for(int r = read_min[1]; r <= read_max[1]; r++) {
+        read_row(r, s);
+        for(c = 0; c < row_len; c++) {
+          dens = row[c];
+          sumsq += dens * dens;
+          sum += dens;
+        }
+      }
+    }
+    mean = (float) (sum / n_read);
+    stdev = (float) sqrt1d((sumsq - (sum * sum / n_read)) / (n_read - 1));
+    if(stdev < 0.000001)
+      stdev = 1.0;
   }
 
   /* -- JV; for vol 
@@ -2605,10 +2699,12 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
       for(cc[mapr] = 0; cc[mapr] < ms->FDim[mapr]; cc[mapr]++) {
         v[mapr] = (cc[mapr] + ms->Min[mapr]) / ((float) ms->Div[mapr]);
 
+        read_row(cc[mapr] + read_min[1], cc[maps] + read_min[2]);
+
         for(cc[mapc] = 0; cc[mapc] < ms->FDim[mapc]; cc[mapc]++) {
           v[mapc] = (cc[mapc] + ms->Min[mapc]) / ((float) ms->Div[mapc]);
 
-          dens = ccp4_next_value(&q, map_mode);
+          dens = row[cc[mapc]];
 
           if(normalize)
             dens = (dens - mean) / stdev;
@@ -2687,6 +2783,10 @@ static int ObjectMapCCP4StrToMap(ObjectMap * I, char *CCP4Str, int bytes, int st
     ErrMessage(I->G, "ObjectMap", "Error reading map");
   } else {
     ms->Active = true;
+    if(I->State.size() <= state) {
+      VecCheckEmplace(I->State, state, I->G);
+    }
+    I->State[state] = std::move(new_ms);
     ObjectMapUpdateExtents(I);
     if(!quiet) {
       PRINTFB(I->G, FB_ObjectMap, FB_Results)
@@ -4635,9 +4735,10 @@ static ObjectMap *ObjectMapReadXPLORStr(PyMOLGlobals * G, ObjectMap * I, char *X
 
 
 /*========================================================================*/
-static ObjectMap *ObjectMapReadCCP4Str(PyMOLGlobals * G, ObjectMap * I, char *XPLORStr,
-                                       int bytes, int state, int quiet,
-                                       int format)
+static ObjectMap *ObjectMapReadCCP4Str(PyMOLGlobals * G, ObjectMap * I,
+                                       const char *XPLORStr, size_t bytes,
+                                       int state, int quiet, int format,
+                                       const float *mn, const float *mx)
 {
   int ok = true;
   int isNew = true;
@@ -4653,7 +4754,12 @@ static ObjectMap *ObjectMapReadCCP4Str(PyMOLGlobals * G, ObjectMap * I, char *XP
     } else {
       isNew = false;
     }
-    ObjectMapCCP4StrToMap(I, XPLORStr, bytes, state, quiet, format);
+    if(!ObjectMapCCP4StrToMap(I, XPLORStr, bytes, state, quiet, format, mn, mx)) {
+      // an existing object keeps its states, see ObjectMapCCP4StrToMap
+      if(isNew)
+        DeleteP(I);
+      return nullptr;
+    }
     SceneChanged(G);
     SceneCountFrames(G);
   }
@@ -4662,35 +4768,43 @@ static ObjectMap *ObjectMapReadCCP4Str(PyMOLGlobals * G, ObjectMap * I, char *XP
 
 
 /*========================================================================*/
+/**
+ * Load a CCP4 or MRC map. Files are memory-mapped, so with a region only the
+ * needed sections and rows are read from disk.
+ *
+ * @param mn Optional world space box to load only a part of the map
+ * @param mx Optional world space box (requires mn)
+ */
 ObjectMap *ObjectMapLoadCCP4(PyMOLGlobals * G, ObjectMap * obj, const char *fname, int state,
-                             int is_string, int bytes, int quiet,
-                             int format)
+                             int is_string, size_t bytes, int quiet,
+                             int format, const float *mn, const float *mx)
 {
   ObjectMap *I = nullptr;
-  char *buffer;
-  long size;
+  std::unique_ptr<pymol::MappedFile> file;
+  const char *buffer = nullptr;
+  size_t size = 0;
 
   if(!is_string) {
     if (!quiet)
       PRINTFB(G, FB_ObjectMap, FB_Actions)
         " ObjectMapLoadCCP4File: Loading from '%s'.\n", fname ENDFB(G);
 
-    buffer = FileGetContents(fname, &size);
-
-    if(!buffer)
+    try {
+      file.reset(new pymol::MappedFile(fname));
+      buffer = file->data();
+      size = file->size();
+    } catch (const std::exception&) {
       ErrMessage(G, "ObjectMapLoadCCP4File", "Unable to open file!");
+    }
   } else {
-    buffer = (char*) fname;
-    size = (long) bytes;
+    buffer = fname;
+    size = bytes;
   }
 
   if (buffer) {
-    I = ObjectMapReadCCP4Str(G, obj, buffer, size, state, quiet, format);
+    I = ObjectMapReadCCP4Str(G, obj, buffer, size, state, quiet, format, mn, mx);
 
-    if(!is_string)
-      mfree(buffer);
-
-    if(!quiet) {
+    if(I && !quiet) {
       if(state < 0)
         state = I->State.size() - 1;
       if(state < I->State.size()) {
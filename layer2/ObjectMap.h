@@ -19,6 +19,8 @@ Z* -------------------------------------------------------------------
 
 #include"os_python.h"
 
+#include <glm/vec3.hpp>
+
 #include"CGO.h"
 #include"PyMOLObject.h"
 #include"Symmetry.h"
@@ -70,6 +72,8 @@ struct ObjectMapState : public CObjectState {
   ObjectMapState(PyMOLGlobals* G);
   ObjectMapState(const ObjectMapState&);
   ObjectMapState& operator=(const ObjectMapState&);
+  ObjectMapState(ObjectMapState&&) = default;
+  ObjectMapState& operator=(ObjectMapState&&) = default;
 };
 
 struct ObjectMap : public pymol::CObject {
@@ -130,7 +134,8 @@ ObjectMap *ObjectMapLoadXPLOR(PyMOLGlobals * G, ObjectMap * obj, const char *fna
                               int state, int is_file, int quiet);
 
 ObjectMap *ObjectMapLoadCCP4(PyMOLGlobals * G, ObjectMap * obj, const char *fname,
-                             int state, int is_string, int bytes, int quiet, int);
+                             int state, int is_string, size_t bytes, int quiet, int,
+                             const float *mn = nullptr, const float *mx = nullptr);
 
 ObjectMap *ObjectMapLoadPHI(PyMOLGlobals * G, ObjectMap * obj, const char *fname, int state,
                             int is_string, int bytes, int quiet);
@@ -146,6 +151,28 @@ ObjectMap* ObjectMapReadDXStr(PyMOLGlobals*, ObjectMap*, const char* MapStr,
 pymol::Result<ObjectMap*> ObjectMapReadCifStr(
     PyMOLGlobals* G, const pymol::cif_data& data_block);
 
+/**
+ * @brief Structure to hold reflection information
+ */
+struct ReflectionInfo {
+  glm::ivec3 hkl{};
+  float fwt{};  //!< amplitude
+  float phwt{}; //!< phase in degrees
+  float fom{};  //!< weight (figure of merit)
+};
+
+/**
+ * @brief Fourier transform map coefficients to a new ObjectMap covering one
+ * unit cell. Reflections are expanded by the space group symmetry.
+ * @param sym Unit cell and space group
+ * @param reflections Map coefficients, the first of symmetry equivalent
+ * reflections is used
+ * @return ObjectMap or error
+ */
+pymol::Result<ObjectMap*> ObjectMapReadReflections(PyMOLGlobals* G,
+    std::unique_ptr<CSymmetry> sym,
+    const std::vector<ReflectionInfo>& reflections);
+
 ObjectMap *ObjectMapLoadDXFile(PyMOLGlobals * G, ObjectMap * obj, const char *fname, int state,
                                int quiet);
 ObjectMap *ObjectMapLoadFLDFile(PyMOLGlobals * G, ObjectMap * obj, const char *fname, int state,
@@ -170,6 +197,7 @@ void ObjectMapStatePurge(PyMOLGlobals * G, ObjectMapState * I);
 int ObjectMapStateInterpolate(
     ObjectMapState* ms, const float* array, float* result, std::uint8_t* flag, int n);
 int ObjectMapStateContainsPoint(ObjectMapState * ms, float *point);
+bool ObjectMapStateSameGrid(ObjectMapState* a, ObjectMapState* b);
 ObjectMapState *ObjectMapStatePrime(ObjectMap * I, int state);
 void ObjectMapUpdateExtents(ObjectMap * I);
 
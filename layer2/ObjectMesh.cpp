@@ -36,6 +36,7 @@ Z* -------------------------------------------------------------------
 #include "Parse.h"
 #include "Scene.h"
 #include "Setting.h"
+#include "Profiler.h"
 #include "ShaderMgr.h"
 #include "Vector.h"
 #include "main.h"
@@ -444,6 +445,7 @@ static void ObjectMeshStateUpdateColors(ObjectMesh* I, ObjectMeshState* ms)
     rc = ms->RC.data();
     vc = ms->VC.data();
     if (vc) {
+      ColorRampedBatch ramped;
       for (a = 0; a < n_vert; a++) {
         if (a == base_n_vert) {
           int new_color = SettingGet_color(
@@ -456,7 +458,7 @@ static void ObjectMeshStateUpdateColors(ObjectMesh* I, ObjectMeshState* ms)
           }
         }
         if (ColorCheckRamped(I->G, cur_color)) {
-          ColorGetRamped(I->G, cur_color, v, vc, state);
+          ramped.add(cur_color, v, vc);
           *rc = cur_color;
           ramped_flag = true;
         } else {
@@ -467,6 +469,7 @@ static void ObjectMeshStateUpdateColors(ObjectMesh* I, ObjectMeshState* ms)
         vc += 3;
         v += 3;
       }
+      ramped.apply(I->G, state);
     }
 
     if (one_color_flag && (!ramped_flag)) {
@@ -481,6 +484,7 @@ static void ObjectMeshStateUpdateColors(ObjectMesh* I, ObjectMeshState* ms)
 
 void ObjectMesh::update()
 {
+  PYMOL_PROFILE_SCOPE(G, "Object", "ObjectMesh::update");
   auto I = this;
   int a;
   int c;
@@ -570,6 +574,12 @@ void ObjectMesh::update()
                ms->Range[3],
                ms->Range[4],
                ms->Range[5]); */
+            // cached per map state, makes re-contouring at a new level
+            // proportional to the mesh size
+            if (ms->MeshMode != cIsomeshMode::gradient) {
+              IsofieldComputeMinMax(I->G, field);
+            }
+
             IsosurfVolume(I->G, I->Setting.get(), nullptr, field, ms->Level,
                 ms->N, ms->V, ms->Range, ms->MeshMode, mesh_skip, ms->AltLevel);
 
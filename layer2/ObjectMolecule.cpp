@@ -48,6 +48,7 @@ Z* -------------------------------------------------------------------
 #include "HydrogenAdder.h"
 #include "Feedback.h"
 #include "Util2.h"
+#include "Profiler.h"
 
 #ifdef _WEBGL
 #endif
@@ -6554,6 +6555,24 @@ int const* ObjectMolecule::getNeighborArray() const
   return this->Neighbor.get();
 }
 
+/**
+ * Get the cached hot field columns for all atoms. The cache is cleared by
+ * any call to ObjectMolecule::invalidate() and by operations which modify
+ * atom properties in place (e.g. alter), see invalidateHotColumns().
+ */
+AtomInfoHotColumns const& ObjectMolecule::getHotColumns() const
+{
+  auto* columns = m_hotColumns.get();
+
+  if (!columns || columns->size() != size_t(NAtom)) {
+    columns = new AtomInfoHotColumns();
+    columns->assign(AtomInfo.data(), NAtom);
+    const_cast<ObjectMolecule*>(this)->m_hotColumns.reset(columns);
+  }
+
+  return *columns;
+}
+
 
 /*========================================================================*/
 #ifndef _PYMOL_NOPY
@@ -9739,41 +9758,49 @@ bool ObjectMoleculeSeleOp(ObjectMolecule * I, int sele, ObjectMoleculeOpRec * op
                   a1 = cs->AtmToIdx[a];
               }
               if(cs && (a1 >= 0)) {
-                coord = cs->coordPtr(a1);
-                if(op_i2) {     /* do we want transformed coordinates? */
-                  if(use_matrices) {
-                    if(!cs->Matrix.empty()) {      /* state transformation */
-                      transform44d3f(cs->Matrix.data(), coord, v1);
+                /* instanced coordinate sets contribute every instance */
+                int n_inst = op_i2 ? cs->getNInstance() : 0;
+                for(int inst = n_inst ? 0 : -1; inst < n_inst; ++inst) {
+                  coord = cs->coordPtr(a1);
+                  if(op_i2) {     /* do we want transformed coordinates? */
+                    if(inst >= 0) {
+                      transform44d3f(cs->getInstanceMatrix(inst), coord, v1);
+                      coord = v1;
+                    }
+                    if(use_matrices) {
+                      if(!cs->Matrix.empty()) {      /* state transformation */
+                        transform44d3f(cs->Matrix.data(), coord, v1);
+                        coord = v1;
+                      }
+                    }
+                    if(obj_TTTFlag) {
+                      transformTTT44f3f(I->TTT, coord, v1);
                       coord = v1;
                     }
                   }
-                  if(obj_TTTFlag) {
-                    transformTTT44f3f(I->TTT, coord, v1);
-                    coord = v1;
-                  }
-                }
-                if(op_i1) {
-                  if(op_v1[0] > coord[0])
+                  if(op_i1) {
+                    if(op_v1[0] > coord[0])
+                      op_v1[0] = coord[0];
+                    if(op_v1[1] > coord[1])
+                      op_v1[1] = coord[1];
+                    if(op_v1[2] > coord[2])
+                      op_v1[2] = coord[2];
+                    if(op_v2[0] < coord[0])
+                      op_v2[0] = coord[0];
+                    if(op_v2[1] < coord[1])
+                      op_v2[1] = coord[1];
+                    if(op_v2[2] < coord[2])
+                      op_v2[2] = coord[2];
+                  } else {
                     op_v1[0] = coord[0];
-                  if(op_v1[1] > coord[1])
                     op_v1[1] = coord[1];
-                  if(op_v1[2] > coord[2])
                     op_v1[2] = coord[2];
-                  if(op_v2[0] < coord[0])
                     op_v2[0] = coord[0];
-                  if(op_v2[1] < coord[1])
                     op_v2[1] = coord[1];
-                  if(op_v2[2] < coord[2])
                     op_v2[2] = coord[2];
-                } else {
-                  op_v1[0] = coord[0];
-                  op_v1[1] = coord[1];
-                  op_v1[2] = coord[2];
-                  op_v2[0] = coord[0];
-                  op_v2[1] = coord[1];
-                  op_v2[2] = coord[2];
+                  }
+                  op_i1++;
                 }
-                op_i1++;
               }
               if(i_DiscreteFlag)
                 break;
@@ -9791,6 +9818,9 @@ bool ObjectMoleculeSeleOp(ObjectMolecule * I, int sele, ObjectMoleculeOpRec * op
 	int use_stereo = 0, use_text_type = 0;
 #endif
 
+        // atom based loops may modify atom properties in place
+        I->invalidateHotColumns();
+
         switch (op->code) {
         case OMOP_INVA:
           /* set up an important optimization... */
@@ -10035,33 +10065,41 @@ bool ObjectMoleculeSeleOp(ObjectMolecule * I, int sele, ObjectMoleculeOpRec * op
                 case OMOP_CSetMinMax:
                   a1 = cs->atmToIdx(a);
                   if(a1 >= 0) {
-                    coord = cs->coordPtr(a1);
-                    if(op->i2) {        /* do we want transformed coordinates? */
-                      if(use_matrices) {
-                        if(!cs->Matrix.empty()) {  /* state transformation */
-                          transform44d3f(cs->Matrix.data(), coord, v1);
+                    /* instanced coordinate sets contribute every instance */
+                    int n_inst = op->i2 ? cs->getNInstance() : 0;
+                    for(int inst = n_inst ? 0 : -1; inst < n_inst; ++inst) {
+                      coord = cs->coordPtr(a1);
+                      if(op->i2) {        /* do we want transformed coordinates? */
+                        if(inst >= 0) {
+                          transform44d3f(cs->getInstanceMatrix(inst), coord, v1);
+                          coord = v1;
+                        }
+                        if(use_matrices) {
+                          if(!cs->Matrix.empty()) {  /* state transformation */
+                            transform44d3f(cs->Matrix.data(), coord, v1);
+                            coord = v1;
+                          }
+                        }
+                        if(I->TTTFlag) {
+                          transformTTT44f3f(I->TTT, coord, v1);
                           coord = v1;
                         }
                       }
-                      if(I->TTTFlag) {
-                        transformTTT44f3f(I->TTT, coord, v1);
-                        coord = v1;
-                      }
-                    }
-                    if(op->i1) {
-                      for(c = 0; c < 3; c++) {
-                        if(*(op->v1 + c) > *(coord + c))
+                      if(op->i1) {
+                        for(c = 0; c < 3; c++) {
+                          if(*(op->v1 + c) > *(coord + c))
+                            *(op->v1 + c) = *(coord + c);
+                          if(*(op->v2 + c) < *(coord + c))
+                            *(op->v2 + c) = *(coord + c);
+                        }
+                      } else {
+                        for(c = 0; c < 3; c++) {
                           *(op->v1 + c) = *(coord + c);
-                        if(*(op->v2 + c) < *(coord + c))
                           *(op->v2 + c) = *(coord + c);
+                        }
                       }
-                    } else {
-                      for(c = 0; c < 3; c++) {
-                        *(op->v1 + c) = *(coord + c);
-                        *(op->v2 + c) = *(coord + c);
-                      }
+                      op->i1++;
                     }
-                    op->i1++;
                   }
                   break;
                 case OMOP_CSetCameraMinMax:
@@ -10549,6 +10587,7 @@ static void ObjMolCoordSetUpdateSpawn(PyMOLGlobals * G,
 /*========================================================================*/
 void ObjectMolecule::update()
 {
+  PYMOL_PROFILE_SCOPE(G, "Object", "ObjectMolecule::update");
   auto I = this;
   int a; /*, ok; */
 
@@ -10558,11 +10597,9 @@ void ObjectMolecule::update()
     /* note which representations are active */
     /* for each atom in each coordset, blank out the representation cache */
     if(I->NCSet > 1) {
-      const AtomInfoType *ai = I->AtomInfo.data();
       I->RepVisCache = 0;
-      for(a = 0; a < I->NAtom; a++) {
-        I->RepVisCache |= ai->visRep;
-        ai++;
+      for (auto visRep : I->getHotColumns().visRep) {
+        I->RepVisCache |= visRep;
       }
     } else {
       I->RepVisCache = cRepBitmask;     /* if only one coordinate set, then
@@ -10571,6 +10608,10 @@ void ObjectMolecule::update()
     }
     I->RepVisCacheValid = true;
   }
+
+  // build the hot columns now, coordinate sets may be updated concurrently
+  I->getHotColumns();
+
   {
     /* determine the start/stop states */
     int start = 0;
@@ -10652,6 +10693,9 @@ void ObjectMolecule::invalidate(cRep_t rep, cRepInv_t level, int state)
   // Remove the "purge" bit
   level = static_cast<decltype(level)>(level & ~cRepInvPurgeMask);
 
+  // any invalidation may come with modified atom properties
+  I->invalidateHotColumns();
+
   if(level >= cRepInvVisib) {
     I->RepVisCacheValid = false;
   }
@@ -11050,7 +11094,18 @@ void ObjectMolecule::render(RenderInfo * info)
     if(cs) {
       if(use_matrices)
         pop_matrix = ObjectStatePushAndApplyMatrix(cs, info);
-      cs->render(info);
+      if(cs->InstanceMatrices.empty()) {
+        cs->render(info);
+      } else {
+        /* instancing: representations are built once and drawn in
+           every instance frame */
+        for(int i = 0, n = cs->getNInstance(); i < n; ++i) {
+          if(ObjectPushAndApplyMatrix(G, info, cs->getInstanceMatrix(i))) {
+            cs->render(info);
+            ObjectStatePopMatrix(cs, info);
+          }
+        }
+      }
       if(pop_matrix)
         ObjectStatePopMatrix(cs, info);
     }
@@ -86,9 +86,12 @@ struct ObjectMolecule : public pymol::CObject {
 
 private:
   pymol::cache_ptr<int[]> Neighbor;
+  pymol::cache_ptr<AtomInfoHotColumns> m_hotColumns;
 
 public:
   int const* getNeighborArray() const;
+  AtomInfoHotColumns const& getHotColumns() const;
+  void invalidateHotColumns() { m_hotColumns.reset(); }
 
   int AtomCounter = -1;
   /* not stored */
@@ -43,6 +43,7 @@ Z* -------------------------------------------------------------------
 #include"ShaderMgr.h"
 #include"CGO.h"
 #include "Feedback.h"
+#include "Profiler.h"
 
 static void ObjectSurfaceRecomputeExtent(ObjectSurface * I);
 
@@ -366,6 +367,7 @@ static void ObjectSurfaceStateUpdateColors(ObjectSurface * I, ObjectSurfaceState
         vc = ms->VC.empty() ? nullptr : ms->VC.data();
         v += 3;
         if(vc) {
+          ColorRampedBatch ramped;
           for(a = 0; a < n_vert; a++) {
             if(a == base_n_vert) {
               int new_color = SettingGet_color(I->G, I->Setting.get(),
@@ -378,7 +380,7 @@ static void ObjectSurfaceStateUpdateColors(ObjectSurface * I, ObjectSurfaceState
               }
             }
             if(ColorCheckRamped(I->G, cur_color)) {
-              ColorGetRamped(I->G, cur_color, v, vc, state);
+              ramped.add(cur_color, v, vc);
               *rc = cur_color;
               ramped_flag = true;
             } else {
@@ -389,6 +391,7 @@ static void ObjectSurfaceStateUpdateColors(ObjectSurface * I, ObjectSurfaceState
             vc += 3;
             v += 6;             /* alternates with normals */
           }
+          ramped.apply(I->G, state);
         }
       }
       break;
@@ -410,6 +413,7 @@ static void ObjectSurfaceStateUpdateColors(ObjectSurface * I, ObjectSurfaceState
         rc = ms->RC.data();
         vc = ms->VC.empty() ? nullptr : ms->VC.data();
         if(vc) {
+          ColorRampedBatch ramped;
           for(a = 0; a < n_vert; a++) {
             if(a == base_n_vert) {
               int new_color = SettingGet_color(I->G, I->Setting.get(),
@@ -422,7 +426,7 @@ static void ObjectSurfaceStateUpdateColors(ObjectSurface * I, ObjectSurfaceState
             }
 
             if(ColorCheckRamped(I->G, cur_color)) {
-              ColorGetRamped(I->G, cur_color, v, vc, state);
+              ramped.add(cur_color, v, vc);
               *rc = cur_color;
               ramped_flag = true;
             } else {
@@ -433,6 +437,7 @@ static void ObjectSurfaceStateUpdateColors(ObjectSurface * I, ObjectSurfaceState
             vc += 3;
             v += 3;
           }
+          ramped.apply(I->G, state);
         }
       }
       break;
@@ -451,6 +456,7 @@ static void ObjectSurfaceStateUpdateColors(ObjectSurface * I, ObjectSurfaceState
 
 void ObjectSurface::update()
 {
+  PYMOL_PROFILE_SCOPE(G, "Object", "ObjectSurface::update");
   auto I = this;
   for(auto& msref : I->State) {
     ObjectSurfaceState *ms = &msref;
@@ -521,6 +527,10 @@ void ObjectSurface::update()
                   ms->AtomVertex, ms->AtomVertex.size() / 3));
             }
 
+            // cached per map state, makes re-contouring at a new level
+            // proportional to the surface size
+            IsofieldComputeMinMax(I->G, oms->Field.get());
+
             ms->nT = ContourSurfVolume(I->G, oms->Field.get(),
                                    ms->Level,
                                    ms->N, ms->V,
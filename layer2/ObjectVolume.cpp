@@ -45,6 +45,7 @@ Z* -------------------------------------------------------------------
 #include "ShaderMgr.h"
 #include "Vector.h"
 #include "main.h"
+#include "Profiler.h"
 
 #define clamp(x, l, h) ((x) < (l) ? (l) : (x) > (h) ? (h) : (x))
 
@@ -361,7 +362,8 @@ void ObjectVolume::invalidate(cRep_t rep, cRepInv_t level, int state)
       if (level == cRepInvColor || level == cRepInvAll) {
         I->State[state].RecolorFlag = true;
       }
-      if (level != cRepInvColor) {
+      // color, visibility and extent changes don't touch the map data
+      if (level >= cRepInvCoord) {
         I->State[state].ResurfaceFlag = true;
         I->State[state].RefreshFlag = true;
       }
@@ -376,18 +378,24 @@ void ObjectVolume::invalidate(cRep_t rep, cRepInv_t level, int state)
  * Get the field either from the associated map, or from vs->Field in case
  * this is a reduced or symmetry expanded volume.
  */
-static CField* ObjectVolumeStateGetField(ObjectVolumeState* vs)
+static Isofield* ObjectVolumeStateGetIsofield(ObjectVolumeState* vs)
 {
   if (!vs)
     return nullptr;
   if (vs->Field)
-    return vs->Field->data.get();
-  return ObjectVolumeStateGetMapState(vs)->Field->data.get();
+    return vs->Field.get();
+  return ObjectVolumeStateGetMapState(vs)->Field.get();
 }
 
-CField* ObjectVolumeGetField(ObjectVolume* I)
+static CField* ObjectVolumeStateGetField(ObjectVolumeState* vs)
 {
-  return ObjectVolumeStateGetField(ObjectVolumeGetActiveState(I));
+  auto field = ObjectVolumeStateGetIsofield(vs);
+  return field ? field->data.get() : nullptr;
+}
+
+Isofield* ObjectVolumeGetField(ObjectVolume* I)
+{
+  return ObjectVolumeStateGetIsofield(ObjectVolumeGetActiveState(I));
 }
 
 /**
@@ -406,6 +414,7 @@ static void get44FracToRealFromCorner(const float* corner, float* frac2real)
 
 void ObjectVolume::update()
 {
+  PYMOL_PROFILE_SCOPE(G, "Object", "ObjectVolume::update");
   auto I = this;
   ObjectMapState* oms = nullptr;
   float carve_buffer;
@@ -810,31 +819,42 @@ void ObjectVolume::render(RenderInfo* info)
       ExtentRender(corner);
     }
 
-    // upload color ramp texture
+    // upload color ramp texture (only if the transfer function changed)
     if (vs->RecolorFlag) {
       const int volume_nColors = 512;
 
-      float* colors = ObjectVolumeStateGetColors(
-          G, vs, volume_nColors, &vs->ramp_min, &vs->ramp_range);
-      if (!colors)
-        continue;
-
-      // volume_layers default is 256, adjust alpha to maintain integrated
-      // opacity with different layer numbers
-      ColorsAdjustAlpha(colors, volume_nColors, 256. / volume_layers);
-
-      if (vs->textures[1]) {
-        G->ShaderMgr->freeGPUBuffer(vs->textures[1]);
-      }
-
-      vs->textures[1] =
+      std::vector<float> key(vs->Ramp);
+      key.push_back(volume_layers);
+      key.push_back(vs->min_max_mean_stdev[3]);
+
+      if (!vs->textures[1] || key != vs->colorTableKey) {
+        float* colors = ObjectVolumeStateGetColors(
+            G, vs, volume_nColors, &vs->ramp_min, &vs->ramp_range);
+        if (!colors)
+          continue;
+
+        // volume_layers default is 256, adjust alpha to maintain integrated
+        // opacity with different layer numbers
+        ColorsAdjustAlpha(colors, volume_nColors, 256. / volume_layers);
+
+        // re-use the texture object, the table has a fixed size
+        auto tex = vs->textures[1]
+                       ? G->ShaderMgr->getGPUBuffer<TextureGL>(vs->textures[1])
+                       : nullptr;
+        if (tex) {
+          tex->texture_data_1D(volume_nColors, colors);
+        } else {
+          vs->textures[1] =
 #ifdef _PYMOL_IP_EXTRAS
 #endif
-          createColorTexture(G, colors, volume_nColors);
+              createColorTexture(G, colors, volume_nColors);
+        }
 
-      tex::env(tex::env_name::ENV_MODE, tex::env_param::REPLACE);
+        tex::env(tex::env_name::ENV_MODE, tex::env_param::REPLACE);
 
-      mfree(colors);
+        mfree(colors);
+        vs->colorTableKey = std::move(key);
+      }
       vs->RecolorFlag = false;
     }
 
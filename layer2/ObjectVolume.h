@@ -31,10 +31,9 @@ struct ObjectVolumeState : public CObjectState {
   int Range[6];
   float ExtentMin[3], ExtentMax[3];
   int ExtentFlag = false;
-  // TODO difference between Resurface, Recolor, Refresh???
-  int RefreshFlag;
-  int ResurfaceFlag = true;
-  int RecolorFlag = true;
+  int RefreshFlag = true;   //!< map data changed (statistics, data texture)
+  int ResurfaceFlag = true; //!< geometry changed (corners, carve mask)
+  int RecolorFlag = true;   //!< transfer function changed (color table)
   pymol::vla<float> AtomVertex;
   float CarveBuffer = 0.0f;
   WordType caption{};
@@ -47,6 +46,7 @@ struct ObjectVolumeState : public CObjectState {
   pymol::copyable_ptr<Isofield> Field;
   float min_max_mean_stdev[4];
   float ramp_min, ramp_range;
+  std::vector<float> colorTableKey; //!< ramp and settings of textures[1]
   int RampSize() const { return Ramp.size() / 5; };
   std::vector<float> Ramp;
   int isUpdated = false;
@@ -84,7 +84,7 @@ int ObjectVolumeNewFromPyList(
 int ObjectVolumeInvalidateMapName(
     ObjectVolume* I, const char* name, const char* new_name);
 
-CField* ObjectVolumeGetField(ObjectVolume* I);
+Isofield* ObjectVolumeGetField(ObjectVolume* I);
 PyObject* ObjectVolumeGetRamp(ObjectVolume* I, int state);
 pymol::Result<> ObjectVolumeSetRamp(
     ObjectVolume* I, std::vector<float>&& ramp_list, int state);
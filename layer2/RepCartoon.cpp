@@ -34,6 +34,7 @@ Z* -------------------------------------------------------------------
 #include"ShaderMgr.h"
 #include "Lex.h"
 #include "CoordSet.h"
+#include "RepLOD.h"
 
 #include "AtomIterators.h"
 
@@ -85,8 +86,13 @@ struct RepCartoon : Rep {
   }
 
   char* LastVisib = nullptr;
+
+  //! Level of detail of preshader/std/ray (see RepLOD.h)
+  RepLODLevel lod;
 };
 
+static RepCartoon* RepCartoonNewImpl(CoordSet* cs, int state, bool defer);
+
 #include"ObjectMolecule.h"
 
 #define ESCAPE_MAX 500
@@ -238,10 +244,41 @@ static int RepCartoonCGOGenerate(RepCartoon * I, RenderInfo * info)
   return ok;
 }
 
+/**
+ * Switch between full detail and a coarse guide atom trace if needed, and
+ * generate the geometry of the new level.
+ */
+static void RepCartoonUpdateLOD(RepCartoon* I)
+{
+  if (!RepLODUpdate(I->cs, I->lod))
+    return;
+
+  CGOFree(I->preshader);
+  CGOFree(I->ray);
+  CGOFree(I->std);
+
+  if (I->lod.coarse) {
+    I->preshader = RepLODTraceCGO(I->cs, I->getState(), cRepCartoonBit,
+        cSetting_cartoon_color,
+        SettingGet<float>(*I->cs, cSetting_cartoon_tube_radius) * 2.F, true);
+  } else {
+    std::unique_ptr<RepCartoon> full(
+        RepCartoonNewImpl(I->cs, I->getState(), false));
+    if (full) {
+      std::swap(I->preshader, full->preshader);
+    }
+  }
+}
+
 void RepCartoon::render(RenderInfo* info)
 {
   auto I = this;
 
+  // don't switch levels between the render and the picking pass
+  if (!info->pick || !I->lod.ready) {
+    RepCartoonUpdateLOD(I);
+  }
+
   if (info->ray) {
 #ifndef _PYMOL_NO_RAY
     CGO* raycgo = I->ray ? I->ray : I->preshader;
@@ -2407,6 +2444,136 @@ static int GetCartoonQuality(CoordSet * cs, int setting, int v1, int v2, int v3,
   return quality;
 }
 
+/**
+ * Contiguous range of guide atoms which starts and ends at segment
+ * boundaries and can be sampled and extruded independently.
+ */
+struct CartoonRange {
+  int begin, end;
+  int contigFlag; //!< serial loop state at `begin`
+};
+
+/**
+ * Minimum number of guide atoms per range, to keep the per-range overhead
+ * (extrusion buffers, CGO concatenation) small
+ */
+#define CARTOON_RANGE_MIN_ATOMS 256
+
+/**
+ * Split the guide atoms into segment aligned ranges for parallel
+ * generation. Returns an empty vector if splitting is not worth it.
+ *
+ * Runs the control flow of the sampling loop in GenerateRepCartoonCGO
+ * without sampling and extruding, and only splits where that loop starts a
+ * segment without pending points. This makes the concatenated output of the
+ * ranges identical to the output of a single pass.
+ */
+static std::vector<CartoonRange> CartoonSplitSegmentRanges(
+    int nAt, const int* seg, const CCInOut* car)
+{
+  std::vector<CartoonRange> ranges;
+
+  if (nAt < 2 * CARTOON_RANGE_MIN_ATOMS) {
+    return ranges;
+  }
+
+  for (int a = 0; a < nAt; ++a) {
+    // putty extrusion may print feedback, keep it serial
+    if (car[a].getCCOut() == cCartoon_putty) {
+      return ranges;
+    }
+  }
+
+  int n_p = 0; // only zero or non-zero matters
+  int cur_car = cCartoon_skip;
+  int contigFlag = false;
+  int extrudeFlag = false;
+  int begin = 0;
+  int begin_contigFlag = false;
+
+  for (int a = 0; a < nAt;) {
+    if (CheckExtrudeContigFlags(nAt, n_p, a, &cur_car, car + a, seg + a,
+            &contigFlag, &extrudeFlag)) {
+      n_p = 0;
+    }
+
+    if (!extrudeFlag) {
+      if (a - begin >= CARTOON_RANGE_MIN_ATOMS && seg[a] != seg[a - 1] &&
+          !n_p) {
+        ranges.push_back({begin, a, begin_contigFlag});
+        begin = a;
+        begin_contigFlag = contigFlag;
+      }
+
+      if (a < nAt - 1 && seg[a] == seg[a + 1]) {
+        n_p = 1;
+      }
+
+      ++a;
+    } else {
+      // extrude at (a + 1) and undo
+      contigFlag = (a + 1 == nAt) || seg[a - 1] == seg[a];
+      extrudeFlag = false;
+      n_p = 0;
+    }
+  }
+
+  if (ranges.empty()) {
+    return ranges;
+  }
+
+  ranges.push_back({begin, nAt, begin_contigFlag});
+  return ranges;
+}
+
+/**
+ * Pick color state which no CGOPickColor call can produce, so the first pick
+ * color of a range CGO is always emitted (see CartoonAppendRangeCGO).
+ */
+static void CartoonPickColorStateReset(CGO* cgo)
+{
+  cgo->current_pick_color_index = (unsigned int) -2;
+  cgo->current_pick_color_bond = cPickableNoPick;
+}
+
+/**
+ * Append a range CGO, dropping its first pick color if it's redundant. This
+ * gives the same op stream as generating all ranges into one CGO.
+ */
+static void CartoonAppendRangeCGO(CGO* cgo, CGO&& src)
+{
+  for (auto it = src.begin(); !it.is_stop(); ++it) {
+    if (it.op_code() == CGO_DRAW_ARRAYS &&
+        (it.cast<cgo::draw::arrays>()->arraybits & CGO_PICK_COLOR_ARRAY)) {
+      // pick colors of Extrude strips, not deduplicated
+      break;
+    }
+
+    if (it.op_code() != CGO_PICK_COLOR)
+      continue;
+
+    auto const pc = it.data();
+    if (CGO_get_uint(pc) == cgo->current_pick_color_index &&
+        CGO_get_int(pc + 1) == cgo->current_pick_color_bond) {
+      float* const op_begin = const_cast<float*>(pc) - 1;
+      size_t const op_size = CGO_PICK_COLOR_SZ + 1;
+      float* const src_end = src.op + src.c;
+      std::copy(op_begin + op_size, src_end, op_begin);
+      src.c -= op_size;
+      src.op[src.c] = 0; // CGO_STOP
+    }
+    break;
+  }
+
+  if (src.current_pick_color_bond != cPickableNoPick ||
+      src.current_pick_color_index != (unsigned int) -2) {
+    cgo->current_pick_color_index = src.current_pick_color_index;
+    cgo->current_pick_color_bond = src.current_pick_color_bond;
+  }
+
+  cgo->move_append(std::move(src));
+}
+
 static
 CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *ndata, short use_cylinders_for_strands,
                            float *pv, int nAt, float *tv, float *pvo,
@@ -2417,22 +2584,8 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
   PyMOLGlobals *G = cs->G;
   int ok = true;
   CGO *cgo;
-  int contigFlag, contFlag, extrudeFlag, n_p;
   CExtrude *ex = nullptr;
-  float dev;
-  unsigned int *vi;
-  int atom_index1, atom_index2;
-  float *v, *v1, *v2, *vo;
-  float *d, *vc = nullptr, *vn;
-  float *valpha = nullptr;
-  int *atp;
-  int c1, c2;
-  int a;
   int sampling;
-  float *sampling_tmp;
-  int *segptr;
-  const CCInOut *cc;
-  int cur_car;
   float loop_radius;
   int nucleic_color = 0;
   float throw_;
@@ -2448,16 +2601,6 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
   float dumbbell_radius, dumbbell_width, dumbbell_length;
   float ring_width;
 
-  auto EXTRUDE_TRUNCATE = [&ex, &n_p, &v, &vc, &valpha, &vn, &vi]() {
-    ExtrudeTruncate(ex, 0);
-    n_p = 0;
-    v = ex->p;
-    vc = ex->c;
-    valpha = ex->alpha;
-    vn = ex->n;
-    vi = ex->i;
-  };
-
   cartoon_color =
     SettingGet_color(G, cs->Setting.get(), obj->Setting.get(), cSetting_cartoon_color);
   ring_width =
@@ -2529,7 +2672,6 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
     SettingGet_i(G, cs->Setting.get(), obj->Setting.get(), cSetting_cartoon_cylindrical_helices);
   int const sampling_cylindrical_helices = sampling / 8 + 1;
 
-  sampling_tmp = pymol::malloc<float>(sampling * 3);
   cartoon_debug = SettingGet_i(G, cs->Setting.get(), obj->Setting.get(), cSetting_cartoon_debug);
 
   cgo = CGONew(G);
@@ -2554,34 +2696,57 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
     ok = GenerateRepCartoonProcessCylindricalHelices(G, obj, cs, cgo, ex, nAt, seg, pv, tv,
                                                      pvo, car, at, dl, cartoon_color, discrete_colors, loop_radius, alpha);
   }
-  if(ok && nAt > 1) {
+  const auto helix_radius = SettingGet<float>(
+      G, cs->Setting.get(), obj->Setting.get(), cSetting_cartoon_helix_radius);
+
+  /*
+   * Sample and extrude the guide atoms [a_begin, a_end). The range must
+   * start and end at segment boundaries. `contigFlag` is the state the
+   * serial loop would have at `a_begin`.
+   */
+  auto generate_range = [&](CGO* cgo, CExtrude* ex, int a_begin, int a_end,
+                            int contigFlag) -> int {
+    int ok = true;
+    int const n_at = a_end - a_begin;
+    int n_p = 0;
+    float *v, *vc, *valpha, *vn;
+    unsigned int* vi;
+    std::vector<float> sampling_tmp(sampling * 3);
+
+    auto EXTRUDE_TRUNCATE = [&]() {
+      ExtrudeTruncate(ex, 0);
+      n_p = 0;
+      v = ex->p;
+      vc = ex->c;
+      valpha = ex->alpha;
+      vn = ex->n;
+      vi = ex->i;
+    };
+
     EXTRUDE_TRUNCATE();
-    v1 = pv;                    /* points */
-    v2 = tv;                    /* tangents */
-    vo = pvo;
-    d = dl;
-    segptr = seg;
-    cc = car;
-    atp = at;                   /* cs index pointer */
-    a = 0;
-    contFlag = true;
-    cur_car = cCartoon_skip;
-    extrudeFlag = false;
-    contigFlag = false;
-
-    const auto helix_radius = SettingGet<float>(
-        G, cs->Setting.get(), obj->Setting.get(), cSetting_cartoon_helix_radius);
+    float* v1 = pv + 3 * a_begin; /* points */
+    float* v2 = tv + 3 * a_begin; /* tangents */
+    float* vo = pvo + 3 * a_begin;
+    float* d = dl + a_begin;
+    int* segptr = seg + a_begin;
+    const CCInOut* cc = car + a_begin;
+    int* atp = at + a_begin; /* cs index pointer */
+    int a = 0;
+    int contFlag = true;
+    int cur_car = cCartoon_skip;
+    int extrudeFlag = false;
 
     while(contFlag) {
-      if (CheckExtrudeContigFlags(nAt, n_p, a, &cur_car, cc, segptr, &contigFlag, &extrudeFlag)){
+      if (CheckExtrudeContigFlags(n_at, n_p, a, &cur_car, cc, segptr, &contigFlag, &extrudeFlag)){
         EXTRUDE_TRUNCATE();
       }
 
       if(ok && !extrudeFlag) {
-        if((a < (nAt - 1)) && (*segptr == *(segptr + 1))) {       /* working in the same segment... */
+        if((a < (n_at - 1)) && (*segptr == *(segptr + 1))) {       /* working in the same segment... */
           AtomInfoType *ai1, *ai2;
-          atom_index1 = cs->IdxToAtm[*atp];
-          atom_index2 = cs->IdxToAtm[*(atp + 1)];
+          int c1, c2;
+          int const atom_index1 = cs->IdxToAtm[*atp];
+          int const atom_index2 = cs->IdxToAtm[*(atp + 1)];
           ai1 = obj->AtomInfo + atom_index1;
           ai2 = obj->AtomInfo + atom_index2;
 
@@ -2589,7 +2754,7 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
           float alpha2 = alpha;
 
           ComputeCartoonAtomColors(G, obj, cs, nuc_flag, atom_index1, atom_index2, &c1, &c2, atp, cc, cur_car, cartoon_color, alpha1, alpha2, nucleic_color, discrete_colors, n_p, contigFlag);
-          dev = throw_ * (*d);
+          float const dev = throw_ * (*d);
 
           auto const cur_sampling = (cur_car == cCartoon_cylinder)
                                         ? sampling_cylindrical_helices
@@ -2602,7 +2767,7 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
 
           /* now do a smoothing pass along orientation 
              vector to smooth helices, etc... */
-          CartoonGenerateRefine(refine, cur_sampling, v, vn, vo, sampling_tmp);
+          CartoonGenerateRefine(refine, cur_sampling, v, vn, vo, sampling_tmp.data());
         }
         v1 += 3;
         v2 += 3;
@@ -2614,14 +2779,14 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
       }
 
       a++;
-      if(a == nAt) {  // if at end, don't continue and extrude if needed
+      if(a == n_at) {  // if at end, don't continue and extrude if needed
         contFlag = false;
         if(n_p)
           extrudeFlag = true;
       }
       if(ok && extrudeFlag) {
         contigFlag = true;
-        if((a < nAt) && extrudeFlag) {
+        if((a < n_at) && extrudeFlag) {
           if(*(segptr - 1) != *(segptr))
             contigFlag = false;
         }
@@ -2678,12 +2843,50 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
         if (ok){
           EXTRUDE_TRUNCATE();  // doesn't include vi = ex->i, not used?
         }
-        /*
-          ExtrudeTruncate(ex, 0);
-        n_p = 0;
-        v = ex->p;
-        vc = ex->c;
-        vn = ex->n;*/
+      }
+    }
+
+    return ok;
+  };
+
+  if(ok && nAt > 1) {
+    auto const ranges = CartoonSplitSegmentRanges(nAt, seg, car);
+
+    if (ranges.size() < 2) {
+      ok = generate_range(cgo, ex, 0, nAt, false);
+    } else {
+      // independent segment ranges, concatenated in order
+      int const n_ranges = ranges.size();
+      std::vector<std::unique_ptr<CGO>> range_cgos(n_ranges);
+      std::vector<int> range_ok(n_ranges, true);
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int r = 0; r < n_ranges; ++r) {
+        auto const& range = ranges[r];
+        auto& range_cgo = range_cgos[r];
+        range_cgo.reset(CGONew(G));
+        CartoonPickColorStateReset(range_cgo.get());
+
+        CExtrude* range_ex = ExtrudeNew(G);
+        if (!range_ex || !ExtrudeAllocPointsNormalsColors(range_ex,
+                             (range.end - range.begin) * (3 * sampling + 3))) {
+          range_ok[r] = false;
+        } else {
+          range_ok[r] = generate_range(range_cgo.get(), range_ex, range.begin,
+              range.end, range.contigFlag);
+        }
+        if (range_ex) {
+          ExtrudeFree(range_ex);
+        }
+      }
+
+      for (int r = 0; ok && r < n_ranges; ++r) {
+        ok = range_ok[r];
+        if (ok) {
+          CartoonAppendRangeCGO(cgo, std::move(*range_cgos[r]));
+        }
       }
     }
   }
@@ -2703,8 +2906,6 @@ CGO *GenerateRepCartoonCGO(CoordSet *cs, ObjectMolecule *obj, nuc_acid_data *nda
   if (ok)
     CGOStop(cgo);
 
-  FreeP(sampling_tmp);
-
   if (!ok){
     CGOFree(cgo);
   }
@@ -3667,6 +3868,15 @@ void RepCartoonSmoothLoops(PyMOLGlobals* G, ObjectMolecule* obj,
 }
 
 Rep *RepCartoonNew(CoordSet * cs, int state)
+{
+  return RepCartoonNewImpl(cs, state, RepLODEnabled(cs));
+}
+
+/**
+ * @param defer Only record visibility, the geometry is generated by
+ * RepCartoonUpdateLOD
+ */
+static RepCartoon* RepCartoonNewImpl(CoordSet* cs, int state, bool defer)
 {
   PyMOLGlobals *G = cs->G;
   ObjectMolecule *obj;
@@ -3704,6 +3914,16 @@ Rep *RepCartoonNew(CoordSet * cs, int state)
 
   auto I = new RepCartoon(cs, state);
 
+  if (defer) {
+    I->LastVisib = pymol::calloc<char>(cs->NIndex);
+    for (int idx = 0; idx < cs->NIndex; ++idx) {
+      I->LastVisib[idx] = GET_BIT(cs->getAtomInfo(idx)->visRep, cRepCartoon);
+    }
+    return I;
+  }
+
+  I->lod.ready = true;
+
   PRINTFD(G, FB_RepCartoon)
     " RepCartoonNew-Debug: entered.\n" ENDFD;
 
@@ -3868,5 +4088,5 @@ Rep *RepCartoonNew(CoordSet * cs, int state)
   FreeP(flag_tmp);
   FreeP(nuc_flag);
   VLAFreeP(ndata.ring_anchor);
-  return (Rep *) I;
+  return I;
 }
@@ -33,8 +33,10 @@
 #include"Scene.h"
 #include"CGO.h"
 #include "Lex.h"
+#include "RepLOD.h"
 
 #include <iostream>
+#include <memory>
 
 struct RepCylBond : Rep {
   using Rep::Rep;
@@ -43,11 +45,20 @@ struct RepCylBond : Rep {
 
   cRep_t type() const override { return cRepCyl; }
   void render(RenderInfo* info) override;
+  bool recoord() override;
 
   CGO* primitiveCGO = nullptr;
   CGO* renderCGO = nullptr;
+
+  //! One entry per primitiveCGO sphere/cylinder, empty if not patchable
+  std::vector<RepCoordPatch> coordPatches;
+
+  //! Level of detail of primitiveCGO (see RepLOD.h)
+  RepLODLevel lod;
 };
 
+static RepCylBond* RepCylBondNewImpl(CoordSet* cs, int state, bool defer);
+
 /* RepCylinder -- This function is a helper function that generates a cylinder for RepCylBond.
  *   Depending on the s1 and s2 arguments, it will either draw a bond or a half bond.  Half bonds
  *   always have flat caps on the inside.  The isRamped argument specifies whether the colors are
@@ -113,6 +124,17 @@ RepCylBond::~RepCylBond()
   CGOFree(I->renderCGO);
 }
 
+bool RepCylBond::recoord()
+{
+  if (coordPatches.empty() ||
+      !RepPatchCoords(primitiveCGO, coordPatches, cs)) {
+    return false;
+  }
+
+  CGOFree(renderCGO);
+  return true;
+}
+
 static int RepCylBondCGOGenerate(RepCylBond * I, RenderInfo * info)
 {
   PyMOLGlobals *G = I->G;
@@ -165,6 +187,34 @@ static int RepCylBondCGOGenerate(RepCylBond * I, RenderInfo * info)
   return true;
 }
 
+/**
+ * Switch between full detail and coarse proxies if needed, and generate the
+ * primitives of the new level.
+ */
+static void RepCylBondUpdateLOD(RepCylBond* I)
+{
+  if (!RepLODUpdate(I->cs, I->lod))
+    return;
+
+  CGOFree(I->renderCGO);
+  CGOFree(I->primitiveCGO);
+  I->coordPatches.clear();
+
+  if (I->lod.coarse) {
+    I->primitiveCGO = RepLODTraceCGO(I->cs, I->getState(), cRepCylBit,
+        cSetting_stick_color,
+        SettingGet<float>(*I->cs, cSetting_stick_radius) * 2.F, false);
+  } else {
+    std::unique_ptr<RepCylBond> full(
+        RepCylBondNewImpl(I->cs, I->getState(), false));
+    if (full) {
+      std::swap(I->primitiveCGO, full->primitiveCGO);
+      std::swap(I->coordPatches, full->coordPatches);
+      I->setHasTransparency(full->hasTransparency());
+    }
+  }
+}
+
 void RepCylBond::render(RenderInfo * info)
 {
   auto I = this;
@@ -173,6 +223,14 @@ void RepCylBond::render(RenderInfo * info)
   PyMOLGlobals *G = I->G;
   int ok = true;
 
+  // don't switch levels between the render and the picking pass
+  if (!pick || !I->lod.ready) {
+    RepCylBondUpdateLOD(I);
+  }
+
+  if (!I->primitiveCGO)
+    return;
+
   if(ray) {
 #ifndef _PYMOL_NO_RAY
     CGORenderRay(I->primitiveCGO, ray, info, nullptr, nullptr, I->cs->Setting.get(), I->obj->Setting.get());
@@ -518,6 +576,15 @@ static int RepValence(RepCylBond *I, CGO *cgo, bool s1, bool s2, bool isRamped,
 }
 
 Rep *RepCylBondNew(CoordSet * cs, int state)
+{
+  return RepCylBondNewImpl(cs, state, RepLODEnabled(cs));
+}
+
+/**
+ * @param defer Only check visibility, the primitives are generated by
+ * RepCylBondUpdateLOD
+ */
+static RepCylBond* RepCylBondNewImpl(CoordSet* cs, int state, bool defer)
 {
   PyMOLGlobals *G = cs->G;
   ObjectMolecule *obj;
@@ -550,6 +617,7 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
   const float _0p9 = 0.9F;
   short shader_mode = 0;
   int ok = true;
+  bool patchable = true;
 
   PRINTFD(G, FB_RepCylBond)
     " RepCylBondNew-Debug: entered.\n" ENDFD;
@@ -571,6 +639,13 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
     return (nullptr);              /* skip if no sticks are visible */
   }
 
+  if (defer) {
+    auto I = new RepCylBond(cs, state);
+    if (SettingGet<float>(*cs, cSetting_stick_transparency) > 0.f)
+      I->setHasTransparency();
+    return I;
+  }
+
   capdrawn = pymol::calloc<float>(obj->NAtom); // max radius of caps
   marked = pymol::calloc<bool>(obj->NAtom);
   CHECKOK(ok, marked);
@@ -590,6 +665,10 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
   transp = SettingGet_f(G, cs->Setting.get(), obj->Setting.get(), cSetting_stick_transparency);
   hide_long = SettingGet_b(G, cs->Setting.get(), obj->Setting.get(), cSetting_hide_long_bonds);
 
+  // bond visibility depends on the bond length
+  if (hide_long)
+    patchable = false;
+
   std::set<int> all_zero_order_bond_atoms;
   b = obj->Bond;
   for(a = 0; ok && a < obj->NBond; a++) {
@@ -633,6 +712,7 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
   auto I = new RepCylBond(cs, state);
 
   I->primitiveCGO = CGONew(G);
+  I->lod.ready = true;
   if(ok && obj->NBond) {
     stick_ball = SettingGet_b(G, cs->Setting.get(), obj->Setting.get(), cSetting_stick_ball);
 
@@ -744,6 +824,9 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
         s1 = s1_before_symop && !symop[0];
         s2 = s2_before_symop && !symop[1];
 
+        if (symop[1])
+          patchable = false;
+
         if(hide_long && (s1 || s2)) {
           float cutoff = (ati1->vdw + ati2->vdw) * _0p9;
           if(!within3f(vv1, vv2, cutoff))       /* atoms separated by more than 90% of the sum of their vdw radii */
@@ -777,7 +860,7 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
 
           /* This means that if stick_ball gets changed, the RepCylBond needs to be completely invalidated */
 
-        auto stick_ball_impl = [&](AtomInfoType * ati1, int b1, int c1, float const* vv1) {
+        auto stick_ball_impl = [&](AtomInfoType * ati1, int b1, int a1, int c1, float const* vv1) {
           int stick_ball_1 = AtomSettingGetWD(G, ati1, cSetting_stick_ball, stick_ball);
           if(stick_ball_1) {
             float vdw = stick_ball_ratio * ((ati1->protons == cAN_H) ? bd_radius : bd_radius_full);
@@ -792,10 +875,12 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
             if(sbc1 == cColorAtomic)
               sbc1 = ati1->color;
             capdrawn[b1] = vdw1;
-            ColorGetCheckRamped(G, sbc1, vv1, rgb1, state);
+            if (ColorGetCheckRamped(G, sbc1, vv1, rgb1, state))
+              patchable = false;
             CGOColorv(I->primitiveCGO, rgb1);
             CGOPickColor(I->primitiveCGO, b1, ati1->masked ? cPickableNoPick : a);
             CGOSphere(I->primitiveCGO, vv1, vdw1);
+            I->coordPatches.push_back({a1, a1, 0.f, 0.f});
           }
         };
 
@@ -812,14 +897,17 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
             }
           }
 
-          if (s1) stick_ball_impl(ati1, b1, c1, vv1);
-          if (s2) stick_ball_impl(ati2, b2, c2, vv2);
+          if (s1) stick_ball_impl(ati1, b1, a1, c1, vv1);
+          if (s2) stick_ball_impl(ati2, b2, a2, c2, vv2);
 
           float rgb1[3], rgb2[3];
           bool isRamped = false;
           isRamped = ColorGetCheckRamped(G, c1, vv1, rgb1, state);
           isRamped = ColorGetCheckRamped(G, c2, vv2, rgb2, state) | isRamped;
 
+          if (isRamped)
+            patchable = false;
+
           if (ord == 0) {
             bd_radius *= valence_zero_scale;
             if (valence_zero_mode == 2) {
@@ -829,6 +917,7 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
 
           if (!ord){
             // zero order bonds
+            patchable = false;
             ok &= RepZeroOrderBond(I, I->primitiveCGO, s1, s2, vv1, vv2, bd_radius, rgb1, rgb2, b1, b2, a, ati1->masked, ati2->masked);
           } else {
             all_zero_order_bond_atoms.erase(b1);
@@ -838,6 +927,7 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
               BondSettingGetWD(G, b, cSetting_valence, valence_flag);
 
             if(bd_valence_flag) {
+              patchable = false;
               Pickable pickdata[] = { { b1, ati1->masked ? cPickableNoPick : a },
                                       { b2, ati2->masked ? cPickableNoPick : a } };
               ok &= RepValence(I, I->primitiveCGO, s1, s2, isRamped, vv1, vv2, other,
@@ -855,6 +945,8 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
 
                 ok &= RepCylinder(I->primitiveCGO, s1, s2, isRamped, vv1, vv2,
                     drawcap1, drawcap2, bd_radius, rgb2, &pickdata);
+                I->coordPatches.push_back({a1, a2,
+                    (s1 || !s2) ? 0.f : .5f, (s1 && !s2) ? .5f : 1.f});
 
                 if (shader_mode) {
                   // don't render caps twice with the cylinder shader
@@ -880,6 +972,7 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
        exactly the same is used to render a sphere so that we won't need to use 
        the sphere shader excessively. */
     for (auto at : all_zero_order_bond_atoms){
+      patchable = false;
       ai1 = obj->AtomInfo + at;
       c1 = ai1->color;
       float *v1 = cs->coordPtr(cs->atmToIdx(at));
@@ -901,12 +994,17 @@ Rep *RepCylBondNew(CoordSet * cs, int state)
   FreeP(capdrawn);
 
   CGOStop(I->primitiveCGO);
+
+  if (!patchable) {
+    I->coordPatches.clear();
+  }
+
   if (!ok){
     delete I;
     I = nullptr;
   }
 
-  return (Rep *) I;
+  return I;
 }
 
 #ifndef PURE_OPENGL_ES_2
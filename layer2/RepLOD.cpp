@@ -0,0 +1,250 @@
+/* 
+A* -------------------------------------------------------------------
+B* This file contains source code for the PyMOL computer program
+C* Copyright (c) Schrodinger, LLC. 
+D* -------------------------------------------------------------------
+E* It is unlawful to modify or remove this copyright notice.
+F* -------------------------------------------------------------------
+G* Please see the accompanying LICENSE file for further information. 
+H* -------------------------------------------------------------------
+I* Additional authors of this source file include:
+-* 
+-* 
+-*
+Z* -------------------------------------------------------------------
+*/
+#include "RepLOD.h"
+#include "CGO.h"
+#include "Color.h"
+#include "CoordSet.h"
+#include "ObjectMolecule.h"
+#include "Scene.h"
+#include "Setting.h"
+#include "Vector.h"
+
+#include <cmath>
+#include <set>
+#include <vector>
+
+// radius of a typical atom for the projected size test
+#define LOD_ATOM_RADIUS 1.5F
+
+// max. distance between consecutive guide atoms of a trace
+#define LOD_GUIDE_CUTOFF 8.F
+
+namespace
+{
+struct LODCluster {
+  int idx; //!< first coordinate index, for color and picking
+  float center[3];
+  float radius;
+};
+} // namespace
+
+bool RepLODEnabled(const CoordSet* cs)
+{
+  int const count = SettingGet<int>(*cs, cSetting_lod_atom_count);
+  return count > 0 && cs->NIndex >= count;
+}
+
+/**
+ * True if the coarse level should be drawn with the current view.
+ *
+ * @param coarse Current level, the switch back to full detail happens at a
+ * slightly larger size to avoid flipping between levels.
+ */
+bool RepLODWantCoarse(const CoordSet* cs, bool coarse)
+{
+  const auto* obj = cs->Obj;
+  float center[3];
+  const float* v = nullptr;
+
+  if (obj->ExtentFlag) {
+    average3f(obj->ExtentMin, obj->ExtentMax, center);
+    v = center;
+  }
+
+  float const size = LOD_ATOM_RADIUS / SceneGetScreenVertexScale(cs->G, v);
+  float threshold = SettingGet<float>(*cs, cSetting_lod_pixel_size);
+
+  if (coarse)
+    threshold *= 1.25F;
+
+  return size < threshold;
+}
+
+/**
+ * Decide the level for the current view.
+ *
+ * @return true if the geometry of `level` must be (re)generated, which is
+ * only the case for the first call and when the level changes. An empty
+ * result (e.g. nothing visible) does not cause regeneration on every frame.
+ */
+bool RepLODUpdate(const CoordSet* cs, RepLODLevel& level)
+{
+  bool const coarse = RepLODEnabled(cs) && RepLODWantCoarse(cs, level.coarse);
+
+  if (level.ready && coarse == level.coarse)
+    return false;
+
+  level.ready = true;
+  level.coarse = coarse;
+  return true;
+}
+
+/**
+ * Group the atoms which show `rep_bit` into per-residue clusters.
+ *
+ * @param[out] idx_to_cluster Cluster for each coordinate index, -1 if hidden
+ * @param guide_only Only consider guide atoms (CA, P)
+ */
+static std::vector<LODCluster> RepLODClusters(const CoordSet* cs,
+    cRepBitmask_t rep_bit, std::vector<int>& idx_to_cluster, bool guide_only)
+{
+  PyMOLGlobals* G = cs->G;
+  std::vector<LODCluster> clusters;
+  const AtomInfoType* ai_first = nullptr;
+  float sum[3] = {}, sum_sq = 0.f, sum_vdw = 0.f;
+  int n = 0;
+
+  auto finish = [&]() {
+    if (!n)
+      return;
+    auto& c = clusters.back();
+    scale3f(sum, 1.f / n, c.center);
+    float const msd = sum_sq / n - lengthsq3f(c.center);
+    c.radius = sqrtf(std::max(msd, 0.f)) + sum_vdw / n;
+  };
+
+  idx_to_cluster.assign(cs->NIndex, -1);
+
+  for (int idx = 0; idx < cs->NIndex; ++idx) {
+    const auto* ai = cs->getAtomInfo(idx);
+
+    if (!(ai->visRep & rep_bit))
+      continue;
+
+    if (guide_only && !(ai->flags & cAtomFlag_guide))
+      continue;
+
+    if (!ai_first || !AtomInfoSameResidueP(G, ai_first, ai)) {
+      finish();
+      clusters.push_back({idx});
+      ai_first = ai;
+      zero3f(sum);
+      sum_sq = sum_vdw = 0.f;
+      n = 0;
+    }
+
+    const float* v = cs->coordPtr(idx);
+    add3f(v, sum, sum);
+    sum_sq += lengthsq3f(v);
+    sum_vdw += ai->vdw;
+    ++n;
+
+    idx_to_cluster[idx] = clusters.size() - 1;
+  }
+
+  finish();
+
+  return clusters;
+}
+
+/**
+ * Color and pick color of a cluster
+ */
+static void RepLODClusterColor(const CoordSet* cs, int state, CGO* cgo,
+    const LODCluster& c, int color)
+{
+  float rgb[3];
+  const auto* ai = cs->getAtomInfo(c.idx);
+  ColorGetCheckRamped(cs->G, color < 0 ? ai->color : color, c.center, rgb, state);
+  CGOColorv(cgo, rgb);
+  CGOPickColor(cgo, cs->IdxToAtm[c.idx],
+      ai->masked ? cPickableNoPick : cPickableAtom);
+}
+
+/**
+ * Merged sphere proxies, one per residue.
+ *
+ * @param color_setting Color setting of the rep, e.g. cSetting_sphere_color
+ * @param scale Scale factor for the radii (sphere_scale)
+ */
+CGO* RepLODSpheresCGO(const CoordSet* cs, int state, cRepBitmask_t rep_bit,
+    int color_setting, float scale)
+{
+  std::vector<int> idx_to_cluster;
+  auto const clusters = RepLODClusters(cs, rep_bit, idx_to_cluster, false);
+  int const color = SettingGet<int>(*cs, color_setting);
+
+  CGO* cgo = CGONew(cs->G);
+
+  for (const auto& c : clusters) {
+    RepLODClusterColor(cs, state, cgo, c, color);
+    CGOSphere(cgo, c.center, c.radius * scale);
+  }
+
+  CGOStop(cgo);
+  return cgo;
+}
+
+/**
+ * Tube proxies which connect the residue centers.
+ *
+ * @param radius Tube radius
+ * @param guide_only If true, connect consecutive guide atoms of the same
+ * chain (cartoon). Otherwise connect residues which share a bond (sticks).
+ */
+CGO* RepLODTraceCGO(const CoordSet* cs, int state, cRepBitmask_t rep_bit,
+    int color_setting, float radius, bool guide_only)
+{
+  std::vector<int> idx_to_cluster;
+  auto const clusters =
+      RepLODClusters(cs, rep_bit, idx_to_cluster, guide_only);
+  int const color = SettingGet<int>(*cs, color_setting);
+  std::set<std::pair<int, int>> links;
+
+  if (guide_only) {
+    for (size_t i = 1; i < clusters.size(); ++i) {
+      const auto* ai1 = cs->getAtomInfo(clusters[i - 1].idx);
+      const auto* ai2 = cs->getAtomInfo(clusters[i].idx);
+      if (ai1->chain == ai2->chain && ai1->segi == ai2->segi &&
+          within3f(clusters[i - 1].center, clusters[i].center,
+              LOD_GUIDE_CUTOFF)) {
+        links.emplace(i - 1, i);
+      }
+    }
+  } else {
+    const auto* obj = cs->Obj;
+    for (int b = 0; b < obj->NBond; ++b) {
+      int const idx1 = cs->atmToIdx(obj->Bond[b].index[0]);
+      int const idx2 = cs->atmToIdx(obj->Bond[b].index[1]);
+      if (idx1 < 0 || idx2 < 0)
+        continue;
+      int const c1 = idx_to_cluster[idx1];
+      int const c2 = idx_to_cluster[idx2];
+      if (c1 >= 0 && c2 >= 0 && c1 != c2) {
+        links.emplace(std::min(c1, c2), std::max(c1, c2));
+      }
+    }
+  }
+
+  CGO* cgo = CGONew(cs->G);
+
+  for (const auto& c : clusters) {
+    RepLODClusterColor(cs, state, cgo, c, color);
+    CGOSphere(cgo, c.center, radius);
+  }
+
+  for (const auto& link : links) {
+    const auto& c1 = clusters[link.first];
+    const auto& c2 = clusters[link.second];
+    float axis[3];
+    subtract3f(c2.center, c1.center, axis);
+    RepLODClusterColor(cs, state, cgo, c1, color);
+    cgo->add<cgo::draw::shadercylinder>(c1.center, axis, radius, 0);
+  }
+
+  CGOStop(cgo);
+  return cgo;
+}
@@ -0,0 +1,50 @@
+/* 
+A* -------------------------------------------------------------------
+B* This file contains source code for the PyMOL computer program
+C* Copyright (c) Schrodinger, LLC. 
+D* -------------------------------------------------------------------
+E* It is unlawful to modify or remove this copyright notice.
+F* -------------------------------------------------------------------
+G* Please see the accompanying LICENSE file for further information. 
+H* -------------------------------------------------------------------
+I* Additional authors of this source file include:
+-* 
+-* 
+-*
+Z* -------------------------------------------------------------------
+*/
+#ifndef _H_RepLOD
+#define _H_RepLOD
+
+#include "Rep.h"
+
+/*
+ * Level of detail for huge coordinate sets.
+ *
+ * Coordinate sets with at least `lod_atom_count` atoms defer their full
+ * detail geometry. When atoms project smaller than `lod_pixel_size` pixels,
+ * per-residue proxies are drawn instead. Only the active level is kept in
+ * memory, the other one is generated on demand.
+ */
+
+struct CoordSet;
+class CGO;
+
+/**
+ * Active level of detail of a rep
+ */
+struct RepLODLevel {
+  bool ready = false;  //!< geometry of the `coarse` level has been generated
+  bool coarse = false; //!< coarse proxies instead of full detail
+};
+
+bool RepLODEnabled(const CoordSet* cs);
+bool RepLODWantCoarse(const CoordSet* cs, bool coarse);
+bool RepLODUpdate(const CoordSet* cs, RepLODLevel& level);
+
+CGO* RepLODSpheresCGO(const CoordSet* cs, int state, cRepBitmask_t rep_bit,
+    int color_setting, float scale);
+CGO* RepLODTraceCGO(const CoordSet* cs, int state, cRepBitmask_t rep_bit,
+    int color_setting, float radius, bool guide_only);
+
+#endif
@@ -630,6 +630,7 @@ Rep* RepMesh::recolor()
     /* now, assign colors to each point */
     map = new MapType(G, I->max_vdw + probe_radius, cs->Coord, cs->NIndex, nullptr);
     if(map) {
+      ColorRampedBatch ramped;
       MapSetupExpress(map);
       for(a = 0; a < I->NTot; a++) {
         AtomInfoType *ai0 = nullptr;
@@ -681,7 +682,7 @@ Rep* RepMesh::recolor()
 
         if(ColorCheckRamped(G, c1)) {
           I->oneColorFlag = false;
-          ColorGetRamped(G, c1, v0, vc, state);
+          ramped.add(c1, v0, vc);
           vc += 3;
         } else {
           c0 = ColorGet(G, c1);
@@ -690,6 +691,7 @@ Rep* RepMesh::recolor()
           *(vc++) = *(c0++);
         }
       }
+      ramped.apply(G, state);
       MapFree(map);
     }
     if(I->oneColorFlag) {
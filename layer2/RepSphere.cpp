@@ -37,6 +37,10 @@
 #include"ObjectMolecule.h"
 #include "Lex.h"
 #include "CoordSet.h"
+#include "RepLOD.h"
+
+#include <atomic>
+#include <memory>
 
 #define SPHERE_NORMAL_RANGE 6.f
 #define SPHERE_NORMAL_RANGE2 (SPHERE_NORMAL_RANGE*SPHERE_NORMAL_RANGE)
@@ -128,11 +132,10 @@ static int RepGetSphereMode(PyMOLGlobals *G, RepSphere * I, bool use_shader){
   case 5:
     // no longer exists, use default
     {
-      static bool warn_once = true;
-      if (warn_once) {
+      static std::atomic<bool> warn_once{true};
+      if (warn_once.exchange(false)) {
         PRINTFB(G, FB_ShaderMgr, FB_Warnings)
           " Warning: sphere_mode=5 was removed, use sphere_mode=9.\n" ENDFB(G);
-        warn_once = false;
       }
     }
   case 4:
@@ -147,6 +150,41 @@ static int RepGetSphereMode(PyMOLGlobals *G, RepSphere * I, bool use_shader){
   return sphere_mode;
 }
 
+static RepSphere* RepSphereNewImpl(CoordSet* cs, int state, bool defer);
+
+/**
+ * Switch between full detail and coarse proxies if needed, and generate the
+ * primitives of the new level.
+ */
+static void RepSphereUpdateLOD(RepSphere* I)
+{
+  if (I->spheroidCGO)
+    return;
+
+  if (!RepLODUpdate(I->cs, I->lod))
+    return;
+
+  if (I->renderCGO != I->primitiveCGO) {
+    CGOFree(I->renderCGO);
+  }
+  I->renderCGO = nullptr;
+  CGOFree(I->primitiveCGO);
+  I->coordPatches.clear();
+
+  if (I->lod.coarse) {
+    I->primitiveCGO = RepLODSpheresCGO(I->cs, I->getState(), cRepSphereBit,
+        cSetting_sphere_color, SettingGet<float>(*I->cs, cSetting_sphere_scale));
+  } else {
+    std::unique_ptr<RepSphere> full(
+        RepSphereNewImpl(I->cs, I->getState(), false));
+    if (full) {
+      std::swap(I->primitiveCGO, full->primitiveCGO);
+      std::swap(I->coordPatches, full->coordPatches);
+      I->setHasTransparency(full->hasTransparency());
+    }
+  }
+}
+
 void RepSphere::render(RenderInfo* info)
 {
   auto I = this;
@@ -155,6 +193,15 @@ void RepSphere::render(RenderInfo* info)
   int ok = true;
   bool use_shader = SettingGetGlobal_b(G, cSetting_sphere_use_shader) &&
                     SettingGetGlobal_b(G, cSetting_use_shaders);
+
+  // don't switch levels between the render and the picking pass
+  if (!pick || !I->lod.ready) {
+    RepSphereUpdateLOD(I);
+  }
+
+  if (!I->primitiveCGO && !I->spheroidCGO)
+    return;
+
   if(ray) {
 #ifndef _PYMOL_NO_RAY
     ok &= RepSphereRenderRay(G, I, info);
@@ -209,6 +256,21 @@ void RepSphere::render(RenderInfo* info)
   }
 }
 
+bool RepSphere::recoord()
+{
+  if (coordPatches.empty() ||
+      !RepPatchCoords(primitiveCGO, coordPatches, cs)) {
+    return false;
+  }
+
+  if (renderCGO != primitiveCGO) {
+    CGOFree(renderCGO);
+  }
+  renderCGO = nullptr;
+
+  return true;
+}
+
 bool RepSphere::sameVis() const
 {
   if (!LastVisib || !LastColor) {
@@ -262,7 +324,7 @@ static bool RepSphereDetermineAtomVisibility(PyMOLGlobals *G,
 static void RepSphereAddAtomVisInfoToStoredVC(RepSphere *I, ObjectMolecule *obj,
     CoordSet * cs, int state, int a1, AtomInfoType *ati1, int a,
     float sphere_scale, int sphere_color, float transp,
-    int *variable_alpha, float sphere_add, int const sphere_mode)
+    int *variable_alpha, bool *ramped, float sphere_add, int const sphere_mode)
 {
   PyMOLGlobals *G = cs->G;
   float at_transp = transp;
@@ -298,6 +360,7 @@ static void RepSphereAddAtomVisInfoToStoredVC(RepSphere *I, ObjectMolecule *obj,
   if(ColorCheckRamped(G, c1)) {
     ColorGetRamped(G, c1, v0, vc, state);
     vcptr = vc;
+    *ramped = true;
   } else {
     vcptr = ColorGet(G, c1);   /* save new color */
   }
@@ -311,6 +374,7 @@ static void RepSphereAddAtomVisInfoToStoredVC(RepSphere *I, ObjectMolecule *obj,
   }
 
   CGOSphere(I->primitiveCGO, v0, radius);
+  I->coordPatches.push_back({a, a, 0.f, 0.f});
 }
 
 /* This function is extraneous to do every time 
@@ -468,6 +532,15 @@ static void RepSphereSetNormalForSphere(RepSphere *I, MapType *map, float *v_tmp
 }
 
 Rep *RepSphereNew(CoordSet * cs, int state)
+{
+  return RepSphereNewImpl(cs, state, RepLODEnabled(cs));
+}
+
+/**
+ * @param defer Only determine visibility, the primitives are generated by
+ * RepSphereUpdateLOD
+ */
+static RepSphere* RepSphereNewImpl(CoordSet* cs, int state, bool defer)
 {
   PyMOLGlobals *G = cs->G;
   ObjectMolecule *obj;
@@ -484,6 +557,7 @@ Rep *RepSphereNew(CoordSet * cs, int state)
   bool *marked = nullptr;
   float transp;
   int variable_alpha = false;
+  bool ramped = false;
   short use_shader = SettingGetGlobal_b(G, cSetting_sphere_use_shader) &&
                      SettingGetGlobal_b(G, cSetting_use_shaders);
   // skip if not visible
@@ -496,8 +570,10 @@ Rep *RepSphereNew(CoordSet * cs, int state)
     return nullptr;
 
   auto I = new RepSphere(cs, state);
-  if (!cs->Spheroid.empty())
+  if (!cs->Spheroid.empty()) {
     I->spheroidCGO = RepSphereGeneratespheroidCGO(obj, cs, GetSpheroidSphereRec(G), state);
+    defer = false;
+  }
 
   if (ok){
     sphere_color =
@@ -520,11 +596,14 @@ Rep *RepSphereNew(CoordSet * cs, int state)
       sphere_add = SettingGet_f(G, cs->Setting.get(), obj->Setting.get(), cSetting_solvent_radius);       /* if so, get solvent radius */
     }
   }
-  I->primitiveCGO = CGONew(G);
+  if (!defer) {
+    I->primitiveCGO = CGONew(G);
+    I->lod.ready = true;
+  }
 
   bool needNormals = (sphere_mode >= 6) && (sphere_mode < 9);
   int nspheres = 0;
-  if (needNormals){
+  if (needNormals && !defer){
     float *v_tmp = VLAlloc(float, 1024);
   for(a = 0; ok && a < cs->NIndex; a++) {
     a1 = cs->IdxToAtm[a];
@@ -554,8 +633,8 @@ Rep *RepSphereNew(CoordSet * cs, int state)
       ati1 = obj->AtomInfo + a1;
         RepSphereSetNormalForSphere(I, map, v_tmp, &v_tmp[a * 3], cut_mult, a, active, dot, n_dot);
         RepSphereAddAtomVisInfoToStoredVC(I, obj, cs, state, a1, ati1, a,
-            sphere_scale, sphere_color, transp, &variable_alpha, sphere_add,
-            sphere_mode);
+            sphere_scale, sphere_color, transp, &variable_alpha, &ramped,
+            sphere_add, sphere_mode);
       }
 	ok &= !G->Interrupt;
       }
@@ -572,14 +651,27 @@ Rep *RepSphereNew(CoordSet * cs, int state)
                                          cartoon_side_chain_helper, ribbon_side_chain_helper);
       if(marked[a1]) {
         nspheres++;
-        RepSphereAddAtomVisInfoToStoredVC(I, obj, cs, state, a1, ati1, a,
-            sphere_scale, sphere_color, transp, &variable_alpha, sphere_add,
-            sphere_mode);
+        if (defer) {
+          float at_transp = transp;
+          AtomSettingGetIfDefined(G, ati1, cSetting_sphere_transparency, &at_transp);
+          if (at_transp > 0.f)
+            I->setHasTransparency();
+        } else {
+          RepSphereAddAtomVisInfoToStoredVC(I, obj, cs, state, a1, ati1, a,
+              sphere_scale, sphere_color, transp, &variable_alpha, &ramped,
+              sphere_add, sphere_mode);
+        }
       }
       ok &= !G->Interrupt;
     }
   }
-  CGOStop(I->primitiveCGO);
+  if (I->primitiveCGO)
+    CGOStop(I->primitiveCGO);
+
+  // normals, spheroids and ramped colors depend on the coordinates
+  if (needNormals || I->spheroidCGO || ramped) {
+    I->coordPatches.clear();
+  }
 
   if(ok) {
     if(!I->LastVisib)
@@ -613,5 +705,5 @@ Rep *RepSphereNew(CoordSet * cs, int state)
     delete I;
     I = nullptr;
   }
-  return (Rep *) I;
+  return I;
 }
@@ -18,6 +18,7 @@ Z* -------------------------------------------------------------------
 #define _H_RepSphere
 
 #include"Rep.h"
+#include"RepLOD.h"
 
 struct PyMOLGlobals;
 struct CoordSet;
@@ -32,12 +33,19 @@ struct RepSphere : Rep {
   cRep_t type() const override { return cRepSphere; }
   void render(RenderInfo* info) override;
   bool sameVis() const override;
+  bool recoord() override;
 
   bool* LastVisib = nullptr;
   int* LastColor = nullptr;
   CGO* renderCGO = nullptr;
   CGO* primitiveCGO = nullptr;
   CGO* spheroidCGO = nullptr;
+
+  //! One entry per primitiveCGO sphere, empty if not patchable
+  std::vector<RepCoordPatch> coordPatches;
+
+  //! Level of detail of primitiveCGO (see RepLOD.h)
+  RepLODLevel lod;
 };
 
 Rep *RepSphereNew(CoordSet * cset, int state);
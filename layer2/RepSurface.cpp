@@ -2838,6 +2838,7 @@ Rep* RepSurface::recolor()
       float color_smoothing_threshold =
           SettingGetGlobal_f(G, cSetting_surface_color_smoothing_threshold);
       int atm, ok = true;
+      ColorRampedBatch ramped;
       MapSetupExpress(map);
       ok &= !G->Interrupt;
       if (ok && I->AT.empty())
@@ -3000,7 +3001,7 @@ Rep* RepSurface::recolor()
             ramped_flag = true;
             break;
           }
-          ColorGetRamped(G, c1, v_pos, vc, state);
+          ramped.add(c1, v_pos, vc);
           vc += 3;
           rc++;
         } else {
@@ -3039,6 +3040,7 @@ Rep* RepSurface::recolor()
         if (!*vi)
           I->allVisibleFlag = false;
       }
+      ramped.apply(G, state);
       MapFree(map);
     }
     if (variable_alpha)
@@ -38,10 +38,14 @@ struct RepWireBond : Rep {
 
   cRep_t type() const override { return cRepLine; }
   void render(RenderInfo* info) override;
+  bool recoord() override;
 
   CGO *shaderCGO = nullptr;
   CGO *primitiveCGO = nullptr;
   bool shaderCGO_has_cylinders = false;
+
+  //! One entry per primitiveCGO line, empty if not patchable
+  std::vector<RepCoordPatch> coordPatches;
 };
 
 #include"ObjectMolecule.h"
@@ -260,6 +264,18 @@ RepWireBond::~RepWireBond()
 }
 
 
+bool RepWireBond::recoord()
+{
+  if (coordPatches.empty() ||
+      !RepPatchCoords(primitiveCGO, coordPatches, cs)) {
+    return false;
+  }
+
+  CGOFree(shaderCGO);
+  shaderCGO_has_cylinders = false;
+  return true;
+}
+
 /* lower memory use and higher performance for
    display of large trajectories, etc. */
 
@@ -600,6 +616,7 @@ Rep *RepWireBondNew(CoordSet * cs, int state)
   int fancy;
   const float _0p9 = 0.9F;
   int ok = true;
+  bool patchable = true;
   unsigned int line_counter = 0;
   PRINTFD(G, FB_RepWireBond)
     " RepWireBondNew-Debug: entered.\n" ENDFD;
@@ -643,6 +660,8 @@ Rep *RepWireBondNew(CoordSet * cs, int state)
     line_stick_helper = false;
   half_bonds = SettingGet_i(G, cs->Setting.get(), obj->Setting.get(), cSetting_half_bonds);
   hide_long = SettingGet_b(G, cs->Setting.get(), obj->Setting.get(), cSetting_hide_long_bonds);
+  if (hide_long)
+    patchable = false;
   na_mode =
     SettingGet_i(G, cs->Setting.get(), obj->Setting.get(), cSetting_cartoon_nucleic_acid_mode);
   int na_mode_ribbon =
@@ -752,6 +771,9 @@ Rep *RepWireBondNew(CoordSet * cs, int state)
         s1 = s1_before_symop && !symop[0];
         s2 = s2_before_symop && !symop[1];
 
+        if (symop[1])
+          patchable = false;
+
         if(hide_long && (s1 || s2)) {
           float cutoff = (ati1->vdw + ati2->vdw) * _0p9;
           if(!within3f(v1, v2, cutoff)) /* atoms separated by more than 90% of the sum of their vdw radii */
@@ -827,11 +849,18 @@ Rep *RepWireBondNew(CoordSet * cs, int state)
               ord = 1;
             }
 
+            if (isRamped)
+              patchable = false;
+
             if (!ord){
+              patchable = false;
               RepWireZeroOrderBond(I->primitiveCGO, s1, s2, v1, v2, rgb1, rgb2, b1, b2, a, .15f, .15f, ati1->masked, ati2->masked);
             } else if (!bd_valence_flag || ord <= 1){
               RepLine(I->primitiveCGO, s1, s2, isRamped, v1, v2, rgb1, b1, b2, a, rgb2, ati1->masked, ati2->masked);
+              I->coordPatches.push_back({a1, a2,
+                  (s1 || !s2) ? 0.f : .5f, (s1 && !s2) ? .5f : 1.f});
             } else {
+              patchable = false;
               if (ord == 4){
                 RepAromatic(I->primitiveCGO, s1, s2, isRamped, v1, v2, other, a1, a2, cs->Coord, rgb1, rgb2, valence, 0, b1, b2, a, ati1->masked, ati2->masked);
               } else {
@@ -856,6 +885,8 @@ Rep *RepWireBondNew(CoordSet * cs, int state)
   CGOEnd(I->primitiveCGO);
   CGOSpecialWithArg(I->primitiveCGO, LINE_LIGHTING, 1.f);
   CGOStop(I->primitiveCGO);
+  if (!patchable)
+    I->coordPatches.clear();
   FreeP(marked);
   FreeP(other);
   if (!ok || !line_counter){
@@ -46,6 +46,7 @@
 #include "List.h"
 #include "ListMacros.h"
 #include "Map.h"
+#include "MapOperation.h"
 #include "Match.h"
 #include "Matrix.h"
 #include "Menu.h"
@@ -69,6 +70,7 @@
 #include "PConv.h"
 #include "Parse.h"
 #include "PlugIOManager.h"
+#include "Profiler.h"
 #include "PyMOL.h"
 #include "PyMOLOptions.h"
 #include "RepDot.h"
@@ -1572,6 +1574,7 @@ void ExecutiveInvalidateSceneMembers(PyMOLGlobals* G)
 
 void ExecutiveUpdateSceneMembers(PyMOLGlobals* G)
 {
+  PYMOL_PROFILE_SCOPE(G, "Executive", "ExecutiveUpdateSceneMembers");
   CExecutive* I = G->Executive;
   ExecutiveUpdateGroups(G, false);
   ExecutiveUpdateGridSlots(G, false);
@@ -2374,6 +2377,11 @@ int ExecutiveDrawCmd(PyMOLGlobals* G, int width, int height, int antialias,
     SceneInvalidateCopy(G, false);
     OrthoDirty(G);
     I->CaptureFlag = true;
+  } else if (!G->HaveGUI) {
+    /* no OpenGL context, rasterize on the CPU instead */
+    ExecutiveUpdateSceneMembers(G);
+    SceneRay(G, width, height, cSceneRay_MODE_RASTER, nullptr, nullptr, 0.0F,
+        0.0F, quiet, nullptr, false, antialias);
   } else {
     if (SettingGetGlobal_i(G, cSetting_draw_mode) == -1) {
       ExecutiveSetSettingFromString(
@@ -3751,6 +3759,14 @@ pymol::Result<ExecutiveLoadArgs> ExecutiveLoadPrepareArgs(PyMOLGlobals* G,
     }
     fname_null_ok = true;
     break;
+  case cLoadTypeCCP4Map:
+  case cLoadTypeCCP4Unspecified:
+  case cLoadTypeMRC:
+    // memory-mapped by ExecutiveLoad
+    if (content) {
+      fname_null_ok = true;
+    }
+    break;
   case cLoadTypePQR:
   case cLoadTypePDBQT:
   case cLoadTypePDB:
@@ -3758,9 +3774,6 @@ pymol::Result<ExecutiveLoadArgs> ExecutiveLoadPrepareArgs(PyMOLGlobals* G,
   case cLoadTypeMMTF:
   case cLoadTypeMAE:
   case cLoadTypeXPLORMap:
-  case cLoadTypeCCP4Map:
-  case cLoadTypeCCP4Unspecified:
-  case cLoadTypeMRC:
   case cLoadTypePHIMap:
   case cLoadTypeMMD:
   case cLoadTypeMOL:
@@ -3865,6 +3878,7 @@ pymol::Result<ExecutiveLoadArgs> ExecutiveLoadPrepareArgs(PyMOLGlobals* G,
 
 pymol::Result<> ExecutiveLoad(PyMOLGlobals* G, ExecutiveLoadArgs const& args)
 {
+  PYMOL_PROFILE_SCOPE(G, "Executive", "ExecutiveLoad");
   pymol::CObject* origObj = nullptr;
   const char* fname = args.fname.c_str();
   const char* content = args.content.data();
@@ -4027,10 +4041,34 @@ pymol::Result<> ExecutiveLoad(PyMOLGlobals* G, ExecutiveLoadArgs const& args)
   case cLoadTypeCCP4Unspecified:
   case cLoadTypeCCP4UnspecifiedStr:
   case cLoadTypeMRC:
-  case cLoadTypeMRCStr:
-    obj = ObjectMapLoadCCP4(G, (ObjectMap*) origObj, content, state, true, size,
-        quiet, content_format);
-    break;
+  case cLoadTypeMRCStr: {
+    const float* mn = nullptr;
+    const float* mx = nullptr;
+    if (args.map_region.size() == 6) {
+      mn = args.map_region.data();
+      mx = mn + 3;
+    }
+
+    if (args.content.empty() && !args.fname.empty()) {
+      // only pages which are accessed get read from disk
+      std::unique_ptr<pymol::MappedFile> file;
+      try {
+        file.reset(new pymol::MappedFile(args.fname));
+      } catch (...) {
+        return pymol::make_error(
+            pymol::string_format("Unable to open file '%s'", fname));
+      }
+      obj = ObjectMapLoadCCP4(G, (ObjectMap*) origObj, file->data(), state,
+          true, file->size(), quiet, content_format, mn, mx);
+    } else {
+      obj = ObjectMapLoadCCP4(G, (ObjectMap*) origObj, content, state, true,
+          args.content.size(), quiet, content_format, mn, mx);
+    }
+
+    if (!obj) {
+      return pymol::make_error("Failed to read map");
+    }
+  } break;
   case cLoadTypeCGO:
     obj = ObjectCGOFromFloatArray(
         G, (ObjectCGO*) origObj, (float*) content, size, state, quiet);
@@ -4107,6 +4145,48 @@ pymol::Result<> ExecutiveLoad(PyMOLGlobals* G, ExecutiveLoadArgs const& args)
   return {};
 }
 
+/**
+ * Load the part of a CCP4 or MRC map file which covers a selection.
+ *
+ * The file is memory-mapped and only the sections and rows inside the
+ * selection extent (plus buffer) get read, so this works for maps which are
+ * much larger than the available memory.
+ *
+ * @param sele Selection which defines the region
+ * @param buffer Padding around the selection extent in Angstrom
+ * @param state Object state to load into (0-based, -1 to append)
+ * @param sele_state Selection state for the extent
+ */
+pymol::Result<> ExecutiveLoadMapRegion(PyMOLGlobals* G, const char* fname,
+    cLoadType_t content_format, const char* object_name, const char* sele,
+    float buffer, int state, int sele_state, int quiet)
+{
+  switch (content_format) {
+  case cLoadTypeCCP4Map:
+  case cLoadTypeCCP4Unspecified:
+  case cLoadTypeMRC:
+    break;
+  default:
+    return pymol::make_error("Region loading requires a CCP4 or MRC map file");
+  }
+
+  float mn[3], mx[3];
+  if (!ExecutiveGetExtent(G, sele, mn, mx, true, sele_state, false)) {
+    return pymol::make_error("Selection is empty");
+  }
+
+  auto res = ExecutiveLoadPrepareArgs(G, fname, nullptr, 0, content_format,
+      object_name, state, -1 /* zoom */, 0 /* discrete */, 1 /* finish */,
+      0 /* multiplex */, quiet, nullptr, nullptr, nullptr);
+  p_return_if_error(res);
+
+  auto& args = res.result();
+  args.map_region = {mn[0] - buffer, mn[1] - buffer, mn[2] - buffer,
+      mx[0] + buffer, mx[1] + buffer, mx[2] + buffer};
+
+  return ExecutiveLoad(G, args);
+}
+
 /* ExecutiveGetExistingCompatible
  *
  * PARAMS
@@ -4453,6 +4533,25 @@ pymol::Result<> ExecutiveAssignSS(PyMOLGlobals* G, const char* target,
   return {};
 }
 
+pymol::Result<std::vector<std::string>> ExecutiveGetSS(PyMOLGlobals* G,
+    const char* target, int state, const char* context, int quiet)
+{
+  if (!target[0]) {
+    return pymol::make_error("selection must not be empty");
+  }
+  auto targetTmp = SelectorTmp::make(G, target);
+  p_return_if_error(targetTmp);
+  int sele0 = targetTmp->getIndex();
+  int sele1 = sele0;
+  pymol::Result<SelectorTmp> contextTmp;
+  if (context && context[0]) {
+    contextTmp = SelectorTmp::make(G, context);
+    p_return_if_error(contextTmp);
+    sele1 = contextTmp->getIndex();
+  }
+  return SelectorGetSS(G, sele0, sele1, state, quiet);
+}
+
 static int* getRepArrayFromBitmask(int visRep);
 
 PyObject* ExecutiveGetVisAsPyDict(PyMOLGlobals* G)
@@ -4640,23 +4739,38 @@ int ExecutiveSetVisFromPyDict(PyMOLGlobals* G, PyObject* dict)
 /**
  * returns a pointer to the data in a volume or map object
  */
-CField* ExecutiveGetVolumeField(PyMOLGlobals* G, const char* objName, int state)
+/**
+ * @param writable The caller exposes the data for modification (e.g. as a
+ * numpy view), see IsofieldDataShared
+ */
+CField* ExecutiveGetVolumeField(
+    PyMOLGlobals* G, const char* objName, int state, bool writable)
 {
   ObjectMapState* oms;
   pymol::CObject* obj;
+  Isofield* field = nullptr;
 
   obj = ExecutiveFindObjectByName(G, objName);
   ok_assert(1, obj);
 
   switch (obj->type) {
   case cObjectVolume:
-    return ObjectVolumeGetField((ObjectVolume*) obj);
+    field = ObjectVolumeGetField((ObjectVolume*) obj);
+    break;
   case cObjectMap:
     oms = ObjectMapGetState((ObjectMap*) obj, state);
-    ok_assert(1, oms && oms->Field);
-    return oms->Field->data.get();
+    ok_assert(1, oms);
+    field = oms->Field.get();
+    break;
   }
 
+  ok_assert(1, field && field->data);
+
+  if (writable)
+    IsofieldDataShared(field);
+
+  return field->data.get();
+
 ok_except1:
   return nullptr;
 }
@@ -6449,14 +6563,6 @@ int*** ExecutiveGetBondPrint(
 }
 
 /*========================================================================*/
-#define cMapOperatorMinimum 0
-#define cMapOperatorMaximum 1
-#define cMapOperatorSum 2
-#define cMapOperatorAverage 3
-#define cMapOperatorDifference 4
-#define cMapOperatorCopy 5
-#define cMapOperatorUnique 6
-
 pymol::Result<> ExecutiveMapSet(PyMOLGlobals* G, const char* name,
     int operator_, const char* operands, int target_state, int source_state,
     int zoom, int quiet)
@@ -6549,16 +6655,16 @@ pymol::Result<> ExecutiveMapSet(PyMOLGlobals* G, const char* name,
     if (!target) { /* target map doesn't exist... */
       int need_union_geometry = false;
       int need_first_geometry = false;
-      switch (operator_) {
-      case cMapOperatorSum:
-      case cMapOperatorAverage:
-      case cMapOperatorMinimum:
-      case cMapOperatorMaximum:
-      case cMapOperatorDifference:
+      switch (static_cast<pymol::MapOperator>(operator_)) {
+      case pymol::MapOperator::Sum:
+      case pymol::MapOperator::Average:
+      case pymol::MapOperator::Minimum:
+      case pymol::MapOperator::Maximum:
+      case pymol::MapOperator::Difference:
         need_union_geometry = true;
         break;
-      case cMapOperatorUnique:
-      case cMapOperatorCopy:
+      case pymol::MapOperator::Unique:
+      case pymol::MapOperator::Copy:
         need_first_geometry = true;
         break;
       }
@@ -6666,188 +6772,56 @@ pymol::Result<> ExecutiveMapSet(PyMOLGlobals* G, const char* name,
 
   /* now do the actual operation */
 
+  const auto op = static_cast<pymol::MapOperator>(operator_);
+
   int src_state;
   for (src_state = src_state_start; src_state < src_state_stop; src_state++) {
     int trg_state = src_state + target_state;
     ObjectMapState* ms;
     VecCheckEmplace(target->State, trg_state, G);
 
-    ms = &target->State[target_state];
+    ms = &target->State[trg_state];
     if (ms->Active) {
       int iter_id = TrackerNewIter(I_Tracker, 0, list_id);
       int n_pnt =
           (ms->Field->points->size() / ms->Field->points->base_size) / 3;
-      float* pnt = (float*) ms->Field->points->data.data();
-      float* r_value = pymol::malloc<float>(n_pnt);
-      float* l_value = pymol::calloc<float>(n_pnt);
-      int* present = pymol::calloc<int>(n_pnt);
-      std::vector<std::uint8_t> inside(n_pnt);
+      const float* pnt = (const float*) ms->Field->points->data.data();
+      pymol::MapAccumulator accum(op, n_pnt);
+      std::vector<float> r_value;
+      std::vector<std::uint8_t> inside;
       SpecRec* rec;
 
       while (TrackerIterNextCandInList(
           I_Tracker, iter_id, (TrackerRef**) (void*) &rec)) {
-        if (rec) {
-          if (rec->type == cExecObject) {
-            if (rec->obj->type == cObjectMap) {
-              ObjectMap* obj = (ObjectMap*) rec->obj;
-              if (ObjectMapInterpolate(
-                      obj, src_state, pnt, r_value, inside.data(), n_pnt)) {
-                int a;
-                float* rv = r_value;
-                float* lv = l_value;
-                auto* flg = inside.data();
-                int* pre = present;
-
-                switch (operator_) {
-                case cMapOperatorCopy:
-                  for (a = 0; a < n_pnt; a++) {
-                    if (flg) {
-                      *lv = *rv;
-                    }
-                    rv++;
-                    lv++;
-                    flg++;
-                  }
-                  break;
-                case cMapOperatorMinimum:
-                  for (a = 0; a < n_pnt; a++) {
-                    if (flg) {
-                      if (*pre) {
-                        if (*lv > *rv)
-                          *lv = *rv;
-                      } else { /* first map */
-                        *pre = 1;
-                        *lv = *rv;
-                      }
-                    }
-                    rv++;
-                    lv++;
-                    flg++;
-                    pre++;
-                  }
-                  break;
-                case cMapOperatorMaximum:
-                  for (a = 0; a < n_pnt; a++) {
-                    if (flg) {
-                      if (*pre) {
-                        if (*lv < *rv)
-                          *lv = *rv;
-                      } else { /* first map */
-                        *pre = 1;
-                        *lv = *rv;
-                      }
-                    }
-                    rv++;
-                    lv++;
-                    flg++;
-                    pre++;
-                  }
-                  break;
-                case cMapOperatorSum:
-                  for (a = 0; a < n_pnt; a++) {
-                    if (flg) {
-                      *lv += *rv;
-                    }
-                    rv++;
-                    lv++;
-                    flg++;
-                  }
-                  break;
-                case cMapOperatorAverage:
-                  for (a = 0; a < n_pnt; a++) {
-                    if (flg) {
-                      *lv += *rv;
-                    }
-                    (*pre)++;
-                    rv++;
-                    lv++;
-                    flg++;
-                    pre++;
-                  }
-                  break;
-                case cMapOperatorDifference:
-                  if (obj != first_operand) {
-                    for (a = 0; a < n_pnt; a++) {
-                      if (flg) {
-                        *lv -= *rv;
-                      }
-                      rv++;
-                      lv++;
-                      flg++;
-                    }
-                  } else {
-                    for (a = 0; a < n_pnt; a++) {
-                      if (flg) {
-                        *lv += *rv;
-                      }
-                      rv++;
-                      lv++;
-                      flg++;
-                    }
-                  }
-                  break;
-                case cMapOperatorUnique:
-                  if (obj != first_operand) {
-                    for (a = 0; a < n_pnt; a++) {
-                      if (flg) {
-                        *lv -= *rv;
-                      }
-                      rv++;
-                      lv++;
-                      flg++;
-                    }
-                  } else {
-                    for (a = 0; a < n_pnt; a++) {
-                      if (flg) {
-                        *lv += *rv;
-                      }
-                      rv++;
-                      lv++;
-                      flg++;
-                    }
-                  }
+        if (!rec || rec->type != cExecObject ||
+            rec->obj->type != cObjectMap) {
+          continue;
+        }
 
-                  break;
-                }
-              }
-            }
-          }
+        ObjectMap* obj = (ObjectMap*) rec->obj;
+        ObjectMapState* oms = ObjectMapGetState(obj, src_state);
+        if (!oms || !oms->Active) {
+          continue;
         }
-      }
 
-      {
-        int a;
-        float* lv = l_value;
-        int* pre = present;
-
-        switch (operator_) {
-        case cMapOperatorUnique:
-          lv = l_value;
-          for (a = 0; a < n_pnt; a++) {
-            if (*lv < 0.0F)
-              *lv = 0.0F;
-            lv++;
-          }
-          break;
-        case cMapOperatorAverage:
-          lv = l_value;
-          pre = present;
-          for (a = 0; a < n_pnt; a++) {
-            if (*pre)
-              *lv /= *pre;
-            lv++;
-            pre++;
-          }
+        if (ObjectMapStateSameGrid(oms, ms)) {
+          /* operand shares the target grid, no resampling */
+          accum.add((const float*) oms->Field->data->data.data(), nullptr,
+              obj == first_operand);
+        } else {
+          r_value.resize(n_pnt);
+          inside.resize(n_pnt);
+          ObjectMapInterpolate(
+              obj, src_state, pnt, r_value.data(), inside.data(), n_pnt);
+          accum.add(r_value.data(), inside.data(), obj == first_operand);
         }
       }
 
-      /* copy after calculation so that operand can include target */
+      /* write after calculation so that operand can include target */
 
-      memcpy(ms->Field->data->data.data(), l_value, n_pnt * sizeof(float));
+      accum.finish((float*) ms->Field->data->data.data());
+      IsofieldDataChanged(ms->Field.get());
 
-      FreeP(present);
-      FreeP(l_value);
-      FreeP(r_value);
       TrackerDelIter(I_Tracker, iter_id);
     }
   }
@@ -7035,6 +7009,10 @@ pymol::Result<> ExecutiveMapNew(PyMOLGlobals* G, const char* name, int type,
             SelectorMapGaussian(
                 G, sele0, ms, 0.0F, state, normalize, true, quiet, resolution);
             break;
+          case 6: /* coulomb_mesh */
+            SelectorMapCoulomb(
+                G, sele0, ms, 0.0F, state, false, false, 1.0F, true);
+            break;
           }
           if (!ms->Active)
             ObjectMapStatePurge(G, ms);
@@ -7064,6 +7042,92 @@ pymol::Result<> ExecutiveMapNew(PyMOLGlobals* G, const char* name, int type,
   return {};
 }
 
+/*========================================================================*/
+/**
+ * Fourier transform map coefficients to a new map object (one unit cell)
+ *
+ * @param hkl Miller indices (3 * n)
+ * @param amplitudes Amplitudes (n)
+ * @param phases Phases in degrees (n)
+ * @param weights Weights (n) or empty for unit weights
+ * @param cell Unit cell (a, b, c, alpha, beta, gamma)
+ * @param space_group Space group symbol
+ */
+pymol::Result<> ExecutiveMapFromReflections(PyMOLGlobals* G, const char* name,
+    const std::vector<int>& hkl, const std::vector<float>& amplitudes,
+    const std::vector<float>& phases, const std::vector<float>& weights,
+    const float* cell, const char* space_group, int zoom, int quiet)
+{
+  const auto n = amplitudes.size();
+  if (hkl.size() != 3 * n || phases.size() != n ||
+      (!weights.empty() && weights.size() != n)) {
+    return pymol::make_error("Reflection arrays have inconsistent lengths");
+  }
+
+  auto sym = std::make_unique<CSymmetry>(G);
+  sym->Crystal.setDims(cell);
+  sym->Crystal.setAngles(cell + 3);
+  sym->setSpaceGroup(space_group);
+
+  std::vector<ReflectionInfo> reflections(n);
+  for (size_t i = 0; i < n; ++i) {
+    reflections[i] = ReflectionInfo{
+        glm::ivec3(hkl[3 * i], hkl[3 * i + 1], hkl[3 * i + 2]), amplitudes[i],
+        phases[i], weights.empty() ? 1.0F : weights[i]};
+  }
+
+  auto result = ObjectMapReadReflections(G, std::move(sym), reflections);
+  p_return_if_error(result);
+
+  auto objMap = result.result();
+  ObjectSetName(objMap, name);
+  ExecutiveDelete(G, name);
+  ExecutiveManageObject(G, objMap, zoom, quiet);
+
+  if (!quiet) {
+    const auto& ms = objMap->State[0];
+    PRINTFB(G, FB_Executive, FB_Details)
+      " Executive: Map '%s' from %zu reflections, grid %d x %d x %d.\n", name,
+      n, ms.FDim[0], ms.FDim[1], ms.FDim[2] ENDFB(G);
+  }
+
+  return {};
+}
+
+/*========================================================================*/
+/**
+ * Interpolated map values at many points (trilinear)
+ *
+ * @param points Model space coordinates (3 * n)
+ * @param outside Value for points outside of the map
+ */
+pymol::Result<std::vector<float>> ExecutiveGetMapValues(PyMOLGlobals* G,
+    const char* name, int state, const float* points, size_t n,
+    float outside)
+{
+  auto obj = ExecutiveFindObject<ObjectMap>(G, name);
+  if (!obj) {
+    return pymol::make_error("Map object \"", name, "\" not found");
+  }
+
+  if (!ObjectMapGetState(obj, state)) {
+    return pymol::make_error("Map object \"", name, "\" has no state ",
+        state + 1);
+  }
+
+  std::vector<float> values(n);
+  std::vector<std::uint8_t> inside(n);
+  ObjectMapInterpolate(obj, state, points, values.data(), inside.data(), n);
+
+  for (size_t i = 0; i < n; ++i) {
+    if (!inside[i]) {
+      values[i] = outside;
+    }
+  }
+
+  return values;
+}
+
 /*========================================================================*/
 int ExecutiveSculptIterateAll(PyMOLGlobals* G)
 {
@@ -11599,6 +11663,7 @@ int ExecutiveCountStates(PyMOLGlobals* G, const char* s1)
 int ExecutiveRay(PyMOLGlobals* G, int width, int height, int mode, float angle,
     float shift, int quiet, int defer, int antialias)
 {
+  PYMOL_PROFILE_SCOPE(G, "Executive", "ExecutiveRay");
   if ((mode == 0) && G->HaveGUI &&
       SettingGetGlobal_b(G, cSetting_auto_copy_images)) {
     /* force deferred behavior if copying image to clipboard */
@@ -14299,17 +14364,32 @@ void ExecutiveSymExp(PyMOLGlobals* G, const char* name, const char* oname,
     }
   }
 
+  // with symmetry_instancing, all mates go into a single object which
+  // renders the asymmetric unit with a list of instance transformations
+  bool const instancing = SettingGet<bool>(G, cSetting_symmetry_instancing);
+  ObjectMolecule* inst_obj = nullptr;
+
   /* go out no more than one lattice step in each direction: -1, 0, +1 */
   for (int x = -1; x < 2; ++x) {
     for (int y = -1; y < 2; ++y) {
       for (int z = -1; z < 2; ++z) {
         for (int a = 0; a < nsymmat; a++) {
           /* make a copy of the original */
-          auto new_obj = ObjectMoleculeCopy(obj);
+          ObjectMolecule* new_obj = nullptr;
+          std::vector<std::array<float, 16>> inst_mats;
           bool keepFlag = false;
 
-          for (int b = 0; b < new_obj->NCSet; ++b) {
-            auto* cs = new_obj->CSet[b];
+          if (instancing) {
+            inst_mats.resize(obj->NCSet);
+            for (auto& inst_mat : inst_mats) {
+              identity44f(inst_mat.data());
+            }
+          } else {
+            new_obj = ObjectMoleculeCopy(obj);
+          }
+
+          for (int b = 0; b < obj->NCSet; ++b) {
+            auto* cs = instancing ? obj->CSet[b] : new_obj->CSet[b];
             if (!cs) {
               continue;
             }
@@ -14343,12 +14423,16 @@ void ExecutiveSymExp(PyMOLGlobals* G, const char* name, const char* oname,
               continue;
             }
 
-            double mat_d[16];
-            copy44f44d(mat, mat_d);
-            ObjectStateLeftCombineMatrixR44d(cs, mat_d);
+            if (instancing) {
+              std::copy_n(mat, 16, inst_mats[b].data());
+            } else {
+              double mat_d[16];
+              copy44f44d(mat, mat_d);
+              ObjectStateLeftCombineMatrixR44d(cs, mat_d);
 
-            if (!matrix_mode) {
-              CoordSetTransform44f(cs, mat);
+              if (!matrix_mode) {
+                CoordSetTransform44f(cs, mat);
+              }
             }
 
             if (keepFlag) {
@@ -14359,7 +14443,7 @@ void ExecutiveSymExp(PyMOLGlobals* G, const char* name, const char* oname,
             for (unsigned idx = 0; idx < cs->NIndex; ++idx) {
               const auto* v2 = cs->coordPtr(idx);
 
-              if (matrix_mode) {
+              if (matrix_mode || instancing) {
                 transform44f3f(mat, v2, ts);
                 v2 = ts;
               }
@@ -14370,9 +14454,11 @@ void ExecutiveSymExp(PyMOLGlobals* G, const char* name, const char* oname,
               }
             }
 
-            // CIF-style symop label (e.g. "1_555")
-            cs->setTitle(pymol::string_format("%d_%.0f%.0f%.0f", a + 1,
-                shift[0] + 5, shift[1] + 5, shift[2] + 5));
+            if (!instancing) {
+              // CIF-style symop label (e.g. "1_555")
+              cs->setTitle(pymol::string_format("%d_%.0f%.0f%.0f", a + 1,
+                  shift[0] + 5, shift[1] + 5, shift[2] + 5));
+            }
           }
 
           if (!keepFlag) {
@@ -14380,6 +14466,25 @@ void ExecutiveSymExp(PyMOLGlobals* G, const char* name, const char* oname,
             continue;
           }
 
+          if (instancing) {
+            if (!inst_obj) {
+              inst_obj = ObjectMoleculeCopy(obj);
+            }
+
+            for (int b = 0; b < inst_obj->NCSet; ++b) {
+              auto* cs = inst_obj->CSet[b];
+              const float* mat = inst_mats[b].data();
+              if (!cs || is_identityf(4, mat)) {
+                continue;
+              }
+              auto& instances = cs->InstanceMatrices;
+              instances.resize(instances.size() + 16);
+              copy44f44d(mat, instances.data() + instances.size() - 16);
+            }
+
+            continue;
+          }
+
           if (segi) {
             auto seg = make_symexp_segi_label(a, x, y, z);
             lexidx_t segi = LexIdx(G, seg.c_str());
@@ -14405,6 +14510,19 @@ void ExecutiveSymExp(PyMOLGlobals* G, const char* name, const char* oname,
       }
     }
   }
+
+  if (inst_obj) {
+    if (!quiet) {
+      PRINTFB(G, FB_Executive, FB_Details)
+      " ExecutiveSymExp: %d instances in object \"%s\"\n",
+          inst_obj->CSet[0] ? inst_obj->CSet[0]->getNInstance() : 0,
+          name ENDFB(G);
+    }
+
+    ObjectSetName(inst_obj, name);
+    ExecutiveDelete(G, inst_obj->Name);
+    ExecutiveManageObject(G, inst_obj, false, quiet);
+  }
 }
 
 void ExecutivePurgeSpec(PyMOLGlobals* G, SpecRec* rec, bool save)
@@ -17441,3 +17559,47 @@ pymol::Result<std::unordered_set<const pymol::CObject*>> ExecutiveGetObjectDeps(
   obj_set.erase(&obj);
   return obj_set;
 }
+
+pymol::Result<> ExecutiveProfile(PyMOLGlobals* G, pymol::zstring_view action,
+    const char* filename, int quiet)
+{
+  auto& profiler = *G->Profiler;
+
+  if (action == "start") {
+    profiler.start();
+  } else if (action == "stop") {
+    profiler.stop();
+  } else if (action == "clear") {
+    profiler.clear();
+  } else if (action == "save") {
+    if (!filename || !filename[0]) {
+      return pymol::make_error("filename required");
+    }
+    p_return_if_error(profiler.saveChromeTrace(filename));
+    if (!quiet) {
+      PRINTFB(G, FB_Executive, FB_Actions)
+        " Profile: %zu events saved to \"%s\".\n", profiler.size(), filename
+        ENDFB(G);
+    }
+  } else if (action == "report") {
+    auto nodes = profiler.summary();
+    PRINTFB(G, FB_Executive, FB_Results)
+      " Profile: %zu events (%zu dropped), recording is %s.\n"
+      "   total ms    self ms    count  scope\n",
+      profiler.size(), profiler.dropped(), profiler.enabled() ? "on" : "off"
+      ENDFB(G);
+    for (const auto& node : nodes) {
+      auto slash = node.path.rfind('/');
+      auto name = (slash == std::string::npos) ? node.path
+                                               : node.path.substr(slash + 1);
+      PRINTFB(G, FB_Executive, FB_Results)
+        " %10.3f %10.3f %8d  %*s%s\n", node.total * 1e3, node.self * 1e3,
+        node.count, node.depth * 2, "", name.c_str() ENDFB(G);
+    }
+  } else {
+    return pymol::make_error("unknown action '", action.c_str(),
+        "', expected start, stop, clear, report or save");
+  }
+
+  return {};
+}
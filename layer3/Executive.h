@@ -222,6 +222,10 @@ pymol::Result<> ExecutiveLoad(PyMOLGlobals* G, const char* fname,
     const char* object_props = nullptr, const char* atom_props = nullptr,
     bool mimic = true);
 
+pymol::Result<> ExecutiveLoadMapRegion(PyMOLGlobals* G, const char* fname,
+    cLoadType_t content_format, const char* object_name, const char* sele,
+    float buffer, int state, int sele_state, int quiet);
+
 int ExecutiveDebug(PyMOLGlobals* G, const char* name);
 
 typedef struct {
@@ -653,6 +657,10 @@ pymol::Result<> ExecutiveMapNew(PyMOLGlobals* G, const char* name, int type,
     float grid_spacing, const char* sele, float buffer, const float* minCorner,
     const float* maxCorner, int state, int have_corners, int quiet, int zoom,
     int normalize, float clamp_floor, float clamp_ceiling, float resolution);
+pymol::Result<> ExecutiveMapFromReflections(PyMOLGlobals* G, const char* name,
+    const std::vector<int>& hkl, const std::vector<float>& amplitudes,
+    const std::vector<float>& phases, const std::vector<float>& weights,
+    const float* cell, const char* space_group, int zoom, int quiet);
 
 int*** ExecutiveGetBondPrint(
     PyMOLGlobals* G, const char* name, int max_bond, int max_type, int* dim);
@@ -677,6 +685,8 @@ pymol::Result<> ExecutiveUnsetSetting(PyMOLGlobals* G, int index,
 pymol::Result<> ExecutiveAssignSS(PyMOLGlobals* G, const char* target,
     int state, const char* context, int preserve, ObjectMolecule* single_object,
     int quiet);
+pymol::Result<std::vector<std::string>> ExecutiveGetSS(PyMOLGlobals* G,
+    const char* target, int state, const char* context, int quiet);
 
 pymol::Result<> ExecutiveRampNew(PyMOLGlobals* G, const char* name,
     const char* src_name, pymol::vla<float> range, pymol::vla<float> color,
@@ -711,8 +721,11 @@ pymol::Result<> ExecutiveReinitialize(
 const char* ExecutiveFindBestNameMatch(PyMOLGlobals* G, const char* name);
 int ExecutiveSetVisFromPyDict(PyMOLGlobals* G, PyObject* dict);
 PyObject* ExecutiveGetVisAsPyDict(PyMOLGlobals* G);
+pymol::Result<std::vector<float>> ExecutiveGetMapValues(PyMOLGlobals* G,
+    const char* name, int state, const float* points, size_t n,
+    float outside);
 CField* ExecutiveGetVolumeField(
-    PyMOLGlobals* G, const char* objName, int state);
+    PyMOLGlobals* G, const char* objName, int state, bool writable = false);
 pymol::Result<> ExecutiveSetVolumeRamp(PyMOLGlobals* G, const char* objName,
     std::vector<float> ramp_list, int state);
 PyObject* ExecutiveGetVolumeRamp(
@@ -987,4 +1000,13 @@ pymol::Result<> ExecutiveUpdateObjectDeps(
 pymol::Result<std::unordered_set<const pymol::CObject*>> ExecutiveGetObjectDeps(
     PyMOLGlobals* G, const pymol::CObject& obj, unsigned int depth = 0);
 
+/**
+ * Controls the built-in profiler (G->Profiler)
+ * @param action start, stop, clear, report (print a summary) or save (write
+ * a Chrome trace JSON file)
+ * @param filename output file for "save"
+ */
+pymol::Result<> ExecutiveProfile(PyMOLGlobals* G, pymol::zstring_view action,
+    const char* filename, int quiet);
+
 #endif
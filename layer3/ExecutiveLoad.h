@@ -19,6 +19,7 @@ struct ExecutiveLoadArgs {
   std::string atom_props;
   bool mimic;
   int plugin_mask = 0;
+  std::vector<float> map_region; //!< optional (min, max) box for map formats
 };
 
 /**
@@ -35,6 +35,12 @@
 #include "CifDataValueFormatter.h"
 #include "MaeExportHelpers.h"
 #include "Feedback.h"
+#include "File.h"
+#include "pymol/memory.h"
+
+#ifdef PYMOL_OPENMP
+#include <omp.h>
+#endif
 
 #ifdef _PYMOL_IP_PROPERTIES
 #include "Property.h"
@@ -127,15 +133,27 @@ struct AtomRef {
   int id;
 };
 
+// streaming export: write out the buffer when it exceeds this size
+const int cMolExportStreamChunkSize = 1 << 20;
+
 /**
  * Abstract base class for exporting molecular selections
  */
 struct MoleculeExporter {
   pymol::vla<char> m_buffer; //!< Out buffer and final result
 
+  /// Output file for streaming export. If set, the buffer is written out in
+  /// chunks and only holds the not yet written tail of the output.
+  FILE* m_stream = nullptr;
+  bool m_stream_error = false;
+
 protected:
   int m_offset = 0; //!< Offset into `m_buffer`
 
+  /// True while the buffer contains placeholders (e.g. atom counts) which
+  /// will be patched later. Prevents streaming until released.
+  bool m_hold_output = false;
+
   CoordSet* m_last_cs = nullptr;
   ObjectMolecule* m_last_obj = nullptr;
   int m_last_state = -1;
@@ -194,6 +212,21 @@ public:
       m_multi = multi;
   }
 
+  /**
+   * Write the buffer content to `m_stream` (if set) and reset the buffer.
+   * Does nothing while output is on hold.
+   */
+  void streamOut() {
+    if (!m_stream || m_hold_output || !m_offset)
+      return;
+
+    if (fwrite(m_buffer.data(), 1, m_offset, m_stream) != size_t(m_offset)) {
+      m_stream_error = true;
+    }
+
+    m_offset = 0;
+  }
+
 private:
   /**
    * Reset the "index" fields in the selector table
@@ -354,6 +387,10 @@ void MoleculeExporter::execute(int sele, int state) {
     }
 
     writeAtom();
+
+    if (m_offset > cMolExportStreamChunkSize) {
+      streamOut();
+    }
   }
 
   if (m_last_cs)
@@ -368,6 +405,9 @@ void MoleculeExporter::execute(int sele, int state) {
     writeBonds();
   }
 
+  m_hold_output = false;
+  streamOut();
+
   m_buffer.resize(m_offset);
 }
 
@@ -436,6 +476,11 @@ void MoleculeExporter::populateBondRefs() {
 
 // ---------------------------------------------------------------------------------- //
 
+// atom records which are collected before formatting them in parallel
+const int cPDBPendingAtomsMax = 1 << 16;
+// atom records per parallel formatting task
+const int cPDBAtomBlockSize = 1 << 10;
+
 struct MoleculeExporterPDB : public MoleculeExporter {
   bool m_conect_all = false;
   bool m_conect_nodup;
@@ -445,6 +490,16 @@ struct MoleculeExporterPDB : public MoleculeExporter {
   const AtomInfoType * m_pre_ter = nullptr;
   PDBInfoRec m_pdb_info;
 
+  // atom record which has not been formatted yet
+  struct PendingAtom {
+    const AtomInfoType* ai;
+    float coord[3];
+    int cnt;
+    bool ter; //!< write a TER record before this atom
+  };
+
+  std::vector<PendingAtom> m_pending;
+
   // quasi constructor
   void init(PyMOLGlobals * G_) override {
     MoleculeExporter::init(G_);
@@ -476,32 +531,88 @@ struct MoleculeExporterPDB : public MoleculeExporter {
   }
 
   /**
-   * Write a TER record if the previous atom was polymer and `ai`
-   * is nullptr, non-polymer, or has a different chain identifier.
+   * True if a TER record needs to be written because the previous atom was
+   * polymer and `ai` is nullptr, non-polymer, or has a different chain
+   * identifier.
    */
-  void writeTER(const AtomInfoType* ai) {
+  bool needTER(const AtomInfoType* ai) {
     if (!m_use_ter_records)
-      return;
+      return false;
 
     if (ai && !(ai->flags & cAtomFlag_polymer)) {
       ai = nullptr;
     }
 
-    if (m_pre_ter && !(ai && ai->chain == m_pre_ter->chain)) {
-      m_offset += VLAprintf(m_buffer, m_offset, "TER   \n");
-    }
+    bool const ter = m_pre_ter && !(ai && ai->chain == m_pre_ter->chain);
 
     m_pre_ter = ai;
+
+    return ter;
+  }
+
+  void writeTER(const AtomInfoType* ai) {
+    if (needTER(ai)) {
+      m_offset += VLAprintf(m_buffer, m_offset, "TER   \n");
+    }
   }
 
   void writeAtom() override {
-    writeTER(m_iter.getAtomInfo());
+    auto const ai = m_iter.getAtomInfo();
+
+    m_pending.push_back({ai, {m_coord[0], m_coord[1], m_coord[2]},
+        getTmpID() - 1, needTER(ai)});
+
+    if (m_pending.size() >= size_t(cPDBPendingAtomsMax)) {
+      flushPendingAtoms();
+    }
+  }
+
+  /**
+   * Format the pending atom records in parallel blocks and append them to
+   * the buffer in order. Must be called before writing any other records.
+   */
+  void flushPendingAtoms() {
+    int const n_atoms = m_pending.size();
+    if (!n_atoms)
+      return;
+
+    int const n_blocks = (n_atoms + cPDBAtomBlockSize - 1) / cPDBAtomBlockSize;
+    std::vector<pymol::vla<char>> blocks(n_blocks);
+    std::vector<int> sizes(n_blocks, 0);
+    auto const matrix = m_mat_full.ptr;
+
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int b = 0; b < n_blocks; ++b) {
+      auto& block = blocks[b];
+      auto& size = sizes[b];
+      int const i_begin = b * cPDBAtomBlockSize;
+      int const i_end = std::min(n_atoms, i_begin + cPDBAtomBlockSize);
+
+      block.resize(100 * (i_end - i_begin));
+
+      for (int i = i_begin; i != i_end; ++i) {
+        auto const& rec = m_pending[i];
+        if (rec.ter) {
+          size += VLAprintf(block, size, "TER   \n");
+        }
+        CoordSetAtomToPDBStrVLA(G, &block, &size, rec.ai, rec.coord, rec.cnt,
+            &m_pdb_info, matrix);
+      }
+    }
 
-    CoordSetAtomToPDBStrVLA(G, &m_buffer, &m_offset, m_iter.getAtomInfo(),
-        m_coord, getTmpID() - 1, &m_pdb_info, m_mat_full.ptr);
+    for (int b = 0; b < n_blocks; ++b) {
+      m_buffer.check(m_offset + sizes[b]);
+      memcpy(m_buffer + m_offset, blocks[b].data(), sizes[b]);
+      m_offset += sizes[b];
+    }
+
+    m_pending.clear();
   }
 
   void writeBonds() override {
+    flushPendingAtoms();
     writeENDMDL();
 
     std::map<int, std::vector<int>> conect;
@@ -551,6 +662,7 @@ struct MoleculeExporterPDB : public MoleculeExporter {
   }
 
   void beginObject() override {
+    flushPendingAtoms();
     MoleculeExporter::beginObject();
 
     m_conect_all = SettingGet_b(G, m_iter.obj->Setting.get(), nullptr, cSetting_pdb_conect_all);
@@ -580,6 +692,7 @@ struct MoleculeExporterPDB : public MoleculeExporter {
   }
 
   void endCoordSet() override {
+    flushPendingAtoms();
     writeTER(nullptr);
 
     MoleculeExporter::endCoordSet();
@@ -998,6 +1111,7 @@ struct MoleculeExporterMOL2 : public MoleculeExporter {
 
     // defer until number of substructures known
     m_counts_offset = m_offset;
+    m_hold_output = true;
     m_offset += VLAprintf(m_buffer, m_offset,
         "X X X                   \n" // deferred
         "SMALL\n"
@@ -1043,6 +1157,7 @@ struct MoleculeExporterMOL2 : public MoleculeExporter {
     m_counts_offset += sprintf(m_buffer + m_counts_offset, "%d %d %d",
         m_n_atoms, (int) m_bonds.size(), (int) m_substs.size());
     m_buffer[m_counts_offset] = ' '; // overwrite terminator
+    m_hold_output = false;
 
     // RTI BOND
     // bond_id origin_atom_id target_atom_id bond_type [status_bits]
@@ -1222,6 +1337,7 @@ struct MoleculeExporterMAE : public MoleculeExporter {
 
     // defer until number of atoms known
     m_n_atoms_offset = m_offset;
+    m_hold_output = true;
 
     keys = {
       "i_m_mmod_type",
@@ -1382,6 +1498,7 @@ struct MoleculeExporterMAE : public MoleculeExporter {
     // atom count
     m_n_atoms_offset += sprintf(m_buffer + m_n_atoms_offset, "m_atom[%d]", m_n_atoms);
     m_buffer[m_n_atoms_offset] = ' '; // overwrite terminator
+    m_hold_output = false;
 
     if (!m_bonds.empty()) {
       // table with zero rows not allowed
@@ -1450,6 +1567,7 @@ struct MoleculeExporterXYZ : public MoleculeExporter {
     // defer until number of atoms known
     m_n_atoms = 0;
     m_n_atoms_offset = m_offset;
+    m_hold_output = true;
 
     m_offset += VLAprintf(m_buffer, m_offset,
         "X         \n" // natoms (deferred)
@@ -1470,6 +1588,7 @@ struct MoleculeExporterXYZ : public MoleculeExporter {
     // atom count
     m_n_atoms_offset += sprintf(m_buffer + m_n_atoms_offset, "%d", m_n_atoms);
     m_buffer[m_n_atoms_offset] = ' '; // overwrite terminator
+    m_hold_output = false;
   }
 
   bool isExcludedBond(int atm1, int atm2) override {
@@ -1624,14 +1743,21 @@ public:
  *               1: molecules per objects
  *               2: molecules per states (default for sdf, mol2)
  */
-pymol::vla<char> MoleculeExporterGetStr(PyMOLGlobals * G,
+/**
+ * Create an exporter for the given format and run it.
+ *
+ * @param stream If not null, stream the output to this file
+ * @return Exporter with the result in `m_buffer`, or nullptr on error
+ */
+static std::unique_ptr<MoleculeExporter> MoleculeExporterExecute(
+    PyMOLGlobals * G,
     const char *format,
     const char *selection,
     int state,
     const char *ref_object,
     int ref_state,
     int multi,
-    bool quiet)
+    FILE* stream = nullptr)
 {
   SelectorTmp tmpsele1(G, selection);
   int sele = tmpsele1.getIndex();
@@ -1685,13 +1811,110 @@ pymol::vla<char> MoleculeExporterGetStr(PyMOLGlobals * G,
   std::setlocale(LC_NUMERIC, "C");
 
   exporter->init(G);
+  exporter->m_stream = stream;
   exporter->setMulti(multi);
   exporter->setRefObject(ref_object, ref_state);
   exporter->execute(sele, state);
 
+  return exporter;
+}
+
+pymol::vla<char> MoleculeExporterGetStr(PyMOLGlobals * G,
+    const char *format,
+    const char *selection,
+    int state,
+    const char *ref_object,
+    int ref_state,
+    int multi,
+    bool quiet)
+{
+  auto exporter = MoleculeExporterExecute(
+      G, format, selection, state, ref_object, ref_state, multi);
+
+  if (!exporter)
+    return {};
+
   return std::move(exporter->m_buffer);
 }
 
+/**
+ * Append the contents of file `src` to file `dst`.
+ */
+static bool MoleculeExporterAppendFile(const char* src, const char* dst)
+{
+  auto in = pymol::unique_ptr_take_ownership(pymol_fopen(src, "rb"), fclose);
+  auto out = pymol::unique_ptr_take_ownership(pymol_fopen(dst, "ab"), fclose);
+
+  if (!in || !out) {
+    return false;
+  }
+
+  std::vector<char> buffer(1 << 20);
+  size_t n;
+  while ((n = fread(buffer.data(), 1, buffer.size(), in.get())) > 0) {
+    if (fwrite(buffer.data(), 1, n, out.get()) != n) {
+      return false;
+    }
+  }
+
+  return !ferror(in.get()) && fclose(out.release()) == 0;
+}
+
+/**
+ * Like MoleculeExporterGetStr, but streams the output to a file. Memory use
+ * is bounded by the chunk size and does not grow with the output size
+ * (except for formats which need a complete molecule before writing it).
+ *
+ * @param append Append to an existing file
+ */
+pymol::Result<> MoleculeExporterSaveFile(PyMOLGlobals * G,
+    const char *filename,
+    const char *format,
+    const char *selection,
+    int state,
+    const char *ref_object,
+    int ref_state,
+    int multi,
+    bool append)
+{
+  // write to a temporary file first, so that a failed export doesn't
+  // truncate an existing file
+  const std::string tmpname = std::string(filename) + ".tmp";
+
+  auto handle = pymol::unique_ptr_take_ownership(
+      pymol_fopen(tmpname.c_str(), "wb"), fclose);
+
+  if (!handle) {
+    return pymol::make_error("Cannot open file for writing: ", filename);
+  }
+
+  auto exporter = MoleculeExporterExecute(G, format, selection, state,
+      ref_object, ref_state, multi, handle.get());
+
+  bool ok = exporter && !exporter->m_stream_error;
+
+  if (fclose(handle.release()) != 0) {
+    ok = false;
+  }
+
+  if (ok) {
+    ok = append ? MoleculeExporterAppendFile(tmpname.c_str(), filename)
+                : FileReplace(tmpname.c_str(), filename);
+  }
+
+  remove(tmpname.c_str());
+
+  if (!exporter) {
+    return pymol::make_error("Export failed");
+  }
+
+  if (!ok) {
+    return pymol::make_error("Writing to file failed: ", filename);
+  }
+
+  return {};
+}
+
 /*========================================================================*/
 
 #ifndef _PYMOL_NOPY
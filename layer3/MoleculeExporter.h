@@ -8,6 +8,7 @@
 #include "vla.h"
 
 #include "PyMOLGlobals.h"
+#include "Result.h"
 
 pymol::vla<char> MoleculeExporterGetStr(PyMOLGlobals * G,
     const char *format,
@@ -18,5 +19,15 @@ pymol::vla<char> MoleculeExporterGetStr(PyMOLGlobals * G,
     int multi=-1,
     bool quiet=true);
 
+pymol::Result<> MoleculeExporterSaveFile(PyMOLGlobals * G,
+    const char *filename,
+    const char *format,
+    const char *sele="all",
+    int state = cStateCurrent,
+    const char *ref_object="",
+    int ref_state = cStateAll,
+    int multi=-1,
+    bool append=false);
+
 PyObject *MoleculeExporterGetPyBonds(PyMOLGlobals * G,
     const char *selection, int state);
@@ -95,6 +95,12 @@ pymol::CObject * PlugIOManagerLoad(PyMOLGlobals * G, pymol::CObject ** obj_ptr,
   return 0;
 }
 
+pymol::Result<> PlugIOManagerSaveTraj(PyMOLGlobals* G, const char* fname,
+    const char* sele, int state, int quiet, const char* plugin_type)
+{
+  return pymol::make_error("VMD Molfile Plugins not compiled into this build");
+}
+
 #else
 
 #include "molfile_plugin.h"
@@ -150,6 +156,20 @@ static molfile_plugin_t* find_plugin(
 static CSymmetry* SymmetryNewFromTimestep(
     PyMOLGlobals* G, molfile_timestep_t* ts);
 
+/**
+ * True if the plugin's read_next_timestep accepts a null timestep (skip the
+ * frame). Not all plugins implement this part of the molfile API.
+ */
+static bool plugin_accepts_null_timestep(const molfile_plugin_t* plugin)
+{
+  for (const char* name : {"dcd", "dtr", "trj", "trr", "xtc"}) {
+    if (strcmp(plugin->name, name) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 int PlugIOManagerLoadTraj(PyMOLGlobals * G, ObjectMolecule * obj,
                           const char *fname, int frame,
                           int interval, int average, int start,
@@ -228,10 +248,22 @@ int PlugIOManagerLoadTraj(PyMOLGlobals * G, ObjectMolecule * obj,
       auto coordbuf = std::vector<float>(natoms * 3);
       timestep.coords = coordbuf.data();
 
+      bool const can_skip = plugin_accepts_null_timestep(plugin);
+
       {
 	  /* read_next_timestep fills in &timestep for each iteration; we need
 	   * to copy that out to a new CoordSet, each time. */
-          while(!plugin->read_next_timestep(file_handle, natoms, &timestep)) {
+          for (;;) {
+            /* frames before 'start' and between intervals are skipped by
+             * passing a null timestep, which lets the plugin seek past them
+             * without decoding (molfile API convention). Other plugins
+             * read into the regular timestep and the frame is discarded. */
+            bool const skip =
+                can_skip && ((cnt + 1 < start) || (icnt > 1));
+            if (plugin->read_next_timestep(
+                    file_handle, natoms, skip ? nullptr : &timestep)) {
+              break;
+            }
             cnt++;
 	    /* start at the 'start'-th frame; skip 'start' frames,
 	     * and skip every interval/icnt frames */
@@ -970,6 +1002,127 @@ ok_except1:
 }
 #endif
 
+/**
+ * Write the selected atoms as a binary trajectory with the molfile plugin
+ * `plugin_type` (e.g. dcd, xtc, trr, dtr), one frame per state. Frames are
+ * passed to the plugin as they are collected from the coordinate sets, no
+ * intermediate copy of the trajectory is made.
+ *
+ * @param sele Atom selection, must be within a single object
+ * @param state Object state (0-based), or cStateAll, or cStateCurrent
+ */
+pymol::Result<> PlugIOManagerSaveTraj(PyMOLGlobals* G, const char* fname,
+    const char* sele, int state, int quiet, const char* plugin_type)
+{
+  CPlugIOManager* I = G->PlugIOManager;
+  molfile_plugin_t* plugin = I ? find_plugin(I, plugin_type) : nullptr;
+
+  if (!plugin) {
+    return pymol::make_error("unable to locate plugin '", plugin_type, "'");
+  }
+
+  if (!plugin->open_file_write || !plugin->write_timestep ||
+      !plugin->close_file_write) {
+    return pymol::make_error(
+        "plugin '", plugin_type, "' cannot write trajectories");
+  }
+
+  auto tmpsele = SelectorTmp::make(G, sele);
+  p_return_if_error(tmpsele);
+  auto sele_id = tmpsele->getIndex();
+
+  auto obj = SelectorGetSingleObjectMolecule(G, sele_id);
+  if (!obj) {
+    return pymol::make_error("selection must be within a single object");
+  }
+
+  std::vector<int> atoms;
+  for (int atm = 0; atm < obj->NAtom; ++atm) {
+    if (SelectorIsMember(G, obj->AtomInfo[atm].selEntry, sele_id)) {
+      atoms.push_back(atm);
+    }
+  }
+
+  int start = 0, stop = obj->NCSet;
+  if (state == cStateCurrent) {
+    state = obj->getCurrentState();
+  }
+  if (state >= 0) {
+    start = state;
+    stop = std::min(state + 1, obj->NCSet);
+  }
+
+  int const natoms = atoms.size();
+  auto handle = plugin->open_file_write(fname, plugin_type, natoms);
+  if (!handle) {
+    return pymol::make_error(
+        "plugin '", plugin_type, "' cannot open '", fname, "'");
+  }
+
+  // atoms which are missing in a state keep their previous coordinates
+  auto coordbuf = std::vector<float>(natoms * 3);
+  int nframes = 0;
+  bool missing = false;
+
+  molfile_timestep_t timestep{};
+  timestep.coords = coordbuf.data();
+
+  for (int s = start; s < stop; ++s) {
+    auto cs = obj->CSet[s];
+    if (!cs) {
+      continue;
+    }
+
+    for (int i = 0; i < natoms; ++i) {
+      int idx = cs->atmToIdx(atoms[i]);
+      if (idx < 0) {
+        missing = true;
+        continue;
+      }
+      copy3(cs->coordPtr(idx), timestep.coords + 3 * i);
+    }
+
+    if (auto const* sym = cs->getSymmetry()) {
+      auto const* dims = sym->Crystal.dims();
+      auto const* angles = sym->Crystal.angles();
+      timestep.A = dims[0];
+      timestep.B = dims[1];
+      timestep.C = dims[2];
+      timestep.alpha = angles[0];
+      timestep.beta = angles[1];
+      timestep.gamma = angles[2];
+    } else {
+      timestep.A = timestep.B = timestep.C = 0.f;
+      timestep.alpha = timestep.beta = timestep.gamma = 90.f;
+    }
+
+    timestep.physical_time = nframes;
+
+    if (plugin->write_timestep(handle, &timestep) != MOLFILE_SUCCESS) {
+      plugin->close_file_write(handle);
+      return pymol::make_error("writing frame ", nframes + 1, " failed");
+    }
+
+    ++nframes;
+  }
+
+  plugin->close_file_write(handle);
+
+  if (missing) {
+    PRINTFB(G, FB_ObjectMolecule, FB_Warnings)
+      " %s-Warning: some atoms are missing in some states\n", __func__
+      ENDFB(G);
+  }
+
+  if (!quiet) {
+    PRINTFB(G, FB_ObjectMolecule, FB_Details)
+      " %s: wrote %d frames (%d atoms) to '%s'.\n", __func__, nframes,
+      natoms, fname ENDFB(G);
+  }
+
+  return {};
+}
+
 #endif
 
 /**
@@ -18,6 +18,8 @@ Z* -------------------------------------------------------------------
 #ifndef _H_IOManager
 #define _H_IOManager
 
+#include "Result.h"
+
 struct PyMOLGlobals;
 struct ObjectMolecule;
 struct ObjectMap;
@@ -36,6 +38,8 @@ enum {
 };
 
 const char * PlugIOManagerFindPluginByExt(PyMOLGlobals * G, const char * ext, int mask=0);
+pymol::Result<> PlugIOManagerSaveTraj(PyMOLGlobals* G, const char* fname,
+    const char* sele, int state, int quiet, const char* plugin_type);
 
 #ifdef __cplusplus
 extern "C" {
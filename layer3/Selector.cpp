@@ -57,6 +57,8 @@ Z* -------------------------------------------------------------------
 #include "P.h"
 #include"ListMacros.h"
 #include "Util2.h"
+#include "Profiler.h"
+#include "CoulombMesh.h"
 
 #ifdef _PYMOL_IP_PROPERTIES
 #endif
@@ -1278,6 +1280,8 @@ int SelectorClassifyAtoms(PyMOLGlobals * G, int sele, int preserve,
 
       /* mark which atoms we can write to */
 
+      obj->invalidateHotColumns();
+
       ai0 = obj->AtomInfo + I->Table[a0].atom;
       if(preserve) {
         printf("NOT IMPLEMENTED\n");
@@ -1571,728 +1575,683 @@ typedef struct {
   int present;
 } SSResi;
 
-int SelectorAssignSS(PyMOLGlobals * G, int target, int present,
-                     int state_value, int preserve, ObjectMolecule * single_object,
-                     int quiet)
-{
-
-  /* PyMOL's secondary structure assignment algorithm: 
-
-     General principal -- if it looks like a duck, then it's a duck:
+/**
+ * Coordinate independent inputs of the secondary structure assignment,
+ * set up once per call and shared (read-only) by all states.
+ */
+struct SSContext {
+  std::vector<SSResi> res; //!< residues with cSSBreakSize gaps between chains
+  //! per residue: indices of residues whose N is too close (through bonds)
+  //! to this residue's carbonyl O to count as a hydrogen bond partner
+  std::vector<std::vector<int>> excluded;
+  HBondCriteria hbc;
+  float cutoff;
+  float helix_psi_target, helix_psi_include, helix_psi_exclude;
+  float helix_phi_target, helix_phi_include, helix_phi_exclude;
+  float strand_psi_target, strand_psi_include, strand_psi_exclude;
+  float strand_phi_target, strand_phi_include, strand_phi_exclude;
+};
 
-     I. Helices
-     - must have reasonably helical geometry within the helical span
-     - near-ideal geometry guarantees helix assignment
-     - a continuous ladder stre i+3, i+4, or i+5 hydrogen bonding
-     with permissible geometry can reinforce marginal cases
-     - a minimum helix is three residues with i+3 H-bond
+/**
+ * Collect the complete (N, CA, C, O) residues of the `present` selection
+ * and pack them into discrete chunks so that we can do easy gap & ladder
+ * analysis.
+ */
+static std::vector<SSResi> SelectorSSCollectResidues(PyMOLGlobals* G,
+    int present, int state_value, int preserve, int quiet)
+{
+  CSelector *I = G->Selector;
+  std::vector<SSResi> res;
+  int a;
+  ObjectMolecule *obj;
+  int aa, a0, a1, at;
+  AtomInfoType *ai, *ai0, *ai1;
+  ObjectMolecule *last_obj = nullptr;
 
-     II. Sheets
-     - Hydrogen bonding ladders are the primary guide
-     - Out-of-the envelope 
-     - 1-residue gaps in sheets are filled unless there
-     is a turn.
-   */
+  /* first, we need to count the number of residues under consideration */
 
-  CSelector *I = G->Selector;
-  SSResi *res;
-  int n_res = 0;
-  int state_start, state_stop, state;
-  int consensus = true;
-  int first_last_only = false;
-  int first_pass = true;
+  for(a = cNDummyAtoms; a < I->Table.size(); a++) {
 
-  if(!single_object) {
-    if(state_value < 0) {
-      switch (state_value) {
-      case cSelectorUpdateTableCurrentState:
-      case cSelectorUpdateTableEffectiveStates:
-        SelectorUpdateTable(G, state_value, -1);
-        break;
-      default:
-        SelectorUpdateTable(G, cSelectorUpdateTableAllStates, -1);
-        break;
-      }
-    } else {
-      SelectorUpdateTable(G, state_value, -1);
-    }
-  } else {
-    SelectorUpdateTableSingleObject(G, single_object, state_value);
-  }
+    obj = I->Obj[I->Table[a].model];
+    at = +I->Table[a].atom;
+    ai = obj->AtomInfo + at;
 
-  res = VLACalloc(SSResi, 1000);
+    /* see if CA coordinates exist... */
 
-  if(state_value < 0) {
-    if(state_value == -4)
-      consensus = false;
-    if(state_value == -5)
-      first_last_only = true;
-    state_start = 0;
-    state_stop = SelectorGetSeleNCSet(G, target);
+    if(SelectorIsMember(G, ai->selEntry, present)) {
 
-    if (state_value == cStateCurrent) {
-      StateIterator iter(G, nullptr, state_value, state_stop);
-      if (iter.next()) {
-        state_start = iter.state;
-        state_stop = iter.state + 1;
-      }
-    }
-  } else {
-    state_start = state_value;
-    state_stop = state_value + 1;
-  }
-  for(state = state_start; state < state_stop; state++) {
-    int a;
-    ObjectMolecule *obj;
-    int aa, a0, a1, at, idx;
-    AtomInfoType *ai, *ai0, *ai1;
-    CoordSet *cs;
-    ObjectMolecule *last_obj = nullptr;
-    /* first, we need to count the number of residues under consideration */
+      if((ai->protons == cAN_C) && (WordMatchExact(G, G->lex_const.CA, ai->name, true))) {
 
-    if(first_pass) {
-      for(a = cNDummyAtoms; a < I->Table.size(); a++) {
+        if(last_obj != obj) {
+          ObjectMoleculeVerifyChemistry(obj, state_value);
+          last_obj = obj;
+        }
+        /* delimit residue */
 
-        obj = I->Obj[I->Table[a].model];
-        at = +I->Table[a].atom;
-        ai = obj->AtomInfo + at;
+        a0 = a - 1;
+        while(a0 >= cNDummyAtoms) {
+          ai0 = I->Obj[I->Table[a0].model]->AtomInfo + I->Table[a0].atom;
+          if(!AtomInfoSameResidue(G, ai0, ai))
+            break;
+          a0--;
+        }
 
-        /* see if CA coordinates exist... */
+        a1 = a + 1;
+        while(a1 < I->Table.size()) {
+          ai1 = I->Obj[I->Table[a1].model]->AtomInfo + I->Table[a1].atom;
+          if(!AtomInfoSameResidue(G, ai1, ai))
+            break;
+          a1++;
+        }
 
-        if(SelectorIsMember(G, ai->selEntry, present)) {
+        {
+          int found_N = 0;
+          int found_O = 0;
+          int found_C = 0;
 
-          if((ai->protons == cAN_C) && (WordMatchExact(G, G->lex_const.CA, ai->name, true))) {
+          /* locate key atoms */
 
-            if(last_obj != obj) {
-              ObjectMoleculeVerifyChemistry(obj, state_value);
-              last_obj = obj;
+          for(aa = a0 + 1; aa < a1; aa++) {
+            ai = I->Obj[I->Table[aa].model]->AtomInfo + I->Table[aa].atom;
+            if((ai->protons == cAN_C) && (WordMatchExact(G, G->lex_const.C, ai->name, true))) {
+              found_C = aa;
             }
-            /* delimit residue */
-
-            a0 = a - 1;
-            while(a0 >= cNDummyAtoms) {
-              ai0 = I->Obj[I->Table[a0].model]->AtomInfo + I->Table[a0].atom;
-              if(!AtomInfoSameResidue(G, ai0, ai))
-                break;
-              a0--;
+            if((ai->protons == cAN_N) && (WordMatchExact(G, G->lex_const.N, ai->name, true))) {
+              found_N = aa;
             }
-
-            a1 = a + 1;
-            while(a1 < I->Table.size()) {
-              ai1 = I->Obj[I->Table[a1].model]->AtomInfo + I->Table[a1].atom;
-              if(!AtomInfoSameResidue(G, ai1, ai))
-                break;
-              a1++;
+            if((ai->protons == cAN_O) && (WordMatchExact(G, G->lex_const.O, ai->name, true))) {
+              found_O = aa;
             }
+          }
 
-            {
-              int found_N = 0;
-              int found_O = 0;
-              int found_C = 0;
-
-              /* locate key atoms */
-
-              for(aa = a0 + 1; aa < a1; aa++) {
-                ai = I->Obj[I->Table[aa].model]->AtomInfo + I->Table[aa].atom;
-                if((ai->protons == cAN_C) && (WordMatchExact(G, G->lex_const.C, ai->name, true))) {
-                  found_C = aa;
-                }
-                if((ai->protons == cAN_N) && (WordMatchExact(G, G->lex_const.N, ai->name, true))) {
-                  found_N = aa;
-                }
-                if((ai->protons == cAN_O) && (WordMatchExact(G, G->lex_const.O, ai->name, true))) {
-                  found_O = aa;
-                }
-              }
-
-              if((found_C) && (found_N) && (found_O)) {
-
-                VLACheck(res, SSResi, n_res);
-                res[n_res].n = found_N;
-                res[n_res].o = found_O;
-                res[n_res].c = found_C;
-                res[n_res].ca = a;
-                res[n_res].obj = I->Obj[I->Table[a].model];
-                res[n_res].real = true;
+          if((found_C) && (found_N) && (found_O)) {
 
-                n_res++;
+            SSResi r{};
+            r.n = found_N;
+            r.o = found_O;
+            r.c = found_C;
+            r.ca = a;
+            r.obj = I->Obj[I->Table[a].model];
+            r.real = true;
+            res.push_back(r);
 
-              } else {
-                if(!quiet) {
-                  PRINTFB(G, FB_Selector, FB_Warnings)
-                    " AssignSS-Warning: Ignoring incomplete residue /%s/%s/%s/%d%c ...\n",
-                    obj->Name, LexStr(G, ai->segi), LexStr(G, ai->chain), ai->resv, ai->getInscode(true) ENDFB(G);
-                }
-              }
-            }
-          }
-        }
-      }                         /* count pass */
-
-      if(preserve) {            /* if we're in preserve mode, then mark which objects don't get changed */
-        int a, b;
-        char ss;
-        ObjectMolecule *p_obj = nullptr;
-        SSResi *r, *r2;
-        for(a = 0; a < n_res; a++) {
-          r = res + a;
-          if(r->real) {
-            if(p_obj != r->obj) {
-              ss = r->obj->AtomInfo[I->Table[r->ca].atom].ssType[0];
-              if((ss == 'S') || (ss == 'H') || (ss == 's') || (ss == 'h')) {
-                p_obj = r->obj;
-
-                b = a;
-                while(b >= 0) {
-                  r2 = res + b;
-                  if(p_obj == r2->obj)
-                    r2->preserve = true;
-                  b--;
-                }
-                b = a + 1;
-                while(b < n_res) {
-                  r2 = res + b;
-                  if(p_obj == r2->obj)
-                    r2->preserve = true;
-                  b++;
-                }
-              }
+          } else {
+            if(!quiet) {
+              PRINTFB(G, FB_Selector, FB_Warnings)
+                " AssignSS-Warning: Ignoring incomplete residue /%s/%s/%s/%d%c ...\n",
+                obj->Name, LexStr(G, ai->segi), LexStr(G, ai->chain), ai->resv, ai->getInscode(true) ENDFB(G);
             }
           }
         }
       }
-      /*  printf("n_res %d\n",n_res); */
+    }
+  }                             /* count pass */
 
-      /* now, let's repack res. into discrete chunks so that we can do easy gap & ladder analysis */
+  int n_res = res.size();
 
-      {
-        SSResi *res2;
-        int a;
-        int n_res2 = 0;
-        int add_break;
-        int at_ca0, at_ca1;
-
-        res2 = VLACalloc(SSResi, n_res * 2);
-
-        for(a = 0; a < n_res; a++) {
-          add_break = false;
-
-          if(!a) {
-            add_break = true;
-          } else if(res[a].obj != res[a - 1].obj) {
-            add_break = true;
-          } else if(res[a].obj) {
-            at_ca0 = I->Table[res[a].ca].atom;
-            at_ca1 = I->Table[res[a - 1].ca].atom;
-            if(!ObjectMoleculeCheckBondSep(res[a].obj, at_ca0, at_ca1, 3)) {    /* CA->N->C->CA = 3 bonds */
-              add_break = true;
+  if(preserve) {                /* if we're in preserve mode, then mark which objects don't get changed */
+    int b;
+    char ss;
+    ObjectMolecule *p_obj = nullptr;
+    SSResi *r, *r2;
+    for(a = 0; a < n_res; a++) {
+      r = res.data() + a;
+      if(r->real) {
+        if(p_obj != r->obj) {
+          ss = r->obj->AtomInfo[I->Table[r->ca].atom].ssType[0];
+          if((ss == 'S') || (ss == 'H') || (ss == 's') || (ss == 'h')) {
+            p_obj = r->obj;
+
+            b = a;
+            while(b >= 0) {
+              r2 = res.data() + b;
+              if(p_obj == r2->obj)
+                r2->preserve = true;
+              b--;
+            }
+            b = a + 1;
+            while(b < n_res) {
+              r2 = res.data() + b;
+              if(p_obj == r2->obj)
+                r2->preserve = true;
+              b++;
             }
           }
+        }
+      }
+    }
+  }
 
-          if(add_break) {
-            n_res2 += cSSBreakSize;
-          }
+  /* now, let's repack res. into discrete chunks so that we can do easy gap & ladder analysis */
 
-          VLACheck(res2, SSResi, n_res2);
-          res2[n_res2] = res[a];
-          n_res2++;
-        }
+  std::vector<SSResi> res2;
+  res2.reserve(n_res * 2 + cSSBreakSize);
 
-        n_res2 += cSSBreakSize;
-        VLACheck(res2, SSResi, n_res2);
+  for(a = 0; a < n_res; a++) {
+    int add_break = false;
 
-        VLAFreeP(res);
-        res = res2;
-        n_res = n_res2;
+    if(!a) {
+      add_break = true;
+    } else if(res[a].obj != res[a - 1].obj) {
+      add_break = true;
+    } else if(res[a].obj) {
+      int at_ca0 = I->Table[res[a].ca].atom;
+      int at_ca1 = I->Table[res[a - 1].ca].atom;
+      if(!ObjectMoleculeCheckBondSep(res[a].obj, at_ca0, at_ca1, 3)) {  /* CA->N->C->CA = 3 bonds */
+        add_break = true;
       }
-      first_pass = false;
     }
 
-    /* okay, the rest of this loop runs for each coordinate set */
-
-    {
-      int b;
-      for(a = 0; a < n_res; a++) {
-        res[a].present = res[a].real;
-
-        if(res[a].present) {
-          obj = res[a].obj;
-          if(state < obj->NCSet)
-            cs = obj->CSet[state];
-          else
-            cs = nullptr;
-          for(b = 0; b < 4; b++) {
-            if(cs) {
-              switch (b) {
-              case 0:
-                at = I->Table[res[a].n].atom;
-                break;
-              case 1:
-                at = I->Table[res[a].o].atom;
-                break;
-              case 2:
-                at = I->Table[res[a].c].atom;
-                break;
-              default:
-              case 3:
-                at = I->Table[res[a].ca].atom;
-                break;
-              }
-              idx = cs->atmToIdx(at);
-            } else
-              idx = -1;
-            if(idx < 0) {
-              res[a].present = false;
-            }
-          }
-        }
-      }
+    if(add_break) {
+      res2.resize(res2.size() + cSSBreakSize, SSResi{});
     }
 
-    /* next, we need to record hydrogen bonding relationships */
+    res2.push_back(res[a]);
+  }
 
-    {
+  res2.resize(res2.size() + cSSBreakSize, SSResi{});
 
-      float *v0, *v1;
-      int n1;
-      int at;
+  return res2;
+}
 
-      int a, aa;
-      int a0, a1;               /* SS res space */
-      int at0, at1;             /* object-atom space */
-      int exclude;
+/**
+ * Set up the hydrogen bonding criteria, the phi/psi windows and the
+ * through-bond exclusions of backbone hydrogen bond candidates. Only
+ * depends on topology and settings, so it's done once for all states.
+ */
+static void SelectorSSInitContext(PyMOLGlobals* G, SSContext& ctx)
+{
+  CSelector *I = G->Selector;
+  auto& res = ctx.res;
+  const int n_res = res.size();
+  auto hbc = &ctx.hbc;
+
+  ObjectMoleculeInitHBondCriteria(G, hbc);
+
+  /* use parameters which reflect the spirit of Kabsch and Sander
+     ( i.e. long hydrogen-bonds/polar electrostatic interactions ) */
+
+  hbc->maxAngle = 63.0F;
+  hbc->maxDistAtMaxAngle = 3.2F;
+  hbc->maxDistAtZero = 4.0F;
+  hbc->power_a = 1.6F;
+  hbc->power_b = 5.0F;
+  hbc->cone_dangle = 0.0F;      /* 180 deg. */
+  if(hbc->maxDistAtMaxAngle != 0.0F) {
+    hbc->factor_a = 0.5F / (float) pow(hbc->maxAngle, hbc->power_a);
+    hbc->factor_b = 0.5F / (float) pow(hbc->maxAngle, hbc->power_b);
+  }
+
+  ctx.cutoff = hbc->maxDistAtMaxAngle;
+  if(ctx.cutoff < hbc->maxDistAtZero) {
+    ctx.cutoff = hbc->maxDistAtZero;
+  }
+
+  ctx.helix_psi_target = SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_psi_target);
+  ctx.helix_psi_include = SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_psi_include);
+  ctx.helix_psi_exclude = SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_psi_exclude);
+  ctx.helix_phi_target = SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_phi_target);
+  ctx.helix_phi_include = SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_phi_include);
+  ctx.helix_phi_exclude = SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_phi_exclude);
+  ctx.strand_psi_target = SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_psi_target);
+  ctx.strand_psi_include = SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_psi_include);
+  ctx.strand_psi_exclude = SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_psi_exclude);
+  ctx.strand_phi_target = SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_phi_target);
+  ctx.strand_phi_include = SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_phi_include);
+  ctx.strand_phi_exclude = SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_phi_exclude);
+
+  /* don't count hbonds between adjacent residues: find all backbone
+     nitrogens within 5 bonds of each carbonyl oxygen */
+
+  ctx.excluded.assign(n_res, {});
+
+  int max_n_atom = 0;
+  for(int a = 0; a < n_res; a++) {
+    if(res[a].obj && max_n_atom < res[a].obj->NAtom)
+      max_n_atom = res[a].obj->NAtom;
+  }
+
+  std::vector<int> zero(max_n_atom), scratch(max_n_atom);
+  std::vector<int> depth(max_n_atom, -1);
+  std::vector<int> res_of_atom(max_n_atom, -1);
+  std::vector<int> visited;
+
+  for(int a_begin = 0; a_begin < n_res;) {
+    ObjectMolecule* obj = res[a_begin].obj;
+    int a_end = a_begin + 1;
+    if(!obj) {
+      a_begin = a_end;
+      continue;
+    }
 
-      ObjectMolecule *obj0, *obj1;
+    /* residues are grouped by object */
+    while(a_end < n_res && (!res[a_end].obj || res[a_end].obj == obj))
+      a_end++;
 
-      CoordSet *cs;
-      float cutoff;
-      HBondCriteria hbcRec, *hbc;
-      int *zero = nullptr, *scratch = nullptr;
+    /* neighbor array is built lazily, do it before going parallel */
+    obj->getNeighborArray();
 
-      {
-        int max_n_atom = I->Table.size();
-        ObjectMolecule *lastObj = nullptr;
-        for(a = cNDummyAtoms; a < I->Table.size(); a++) {
-          ObjectMolecule *obj = I->Obj[I->Table[a].model];
-          if(obj != lastObj) {
-            if(max_n_atom < obj->NAtom)
-              max_n_atom = obj->NAtom;
-            lastObj = obj;
-          }
-        }
-        zero = pymol::calloc<int>(max_n_atom);
-        scratch = pymol::malloc<int>(max_n_atom);
-      }
+    for(int a = a_begin; a < a_end; a++) {
+      if(res[a].obj)
+        res_of_atom[I->Table[res[a].n].atom] = a;
+    }
 
-      for(a = 0; a < n_res; a++) {
-        res[a].n_acc = 0;
-        res[a].n_don = 0;
-      }
-      hbc = &hbcRec;
-      ObjectMoleculeInitHBondCriteria(G, hbc);
+    for(int a0 = a_begin; a0 < a_end; a0++) {
+      if(!res[a0].obj)
+        continue;
 
-      /* use parameters which reflect the spirit of Kabsch and Sander
-         ( i.e. long hydrogen-bonds/polar electrostatic interactions ) */
+      const int at0 = I->Table[res[a0].o].atom;
 
-      hbc->maxAngle = 63.0F;
-      hbc->maxDistAtMaxAngle = 3.2F;
-      hbc->maxDistAtZero = 4.0F;
-      hbc->power_a = 1.6F;
-      hbc->power_b = 5.0F;
-      hbc->cone_dangle = 0.0F;  /* 180 deg. */
-      if(hbc->maxDistAtMaxAngle != 0.0F) {
-        hbc->factor_a = 0.5F / (float) pow(hbc->maxAngle, hbc->power_a);
-        hbc->factor_b = 0.5F / (float) pow(hbc->maxAngle, hbc->power_b);
+      /* breadth-first search for candidates within 5 bonds, then confirm
+         with the same test as the pairwise check */
+      visited.assign(1, at0);
+      depth[at0] = 0;
+      for(size_t i = 0; i < visited.size(); i++) {
+        const int at = visited[i];
+        if(depth[at] == 5)
+          continue;
+        for (auto const& neighbor : AtomNeighbors(obj, at)) {
+          if(depth[neighbor.atm] < 0) {
+            depth[neighbor.atm] = depth[at] + 1;
+            visited.push_back(neighbor.atm);
+          }
+        }
       }
 
-      cutoff = hbc->maxDistAtMaxAngle;
-      if(cutoff < hbc->maxDistAtZero) {
-        cutoff = hbc->maxDistAtZero;
+      for(const int at1 : visited) {
+        const int a1 = res_of_atom[at1];
+        if(a1 >= 0 && SelectorCheckNeighbors(G, 5, obj, at0, at1,
+                                             zero.data(), scratch.data())) {
+          ctx.excluded[a0].push_back(a1);
+        }
+        depth[at1] = -1;
       }
+    }
 
-      n1 = 0;
-
-      const size_t table_size = I->Table.size();
-      auto coords_flat = std::vector<float>(3 * table_size);
-      auto* coords = pymol::reshape<3>(coords_flat.data());
-      auto Flag1 = std::vector<MapFlag_t>(table_size, 0);
-      auto Flag2 = std::vector<int>(table_size, 0);
+    for(int a = a_begin; a < a_end; a++) {
+      if(res[a].obj)
+        res_of_atom[I->Table[res[a].n].atom] = -1;
+    }
 
-      for(a = 0; a < n_res; a++) {
-        if(res[a].present) {
-          obj0 = res[a].obj;
+    a_begin = a_end;
+  }
+}
 
-          if(obj0) {
-            /* map will contain the h-bond backbone nitrogens */
+/**
+ * Assign secondary structure for one state.
+ *
+ * @param ctx shared residue table and parameters
+ * @param state object state
+ * @param res scratch residue table, gets overwritten with a copy of ctx.res
+ * @param[out] ss secondary structure per residue, 0 for residues without
+ * coordinates in this state
+ * @return false if the neighbor search gave up (unreasonable number of
+ * neighbors)
+ */
+static bool SelectorSSAssignState(PyMOLGlobals* G, const SSContext& ctx,
+    int state, std::vector<SSResi>& res_vec, std::string& ss)
+{
+  CSelector *I = G->Selector;
+  bool too_many_atoms = false;
 
-            aa = res[a].n;
-            at = I->Table[aa].atom;
-            Flag2[aa] = a;   /* so we can find the atom again... */
+  res_vec = ctx.res;
+  SSResi* const res = res_vec.data();
+  const int n_res = res_vec.size();
 
-            cs = obj0->getCoordSet(state);
-            if (!cs)
-              continue;
+  {
+    int a, b, at, idx;
+    ObjectMolecule *obj;
+    CoordSet *cs;
+    for(a = 0; a < n_res; a++) {
+      res[a].present = res[a].real;
 
-            if (CoordSetGetAtomVertex(cs, at, coords[aa])) {
-              Flag1[aa] = true;
-              n1++;
+      if(res[a].present) {
+        obj = res[a].obj;
+        if(state < obj->NCSet)
+          cs = obj->CSet[state];
+        else
+          cs = nullptr;
+        for(b = 0; b < 4; b++) {
+          if(cs) {
+            switch (b) {
+            case 0:
+              at = I->Table[res[a].n].atom;
+              break;
+            case 1:
+              at = I->Table[res[a].o].atom;
+              break;
+            case 2:
+              at = I->Table[res[a].c].atom;
+              break;
+            default:
+            case 3:
+              at = I->Table[res[a].ca].atom;
+              break;
             }
-
-            /* also copy O coordinates for usage below */
-
-            aa = res[a].o;
-            at = I->Table[aa].atom;
-            CoordSetGetAtomVertex(cs, at, coords[aa]);
+            idx = cs->atmToIdx(at);
+          } else
+            idx = -1;
+          if(idx < 0) {
+            res[a].present = false;
           }
         }
       }
+    }
+  }
 
-      if(n1) {
-        short too_many_atoms = false;
-        std::unique_ptr<MapType> map(new MapType(G, -cutoff,
-            pymol::flatten(coords), table_size, nullptr, Flag1.data()));
-        if(map) {
+  /* next, we need to record hydrogen bonding relationships */
 
-          for(a0 = 0; a0 < n_res; a0++) {
+  {
+    const float cutoff = ctx.cutoff;
+    HBondCriteria hbc = ctx.hbc;
+    int n1 = 0;
 
-            if(res[a0].obj) {
+    /* map will contain the h-bond backbone nitrogens, indexed in SS res space */
+    auto coords_n = std::vector<float>(3 * n_res);
+    auto coords_o = std::vector<float>(3 * n_res);
+    auto Flag1 = std::vector<MapFlag_t>(n_res, 0);
 
-              /* now iterate through carbonyls */
-              obj0 = res[a0].obj;
-              const auto as0 = res[a0].o;
-              at0 = I->Table[as0].atom;
+    for(int a = 0; a < n_res; a++) {
+      if(res[a].present) {
+        auto cs = res[a].obj->getCoordSet(state);
+        if (!cs)
+          continue;
 
-              v0 = coords[as0];
+        if (CoordSetGetAtomVertex(cs, I->Table[res[a].n].atom, &coords_n[3 * a])) {
+          Flag1[a] = true;
+          n1++;
+        }
 
-              int nat = 0;
-              for (const auto as1 : MapEIter(*map, v0)) {
-                    v1 = coords[as1];
+        /* also copy O coordinates for usage below */
+        CoordSetGetAtomVertex(cs, I->Table[res[a].o].atom, &coords_o[3 * a]);
+      }
+    }
 
-                    if(within3f(v0, v1, cutoff)) {
+    if(n1) {
+      MapType map(G, -cutoff, coords_n.data(), n_res, nullptr, Flag1.data());
 
-                      obj1 = I->Obj[I->Table[as1].model];
-                      at1 = I->Table[as1].atom;
+      for(int a0 = 0; a0 < n_res; a0++) {
+        if(!res[a0].present)
+          continue;
 
-                      if(obj0 == obj1) {        /* don't count hbonds between adjacent residues */
-                        exclude = SelectorCheckNeighbors(G, 5, obj0, at0, at1,
-                                                         zero, scratch);
-                      } else {
-                        exclude = false;
-                      }
+        /* now iterate through carbonyls */
+        ObjectMolecule* obj0 = res[a0].obj;
+        const int at0 = I->Table[res[a0].o].atom;
+        const float* v0 = &coords_o[3 * a0];
+        const auto& excluded = ctx.excluded[a0];
 
-                      /*                      if(!exclude) {
-                         printf("at1 %s %s vs at0 %s %s\n",
-                         obj1->AtomInfo[at1].resi,
-                         obj1->AtomInfo[at1].name,
-                         obj0->AtomInfo[at0].resi,
-                         obj0->AtomInfo[at0].name
-                         );
-                         }
-                       */
-                      if((!exclude) && ObjectMoleculeGetCheckHBond(NULL, nullptr, obj1,    /* donor first */
-                                                                   at1, state, obj0,    /* then acceptor */
-                                                                   at0, state, hbc)) {
-
-                        /*                        printf(" found hbond between acceptor resi %s and donor resi %s\n",
-                           res[a0].obj->AtomInfo[at0].resi,
-                           res[I->Flag2[as1]].obj->AtomInfo[I->Table[as1].atom].resi); */
-
-                        a1 = Flag2[as1];     /* index in SS n_res space */
-
-                        /* store acceptor link */
-
-                        n1 = res[a0].n_acc;
-                        if(n1 < (cSSMaxHBond - 1)) {
-                          res[a0].acc[n1] = a1;
-                          res[a0].n_acc = n1 + 1;
-                        }
+        int nat = 0;
+        for (const int a1 : MapEIter(map, v0)) {
+          const float* v1 = &coords_n[3 * a1];
 
-                        /* store donor link */
+          if(within3f(v0, v1, cutoff)) {
+            ObjectMolecule* obj1 = res[a1].obj;
+            const int at1 = I->Table[res[a1].n].atom;
 
-                        n1 = res[a1].n_don;
-                        if(n1 < (cSSMaxHBond - 1)) {
-                          res[a1].don[n1] = a0;
-                          res[a1].n_don = n1 + 1;
-                        }
-                      }
-                    }
-		    nat++;
-                  }
-                  if (nat > 1000){ // if map returns more than 1000 atoms within 4, should be a dss error
-                    too_many_atoms = true;
-                    break;
-                  }
-            }
-          }
-        }
-	if (too_many_atoms){
-	  PRINTFB(G, FB_Selector, FB_Errors)
-	    " %s: ERROR: Unreasonable number of neighbors for dss, cannot assign secondary structure.\n", __func__ ENDFB(G);
-	}
-      }
-      FreeP(zero);
-      FreeP(scratch);
-    }
+            /* don't count hbonds between adjacent residues */
+            bool exclude = (obj0 == obj1) &&
+              std::find(excluded.begin(), excluded.end(), a1) != excluded.end();
 
-    {                           /* compute phi, psi's */
+            if((!exclude) && ObjectMoleculeGetCheckHBond(nullptr, nullptr, obj1,   /* donor first */
+                                                         at1, state, obj0,  /* then acceptor */
+                                                         at0, state, &hbc)) {
 
-      SSResi *r;
-      int a;
+              /* store acceptor link */
 
-      float helix_psi_delta, helix_phi_delta;
-      float strand_psi_delta, strand_phi_delta;
-
-      float helix_psi_target = SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_psi_target);
-      float helix_psi_include =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_psi_include);
-      float helix_psi_exclude =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_psi_exclude);
-
-      float helix_phi_target = SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_phi_target);
-      float helix_phi_include =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_phi_include);
-      float helix_phi_exclude =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_helix_phi_exclude);
-
-      float strand_psi_target =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_psi_target);
-      float strand_psi_include =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_psi_include);
-      float strand_psi_exclude =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_psi_exclude);
-
-      float strand_phi_target =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_phi_target);
-      float strand_phi_include =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_phi_include);
-      float strand_phi_exclude =
-        SettingGet_f(G, nullptr, nullptr, cSetting_ss_strand_phi_exclude);
-
-      for(a = 0; a < n_res; a++) {
-        r = res + a;
-        if(r->real && ((r - 1)->real)) {
-          r->flags = 0;
-
-          if(ObjectMoleculeGetPhiPsi
-             (r->obj, I->Table[r->ca].atom, &r->phi, &r->psi, state)) {
-            r->flags |= cSSGotPhiPsi;
-
-            helix_psi_delta = (float) fabs(r->psi - helix_psi_target);
-            strand_psi_delta = (float) fabs(r->psi - strand_psi_target);
-            helix_phi_delta = (float) fabs(r->phi - helix_phi_target);
-            strand_phi_delta = (float) fabs(r->phi - strand_phi_target);
-
-            if(helix_psi_delta > 180.0F)
-              helix_psi_delta = 360.0F - helix_psi_delta;
-            if(strand_psi_delta > 180.0F)
-              strand_psi_delta = 360.0F - strand_psi_delta;
-            if(helix_phi_delta > 180.0F)
-              helix_phi_delta = 360.0F - helix_phi_delta;
-            if(strand_phi_delta > 180.0F)
-              strand_phi_delta = 360.0F - strand_phi_delta;
-
-            /* printf("helix %d strand %d\n",helix_delta,strand_delta); */
-
-            if((helix_psi_delta > helix_psi_exclude) ||
-               (helix_phi_delta > helix_phi_exclude)) {
-              r->flags |= cSSPhiPsiNotHelix;
-            } else if((helix_psi_delta < helix_psi_include) &&
-                      (helix_phi_delta < helix_phi_include)) {
-              r->flags |= cSSPhiPsiHelix;
-            }
+              n1 = res[a0].n_acc;
+              if(n1 < (cSSMaxHBond - 1)) {
+                res[a0].acc[n1] = a1;
+                res[a0].n_acc = n1 + 1;
+              }
+
+              /* store donor link */
 
-            if((strand_psi_delta > strand_psi_exclude) ||
-               (strand_phi_delta > strand_phi_exclude)) {
-              r->flags |= cSSPhiPsiNotStrand;
-            } else if((strand_psi_delta < strand_psi_include) &&
-                      (strand_phi_delta < strand_phi_include)) {
-              r->flags |= cSSPhiPsiStrand;
+              n1 = res[a1].n_don;
+              if(n1 < (cSSMaxHBond - 1)) {
+                res[a1].don[n1] = a0;
+                res[a1].n_don = n1 + 1;
+              }
             }
           }
+          nat++;
+        }
+        if (nat > 1000){ // if map returns more than 1000 atoms within 4, should be a dss error
+          too_many_atoms = true;
+          break;
         }
       }
     }
+  }
 
-    /* by default, tentatively assign everything as loop */
+  {                             /* compute phi, psi's */
 
-    {
-      int a;
-      for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
-        if(res[a].present)
-          res[a].ss = 'L';
-      }
-    }
-
-    {
-      SSResi *r, *r2;
-      int a, b, c;
+    SSResi *r;
+    int a;
 
-      for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
-        r = res + a;
-        if(r->real) {
+    float helix_psi_delta, helix_phi_delta;
+    float strand_psi_delta, strand_phi_delta;
 
-          /* look for tell-tale i+3,4,5 hydrogen bonds for helix  */
+    for(a = 0; a < n_res; a++) {
+      r = res + a;
+      if(r->real && ((r - 1)->real)) {
+        r->flags = 0;
 
-          /* is residue an acceptor for i+3,4,5 residue? */
-          for(b = 0; b < r->n_acc; b++) {
-            r->flags |=
-              ((r->acc[b] == (a + 3)) ? cSSHelix3HBond : 0) |
-              ((r->acc[b] == (a + 4)) ? cSSHelix4HBond : 0) |
-              ((r->acc[b] == (a + 5)) ? cSSHelix5HBond : 0);
+        if(ObjectMoleculeGetPhiPsi
+           (r->obj, I->Table[r->ca].atom, &r->phi, &r->psi, state)) {
+          r->flags |= cSSGotPhiPsi;
 
-          }
+          helix_psi_delta = (float) fabs(r->psi - ctx.helix_psi_target);
+          strand_psi_delta = (float) fabs(r->psi - ctx.strand_psi_target);
+          helix_phi_delta = (float) fabs(r->phi - ctx.helix_phi_target);
+          strand_phi_delta = (float) fabs(r->phi - ctx.strand_phi_target);
 
-          /* is residue a donor for i-3,4,5 residue */
-          for(b = 0; b < r->n_don; b++) {
-            r->flags |=
-              ((r->don[b] == (a - 3)) ? cSSHelix3HBond : 0) |
-              ((r->don[b] == (a - 4)) ? cSSHelix4HBond : 0) |
-              ((r->don[b] == (a - 5)) ? cSSHelix5HBond : 0);
+          if(helix_psi_delta > 180.0F)
+            helix_psi_delta = 360.0F - helix_psi_delta;
+          if(strand_psi_delta > 180.0F)
+            strand_psi_delta = 360.0F - strand_psi_delta;
+          if(helix_phi_delta > 180.0F)
+            helix_phi_delta = 360.0F - helix_phi_delta;
+          if(strand_phi_delta > 180.0F)
+            strand_phi_delta = 360.0F - strand_phi_delta;
 
+          if((helix_psi_delta > ctx.helix_psi_exclude) ||
+             (helix_phi_delta > ctx.helix_phi_exclude)) {
+            r->flags |= cSSPhiPsiNotHelix;
+          } else if((helix_psi_delta < ctx.helix_psi_include) &&
+                    (helix_phi_delta < ctx.helix_phi_include)) {
+            r->flags |= cSSPhiPsiHelix;
           }
 
-          /*        if(r->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) {
-             printf("HelixHB %s \n",
-             r->obj->AtomInfo[I->Table[r->ca].atom].resi);
-             }
-           */
-
-          /* look for double h-bonded antiparallel beta sheet pairs:
-           * 
-           *  \ /\ /
-           *   N  C
-           *   #  O
-           *   O  #
-           *   C  N
-           *  / \/ \
-           *
-           */
+          if((strand_psi_delta > ctx.strand_psi_exclude) ||
+             (strand_phi_delta > ctx.strand_phi_exclude)) {
+            r->flags |= cSSPhiPsiNotStrand;
+          } else if((strand_psi_delta < ctx.strand_psi_include) &&
+                    (strand_phi_delta < ctx.strand_phi_include)) {
+            r->flags |= cSSPhiPsiStrand;
+          }
+        }
+      }
+    }
+  }
+  /* by default, tentatively assign everything as loop */
 
-          for(b = 0; b < r->n_acc; b++) {       /* iterate through acceptors */
-            r2 = (res + r->acc[b]);
-            if(r2->real) {
-              for(c = 0; c < r2->n_acc; c++) {
-                if(r2->acc[c] == a) {   /* found a pair */
-                  r->flags |= cSSAntiStrandDoubleHB;
-                  r2->flags |= cSSAntiStrandDoubleHB;
+  {
+    int a;
+    for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
+      if(res[a].present)
+        res[a].ss = 'L';
+    }
+  }
 
-                  /*                printf("anti double %s to %s\n",
-                     r->obj->AtomInfo[I->Table[r->ca].atom].resi,
-                     r2->obj->AtomInfo[I->Table[r2->ca].atom].resi); */
+  {
+    SSResi *r, *r2;
+    int a, b, c;
+
+    for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
+      r = res + a;
+      if(r->real) {
+
+        /* look for tell-tale i+3,4,5 hydrogen bonds for helix  */
+
+        /* is residue an acceptor for i+3,4,5 residue? */
+        for(b = 0; b < r->n_acc; b++) {
+          r->flags |=
+            ((r->acc[b] == (a + 3)) ? cSSHelix3HBond : 0) |
+            ((r->acc[b] == (a + 4)) ? cSSHelix4HBond : 0) |
+            ((r->acc[b] == (a + 5)) ? cSSHelix5HBond : 0);
+
+        }
+
+        /* is residue a donor for i-3,4,5 residue */
+        for(b = 0; b < r->n_don; b++) {
+          r->flags |=
+            ((r->don[b] == (a - 3)) ? cSSHelix3HBond : 0) |
+            ((r->don[b] == (a - 4)) ? cSSHelix4HBond : 0) |
+            ((r->don[b] == (a - 5)) ? cSSHelix5HBond : 0);
+
+        }
+
+        /*        if(r->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) {
+           printf("HelixHB %s \n",
+           r->obj->AtomInfo[I->Table[r->ca].atom].resi);
+           }
+         */
+
+        /* look for double h-bonded antiparallel beta sheet pairs:
+         * 
+         *  \ /\ /
+         *   N  C
+         *   #  O
+         *   O  #
+         *   C  N
+         *  / \/ \
+         *
+         */
+
+        for(b = 0; b < r->n_acc; b++) {       /* iterate through acceptors */
+          r2 = (res + r->acc[b]);
+          if(r2->real) {
+            for(c = 0; c < r2->n_acc; c++) {
+              if(r2->acc[c] == a) {   /* found a pair */
+                r->flags |= cSSAntiStrandDoubleHB;
+                r2->flags |= cSSAntiStrandDoubleHB;
+
+                /*                printf("anti double %s to %s\n",
+                   r->obj->AtomInfo[I->Table[r->ca].atom].resi,
+                   r2->obj->AtomInfo[I->Table[r2->ca].atom].resi); */
 
-                }
               }
             }
           }
+        }
 
-          /* look for antiparallel beta buldges
-           * 
-           *     CCNC
-           *  \ / O  \ /
-           *   N      C
-           *   #      O
-           *    O    #
-           *     C  N
-           *    / \/ \
-           *
-           */
-
-          for(b = 0; b < r->n_acc; b++) {       /* iterate through acceptors */
-            r2 = (res + r->acc[b]) + 1; /* go forward 1 */
-            if(r2->real) {
-              for(c = 0; c < r2->n_acc; c++) {
-                if(r2->acc[c] == a) {   /* found a buldge */
-                  r->flags |= cSSAntiStrandDoubleHB;
-                  r2->flags |= cSSAntiStrandBuldgeHB;
-                  (r2 - 1)->flags |= cSSAntiStrandBuldgeHB;
-
-                  /*                printf("anti BULDGE %s to %s %s\n",
-                     r->obj->AtomInfo[I->Table[r->ca].atom].resi,
-                     r2->obj->AtomInfo[I->Table[r2->ca].atom].resi,
-                     r2->obj->AtomInfo[I->Table[(r2-1)->ca].atom].resi); */
+        /* look for antiparallel beta buldges
+         * 
+         *     CCNC
+         *  \ / O  \ /
+         *   N      C
+         *   #      O
+         *    O    #
+         *     C  N
+         *    / \/ \
+         *
+         */
+
+        for(b = 0; b < r->n_acc; b++) {       /* iterate through acceptors */
+          r2 = (res + r->acc[b]) + 1; /* go forward 1 */
+          if(r2->real) {
+            for(c = 0; c < r2->n_acc; c++) {
+              if(r2->acc[c] == a) {   /* found a buldge */
+                r->flags |= cSSAntiStrandDoubleHB;
+                r2->flags |= cSSAntiStrandBuldgeHB;
+                (r2 - 1)->flags |= cSSAntiStrandBuldgeHB;
+
+                /*                printf("anti BULDGE %s to %s %s\n",
+                   r->obj->AtomInfo[I->Table[r->ca].atom].resi,
+                   r2->obj->AtomInfo[I->Table[r2->ca].atom].resi,
+                   r2->obj->AtomInfo[I->Table[(r2-1)->ca].atom].resi); */
 
-                }
               }
             }
           }
+        }
 
-          /* look for antiparallel beta sheet ladders (single or double)
-           *
-           *        O
-           *     N  C
-           *  \ / \/ \ /
-           *   C      N
-           *   O      #
-           *   #      O
-           *   N      C
-           *  / \ /\ / \
-           *     C  N
-           *     O
-           */
+        /* look for antiparallel beta sheet ladders (single or double)
+         *
+         *        O
+         *     N  C
+         *  \ / \/ \ /
+         *   C      N
+         *   O      #
+         *   #      O
+         *   N      C
+         *  / \ /\ / \
+         *     C  N
+         *     O
+         */
 
-          if((r + 1)->real && (r + 2)->real) {
+        if((r + 1)->real && (r + 2)->real) {
 
-            for(b = 0; b < r->n_acc; b++) {     /* iterate through acceptors */
-              r2 = (res + r->acc[b]) - 2;       /* go back 2 */
-              if(r2->real) {
+          for(b = 0; b < r->n_acc; b++) {     /* iterate through acceptors */
+            r2 = (res + r->acc[b]) - 2;       /* go back 2 */
+            if(r2->real) {
 
-                for(c = 0; c < r2->n_acc; c++) {
+              for(c = 0; c < r2->n_acc; c++) {
 
-                  if(r2->acc[c] == a + 2) {     /* found a ladder */
+                if(r2->acc[c] == a + 2) {     /* found a ladder */
 
-                    (r)->flags |= cSSAntiStrandSingleHB;
-                    (r + 1)->flags |= cSSAntiStrandSkip;
-                    (r + 2)->flags |= cSSAntiStrandSingleHB;
+                  (r)->flags |= cSSAntiStrandSingleHB;
+                  (r + 1)->flags |= cSSAntiStrandSkip;
+                  (r + 2)->flags |= cSSAntiStrandSingleHB;
 
-                    (r2)->flags |= cSSAntiStrandSingleHB;
-                    (r2 + 1)->flags |= cSSAntiStrandSkip;
-                    (r2 + 2)->flags |= cSSAntiStrandSingleHB;
+                  (r2)->flags |= cSSAntiStrandSingleHB;
+                  (r2 + 1)->flags |= cSSAntiStrandSkip;
+                  (r2 + 2)->flags |= cSSAntiStrandSingleHB;
 
-                    /*                  printf("anti ladder %s %s to %s %s\n",
-                       r->obj->AtomInfo[I->Table[r->ca].atom].resi,
-                       r->obj->AtomInfo[I->Table[(r+2)->ca].atom].resi,
-                       r2->obj->AtomInfo[I->Table[r2->ca].atom].resi,
-                       r2->obj->AtomInfo[I->Table[(r2+2)->ca].atom].resi); */
-                  }
+                  /*                  printf("anti ladder %s %s to %s %s\n",
+                     r->obj->AtomInfo[I->Table[r->ca].atom].resi,
+                     r->obj->AtomInfo[I->Table[(r+2)->ca].atom].resi,
+                     r2->obj->AtomInfo[I->Table[r2->ca].atom].resi,
+                     r2->obj->AtomInfo[I->Table[(r2+2)->ca].atom].resi); */
                 }
               }
             }
           }
+        }
 
-          /* look for parallel beta sheet ladders 
-           *
+        /* look for parallel beta sheet ladders 
+         *
 
-           *    \ /\ /
-           *     C  N
-           *    O    #
-           *   #      O
-           *   N      C
-           *  / \ /\ / \
-           *     C  N
-           *     O
-           */
+         *    \ /\ /
+         *     C  N
+         *    O    #
+         *   #      O
+         *   N      C
+         *  / \ /\ / \
+         *     C  N
+         *     O
+         */
 
-          if((r + 1)->real && (r + 2)->real) {
+        if((r + 1)->real && (r + 2)->real) {
 
-            for(b = 0; b < r->n_acc; b++) {     /* iterate through acceptors */
-              r2 = (res + r->acc[b]);
-              if(r2->real) {
+          for(b = 0; b < r->n_acc; b++) {     /* iterate through acceptors */
+            r2 = (res + r->acc[b]);
+            if(r2->real) {
 
-                for(c = 0; c < r2->n_acc; c++) {
+              for(c = 0; c < r2->n_acc; c++) {
 
-                  if(r2->acc[c] == a + 2) {     /* found a ladder */
+                if(r2->acc[c] == a + 2) {     /* found a ladder */
 
-                    (r)->flags |= cSSParaStrandSingleHB;
-                    (r + 1)->flags |= cSSParaStrandSkip;
-                    (r + 2)->flags |= cSSParaStrandSingleHB;
+                  (r)->flags |= cSSParaStrandSingleHB;
+                  (r + 1)->flags |= cSSParaStrandSkip;
+                  (r + 2)->flags |= cSSParaStrandSingleHB;
 
-                    (r2)->flags |= cSSParaStrandDoubleHB;
+                  (r2)->flags |= cSSParaStrandDoubleHB;
 
-                    /*                                    printf("parallel ladder %s %s to %s \n",
-                       r->obj->AtomInfo[I->Table[r->ca].atom].resi,
-                       r->obj->AtomInfo[I->Table[(r+2)->ca].atom].resi,
-                       r2->obj->AtomInfo[I->Table[r2->ca].atom].resi); */
-                  }
+                  /*                                    printf("parallel ladder %s %s to %s \n",
+                     r->obj->AtomInfo[I->Table[r->ca].atom].resi,
+                     r->obj->AtomInfo[I->Table[(r+2)->ca].atom].resi,
+                     r2->obj->AtomInfo[I->Table[r2->ca].atom].resi); */
                 }
               }
             }
@@ -2300,370 +2259,553 @@ int SelectorAssignSS(PyMOLGlobals * G, int target, int present,
         }
       }
     }
+  }
 
-    {
-      int a;
-      SSResi *r;
-      /* convert flags to assignments */
+  {
+    int a;
+    SSResi *r;
+    /* convert flags to assignments */
 
-      /* HELICES FIRST */
+    /* HELICES FIRST */
 
-      for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
-        r = res + a;
+    for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
+      r = res + a;
 
-        if(r->real) {
-          /* clean internal helical residues are easy to find using H-bonds */
+      if(r->real) {
+        /* clean internal helical residues are easy to find using H-bonds */
 
-          if(((r - 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r + 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond))) {
-            if(!(r->flags & (cSSPhiPsiNotHelix))) {
-              r->ss = 'H';
-            }
+        if(((r - 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r + 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond))) {
+          if(!(r->flags & (cSSPhiPsiNotHelix))) {
+            r->ss = 'H';
           }
+        }
 
-          /*
-             if(((r-1)->flags & (cSSHelix3HBond )) &&
-             ((r  )->flags & (cSSHelix3HBond )) &&
-             ((r+1)->flags & (cSSHelix3HBond ))) {
-             if(!(r->flags & (cSSPhiPsiNotHelix))) {
-             r->ss = 'H';
-             }
-             }
+        /*
+           if(((r-1)->flags & (cSSHelix3HBond )) &&
+           ((r  )->flags & (cSSHelix3HBond )) &&
+           ((r+1)->flags & (cSSHelix3HBond ))) {
+           if(!(r->flags & (cSSPhiPsiNotHelix))) {
+           r->ss = 'H';
+           }
+           }
 
-             if(((r-1)->flags & (cSSHelix4HBond)) &&
-             ((r  )->flags & (cSSHelix4HBond)) &&
-             ((r+1)->flags & (cSSHelix4HBond))) {
-             if(!(r->flags & (cSSPhiPsiNotHelix))) {
-             r->ss = 'H';
-             }
-             }
+           if(((r-1)->flags & (cSSHelix4HBond)) &&
+           ((r  )->flags & (cSSHelix4HBond)) &&
+           ((r+1)->flags & (cSSHelix4HBond))) {
+           if(!(r->flags & (cSSPhiPsiNotHelix))) {
+           r->ss = 'H';
+           }
+           }
 
-             if(((r-1)->flags & (cSSHelix5HBond)) &&
-             ((r  )->flags & (cSSHelix5HBond)) &&
-             ((r+1)->flags & (cSSHelix5HBond))) {
-             if(!(r->flags & (cSSPhiPsiNotHelix))) {
-             r->ss = 'H';
-             }
-             }
-           */
+           if(((r-1)->flags & (cSSHelix5HBond)) &&
+           ((r  )->flags & (cSSHelix5HBond)) &&
+           ((r+1)->flags & (cSSHelix5HBond))) {
+           if(!(r->flags & (cSSPhiPsiNotHelix))) {
+           r->ss = 'H';
+           }
+           }
+         */
 
-        }
       }
+    }
 
-      for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
-        r = res + a;
+    for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
+      r = res + a;
 
-        if(r->real) {
+      if(r->real) {
 
-          /* occasionally they'll be one whacked out residue missing h-bonds... 
-             in an otherwise good segment */
+        /* occasionally they'll be one whacked out residue missing h-bonds... 
+           in an otherwise good segment */
 
-          if(((r - 2)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r - 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r - 1)->flags & (cSSPhiPsiHelix)) &&
-             ((r)->flags & (cSSPhiPsiHelix)) &&
-             ((r + 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r + 1)->flags & (cSSPhiPsiHelix)) &&
-             ((r + 2)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond))
-            ) {
-            r->ss = 'h';
-          }
+        if(((r - 2)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r - 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r - 1)->flags & (cSSPhiPsiHelix)) &&
+           ((r)->flags & (cSSPhiPsiHelix)) &&
+           ((r + 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r + 1)->flags & (cSSPhiPsiHelix)) &&
+           ((r + 2)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond))
+          ) {
+          r->ss = 'h';
         }
       }
+    }
 
-      for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
-        r = res + a;
-        if(r->real) {
-          if(r->ss == 'h') {
-            r->flags |= (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond);
-            r->ss = 'H';
-          }
+    for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
+      r = res + a;
+      if(r->real) {
+        if(r->ss == 'h') {
+          r->flags |= (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond);
+          r->ss = 'H';
         }
       }
+    }
 
-      for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
-        r = res + a;
+    for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
+      r = res + a;
 
-        if(r->real) {
+      if(r->real) {
 
-          /* deciding where the helix ends is trickier -- here we use helix geometry */
+        /* deciding where the helix ends is trickier -- here we use helix geometry */
 
-          if(((r)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r)->flags & (cSSPhiPsiHelix)) &&
-             ((r + 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r + 1)->flags & (cSSPhiPsiHelix)) &&
-             ((r + 2)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r + 2)->flags & (cSSPhiPsiHelix)) && ((r + 1)->ss == 'H')
-            ) {
-            r->ss = 'H';
-          }
-
-          if(((r)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r)->flags & (cSSPhiPsiHelix)) &&
-             ((r - 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r - 1)->flags & (cSSPhiPsiHelix)) &&
-             ((r - 2)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
-             ((r - 2)->flags & (cSSPhiPsiHelix)) && ((r - 1)->ss == 'H')
-            ) {
-            r->ss = 'H';
-          }
+        if(((r)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r)->flags & (cSSPhiPsiHelix)) &&
+           ((r + 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r + 1)->flags & (cSSPhiPsiHelix)) &&
+           ((r + 2)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r + 2)->flags & (cSSPhiPsiHelix)) && ((r + 1)->ss == 'H')
+          ) {
+          r->ss = 'H';
+        }
 
+        if(((r)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r)->flags & (cSSPhiPsiHelix)) &&
+           ((r - 1)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r - 1)->flags & (cSSPhiPsiHelix)) &&
+           ((r - 2)->flags & (cSSHelix3HBond | cSSHelix4HBond | cSSHelix5HBond)) &&
+           ((r - 2)->flags & (cSSPhiPsiHelix)) && ((r - 1)->ss == 'H')
+          ) {
+          r->ss = 'H';
         }
+
       }
+    }
 
-      /* THEN SHEETS/STRANDS */
+    /* THEN SHEETS/STRANDS */
 
-      for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
-        r = res + a;
-        if(r->real) {
+    for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
+      r = res + a;
+      if(r->real) {
 
-          /* Antiparallel Sheets */
+        /* Antiparallel Sheets */
 
-          if(((r)->flags & (cSSAntiStrandDoubleHB)) &&
-             (!((r->flags & (cSSPhiPsiNotStrand))))) {
-            (r)->ss = 'S';
-          }
+        if(((r)->flags & (cSSAntiStrandDoubleHB)) &&
+           (!((r->flags & (cSSPhiPsiNotStrand))))) {
+          (r)->ss = 'S';
+        }
 
-          if(((r)->flags & (cSSAntiStrandBuldgeHB)) &&  /* no strand geometry filtering for buldges.. */
-             ((r + 1)->flags & (cSSAntiStrandBuldgeHB))) {
-            (r)->ss = 'S';
-            (r + 1)->ss = 'S';
-          }
+        if(((r)->flags & (cSSAntiStrandBuldgeHB)) &&  /* no strand geometry filtering for buldges.. */
+           ((r + 1)->flags & (cSSAntiStrandBuldgeHB))) {
+          (r)->ss = 'S';
+          (r + 1)->ss = 'S';
+        }
 
-          if(((r - 1)->flags & (cSSAntiStrandDoubleHB)) &&
-             ((r)->flags & (cSSAntiStrandSkip)) &&
-             (!(((r)->flags & (cSSPhiPsiNotStrand)))) &&
-             ((r + 1)->flags & (cSSAntiStrandSingleHB | cSSAntiStrandDoubleHB))) {
+        if(((r - 1)->flags & (cSSAntiStrandDoubleHB)) &&
+           ((r)->flags & (cSSAntiStrandSkip)) &&
+           (!(((r)->flags & (cSSPhiPsiNotStrand)))) &&
+           ((r + 1)->flags & (cSSAntiStrandSingleHB | cSSAntiStrandDoubleHB))) {
 
-            (r)->ss = 'S';
-          }
+          (r)->ss = 'S';
+        }
 
-          if(((r - 1)->flags & (cSSAntiStrandSingleHB | cSSAntiStrandDoubleHB)) &&
-             ((r)->flags & (cSSAntiStrandSkip)) &&
-             (!(((r)->flags & (cSSPhiPsiNotStrand)))) &&
-             ((r + 1)->flags & (cSSAntiStrandDoubleHB))) {
-            (r)->ss = 'S';
-          }
+        if(((r - 1)->flags & (cSSAntiStrandSingleHB | cSSAntiStrandDoubleHB)) &&
+           ((r)->flags & (cSSAntiStrandSkip)) &&
+           (!(((r)->flags & (cSSPhiPsiNotStrand)))) &&
+           ((r + 1)->flags & (cSSAntiStrandDoubleHB))) {
+          (r)->ss = 'S';
+        }
 
-          /* include open "ladders" if PHIPSI geometry supports assignment */
+        /* include open "ladders" if PHIPSI geometry supports assignment */
 
-          if(((r - 1)->flags & (cSSAntiStrandSingleHB | cSSAntiStrandDoubleHB)) &&
-             ((r - 1)->flags & (cSSPhiPsiStrand)) &&
-             (!(((r - 1)->flags & (cSSPhiPsiNotStrand)))) &&
-             ((r)->flags & (cSSPhiPsiStrand)) &&
-             (!(((r - 1)->flags & (cSSPhiPsiNotStrand)))) &&
-             ((r + 1)->flags & (cSSAntiStrandSingleHB | cSSAntiStrandDoubleHB)) &&
-             ((r + 1)->flags & (cSSPhiPsiStrand))) {
+        if(((r - 1)->flags & (cSSAntiStrandSingleHB | cSSAntiStrandDoubleHB)) &&
+           ((r - 1)->flags & (cSSPhiPsiStrand)) &&
+           (!(((r - 1)->flags & (cSSPhiPsiNotStrand)))) &&
+           ((r)->flags & (cSSPhiPsiStrand)) &&
+           (!(((r - 1)->flags & (cSSPhiPsiNotStrand)))) &&
+           ((r + 1)->flags & (cSSAntiStrandSingleHB | cSSAntiStrandDoubleHB)) &&
+           ((r + 1)->flags & (cSSPhiPsiStrand))) {
 
-            (r - 1)->ss = 'S';
-            (r)->ss = 'S';
-            (r + 1)->ss = 'S';
-          }
+          (r - 1)->ss = 'S';
+          (r)->ss = 'S';
+          (r + 1)->ss = 'S';
+        }
 
-          /* Parallel Sheets */
+        /* Parallel Sheets */
 
-          if(((r)->flags & (cSSParaStrandDoubleHB)) &&
-             (!(((r)->flags & (cSSPhiPsiNotStrand))))) {
-            (r)->ss = 'S';
-          }
+        if(((r)->flags & (cSSParaStrandDoubleHB)) &&
+           (!(((r)->flags & (cSSPhiPsiNotStrand))))) {
+          (r)->ss = 'S';
+        }
 
-          if(((r - 1)->flags & (cSSParaStrandDoubleHB)) &&
-             ((r)->flags & (cSSParaStrandSkip)) &&
-             (!(((r)->flags & (cSSPhiPsiNotStrand)))) &&
-             ((r + 1)->flags & (cSSParaStrandSingleHB | cSSParaStrandDoubleHB))) {
+        if(((r - 1)->flags & (cSSParaStrandDoubleHB)) &&
+           ((r)->flags & (cSSParaStrandSkip)) &&
+           (!(((r)->flags & (cSSPhiPsiNotStrand)))) &&
+           ((r + 1)->flags & (cSSParaStrandSingleHB | cSSParaStrandDoubleHB))) {
 
-            (r)->ss = 'S';
-          }
+          (r)->ss = 'S';
+        }
 
-          if(((r - 1)->flags & (cSSParaStrandSingleHB | cSSParaStrandDoubleHB)) &&
-             ((r)->flags & (cSSParaStrandSkip)) &&
-             (!(((r)->flags & (cSSPhiPsiNotStrand)))) &&
-             ((r + 1)->flags & (cSSParaStrandDoubleHB))) {
-            (r)->ss = 'S';
-          }
+        if(((r - 1)->flags & (cSSParaStrandSingleHB | cSSParaStrandDoubleHB)) &&
+           ((r)->flags & (cSSParaStrandSkip)) &&
+           (!(((r)->flags & (cSSPhiPsiNotStrand)))) &&
+           ((r + 1)->flags & (cSSParaStrandDoubleHB))) {
+          (r)->ss = 'S';
+        }
 
-          /* include open "ladders" if PHIPSI geometry supports assignment */
+        /* include open "ladders" if PHIPSI geometry supports assignment */
 
-          if(((r - 1)->flags & (cSSParaStrandSingleHB | cSSParaStrandDoubleHB)) &&
-             ((r - 1)->flags & (cSSPhiPsiStrand)) &&
-             ((r)->flags & (cSSParaStrandSkip)) &&
-             ((r)->flags & (cSSPhiPsiStrand)) &&
-             ((r + 1)->flags & (cSSParaStrandSingleHB | cSSParaStrandDoubleHB)) &&
-             ((r + 1)->flags & (cSSPhiPsiStrand))) {
+        if(((r - 1)->flags & (cSSParaStrandSingleHB | cSSParaStrandDoubleHB)) &&
+           ((r - 1)->flags & (cSSPhiPsiStrand)) &&
+           ((r)->flags & (cSSParaStrandSkip)) &&
+           ((r)->flags & (cSSPhiPsiStrand)) &&
+           ((r + 1)->flags & (cSSParaStrandSingleHB | cSSParaStrandDoubleHB)) &&
+           ((r + 1)->flags & (cSSPhiPsiStrand))) {
 
-            (r - 1)->ss = 'S';
-            (r)->ss = 'S';
-            (r + 1)->ss = 'S';
+          (r - 1)->ss = 'S';
+          (r)->ss = 'S';
+          (r + 1)->ss = 'S';
 
-          }
         }
       }
     }
+  }
 
-    {
-      int a, b;
-      SSResi *r, *r2;
-      int repeat = true;
-      int found;
+  {
+    int a, b;
+    SSResi *r, *r2;
+    int repeat = true;
+    int found;
 
-      while(repeat) {
-        repeat = false;
+    while(repeat) {
+      repeat = false;
 
-        for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
-          r = res + a;
-          if(r->real) {
+      for(a = cSSBreakSize; a < (n_res - cSSBreakSize); a++) {
+        r = res + a;
+        if(r->real) {
 
-            /* make sure we don't have any 2-residue segments */
+          /* make sure we don't have any 2-residue segments */
 
-            if((r->ss == 'S') && ((r + 1)->ss == 'S') &&
-               (((r - 1)->ss != 'S') && ((r + 2)->ss != 'S'))) {
-              r->ss = 'L';
-              (r + 1)->ss = 'L';
-              repeat = true;
-            }
-            if((r->ss == 'H') && ((r + 1)->ss == 'H') &&
-               (((r - 1)->ss != 'H') && ((r + 2)->ss != 'H'))) {
-              r->ss = 'L';
-              (r + 1)->ss = 'L';
-              repeat = true;
-            }
+          if((r->ss == 'S') && ((r + 1)->ss == 'S') &&
+             (((r - 1)->ss != 'S') && ((r + 2)->ss != 'S'))) {
+            r->ss = 'L';
+            (r + 1)->ss = 'L';
+            repeat = true;
+          }
+          if((r->ss == 'H') && ((r + 1)->ss == 'H') &&
+             (((r - 1)->ss != 'H') && ((r + 2)->ss != 'H'))) {
+            r->ss = 'L';
+            (r + 1)->ss = 'L';
+            repeat = true;
+          }
 
-            /* make sure we don't have any 1-residue segments */
+          /* make sure we don't have any 1-residue segments */
 
-            if((r->ss == 'S') && (((r - 1)->ss != 'S') && ((r + 1)->ss != 'S'))) {
-              r->ss = 'L';
-              repeat = true;
-            }
-            if((r->ss == 'H') && (((r - 1)->ss != 'H') && ((r + 1)->ss != 'H'))) {
-              r->ss = 'L';
-              repeat = true;
-            }
+          if((r->ss == 'S') && (((r - 1)->ss != 'S') && ((r + 1)->ss != 'S'))) {
+            r->ss = 'L';
+            repeat = true;
+          }
+          if((r->ss == 'H') && (((r - 1)->ss != 'H') && ((r + 1)->ss != 'H'))) {
+            r->ss = 'L';
+            repeat = true;
+          }
 
-            /* double-check to make sure every terminal strand residue 
-               that should have a partner has one */
+          /* double-check to make sure every terminal strand residue 
+             that should have a partner has one */
 
-            if((r->ss == 'S') && (((r - 1)->ss != 'S') || ((r + 1)->ss != 'S'))) {
+          if((r->ss == 'S') && (((r - 1)->ss != 'S') || ((r + 1)->ss != 'S'))) {
 
-              found = false;
+            found = false;
+
+            for(b = 0; b < r->n_acc; b++) {
+              r2 = res + r->acc[b];
+              if(r2->ss == r->ss) {
+                found = true;
+                break;
+              }
+            }
 
-              for(b = 0; b < r->n_acc; b++) {
-                r2 = res + r->acc[b];
+            if(!found) {
+              for(b = 0; b < r->n_don; b++) {
+                r2 = res + r->don[b];
                 if(r2->ss == r->ss) {
                   found = true;
                   break;
                 }
               }
+            }
 
-              if(!found) {
-                for(b = 0; b < r->n_don; b++) {
-                  r2 = res + r->don[b];
-                  if(r2->ss == r->ss) {
-                    found = true;
-                    break;
-                  }
-                }
-              }
+            if(!found) {     
+              /* allow these strand "skip" residues to persist if a neighbor has hydrogen bonds */
+              if(r->flags & (cSSAntiStrandSkip | cSSParaStrandSkip)) {
 
-              if(!found) {     
-                /* allow these strand "skip" residues to persist if a neighbor has hydrogen bonds */
-                if(r->flags & (cSSAntiStrandSkip | cSSParaStrandSkip)) {
+                if((r + 1)->ss == r->ss)
+                  for(b = 0; b < (r + 1)->n_acc; b++) {
+                    r2 = res + (r + 1)->acc[b];
+                    if(r2->ss == r->ss) {
+                      found = true;
+                      break;
+                    }
+                  }
 
-                  if((r + 1)->ss == r->ss)
-                    for(b = 0; b < (r + 1)->n_acc; b++) {
-                      r2 = res + (r + 1)->acc[b];
+                if(!found) {
+                  if((r - 1)->ss == r->ss) {
+                    for(b = 0; b < (r - 1)->n_don; b++) {
+                      r2 = res + (r - 1)->don[b];
                       if(r2->ss == r->ss) {
                         found = true;
                         break;
                       }
                     }
-
-                  if(!found) {
-                    if((r - 1)->ss == r->ss) {
-                      for(b = 0; b < (r - 1)->n_don; b++) {
-                        r2 = res + (r - 1)->don[b];
-                        if(r2->ss == r->ss) {
-                          found = true;
-                          break;
-                        }
-                      }
-                    }
                   }
                 }
               }
+            }
 
-              if(!found) {
-                r->ss = 'L';
-                repeat = true;
-              }
+            if(!found) {
+              r->ss = 'L';
+              repeat = true;
             }
           }
         }
       }
     }
+  }
+
+  ss.resize(n_res);
+  for(int a = 0; a < n_res; a++) {
+    ss[a] = res[a].present ? res[a].ss : 0;
+  }
+
+  return !too_many_atoms;
+}
+
+/**
+ * States to evaluate for the given `state_value` (see SelectorAssignSS)
+ */
+static std::vector<int> SelectorSSStates(PyMOLGlobals* G, int target,
+    int state_value)
+{
+  std::vector<int> states;
+  int state_start, state_stop;
+
+  if(state_value < 0) {
+    state_start = 0;
+    state_stop = SelectorGetSeleNCSet(G, target);
+
+    if (state_value == cStateCurrent) {
+      StateIterator iter(G, nullptr, state_value, state_stop);
+      if (iter.next()) {
+        state_start = iter.state;
+        state_stop = iter.state + 1;
+      }
+    }
+  } else {
+    state_start = state_value;
+    state_stop = state_value + 1;
+  }
+
+  for(int state = state_start; state < state_stop; state++) {
+    states.push_back(state);
+    if((state_value == -5) && (state == state_start) &&
+        (state_stop - 2 > state))   /* first and last only */
+      state = state_stop - 2;
+  }
+
+  return states;
+}
+
+static void SelectorSSUpdateTable(PyMOLGlobals* G, int state_value,
+    ObjectMolecule* single_object)
+{
+  if(!single_object) {
+    if(state_value < 0) {
+      switch (state_value) {
+      case cSelectorUpdateTableCurrentState:
+      case cSelectorUpdateTableEffectiveStates:
+        SelectorUpdateTable(G, state_value, -1);
+        break;
+      default:
+        SelectorUpdateTable(G, cSelectorUpdateTableAllStates, -1);
+        break;
+      }
+    } else {
+      SelectorUpdateTable(G, state_value, -1);
+    }
+  } else {
+    SelectorUpdateTableSingleObject(G, single_object, state_value);
+  }
+}
+
+/**
+ * Evaluate all `states` (in parallel, if available) and pass the
+ * per-state assignments to `func` serially and in state order.
+ *
+ * @param func callback with signature (int state, std::string& ss)
+ */
+template <typename Func>
+static void SelectorSSForEachState(PyMOLGlobals* G, const SSContext& ctx,
+    const std::vector<int>& states, Func&& func)
+{
+  // bounds memory use for long trajectories
+  const int block_size = 64;
+  const int n_states = states.size();
+
+  std::vector<std::string> block_ss(block_size);
+  std::vector<char> block_ok(block_size);
+
+  for(int block_start = 0; block_start < n_states; block_start += block_size) {
+    const int block_n = std::min(block_size, n_states - block_start);
 
+#ifdef PYMOL_OPENMP
+#pragma omp parallel
+#endif
     {
-      int a;
-      for(a = 0; a < n_res; a++) {      /* now apply consensus or union behavior, if appropriate */
-        if(res[a].present) {
-          if(res[a].ss_save) {
-            if(res[a].ss != res[a].ss_save) {
-              if(consensus) {
-                res[a].ss = res[a].ss_save = 'L';
-              } else if(res[a].ss == 'L')
-                res[a].ss = res[a].ss_save;
-            }
+      std::vector<SSResi> scratch;
+
+#ifdef PYMOL_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(int i = 0; i < block_n; i++) {
+        block_ok[i] = SelectorSSAssignState(G, ctx, states[block_start + i],
+            scratch, block_ss[i]);
+      }
+    }
+
+    for(int i = 0; i < block_n; i++) {
+      if(!block_ok[i]) {
+        PRINTFB(G, FB_Selector, FB_Errors)
+          " %s: ERROR: Unreasonable number of neighbors for dss, cannot assign secondary structure.\n", __func__ ENDFB(G);
+      }
+      func(states[block_start + i], block_ss[i]);
+    }
+  }
+}
+
+int SelectorAssignSS(PyMOLGlobals * G, int target, int present,
+                     int state_value, int preserve, ObjectMolecule * single_object,
+                     int quiet)
+{
+
+  /* PyMOL's secondary structure assignment algorithm: 
+
+     General principal -- if it looks like a duck, then it's a duck:
+
+     I. Helices
+     - must have reasonably helical geometry within the helical span
+     - near-ideal geometry guarantees helix assignment
+     - a continuous ladder stre i+3, i+4, or i+5 hydrogen bonding
+     with permissible geometry can reinforce marginal cases
+     - a minimum helix is three residues with i+3 H-bond
+
+     II. Sheets
+     - Hydrogen bonding ladders are the primary guide
+     - Out-of-the envelope 
+     - 1-residue gaps in sheets are filled unless there
+     is a turn.
+
+     The residue table and the through-bond exclusions are set up once,
+     states are independent and get evaluated in parallel. Consensus or
+     union behavior is then applied in state order.
+   */
+
+  CSelector *I = G->Selector;
+  const bool consensus = (state_value != -4);
+
+  SelectorSSUpdateTable(G, state_value, single_object);
+
+  SSContext ctx;
+  ctx.res = SelectorSSCollectResidues(G, present, state_value, preserve, quiet);
+  SelectorSSInitContext(G, ctx);
+
+  const auto& res = ctx.res;
+  const int n_res = res.size();
+  std::string ss_save(n_res, 0);
+
+  auto states = SelectorSSStates(G, target, state_value);
+
+  SelectorSSForEachState(G, ctx, states, [&](int state, std::string& ss) {
+    int a;
+    for(a = 0; a < n_res; a++) {        /* now apply consensus or union behavior, if appropriate */
+      if(ss[a]) {
+        if(ss_save[a]) {
+          if(ss[a] != ss_save[a]) {
+            if(consensus) {
+              ss[a] = ss_save[a] = 'L';
+            } else if(ss[a] == 'L')
+              ss[a] = ss_save[a];
           }
-          res[a].ss_save = res[a].ss;
         }
+        ss_save[a] = ss[a];
       }
     }
 
-    {
-      int a, aa;
-      ObjectMolecule *obj = nullptr, *last_obj = nullptr;
-      AtomInfoType *ai;
-      int changed_flag = false;
+    int aa;
+    ObjectMolecule *obj = nullptr, *last_obj = nullptr;
+    AtomInfoType *ai;
+    int changed_flag = false;
 
-      for(a = 0; a < n_res; a++) {
-        if(res[a].present && (!res[a].preserve)) {
+    for(a = 0; a < n_res; a++) {
+      if(ss[a] && (!res[a].preserve)) {
 
-          aa = res[a].ca;
-          obj = I->Obj[I->Table[aa].model];
+        aa = res[a].ca;
+        obj = I->Obj[I->Table[aa].model];
 
-          if(obj != last_obj) {
-            if(changed_flag && last_obj) {
-              last_obj->invalidate(cRepCartoon, cRepInvRep, -1);
-              SceneChanged(G);
-              changed_flag = false;
-            }
-            last_obj = obj;
+        if(obj != last_obj) {
+          if(changed_flag && last_obj) {
+            last_obj->invalidate(cRepCartoon, cRepInvRep, -1);
+            SceneChanged(G);
+            changed_flag = false;
           }
-          ai = obj->AtomInfo + I->Table[aa].atom;
+          last_obj = obj;
+        }
+        ai = obj->AtomInfo + I->Table[aa].atom;
 
-          if(SelectorIsMember(G, ai->selEntry, target)) {
-            ai->ssType[0] = res[a].ss;
-            ai->cartoon = 0;    /* switch back to auto */
-            ai->ssType[1] = 0;
-            changed_flag = true;
-          }
+        if(SelectorIsMember(G, ai->selEntry, target)) {
+          ai->ssType[0] = ss[a];
+          ai->cartoon = 0;      /* switch back to auto */
+          ai->ssType[1] = 0;
+          changed_flag = true;
         }
       }
+    }
 
-      if(changed_flag && last_obj) {
-        last_obj->invalidate(cRepCartoon, cRepInvRep, -1);
-        SceneChanged(G);
-        changed_flag = false;
-      }
+    if(changed_flag && last_obj) {
+      last_obj->invalidate(cRepCartoon, cRepInvRep, -1);
+      SceneChanged(G);
+      changed_flag = false;
     }
-    if(first_last_only && (state == state_start))
-      state = state_stop - 2;
-  }
+  });
 
-  VLAFreeP(res);
   return 1;
 }
 
+std::vector<std::string> SelectorGetSS(PyMOLGlobals* G, int target,
+    int present, int state_value, int quiet)
+{
+  CSelector *I = G->Selector;
+
+  SelectorSSUpdateTable(G, state_value, nullptr);
+
+  SSContext ctx;
+  ctx.res = SelectorSSCollectResidues(G, present, state_value, false, quiet);
+  SelectorSSInitContext(G, ctx);
+
+  /* residues reported in the result */
+  std::vector<int> reported;
+  for(size_t a = 0; a < ctx.res.size(); a++) {
+    const auto& r = ctx.res[a];
+    if(r.real && SelectorIsMember(G,
+          r.obj->AtomInfo[I->Table[r.ca].atom].selEntry, target)) {
+      reported.push_back(a);
+    }
+  }
+
+  std::vector<std::string> result;
+  auto states = SelectorSSStates(G, target, state_value);
+
+  SelectorSSForEachState(G, ctx, states, [&](int state, std::string& ss) {
+    std::string state_ss(reported.size(), '-');
+    for(size_t i = 0; i < reported.size(); i++) {
+      if(ss[reported[i]])
+        state_ss[i] = ss[reported[i]];
+    }
+    result.push_back(std::move(state_ss));
+  });
+
+  return result;
+}
+
 PyObject *SelectorColorectionGet(PyMOLGlobals * G, const char *prefix)
 {
 #ifdef _PYMOL_NOPY
@@ -4837,6 +4979,9 @@ static double max6d(double a, double b, double c, double d, double e, double f)
 
 typedef double AtomSF[11];
 
+/* number of grid slabs per parallel chunk of the map generators */
+static const int cSlabChunk = 16;
+
 
 /*========================================================================*/
 int SelectorMapGaussian(PyMOLGlobals * G, int sele1, ObjectMapState * oMap,
@@ -4859,10 +5004,9 @@ int SelectorMapGaussian(PyMOLGlobals * G, int sele1, ObjectMapState * oMap,
   float *occup = nullptr, *oc;
   int prot;
   int once_flag;
-  float d, e_val;
   double sum, sumsq;
   float mean, stdev;
-  double sf[256][11], *sfp;
+  double sf[256][11];
   AtomSF *atom_sf = nullptr;
   double b_adjust = (double) SettingGetGlobal_f(G, cSetting_gaussian_b_adjust);
   double elim = 7.0;
@@ -5231,59 +5375,57 @@ int SelectorMapGaussian(PyMOLGlobals * G, int sele1, ObjectMapState * oMap,
     n2 = 0;
     std::unique_ptr<MapType> map(new MapType(G, -max_rcut, point, n1, nullptr));
     if(map) {
+      CField *data = oMap->Field->data.get();
+      CField *points = oMap->Field->points.get();
+      const int *min = oMap->Min;
+      const int *max = oMap->Max;
+
+      /* build the lookup lists up front, they are shared by all threads */
+      MapSetupExpress(map.get());
+
       sum = 0.0;
       sumsq = 0.0;
-      for(a = oMap->Min[0]; a <= oMap->Max[0]; a++) {
-        OrthoBusyFast(G, a - oMap->Min[0], oMap->Max[0] - oMap->Min[0] + 1);
-        for(b = oMap->Min[1]; b <= oMap->Max[1]; b++) {
-          for(c = oMap->Min[2]; c <= oMap->Max[2]; c++) {
-            e_val = 0.0;
-            v2 = F4Ptr(oMap->Field->points, a, b, c, 0);
-                if(use_max) {
-                  float e_partial;
-                  for (const auto j : MapEIter(*map, v2)) {
-                    d = (float) diff3f(point + 3 * j, v2) * blur_factor;        
-                    /* scale up width */
-                    sfp = atom_sf[j];
-                    if(d < sfp[10]) {
-                      d = d * d;
-                      if(d < R_SMALL8)
-                        d = R_SMALL8;
-                      e_partial = (float) ((sfp[0] * exp(-sfp[1] * d))
-                                           + (sfp[2] * exp(-sfp[3] * d))
-                                           + (sfp[4] * exp(-sfp[5] * d))
-                                           + (sfp[6] * exp(-sfp[7] * d))
-                                           + (sfp[8] * exp(-sfp[9] * d))) * blur_factor;       
-                      /* scale down intensity */
-                      if(e_partial > e_val)
-                        e_val = e_partial;
-                    }
-                  }
-                } else {
-                  for (const auto j : MapEIter(*map, v2)) {
-                    d = (float) diff3f(point + 3 * j, v2) * blur_factor;       
-                    /* scale up width */
-                    sfp = atom_sf[j];
-                    if(d < sfp[10]) {
-                      d = d * d;
-                      if(d < R_SMALL8)
-                        d = R_SMALL8;
-                      e_val += (float) ((sfp[0] * exp(-sfp[1] * d))
-                                        + (sfp[2] * exp(-sfp[3] * d))
-                                        + (sfp[4] * exp(-sfp[5] * d))
-                                        + (sfp[6] * exp(-sfp[7] * d))
-                                        + (sfp[8] * exp(-sfp[9] * d))) * blur_factor;  
-                      /* scale down intensity */
-                    }
-                  }
+
+      /* slabs are evaluated in parallel, in chunks to keep the busy bar going */
+      for(int a0 = min[0]; a0 <= max[0]; a0 += cSlabChunk) {
+        OrthoBusyFast(G, a0 - min[0], max[0] - min[0] + 1);
+        const int a1 = std::min(a0 + cSlabChunk - 1, max[0]);
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:sum,sumsq)
+#endif
+        for(int a = a0; a <= a1; a++) {
+          for(int b = min[1]; b <= max[1]; b++) {
+            for(int c = min[2]; c <= max[2]; c++) {
+              float e_val = 0.0F;
+              const float *v2 = F4Ptr(points, a, b, c, 0);
+              for (const auto j : MapEIter(*map, v2)) {
+                float d = (float) diff3f(point + 3 * j, v2) * blur_factor;
+                /* scale up width */
+                const double *sfp = atom_sf[j];
+                if(d < sfp[10]) {
+                  d = d * d;
+                  if(d < R_SMALL8)
+                    d = R_SMALL8;
+                  float e_partial = (float) ((sfp[0] * exp(-sfp[1] * d))
+                                             + (sfp[2] * exp(-sfp[3] * d))
+                                             + (sfp[4] * exp(-sfp[5] * d))
+                                             + (sfp[6] * exp(-sfp[7] * d))
+                                             + (sfp[8] * exp(-sfp[9] * d))) * blur_factor;
+                  /* scale down intensity */
+                  if(!use_max)
+                    e_val += e_partial;
+                  else if(e_partial > e_val)
+                    e_val = e_partial;
                 }
-            F3(oMap->Field->data, a, b, c) = e_val;
-            sum += e_val;
-            sumsq += (e_val * e_val);
-            n2++;
+              }
+              F3(data, a, b, c) = e_val;
+              sum += e_val;
+              sumsq += (e_val * e_val);
+            }
           }
         }
       }
+      n2 = (max[0] - min[0] + 1) * (max[1] - min[1] + 1) * (max[2] - min[2] + 1);
       mean = (float) (sum / n2);
       stdev = (float) sqrt1d((sumsq - (sum * sum / n2)) / (n2 - 1));
       if(normalize) {
@@ -5327,7 +5469,8 @@ int SelectorMapGaussian(PyMOLGlobals * G, int sele1, ObjectMapState * oMap,
 
 /*========================================================================*/
 int SelectorMapCoulomb(PyMOLGlobals * G, int sele1, ObjectMapState * oMap,
-                       float cutoff, int state, int neutral, int shift, float shift_power)
+                       float cutoff, int state, int neutral, int shift, float shift_power,
+                       int mesh)
 {
   CSelector *I = G->Selector;
   float *v2;
@@ -5458,7 +5601,6 @@ int SelectorMapCoulomb(PyMOLGlobals * G, int sele1, ObjectMapState * oMap,
     int *max = oMap->Max;
     CField *data = oMap->Field->data.get();
     CField *points = oMap->Field->points.get();
-    float dist;
 
     if(cutoff > 0.0F) {         /* we are using a cutoff */
       if(shift) {
@@ -5474,84 +5616,107 @@ int SelectorMapCoulomb(PyMOLGlobals * G, int sele1, ObjectMapState * oMap,
       std::unique_ptr<MapType> map(
           new MapType(G, -(cutoff), point, n_point, nullptr));
       if(map) {
-        float dx, dy, dz;
-        float cut = cutoff;
-        float cut2 = cutoff * cutoff;
-
-        for(a = min[0]; a <= max[0]; a++) {
-          OrthoBusyFast(G, a - min[0], max[0] - min[0] + 1);
-          for(b = min[1]; b <= max[1]; b++) {
-            for(c = min[2]; c <= max[2]; c++) {
-              F3(data, a, b, c) = 0.0F;
-              v2 = F4Ptr(points, a, b, c, 0);
-              {
-                {
-                  for (const auto j : MapEIter(*map, v2)) {
-                    v1 = point + 3 * j;
-                    while(1) {
-
-                      dx = v1[0] - v2[0];
-                      dy = v1[1] - v2[1];
-                      dx = (float) fabs(dx);
-                      dy = (float) fabs(dy);
-                      if(dx > cut)
-                        break;
-                      dz = v1[2] - v2[2];
-                      dx = dx * dx;
-                      if(dy > cut)
-                        break;
-                      dz = (float) fabs(dz);
-                      dy = dy * dy;
-                      if(dz > cut)
-                        break;
-                      dx = dx + dy;
-                      dz = dz * dz;
-                      if(dx > cut2)
-                        break;
-                      dy = dx + dz;
-                      if(dy > cut2)
-                        break;
-                      dist = (float) sqrt1f(dy);
+        const float cut2 = cutoff * cutoff;
 
-                      if(dist > R_SMALL4) {
-                        if(shift) {
-                          if(dist < cutoff) {
-                            F3(data, a, b, c) += (charge[j] / dist) *
-                              (_1 - (float) pow(dist, shift_power) / cutoff_to_power);
-                          }
-                        } else {
-                          F3(data, a, b, c) += charge[j] / dist;
-                        }
-                      }
+        /* build the lookup lists up front, they are shared by all threads */
+        MapSetupExpress(map.get());
 
-                      break;
+        for(int a0 = min[0]; a0 <= max[0]; a0 += cSlabChunk) {
+          OrthoBusyFast(G, a0 - min[0], max[0] - min[0] + 1);
+          const int a1 = std::min(a0 + cSlabChunk - 1, max[0]);
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+          for(int a = a0; a <= a1; a++) {
+            for(int b = min[1]; b <= max[1]; b++) {
+              for(int c = min[2]; c <= max[2]; c++) {
+                float potential = 0.0F;
+                const float *v2 = F4Ptr(points, a, b, c, 0);
+                for (const auto j : MapEIter(*map, v2)) {
+                  const float *v1 = point + 3 * j;
+                  float dist2 = diffsq3f(v1, v2);
+                  if(dist2 > cut2)
+                    continue;
+                  float dist = (float) sqrt1f(dist2);
+                  if(dist > R_SMALL4) {
+                    if(shift) {
+                      if(dist < cutoff) {
+                        potential += (charge[j] / dist) *
+                          (_1 - (float) pow(dist, shift_power) / cutoff_to_power);
+                      }
+                    } else {
+                      potential += charge[j] / dist;
                     }
                   }
                 }
+                F3(data, a, b, c) = potential;
               }
             }
           }
         }
       }
-    } else {
-      float *v1;
+    } else if(mesh && oMap->Origin.size() == 3 && oMap->Grid.size() == 3) {
       PRINTFB(G, FB_Selector, FB_Details)
-        " %s: Evaluating Coulomb potential for grid (no cutoff)...\n", __func__
+        " %s: Evaluating Coulomb potential for grid (particle-mesh)...\n", __func__
         ENDFB(G);
 
+      int dims[3];
+      float origin[3];
+      for(a = 0; a < 3; a++) {
+        dims[a] = max[a] - min[a] + 1;
+        origin[a] = oMap->Origin[a] + min[a] * oMap->Grid[a];
+      }
+
+      std::vector<float> potential(size_t(dims[0]) * dims[1] * dims[2]);
+      pymol::coulomb_mesh_potential(point, charge, n_point, origin,
+          oMap->Grid.data(), dims, potential.data(), R_SMALL4);
+
+      const float *src = potential.data();
       for(a = min[0]; a <= max[0]; a++) {
-        OrthoBusyFast(G, a - min[0], max[0] - min[0] + 1);
         for(b = min[1]; b <= max[1]; b++) {
           for(c = min[2]; c <= max[2]; c++) {
-            F3(data, a, b, c) = 0.0F;
-            v1 = point;
-            v2 = F4Ptr(points, a, b, c, 0);
-            for(j = 0; j < n_point; j++) {
-              dist = (float) diff3f(v1, v2);
-              v1 += 3;
-              if(dist > R_SMALL4) {
-                F3(data, a, b, c) += charge[j] / dist;
+            F3(data, a, b, c) = *(src++);
+          }
+        }
+      }
+    } else {
+      PRINTFB(G, FB_Selector, FB_Details)
+        " %s: Evaluating Coulomb potential for grid (no cutoff)...\n", __func__
+        ENDFB(G);
+
+      /* structure of arrays for a vectorizable inner loop */
+      std::vector<float> px(n_point), py(n_point), pz(n_point);
+      for(j = 0; j < n_point; j++) {
+        px[j] = point[3 * j];
+        py[j] = point[3 * j + 1];
+        pz[j] = point[3 * j + 2];
+      }
+      const float *x = px.data(), *y = py.data(), *z = pz.data();
+      const float min_dist2 = R_SMALL4 * R_SMALL4;
+
+      for(int a0 = min[0]; a0 <= max[0]; a0 += cSlabChunk) {
+        OrthoBusyFast(G, a0 - min[0], max[0] - min[0] + 1);
+        const int a1 = std::min(a0 + cSlabChunk - 1, max[0]);
+#ifdef PYMOL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for(int a = a0; a <= a1; a++) {
+          for(int b = min[1]; b <= max[1]; b++) {
+            for(int c = min[2]; c <= max[2]; c++) {
+              const float *v2 = F4Ptr(points, a, b, c, 0);
+              const float v2x = v2[0], v2y = v2[1], v2z = v2[2];
+              float potential = 0.0F;
+#ifdef PYMOL_OPENMP
+#pragma omp simd reduction(+:potential)
+#endif
+              for(int k = 0; k < n_point; k++) {
+                float dx = x[k] - v2x;
+                float dy = y[k] - v2y;
+                float dz = z[k] - v2z;
+                float dist2 = dx * dx + dy * dy + dz * dz;
+                potential += (dist2 > min_dist2) ? charge[k] / sqrtf(dist2) : 0.0F;
               }
+              F3(data, a, b, c) = potential;
             }
           }
         }
@@ -6771,6 +6936,7 @@ _SelectorCreate(PyMOLGlobals * G, pymol::zstring_view sname, const char *sele,
                            int n_obj, const std::unordered_map<int, int>* id2tag, int executive_manage,
                            int state, SelectorID_t domain)
 {
+  PYMOL_PROFILE_SCOPE(G, "Selector", "SelectorCreate");
   sele_array_t atom{};
   std::string name;
   int c = 0;
@@ -7042,6 +7208,7 @@ int SelectorUpdateTable(PyMOLGlobals * G, int req_state, SelectorID_t domain)
 
 int SelectorUpdateTableImpl(PyMOLGlobals * G, CSelector *I, int req_state, SelectorID_t domain)
 {
+  PYMOL_PROFILE_SCOPE(G, "Selector", "SelectorUpdateTable");
   int a = 0;
   ov_size c = 0;
   int modelCnt;
@@ -7458,6 +7625,38 @@ static int SelectorModulate1(PyMOLGlobals * G, EvalElem * base, int state)
 }
 
 
+/*========================================================================*/
+/**
+ * Set `sele[a]` for all non-dummy atoms in the table from a predicate on the
+ * per-object hot columns. Table entries are grouped by object, so the columns
+ * are looked up once per object and the predicate only touches contiguous
+ * arrays.
+ *
+ * @param pred Callable with signature `bool(AtomInfoHotColumns const&, int atm)`
+ * @return Number of selected atoms
+ */
+template <typename Pred>
+static int SelectorSelectByHotColumns(CSelector* I, int* sele, Pred pred)
+{
+  int c = 0;
+  ObjectMolecule const* last_obj = nullptr;
+  AtomInfoHotColumns const* columns = nullptr;
+
+  for (size_t a = cNDummyAtoms; a < I->Table.size(); ++a) {
+    auto const& rec = I->Table[a];
+    auto const* obj = I->Obj[rec.model];
+    if (obj != last_obj) {
+      columns = &obj->getHotColumns();
+      last_obj = obj;
+    }
+    if ((sele[a] = pred(*columns, rec.atom))) {
+      ++c;
+    }
+  }
+
+  return c;
+}
+
 /*========================================================================*/
 static int SelectorSelect0(PyMOLGlobals * G, EvalElem * passed_base)
 {
@@ -7523,8 +7722,10 @@ static int SelectorSelect0(PyMOLGlobals * G, EvalElem * passed_base)
       base[0].sele[a] = I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].hetatm;
     break;
   case SELE_HYDz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] = I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].isHydrogen();
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return col.protons[atm] == cAN_H;
+        });
     break;
   case SELE_METz:
     for(a = cNDummyAtoms; a < I->Table.size(); a++) {
@@ -7553,34 +7754,40 @@ static int SelectorSelect0(PyMOLGlobals * G, EvalElem * passed_base)
     }
     break;
   case SELE_FXDz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_fix;
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_fix);
+        });
     break;
   case SELE_RSTz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_restrain;
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_restrain);
+        });
     break;
   case SELE_POLz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_polymer;
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_polymer);
+        });
     break;
   case SELE_PROz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_protein;
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_protein);
+        });
     break;
   case SELE_NUCz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_nucleic;
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_nucleic);
+        });
     break;
   case SELE_SOLz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_solvent;
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_solvent);
+        });
     break;
   case SELE_PTDz:
     for(a = cNDummyAtoms; a < I->Table.size(); a++)
@@ -7591,19 +7798,22 @@ static int SelectorSelect0(PyMOLGlobals * G, EvalElem * passed_base)
       base[0].sele[a] = I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].masked;
     break;
   case SELE_ORGz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_organic;
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_organic);
+        });
     break;
   case SELE_INOz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_inorganic;
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_inorganic);
+        });
     break;
   case SELE_GIDz:
-    for(a = cNDummyAtoms; a < I->Table.size(); a++)
-      base[0].sele[a] =
-        bool(I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & cAtomFlag_guide);
+    SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & cAtomFlag_guide);
+        });
     break;
 
   case SELE_PREz:
@@ -7972,24 +8182,17 @@ static pymol::Result<> SelectorSelect1(PyMOLGlobals * G, EvalElem * base, int qu
       if(WordMatchComma(G, base[1].text(), rep_names[a].word, ignore_case) < 0)
         rep_mask |= rep_names[a].value;
     }
-    for(SelectorAtomIterator iter(I); iter.next();) {
-      if(iter.getAtomInfo()->visRep & rep_mask) {
-        base[0].sele[iter.a] = true;
-        c++;
-      } else {
-        base[0].sele[iter.a] = false;
-      }
-    }
+    c = SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [rep_mask](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.visRep[atm] & rep_mask);
+        });
     break;
   case SELE_COLs:
     col_idx = ColorGetIndex(G, base[1].text());
-    for(a = cNDummyAtoms; a < I_NAtom; a++) {
-      base[0].sele[a] = false;
-      if(I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].color == col_idx) {
-        base[0].sele[a] = true;
-        c++;
-      }
-    }
+    c = SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [col_idx](AtomInfoHotColumns const& col, int atm) {
+          return col.color[atm] == col_idx;
+        });
     break;
   case SELE_CCLs:
   case SELE_RCLs:
@@ -8131,13 +8334,10 @@ static pymol::Result<> SelectorSelect1(PyMOLGlobals * G, EvalElem * base, int qu
   case SELE_FLGs:
     sscanf(base[1].text(), "%d", &flag);
     flag = (1 << flag);
-    for(a = cNDummyAtoms; a < I_NAtom; a++) {
-      if(I->Obj[I->Table[a].model]->AtomInfo[I->Table[a].atom].flags & flag) {
-        base[0].sele[a] = true;
-        c++;
-      } else
-        base[0].sele[a] = false;
-    }
+    c = SelectorSelectByHotColumns(I, base[0].sele_data(),
+        [flag](AtomInfoHotColumns const& col, int atm) {
+          return bool(col.flags[atm] & flag);
+        });
     break;
   case SELE_NTYs:
     {
@@ -9603,6 +9803,7 @@ pymol::Result<sele_array_t> SelectorEvaluate(PyMOLGlobals* G,
     std::vector<std::string>& word,
     int state, int quiet)
 {
+  PYMOL_PROFILE_SCOPE(G, "Selector", "SelectorEvaluate");
   int level = 0, imp_op_level = 0;
   int depth = 0;
   int a, b, c = 0;
@@ -17,7 +17,9 @@ Z* -------------------------------------------------------------------
 #ifndef _H_Selector
 #define _H_Selector
 
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include"os_python.h"
 
@@ -140,7 +142,8 @@ int SelectorMapMaskVDW(PyMOLGlobals * G, int sele1, ObjectMapState * oMap, float
                        int state);
 
 int SelectorMapCoulomb(PyMOLGlobals * G, int sele1, ObjectMapState * oMap, float cutoff,
-                       int state, int neutral, int shift, float shift_power);
+                       int state, int neutral, int shift, float shift_power,
+                       int mesh = false);
 
 int SelectorMapGaussian(PyMOLGlobals * G, int sele1, ObjectMapState * oMap,
                         float buffer, int state, int normalize, int use_max, int quiet,
@@ -162,6 +165,16 @@ void SelectorMemoryDump(PyMOLGlobals * G);
 int SelectorAssignSS(PyMOLGlobals * G, int target, int present, int state_value,
                      int preserve, ObjectMolecule * single_object, int quiet);
 
+/**
+ * Secondary structure assignment like SelectorAssignSS, but without modifying
+ * any atoms.
+ * @return One string per evaluated state, with one character per complete
+ * residue (N, CA, C, O) in `target`. Residues without coordinates in a state
+ * are reported as '-'.
+ */
+std::vector<std::string> SelectorGetSS(PyMOLGlobals* G, int target,
+    int present, int state_value, int quiet);
+
 int SelectorPurgeObjectMembers(PyMOLGlobals * G, ObjectMolecule * obj);
 void SelectorDefragment(PyMOLGlobals * G);
 
@@ -74,6 +74,7 @@ Z* -------------------------------------------------------------------
 #include"PlugIOManager.h"
 #include"ObjectAlignment.h"
 #include"Feedback.h"
+#include"Profiler.h"
 
 #include "MovieScene.h"
 #include "CifFile.h"
@@ -722,7 +723,7 @@ static PyObject * CmdGetVolumeField(PyObject * self, PyObject * args)
     API_HANDLE_ERROR;
   }
   if(ok && (ok = APIEnterBlockedNotModal(G))) {
-    CField * field = ExecutiveGetVolumeField(G, objName, state);
+    CField * field = ExecutiveGetVolumeField(G, objName, state, !copy);
     if (field) {
       result = FieldAsNumPyArray(field, copy);
     }
@@ -1521,6 +1522,33 @@ static PyObject * CmdMapGenerate(PyObject * self, PyObject * args)
   return APIAutoNone(Py_BuildValue("s", cResult));
 }
 
+static PyObject* CmdMapFromReflections(PyObject* self, PyObject* args)
+{
+  PyMOLGlobals* G = nullptr;
+  const char *name, *space_group;
+  PyObject *pyhkl, *pyamplitudes, *pyphases, *pyweights, *pycell;
+  int zoom, quiet;
+  API_SETUP_ARGS(G, self, args, "OsOOOOOsii", &self, &name, &pyhkl,
+      &pyamplitudes, &pyphases, &pyweights, &pycell, &space_group, &zoom,
+      &quiet);
+
+  std::vector<int> hkl;
+  std::vector<float> amplitudes, phases, weights, cell;
+  API_ASSERT(PConvFromPyObject(G, pyhkl, hkl));
+  API_ASSERT(PConvFromPyObject(G, pyamplitudes, amplitudes));
+  API_ASSERT(PConvFromPyObject(G, pyphases, phases));
+  API_ASSERT(PConvFromPyObject(G, pycell, cell) && cell.size() == 6);
+  if (pyweights != Py_None) {
+    API_ASSERT(PConvFromPyObject(G, pyweights, weights));
+  }
+
+  API_ASSERT(APIEnterNotModal(G));
+  auto result = ExecutiveMapFromReflections(G, name, hkl, amplitudes, phases,
+      weights, cell.data(), space_group, zoom, quiet);
+  APIExit(G);
+  return APIResult(G, result);
+}
+
 static PyObject *CmdMapNew(PyObject * self, PyObject * args)
 {
   PyMOLGlobals *G = nullptr;
@@ -2418,6 +2446,36 @@ static PyObject *CmdProtect(PyObject * self, PyObject * args)
   return APIResult(G, result);
 }
 
+static PyObject* CmdProfile(PyObject* self, PyObject* args)
+{
+  PyMOLGlobals* G = nullptr;
+  const char *action, *filename;
+  int quiet;
+  API_SETUP_ARGS(G, self, args, "Ossi", &self, &action, &filename, &quiet);
+  API_ASSERT(APIEnterNotModal(G));
+  auto result = ExecutiveProfile(G, action, filename, quiet);
+  APIExit(G);
+  return APIResult(G, result);
+}
+
+static PyObject* CmdGetProfile(PyObject* self, PyObject* args)
+{
+  PyMOLGlobals* G = nullptr;
+  API_SETUP_ARGS(G, self, args, "O", &self);
+  API_ASSERT(APIEnterNotModal(G));
+  auto nodes = G->Profiler->summary();
+  APIExit(G);
+
+  PyObject* result = PyList_New(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const auto& node = nodes[i];
+    PyList_SET_ITEM(result, i,
+        Py_BuildValue("(ssidd)", node.path.c_str(), node.category, node.count,
+            node.total, node.self));
+  }
+  return result;
+}
+
 static PyObject *CmdButton(PyObject * self, PyObject * args)
 {
   PyMOLGlobals *G = nullptr;
@@ -3901,6 +3959,45 @@ static PyObject *CmdGetStr(PyObject * self, PyObject * args)
   return APIAutoNone(result);
 }
 
+static PyObject *CmdSaveMolecules(PyObject * self, PyObject * args)
+{
+  PyMOLGlobals *G = nullptr;
+  const char *filename;
+  const char *format;
+  const char *sele;
+  int state;
+  const char *ref;
+  int ref_state;
+  int multi;
+  int append;
+
+  API_SETUP_ARGS(G, self, args, "Osssisiii", &self, &filename, &format, &sele,
+      &state, &ref, &ref_state, &multi, &append);
+  API_ASSERT(APIEnterNotModal(G));
+  auto result = MoleculeExporterSaveFile(G, filename, format, sele, state,
+      ref, ref_state, multi, append);
+  APIExit(G);
+  return APIResult(G, result);
+}
+
+static PyObject *CmdSaveTraj(PyObject * self, PyObject * args)
+{
+  PyMOLGlobals *G = nullptr;
+  const char *filename;
+  const char *sele;
+  int state;
+  const char *plugin_type;
+  int quiet;
+
+  API_SETUP_ARGS(G, self, args, "Ossisi", &self, &filename, &sele, &state,
+      &plugin_type, &quiet);
+  API_ASSERT(APIEnterNotModal(G));
+  auto result =
+      PlugIOManagerSaveTraj(G, filename, sele, state, quiet, plugin_type);
+  APIExit(G);
+  return APIResult(G, result);
+}
+
 static PyObject *CmdGetModel(PyObject * self, PyObject * args)
 {
   PyMOLGlobals *G = nullptr;
@@ -4440,6 +4537,39 @@ static PyObject *CmdSetMatrix(PyObject * self, PyObject * args)
 }
 #endif
 
+static PyObject *CmdGetMapValues(PyObject * self, PyObject * args)
+{
+  PyMOLGlobals *G = nullptr;
+  const char* name;
+  Py_buffer points;
+  int state;
+  float outside;
+  API_SETUP_ARGS(G, self, args, "Osy*if", &self, &name, &points, &state,
+      &outside);
+
+  const size_t n = points.len / (3 * sizeof(float));
+  if (points.len != Py_ssize_t(n * 3 * sizeof(float))) {
+    PyBuffer_Release(&points);
+    return APIFailure(G, "points must be float32 with shape (N, 3)");
+  }
+
+  APIEnterBlocked(G);
+  auto result = ExecutiveGetMapValues(
+      G, name, state, static_cast<const float*>(points.buf), n, outside);
+  APIExitBlocked(G);
+  PyBuffer_Release(&points);
+
+  if (!result) {
+    return APIFailure(G, result.error());
+  }
+
+  // raw float32 buffer, wrapped without copy by numpy.frombuffer
+  const auto& values = result.result();
+  return PyByteArray_FromStringAndSize(
+      reinterpret_cast<const char*>(values.data()),
+      values.size() * sizeof(float));
+}
+
 static PyObject *CmdGetMinMax(PyObject * self, PyObject * args)
 {
   PyMOLGlobals *G = nullptr;
@@ -4749,7 +4879,9 @@ static PyObject *CmdPNG(PyObject * self, PyObject * args)
 
     if(!prior) {
       if(ray || (!G->HaveGUI && (!SceneGetCopyType(G) || width || height))) {
-        prior = SceneRay(G, width, height, SettingGetGlobal_i(G, cSetting_ray_default_renderer),
+        int mode = (ray == 2) ? cSceneRay_MODE_RASTER
+                              : SettingGetGlobal_i(G, cSetting_ray_default_renderer);
+        prior = SceneRay(G, width, height, mode,
                  nullptr, nullptr, 0.0F, 0.0F, quiet, nullptr, true, -1);
       } else if(width || height) {
         Extent2D extent{static_cast<std::uint32_t>(width),
@@ -5514,6 +5646,22 @@ static PyObject *CmdLoad(PyObject * self, PyObject * args)
   return APIResult(G, result);
 }
 
+static PyObject *CmdLoadMapRegion(PyObject * self, PyObject * args)
+{
+  PyMOLGlobals *G = nullptr;
+  const char *fname, *oname, *sele;
+  float buffer;
+  int state, type, sele_state, quiet;
+  API_SETUP_ARGS(G, self, args, "Ossisfiii", &self, &oname, &fname, &type,
+      &sele, &buffer, &state, &sele_state, &quiet);
+  API_ASSERT(APIEnterNotModal(G));
+  auto result = ExecutiveLoadMapRegion(G, fname, cLoadType_t(type), oname,
+      sele, buffer, state, sele_state, quiet);
+  OrthoRestorePrompt(G);
+  APIExit(G);
+  return APIResult(G, result);
+}
+
 static PyObject *CmdLoadTraj(PyObject * self, PyObject * args)
 {
   PyMOLGlobals *G = nullptr;
@@ -5575,6 +5723,18 @@ static PyObject *CmdAssignSS(PyObject * self, PyObject * args)
   return APIResult(G, result);
 }
 
+static PyObject* CmdGetSS(PyObject* self, PyObject* args)
+{
+  PyMOLGlobals* G = nullptr;
+  int state, quiet;
+  const char *str1, *str2;
+  API_SETUP_ARGS(G, self, args, "Osisi", &self, &str1, &state, &str2, &quiet);
+  API_ASSERT(APIEnterNotModal(G));
+  auto result = ExecutiveGetSS(G, str1, state, str2, quiet);
+  APIExit(G);
+  return APIResult(G, result);
+}
+
 static PyObject *CmdSpheroid(PyObject * self, PyObject * args)
 
 
@@ -6334,6 +6494,7 @@ static PyMethodDef Cmd_methods[] = {
   {"get_coordset", CmdGetCoordSetAsNumPy, METH_VARARGS},
   {"get_distance", CmdGetDistance, METH_VARARGS},
   {"get_dihe", CmdGetDihe, METH_VARARGS},
+  {"get_dss", CmdGetSS, METH_VARARGS},
   {"get_drag_object_name", CmdGetDragObjectName, METH_VARARGS},
   {"get_editor_scheme", CmdGetEditorScheme, METH_VARARGS},
   {"get_frame", CmdGetFrame, METH_VARARGS},
@@ -6341,6 +6502,7 @@ static PyMethodDef Cmd_methods[] = {
   {"get_idtf", CmdGetIdtf, METH_VARARGS},
   {"get_legal_name", CmdGetLegalName, METH_VARARGS},
   {"get_m2io_first_block_properties", CmdM2ioFirstBlockProperties, METH_VARARGS},
+  {"get_map_values", CmdGetMapValues, METH_VARARGS},
 //  {"get_matrix", CmdGetMatrix, METH_VARARGS},
   {"get_min_max", CmdGetMinMax, METH_VARARGS},
   {"get_mtl_obj", CmdGetMtlObj, METH_VARARGS},
@@ -6358,6 +6520,7 @@ static PyMethodDef Cmd_methods[] = {
   {"get_object_settings", CmdGetObjectSettings, METH_VARARGS},
   {"get_origin", CmdGetOrigin, METH_VARARGS},
   {"get_position", CmdGetPosition, METH_VARARGS},
+  {"get_profile", CmdGetProfile, METH_VARARGS},
   {"get_povray", CmdGetPovRay, METH_VARARGS},
   {"get_progress", CmdGetProgress, METH_VARARGS},
   {"get_phipsi", CmdGetPhiPsi, METH_VARARGS},
@@ -6410,10 +6573,12 @@ static PyMethodDef Cmd_methods[] = {
   {"load_color_table", CmdLoadColorTable, METH_VARARGS},
   {"load_coords", CmdLoadCoords, METH_VARARGS},
   {"load_coordset", CmdLoadCoordSet, METH_VARARGS},
+  {"load_map_region", CmdLoadMapRegion, METH_VARARGS},
   {"load_png", CmdLoadPNG, METH_VARARGS},
   {"load_object", CmdLoadObject, METH_VARARGS},
   {"load_traj", CmdLoadTraj, METH_VARARGS},
   {"look_at", CmdLookAt, METH_VARARGS},
+  {"map_from_reflections", CmdMapFromReflections, METH_VARARGS},
   {"map_generate", CmdMapGenerate, METH_VARARGS},
   {"map_new", CmdMapNew, METH_VARARGS},
   {"map_double", CmdMapDouble, METH_VARARGS},
@@ -6442,11 +6607,14 @@ static PyMethodDef Cmd_methods[] = {
   {"onoff", CmdOnOff, METH_VARARGS},
   {"onoff_by_sele", CmdOnOffBySele, METH_VARARGS},
   {"order", CmdOrder, METH_VARARGS},
+  {"save_molecules", CmdSaveMolecules, METH_VARARGS},
+  {"save_traj", CmdSaveTraj, METH_VARARGS},
   {"scrollto", CmdScrollTo, METH_VARARGS},
   {"overlap", CmdOverlap, METH_VARARGS},
   {"paste", CmdPaste, METH_VARARGS},
   {"png", CmdPNG, METH_VARARGS},
   {"pop", CmdPop, METH_VARARGS},
+  {"profile", CmdProfile, METH_VARARGS},
   {"protect", CmdProtect, METH_VARARGS},
   {"pseudoatom", CmdPseudoatom, METH_VARARGS},
 #if 1
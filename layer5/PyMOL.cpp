@@ -66,6 +66,9 @@
 #include "ButMode.h"
 #include "CGORenderer.h"
 #include "GFXManager.h"
+#include "MyPNG.h"
+#include "Profiler.h"
+#include "Util2.h"
 
 #ifdef _PYMOL_OPENVR
 #include "OpenVRMode.h"
@@ -81,7 +84,12 @@
 #include "ShaderMgr.h"
 #include "Version.h"
 
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _PYMOL_NOPY
 PyMOLGlobals *SingletonPyMOLGlobals = nullptr;
@@ -1932,6 +1940,7 @@ void PyMOL_Start(CPyMOL * I)
 #include "lex_constants.h"
 
   G->Feedback = new CFeedback(G, G->Option->quiet);
+  G->Profiler = new pymol::Profiler();
   WordInit(G);
   UtilInit(G);
   ColorInit(G);
@@ -1963,7 +1972,6 @@ void PyMOL_Start(CPyMOL * I)
   SculptCacheInit(G);
   VFontInit(G);
   ExecutiveInit(G);
-  IsosurfInit(G);
   TetsurfInit(G);
   EditorInit(G);
 #ifdef TRACKER_UNIT_TEST
@@ -2013,7 +2021,6 @@ void PyMOL_Stop(CPyMOL * I)
   PyMOLGlobals *G = I->G;
   G->Terminating = true;
   TetsurfFree(G);
-  IsosurfFree(G);
   WizardFree(G);
 #ifdef SYM_TO_MAT_LIST_IN_C
   SymmetryFree(G);
@@ -2050,6 +2057,7 @@ void PyMOL_Stop(CPyMOL * I)
   ColorFree(G);
   UtilFree(G);
   WordFree(G);
+  DeleteP(G->Profiler);
   DeleteP(G->Feedback);
 
   PyMOL_PurgeAPI(I);
@@ -2080,6 +2088,249 @@ void PyMOL_Free(CPyMOL * I)
 #endif
 }
 
+/*
+ * Batch thumbnail rendering
+ *
+ * Worker 0 is the client's instance. Builds without Python can start
+ * additional private instances, each with its own globals, so that jobs
+ * render concurrently. With Python, all instances share the interpreter
+ * and the API lock, so jobs are rendered one after the other.
+ *
+ * Concurrent workers rely on render state (ray tracing timings, the last
+ * ray traced volume image, the OpenVR field of view) living in each
+ * instance's CScene rather than in function statics. New mutable statics
+ * on the load and render paths would break this.
+ */
+struct CPyMOLBatch {
+  CPyMOL* client = nullptr;
+  std::vector<CPyMOL*> workers;
+};
+
+CPyMOLBatch *PyMOLBatch_New(CPyMOL * I, int n_workers)
+{
+  PyMOLGlobals* G = I->G;
+  auto B = new CPyMOLBatch();
+  B->client = I;
+  B->workers.push_back(I);
+
+#ifdef _PYMOL_NOPY
+  for (int a = 1; a < n_workers; ++a) {
+    CPyMOL* W = PyMOL_NewWithOptions(G->Option);
+    W->G->Option->quiet = true;
+    PyMOL_Start(W);
+    B->workers.push_back(W);
+  }
+#else
+  if (n_workers > 1) {
+    PRINTFB(G, FB_Executive, FB_Blather)
+      " PyMOLBatch: concurrent workers need a build without Python, using 1.\n"
+      ENDFB(G);
+  }
+#endif
+
+  return B;
+}
+
+void PyMOLBatch_Free(CPyMOLBatch * B)
+{
+  if (!B)
+    return;
+  for (size_t a = 1; a < B->workers.size(); ++a) {
+    PyMOL_Stop(B->workers[a]);
+    PyMOL_Free(B->workers[a]);
+  }
+  delete B;
+}
+
+/**
+ * Compression suffixes which may follow the format extension, e.g.
+ * "1abc.pdb.gz". The C API does not decompress, see BatchRenderJob.
+ */
+static const char* const BatchCompressionSuffixes[] = {
+    ".gz", ".bz2", ".xz", ".zip", ".z"};
+
+/**
+ * Length of the file name without a trailing compression suffix
+ */
+static size_t BatchUncompressedLength(const char* filename)
+{
+  std::string lower(filename);
+  for (auto& c : lower)
+    c = tolower(c);
+  for (auto suffix : BatchCompressionSuffixes) {
+    size_t n = strlen(suffix);
+    if (lower.size() > n && lower.compare(lower.size() - n, n, suffix) == 0)
+      return lower.size() - n;
+  }
+  return lower.size();
+}
+
+/**
+ * File format for `PyMOL_CmdLoad` from the file name extension, ignoring
+ * a trailing compression suffix
+ */
+static std::string BatchFormatFromFilename(const char* filename)
+{
+  std::string name(filename, BatchUncompressedLength(filename));
+  auto dot = name.find_last_of("./\\");
+  if (dot == std::string::npos || name[dot] != '.')
+    return "pdb";
+  std::string ext = name.substr(dot + 1);
+  for (auto& c : ext)
+    c = tolower(c);
+  if (ext == "ent")
+    return "pdb";
+  if (ext == "mmcif")
+    return "cif";
+  if (ext == "mdl")
+    return "mol";
+  return ext;
+}
+
+static std::string BatchTrim(const std::string& s)
+{
+  auto first = s.find_first_not_of(" \t\r");
+  if (first == std::string::npos)
+    return "";
+  auto last = s.find_last_not_of(" \t\r");
+  return s.substr(first, last - first + 1);
+}
+
+/**
+ * Runs one style script command. Only the subset of commands which map
+ * onto the C API is available: set, show, hide, as, color, bg_color,
+ * orient, zoom and turn.
+ */
+static bool BatchRunCommand(CPyMOL* I, const std::string& line, int quiet)
+{
+  auto split = line.find_first_of(" \t");
+  std::string name = line.substr(0, split);
+  std::vector<std::string> args;
+  if (split != std::string::npos) {
+    for (auto& arg : strsplit(line.substr(split + 1), ','))
+      args.push_back(BatchTrim(arg));
+  }
+
+  auto arg = [&args](size_t i, const char* def) {
+    return (i < args.size() && !args[i].empty()) ? args[i].c_str() : def;
+  };
+
+  PyMOLreturn_status result = { PyMOLstatus_FAILURE };
+
+  if (name == "set" && args.size() >= 2) {
+    result = PyMOL_CmdSet(I, args[0].c_str(), args[1].c_str(),
+        arg(2, "all"), 0, quiet, true);
+  } else if (name == "show") {
+    result = PyMOL_CmdShow(I, arg(0, "lines"), arg(1, "all"), quiet);
+  } else if (name == "hide") {
+    result = PyMOL_CmdHide(I, arg(0, "everything"), arg(1, "all"), quiet);
+  } else if (name == "as" && !args.empty()) {
+    result = PyMOL_CmdHide(I, "everything", arg(1, "all"), quiet);
+    if (result.status == PyMOLstatus_SUCCESS)
+      result = PyMOL_CmdShow(I, arg(0, "lines"), arg(1, "all"), quiet);
+  } else if (name == "color" && !args.empty()) {
+    result = PyMOL_CmdColor(I, arg(0, "white"), arg(1, "all"), 0, quiet);
+  } else if (name == "bg_color") {
+    result = PyMOL_CmdBackgroundColor(I, arg(0, "black"));
+  } else if (name == "orient") {
+    result = PyMOL_CmdOrient(I, arg(0, "all"), 0.0F, 0, 0, 0.0F, quiet);
+  } else if (name == "zoom") {
+    result = PyMOL_CmdZoom(I, arg(0, "all"), 0.0F, 0, 0, 0.0F, quiet);
+  } else if (name == "turn" && args.size() >= 2) {
+    result = PyMOL_CmdTurn(I, args[0][0], atof(args[1].c_str()));
+  }
+
+  if (result.status != PyMOLstatus_SUCCESS) {
+    PyMOLGlobals* G = I->G;
+    PRINTFB(G, FB_Executive, FB_Errors)
+      " PyMOLBatch-Error: failed or unsupported command '%s'\n", line.c_str()
+      ENDFB(G);
+    return false;
+  }
+  return true;
+}
+
+static PyMOLreturn_status BatchWritePNG(CPyMOL* I, const char* filename, int quiet)
+{
+  int ok = false;
+  PYMOL_API_LOCK
+  ok = ScenePNG(I->G, filename, -1.0F, quiet, true, cMyPNG_FormatPNG);
+  PYMOL_API_UNLOCK return return_status_ok(ok);
+}
+
+static PyMOLstatus BatchRenderJob(CPyMOL* I, const PyMOLBatchJob& job, int quiet)
+{
+  // cheap reset: drops objects and restores settings, colors and view,
+  // while keeping everything PyMOL_Start initialized
+  if (PyMOL_CmdReinitialize(I, "everything", "").status != PyMOLstatus_SUCCESS)
+    return PyMOLstatus_FAILURE;
+
+  if (BatchUncompressedLength(job.filename) != strlen(job.filename)) {
+    PyMOLGlobals* G = I->G;
+    PRINTFB(G, FB_Executive, FB_Errors)
+      " PyMOLBatch-Error: compressed file '%s' not supported, please"
+      " decompress it first\n", job.filename ENDFB(G);
+    return PyMOLstatus_FAILURE;
+  }
+
+  auto format = BatchFormatFromFilename(job.filename);
+  if (PyMOL_CmdLoad(I, job.filename, "filename", format.c_str(), "", 0, 0, 1,
+          quiet, 0, -1).status != PyMOLstatus_SUCCESS)
+    return PyMOLstatus_FAILURE;
+
+  if (job.script) {
+    for (auto& line : strsplit(job.script, '\n')) {
+      for (auto& cmd : strsplit(line, ';')) {
+        auto stripped = BatchTrim(cmd);
+        if (stripped.empty() || stripped[0] == '#')
+          continue;
+        if (!BatchRunCommand(I, stripped, quiet))
+          return PyMOLstatus_FAILURE;
+      }
+    }
+  }
+
+  if (PyMOL_CmdRay(I, job.width, job.height, PYMOL_DEFAULT, 0.0F, 0.0F,
+          job.renderer, 0, quiet).status != PyMOLstatus_SUCCESS)
+    return PyMOLstatus_FAILURE;
+
+  return BatchWritePNG(I, job.output, quiet).status;
+}
+
+/**
+ * Renders all jobs, distributing them over the batch workers. Each job's
+ * `status` field receives its own result; the returned status is
+ * PyMOLstatus_FAILURE if any job failed.
+ */
+PyMOLreturn_status PyMOLBatch_Render(CPyMOLBatch * B, PyMOLBatchJob * jobs, int n_jobs,
+                                     int quiet)
+{
+  std::atomic<int> next_job(0);
+
+  auto worker = [&](CPyMOL* W) {
+    for (int j; (j = next_job++) < n_jobs;) {
+      jobs[j].status = BatchRenderJob(W, jobs[j], quiet);
+    }
+  };
+
+  size_t n_threads = std::min<size_t>(B->workers.size(), std::max(n_jobs, 1));
+  if (n_threads > 1) {
+    std::vector<std::thread> threads;
+    for (size_t a = 1; a < n_threads; ++a)
+      threads.emplace_back(worker, B->workers[a]);
+    worker(B->workers[0]);
+    for (auto& t : threads)
+      t.join();
+  } else {
+    worker(B->workers[0]);
+  }
+
+  bool ok = true;
+  for (int j = 0; j < n_jobs; ++j)
+    ok = ok && jobs[j].status == PyMOLstatus_SUCCESS;
+  return return_status_ok(ok);
+}
+
 struct PyMOLGlobals* PyMOL_GetGlobals(CPyMOL * I)
 {
   return I->G;
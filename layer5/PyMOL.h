@@ -560,6 +560,30 @@ PyMOLreturn_status PyMOL_CmdMapNew(CPyMOL * I, const char *name, int type, float
 				   const char *selection, int state, int normalize,
 				   int zoom, int quiet);
 
+/* batch thumbnail rendering: a long-lived service that renders a queue of
+   (structure file, style script, image size) jobs to PNG files, resetting
+   the scene between jobs instead of restarting PyMOL */
+
+typedef struct {
+  const char *filename;         /* structure file, format taken from the extension */
+  const char *script;           /* style commands, newline or ';' separated, may be NULL */
+  const char *output;           /* PNG file name */
+  int width, height;
+  int renderer;                 /* PYMOL_DEFAULT, 0 (ray tracer) or 9 (rasterizer) */
+  PyMOLstatus status;           /* set by PyMOLBatch_Render */
+} PyMOLBatchJob;
+
+struct CPyMOLBatch;
+
+/* n_workers > 1 starts additional private instances which render jobs
+   concurrently (only available in builds without Python). Each job is
+   loaded, styled and rendered entirely within one instance. Compressed
+   structure files (.gz, .bz2, ...) are not supported and fail their job. */
+CPyMOLBatch *PyMOLBatch_New(CPyMOL * I, int n_workers);
+PyMOLreturn_status PyMOLBatch_Render(CPyMOLBatch * B, PyMOLBatchJob * jobs, int n_jobs,
+                                     int quiet);
+void PyMOLBatch_Free(CPyMOLBatch * B);
+
 #ifdef _PYMOL_LIB
 PyMOLreturn_string_array PyMOL_GetObjectList(CPyMOL * I, const char *s0);
 PyMOLreturn_status PyMOL_SetIsEnabledCallback(CPyMOL * I, void *CallbackObject, void (*enabledCallback)(void *, const char *, int ));
@@ -54,6 +54,11 @@ PyMOLGlobals* PyMOLInstance::G() noexcept
   return m_G;
 }
 
+CPyMOL* PyMOLInstance::Inst() noexcept
+{
+  return m_Inst;
+}
+
 namespace test {
 
 TmpFILE::TmpFILE()
@@ -32,6 +32,11 @@ public:
    * @return PyMOLGlobals pointer
    */
   PyMOLGlobals* G() noexcept;
+
+  /**
+   * @return C API instance pointer
+   */
+  CPyMOL* Inst() noexcept;
 private:
   CPyMOL* m_Inst;
   PyMOLGlobals* m_G;
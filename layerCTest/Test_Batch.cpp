@@ -0,0 +1,71 @@
+#include "Test.h"
+
+#include <fstream>
+
+#include "PyMOL.h"
+
+using namespace pymol;
+
+static const char* batch_pdb =
+    "ATOM      1  N   GLY A   1       0.000   0.000   0.000  1.00  0.00           N\n"
+    "ATOM      2  CA  GLY A   1       1.450   0.000   0.000  1.00  0.00           C\n"
+    "ATOM      3  C   GLY A   1       2.000   1.420   0.000  1.00  0.00           C\n"
+    "ATOM      4  O   GLY A   1       1.250   2.390   0.000  1.00  0.00           O\n"
+    "END\n";
+
+static bool isPNGFile(const char* filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  char magic[4] = {};
+  in.read(magic, 4);
+  return in && std::memcmp(magic, "\x89PNG", 4) == 0;
+}
+
+TEST_CASE("PyMOLBatch round trip", "[PyMOLBatch]")
+{
+  PyMOLInstance pymol;
+  test::TmpFILE pdb, png1, png2;
+  std::ofstream(pdb.getFilename()) << batch_pdb;
+
+  PyMOLBatchJob jobs[] = {
+      {pdb.getFilename(), "as spheres; color red; orient", png1.getFilename(),
+          40, 30, 0, PyMOLstatus_FAILURE},
+      {pdb.getFilename(), nullptr, png2.getFilename(), 20, 20, 0,
+          PyMOLstatus_FAILURE},
+  };
+
+  auto B = PyMOLBatch_New(pymol.Inst(), 2);
+  REQUIRE(B != nullptr);
+  auto result = PyMOLBatch_Render(B, jobs, 2, true);
+  PyMOLBatch_Free(B);
+
+  REQUIRE(result.status == PyMOLstatus_SUCCESS);
+  REQUIRE(jobs[0].status == PyMOLstatus_SUCCESS);
+  REQUIRE(jobs[1].status == PyMOLstatus_SUCCESS);
+  REQUIRE(isPNGFile(png1.getFilename()));
+  REQUIRE(isPNGFile(png2.getFilename()));
+}
+
+TEST_CASE("PyMOLBatch failing jobs", "[PyMOLBatch]")
+{
+  PyMOLInstance pymol;
+  test::TmpFILE pdb, png;
+  std::ofstream(pdb.getFilename()) << batch_pdb;
+
+  PyMOLBatchJob jobs[] = {
+      // compressed input is not supported
+      {"missing.pdb.gz", nullptr, png.getFilename(), 20, 20, 0,
+          PyMOLstatus_SUCCESS},
+      // unsupported style command
+      {pdb.getFilename(), "no_such_command", png.getFilename(), 20, 20, 0,
+          PyMOLstatus_SUCCESS},
+  };
+
+  auto B = PyMOLBatch_New(pymol.Inst(), 1);
+  auto result = PyMOLBatch_Render(B, jobs, 2, true);
+  PyMOLBatch_Free(B);
+
+  REQUIRE(result.status == PyMOLstatus_FAILURE);
+  REQUIRE(jobs[0].status == PyMOLstatus_FAILURE);
+  REQUIRE(jobs[1].status == PyMOLstatus_FAILURE);
+}
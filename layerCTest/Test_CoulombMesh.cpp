@@ -0,0 +1,74 @@
+#include "Test.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "CoulombMesh.h"
+
+TEST_CASE("Particle-mesh Coulomb matches direct sum", "[CoulombMesh]")
+{
+  std::mt19937 mt(7);
+  std::uniform_real_distribution<float> pos(-2.f, 14.f);
+  std::uniform_real_distribution<float> chg(-1.f, 1.f);
+
+  const size_t n = 60;
+  std::vector<float> coords(3 * n), charges(n);
+  for (size_t i = 0; i < n; ++i) {
+    for (int d = 0; d < 3; ++d)
+      coords[3 * i + d] = pos(mt);
+    charges[i] = chg(mt);
+  }
+
+  const float origin[3] = {0.f, 1.f, -0.5f};
+  const float spacing[3] = {0.5f, 0.6f, 0.5f};
+  const int dims[3] = {24, 19, 25};
+  const size_t n_out = size_t(dims[0]) * dims[1] * dims[2];
+
+  std::vector<float> mesh(n_out);
+  pymol::coulomb_mesh_potential(coords.data(), charges.data(), n, origin,
+      spacing, dims, mesh.data(), 0.f);
+
+  double err2 = 0, ref2 = 0;
+  for (int a = 0; a < dims[0]; ++a) {
+    for (int b = 0; b < dims[1]; ++b) {
+      for (int c = 0; c < dims[2]; ++c) {
+        const float p[3] = {origin[0] + a * spacing[0],
+            origin[1] + b * spacing[1], origin[2] + c * spacing[2]};
+        double ref = 0;
+        for (size_t i = 0; i < n; ++i) {
+          double dx = p[0] - coords[3 * i];
+          double dy = p[1] - coords[3 * i + 1];
+          double dz = p[2] - coords[3 * i + 2];
+          ref += charges[i] / std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+        double diff = mesh[(size_t(a) * dims[1] + b) * dims[2] + c] - ref;
+        err2 += diff * diff;
+        ref2 += ref * ref;
+      }
+    }
+  }
+
+  REQUIRE(std::sqrt(err2 / ref2) < 0.02);
+}
+
+TEST_CASE("Particle-mesh Coulomb single charge", "[CoulombMesh]")
+{
+  const float coord[3] = {3.3f, 2.1f, 4.7f};
+  const float charge = 2.f;
+  const float origin[3] = {0.f, 0.f, 0.f};
+  const float spacing[3] = {1.f, 1.f, 1.f};
+  const int dims[3] = {10, 10, 10};
+
+  std::vector<float> mesh(1000);
+  pymol::coulomb_mesh_potential(
+      coord, &charge, 1, origin, spacing, dims, mesh.data());
+
+  // far field is dominated by the smooth part
+  const float r = std::sqrt(3.3f * 3.3f + 2.1f * 2.1f + 4.7f * 4.7f);
+  REQUIRE(mesh[0] == Approx(charge / r).epsilon(0.01));
+
+  const float dx = 9 - 3.3f, dy = 9 - 2.1f, dz = 9 - 4.7f;
+  REQUIRE(mesh[999] ==
+          Approx(charge / std::sqrt(dx * dx + dy * dy + dz * dz)).epsilon(0.01));
+}
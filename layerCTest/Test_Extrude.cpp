@@ -0,0 +1,167 @@
+#include "Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "CGO.h"
+#include "Extrude.h"
+#include "Vector.h"
+
+using namespace pymol;
+
+/**
+ * Tube along a helical path with per-point colors, alphas and atom indices
+ */
+static CExtrude* makeHelixTube(PyMOLGlobals* G, int n, int quality)
+{
+  auto I = ExtrudeNew(G);
+  REQUIRE(ExtrudeAllocPointsNormalsColors(I, n));
+
+  for (int a = 0; a < n; ++a) {
+    float* p = I->p + 3 * a;
+    p[0] = 2.3f * std::cos(a * 0.4f);
+    p[1] = 2.3f * std::sin(a * 0.4f);
+    p[2] = 0.6f * a;
+
+    float* c = I->c + 3 * a;
+    c[0] = a / float(n);
+    c[1] = 1.f - a / float(n);
+    c[2] = 0.5f;
+
+    I->alpha[a] = 1.f - 0.01f * a;
+    I->i[a] = 100 + a;
+  }
+
+  REQUIRE(ExtrudeComputeTangents(I));
+  REQUIRE(ExtrudeCircle(I, quality, 0.5f));
+  ExtrudeBuildNormals1f(I);
+
+  return I;
+}
+
+/**
+ * The body of ExtrudeCGOSurfaceTube (without caps) as it was before the
+ * strips were written as draw arrays: one BEGIN/END block per strip with
+ * color, alpha, pick color, normal and vertex ops for every point.
+ */
+static void referenceSurfaceTube(const CExtrude* I, CGO* cgo,
+    const float* color_override, int dash)
+{
+  int const N = I->N;
+  std::vector<float> TV(3 * (I->Ns + 1) * N), TN(TV.size());
+
+  for (int b = 0; b <= I->Ns; ++b) {
+    int const s = (b == I->Ns) ? 0 : b;
+    for (int a = 0; a < N; ++a) {
+      float* tv = TV.data() + 3 * (a + b * N);
+      float* tn = TN.data() + 3 * (a + b * N);
+      transform33Tf3f(I->n + 9 * a, I->sv + 3 * s, tv);
+      add3f(I->p + 3 * a, tv, tv);
+      transform33Tf3f(I->n + 9 * a, I->sn + 3 * s, tn);
+    }
+  }
+
+  int const start = I->Ns / 4;
+  int const stop = 3 * I->Ns / 4;
+
+  for (int a_start = 0, a_incr = (dash ? dash : N); a_start < N - 1;
+       a_start += a_incr) {
+    int const a_end = std::min(a_start + a_incr, N);
+
+    for (int b = 0; b < I->Ns; ++b) {
+      CGOBegin(cgo, GL_TRIANGLE_STRIP);
+      for (int a = a_start; a < a_end; ++a) {
+        const float* tv = TV.data() + 3 * (a + b * N);
+        const float* tn = TN.data() + 3 * (a + b * N);
+        if (color_override && b > start && b < stop)
+          CGOColorv(cgo, color_override);
+        else
+          CGOColorv(cgo, I->c + 3 * a);
+        CGOAlpha(cgo, I->alpha[a]);
+        CGOPickColor(cgo, I->i[a], cPickableAtom);
+        CGONormalv(cgo, tn);
+        CGOVertexv(cgo, tv);
+        CGONormalv(cgo, tn + 3 * N);
+        CGOVertexv(cgo, tv + 3 * N);
+      }
+      CGOEnd(cgo);
+      CGOPickColor(cgo, -1, cPickableNoPick);
+    }
+  }
+}
+
+static std::vector<const cgo::draw::arrays*> getDrawArrays(const CGO* cgo)
+{
+  std::vector<const cgo::draw::arrays*> ops;
+  for (auto it = cgo->begin(); !it.is_stop(); ++it) {
+    if (it.op_code() == CGO_DRAW_ARRAYS)
+      ops.push_back(it.cast<cgo::draw::arrays>());
+  }
+  return ops;
+}
+
+static void requireSameDrawArrays(const CGO* actual, const CGO* expected)
+{
+  auto const ops1 = getDrawArrays(actual);
+  auto const ops2 = getDrawArrays(expected);
+  REQUIRE(!ops2.empty());
+  REQUIRE(ops1.size() == ops2.size());
+
+  for (size_t k = 0; k < ops1.size(); ++k) {
+    auto const op1 = ops1[k];
+    auto const op2 = ops2[k];
+    REQUIRE(op1->mode == op2->mode);
+    REQUIRE(op1->arraybits == op2->arraybits);
+    REQUIRE(op1->nverts == op2->nverts);
+
+    int const nverts = op1->nverts;
+    auto const d1 = CGODrawArraysGetData(
+        const_cast<float*>(op1->get_data()), op1->arraybits, nverts);
+    auto const d2 = CGODrawArraysGetData(
+        const_cast<float*>(op2->get_data()), op2->arraybits, nverts);
+
+    for (int j = 0; j < 3 * nverts; ++j) {
+      REQUIRE(d1.vertex[j] == Approx(d2.vertex[j]).margin(1e-5));
+      REQUIRE(d1.normal[j] == Approx(d2.normal[j]).margin(1e-5));
+    }
+
+    REQUIRE(test::isArrayEqual(d1.color, d2.color, 4 * nverts));
+
+    for (int j = 0; j < nverts; ++j) {
+      REQUIRE(CGO_get_uint(d1.pick_color + 2 * j) ==
+              CGO_get_uint(d2.pick_color + 2 * j));
+      REQUIRE(CGO_get_int(d1.pick_color + 2 * j + 1) ==
+              CGO_get_int(d2.pick_color + 2 * j + 1));
+    }
+  }
+}
+
+TEST_CASE("ExtrudeCGOSurfaceTube matches BEGIN/END strips", "[Extrude]")
+{
+  PyMOLInstance pymol;
+  auto G = pymol.G();
+  auto I = makeHelixTube(G, 37, 12);
+
+  const float red[] = {1.f, 0.f, 0.f};
+  const float* color_override = nullptr;
+  int dash = 0;
+
+  SECTION("plain") {}
+  SECTION("color override") { color_override = red; }
+  SECTION("dashes") { dash = 5; }
+
+  CGO actual(G);
+  REQUIRE(ExtrudeCGOSurfaceTube(I, &actual, cCylCap::None, color_override,
+      false, dash));
+  CGOStop(&actual);
+
+  CGO reference(G);
+  referenceSurfaceTube(I, &reference, color_override, dash);
+  CGOStop(&reference);
+  std::unique_ptr<CGO> combined(CGOCombineBeginEnd(&reference));
+
+  requireSameDrawArrays(&actual, combined.get());
+
+  ExtrudeFree(I);
+}
@@ -0,0 +1,50 @@
+#include "Test.h"
+
+#include <cmath>
+#include <random>
+
+#include "FieldQuantize.h"
+
+TEST_CASE("quantize_floats round trip", "[FieldQuantize]")
+{
+  const size_t count = pymol::QuantizedFloats::block_size * 2 + 100;
+  std::vector<float> values(count);
+  std::mt19937 mt(7);
+  std::normal_distribution<float> dist(0.f, 2.f);
+  for (auto& v : values)
+    v = dist(mt);
+
+  for (int bits : {8, 16}) {
+    auto q = pymol::quantize_floats(values.data(), count, bits);
+    REQUIRE(q.bits == bits);
+    REQUIRE(q.size() == count);
+    REQUIRE(q.offsets.size() == 3);
+    REQUIRE(q.codes.size() == count * bits / 8);
+
+    std::vector<float> decoded(count);
+    REQUIRE(pymol::dequantize_floats(q, decoded.data()));
+
+    for (size_t i = 0; i < count; ++i) {
+      auto block = i / pymol::QuantizedFloats::block_size;
+      REQUIRE(std::abs(decoded[i] - values[i]) <=
+              q.scales[block] * 0.5f + 1e-6f);
+    }
+  }
+}
+
+TEST_CASE("quantize_floats constant and non-finite", "[FieldQuantize]")
+{
+  std::vector<float> values(10, 3.5f);
+  values[4] = NAN;
+
+  auto q = pymol::quantize_floats(values.data(), values.size(), 16);
+  REQUIRE(q.scales[0] == 0.f);
+
+  std::vector<float> decoded(values.size());
+  REQUIRE(pymol::dequantize_floats(q, decoded.data()));
+  for (float v : decoded)
+    REQUIRE(v == 3.5f);
+
+  q.offsets.clear();
+  REQUIRE_FALSE(pymol::dequantize_floats(q, decoded.data()));
+}
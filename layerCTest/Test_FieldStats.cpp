@@ -0,0 +1,72 @@
+#include "Test.h"
+
+#include <cmath>
+#include <random>
+
+#include "Field.h"
+#include "FieldStats.h"
+
+TEST_CASE("FieldStats ramp", "[FieldStats]")
+{
+  const int dims[3] = {10, 4, 5};
+  CFieldTyped<float> field(dims, 3);
+  for (int x = 0; x < dims[0]; ++x)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int z = 0; z < dims[2]; ++z)
+        *field.ptr(x, y, z) = x;
+
+  pymol::FieldStats stats(field);
+  REQUIRE(stats.count() == 200);
+  REQUIRE(stats.min() == 0.f);
+  REQUIRE(stats.max() == 9.f);
+  REQUIRE(stats.mean() == Approx(4.5f));
+  REQUIRE(stats.stdev() == Approx(std::sqrt(8.25f)));
+
+  const auto his = stats.histogram(field, 10, 0.f, 9.f);
+  REQUIRE(his.size() == 10);
+  for (int i = 0; i < 10; ++i)
+    REQUIRE(his[i] == 20.f);
+
+  // values outside the range are not counted
+  const auto& sub = stats.histogram(field, 4, 2.f, 5.f);
+  REQUIRE(sub.size() == 4);
+  REQUIRE(sub[0] == 20.f);
+  REQUIRE(sub[3] == 20.f);
+
+  // memoized
+  REQUIRE(stats.histogram(field, 10, 0.f, 9.f) == his);
+}
+
+TEST_CASE("FieldStats matches serial sums", "[FieldStats]")
+{
+  const int dims[3] = {37, 21, 43};
+  CFieldTyped<float> field(dims, 3);
+  std::mt19937 mt(3);
+  std::normal_distribution<float> dist(1.f, 2.f);
+  double sum = 0, sumsq = 0;
+  float mn = 1e9f, mx = -1e9f;
+  for (int x = 0; x < dims[0]; ++x)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int z = 0; z < dims[2]; ++z) {
+        float v = dist(mt);
+        *field.ptr(x, y, z) = v;
+        sum += v;
+        sumsq += double(v) * v;
+        mn = std::min(mn, v);
+        mx = std::max(mx, v);
+      }
+
+  const size_t n = size_t(dims[0]) * dims[1] * dims[2];
+  pymol::FieldStats stats(field);
+  REQUIRE(stats.count() == n);
+  REQUIRE(stats.min() == mn);
+  REQUIRE(stats.max() == mx);
+  REQUIRE(stats.mean() == Approx(sum / n));
+  REQUIRE(stats.stdev() == Approx(std::sqrt(sumsq / n - (sum / n) * (sum / n))));
+
+  const auto& his = stats.histogram(field, 50, mn, mx);
+  double total = 0;
+  for (float c : his)
+    total += c;
+  REQUIRE(total == n);
+}
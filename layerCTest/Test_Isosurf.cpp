@@ -0,0 +1,101 @@
+#include "Test.h"
+
+#include <cmath>
+#include <set>
+#include <tuple>
+
+#include "Isosurf.h"
+#include "MinMaxTree.h"
+
+using namespace pymol;
+
+using Vertex = std::tuple<long, long, long>;
+
+static Vertex roundedVertex(const float* v)
+{
+  return Vertex{std::lround(v[0] * 1e3), std::lround(v[1] * 1e3),
+      std::lround(v[2] * 1e3)};
+}
+
+/**
+ * Field with unit grid spacing and a distance function, larger than one
+ * contouring sub-block (64 points) in every dimension.
+ */
+static Isofield makeDistanceField(PyMOLGlobals* G, const int* dims)
+{
+  Isofield field(G, dims);
+  for (int x = 0; x < dims[0]; ++x)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int z = 0; z < dims[2]; ++z) {
+        auto point = field.points->ptr<float>(x, y, z);
+        point[0] = x;
+        point[1] = y;
+        point[2] = z;
+        const float d[3] = {x - 40.3f, y - 39.7f, z - 35.1f};
+        field.data->get<float>(x, y, z) =
+            std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+      }
+  return field;
+}
+
+/**
+ * Points where the level crosses a grid edge, computed directly
+ */
+static std::set<Vertex> edgeCrossings(const Isofield& field, float level)
+{
+  std::set<Vertex> crossings;
+  auto dims = field.dimensions;
+  for (int x = 0; x < dims[0]; ++x)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int z = 0; z < dims[2]; ++z) {
+        float v0 = field.data->get<float>(x, y, z);
+        for (int c = 0; c < 3; ++c) {
+          int q[3] = {x, y, z};
+          if (++q[c] == dims[c])
+            continue;
+          float v1 = field.data->get<float>(q[0], q[1], q[2]);
+          if ((v0 < level) == (v1 < level))
+            continue;
+          float t = (level - v0) / (v1 - v0);
+          float p[3] = {float(x), float(y), float(z)};
+          p[c] += t;
+          crossings.insert(roundedVertex(p));
+        }
+      }
+  return crossings;
+}
+
+static std::set<Vertex> contourVertices(
+    PyMOLGlobals* G, Isofield& field, float level, cIsomeshMode mode)
+{
+  pymol::vla<int> num(1000);
+  pymol::vla<float> vert(1000);
+  REQUIRE(IsosurfVolume(G, nullptr, nullptr, &field, level, num, vert,
+      nullptr, mode, 1, 0.f));
+
+  std::set<Vertex> vertices;
+  for (size_t i = 0; i + 2 < vert.size(); i += 3)
+    vertices.insert(roundedVertex(vert.data() + i));
+  return vertices;
+}
+
+TEST_CASE("IsosurfVolume sub-blocks match edge crossings", "[Isosurf]")
+{
+  PyMOLInstance pymol;
+  auto G = pymol.G();
+
+  // sphere of radius 30 crosses the sub-block boundaries at 64 and 128
+  const int dims[3] = {75, 130, 70};
+  const float level = 30.f;
+  auto field = makeDistanceField(G, dims);
+  auto expected = edgeCrossings(field, level);
+  REQUIRE(expected.size() > 1000);
+
+  REQUIRE(contourVertices(G, field, level, cIsomeshMode::isomesh) == expected);
+  REQUIRE(contourVertices(G, field, level, cIsomeshMode::isodot) == expected);
+
+  // with empty bricks skipped
+  IsofieldComputeMinMax(G, &field);
+  REQUIRE(field.minmax);
+  REQUIRE(contourVertices(G, field, level, cIsomeshMode::isomesh) == expected);
+}
@@ -0,0 +1,61 @@
+#include "Test.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "MapOperation.h"
+
+using pymol::MapAccumulator;
+using pymol::MapOperator;
+
+TEST_CASE("MapAccumulator sum, average and difference", "[MapOperation]")
+{
+  const std::vector<float> a{1.f, 2.f, 3.f, 4.f};
+  const std::vector<float> b{10.f, 20.f, 30.f, 40.f};
+  const std::vector<std::uint8_t> inside{1, 0, 1, 1};
+  std::vector<float> out(4);
+
+  MapAccumulator sum(MapOperator::Sum, 4);
+  sum.add(a.data(), nullptr, true);
+  sum.add(b.data(), inside.data(), false);
+  sum.finish(out.data());
+  REQUIRE(out == std::vector<float>{11.f, 2.f, 33.f, 44.f});
+
+  MapAccumulator avg(MapOperator::Average, 4);
+  avg.add(a.data(), nullptr, true);
+  avg.add(b.data(), inside.data(), false);
+  avg.finish(out.data());
+  REQUIRE(out == std::vector<float>{5.5f, 2.f, 16.5f, 22.f});
+
+  MapAccumulator diff(MapOperator::Difference, 4);
+  diff.add(b.data(), nullptr, true);
+  diff.add(a.data(), inside.data(), false);
+  diff.finish(out.data());
+  REQUIRE(out == std::vector<float>{9.f, 20.f, 27.f, 36.f});
+}
+
+TEST_CASE("MapAccumulator minimum, maximum and unique", "[MapOperation]")
+{
+  const std::vector<float> a{1.f, -2.f, 3.f};
+  const std::vector<float> b{0.f, 5.f, 7.f};
+  const std::vector<std::uint8_t> inside{1, 1, 0};
+  std::vector<float> out(3);
+
+  MapAccumulator mn(MapOperator::Minimum, 3);
+  mn.add(b.data(), inside.data(), true);
+  mn.add(a.data(), nullptr, false);
+  mn.finish(out.data());
+  REQUIRE(out == std::vector<float>{0.f, -2.f, 3.f});
+
+  MapAccumulator mx(MapOperator::Maximum, 3);
+  mx.add(a.data(), nullptr, true);
+  mx.add(b.data(), inside.data(), false);
+  mx.finish(out.data());
+  REQUIRE(out == std::vector<float>{1.f, 5.f, 3.f});
+
+  MapAccumulator uniq(MapOperator::Unique, 3);
+  uniq.add(a.data(), nullptr, true);
+  uniq.add(b.data(), inside.data(), false);
+  uniq.finish(out.data());
+  REQUIRE(out == std::vector<float>{1.f, 0.f, 3.f});
+}
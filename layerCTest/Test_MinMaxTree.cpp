@@ -0,0 +1,96 @@
+#include "Test.h"
+
+#include <random>
+
+#include "Field.h"
+#include "MinMaxTree.h"
+
+TEST_CASE("MinMaxTree ramp", "[MinMaxTree]")
+{
+  const int dims[3] = {20, 17, 30};
+  CFieldTyped<float> field(dims, 3);
+  for (int x = 0; x < dims[0]; ++x)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int z = 0; z < dims[2]; ++z)
+        *field.ptr(x, y, z) = x;
+
+  pymol::MinMaxTree tree(field);
+  REQUIRE(tree.min() == 0.f);
+  REQUIRE(tree.max() == 19.f);
+
+  const int lo[3] = {0, 0, 0};
+  const int hi[3] = {19, 16, 29};
+  int out_lo[3], out_hi[3];
+
+  REQUIRE(tree.contains(lo, hi, 5.5f));
+  REQUIRE_FALSE(tree.contains(lo, hi, 100.f));
+  REQUIRE_FALSE(tree.activeBounds(lo, hi, -1.f, out_lo, out_hi));
+
+  // first brick covers points 0 to 8
+  REQUIRE(tree.activeBounds(lo, hi, 5.5f, out_lo, out_hi));
+  REQUIRE(out_lo[0] == 0);
+  REQUIRE(out_hi[0] == 8);
+  REQUIRE(out_lo[1] == 0);
+  REQUIRE(out_hi[1] == 16);
+  REQUIRE(out_lo[2] == 0);
+  REQUIRE(out_hi[2] == 29);
+
+  // shared boundary point
+  REQUIRE(tree.activeBounds(lo, hi, 8.f, out_lo, out_hi));
+  REQUIRE(out_lo[0] == 0);
+  REQUIRE(out_hi[0] == 16);
+
+  // clipped to query
+  const int sub_lo[3] = {10, 2, 3};
+  const int sub_hi[3] = {19, 5, 6};
+  REQUIRE_FALSE(tree.contains(sub_lo, sub_hi, 5.5f));
+  REQUIRE(tree.activeBounds(sub_lo, sub_hi, 17.f, out_lo, out_hi));
+  REQUIRE(out_lo[0] == 16);
+  REQUIRE(out_hi[0] == 19);
+  REQUIRE(out_lo[1] == 2);
+  REQUIRE(out_hi[1] == 5);
+}
+
+TEST_CASE("MinMaxTree covers all crossing edges", "[MinMaxTree]")
+{
+  const int dims[3] = {33, 9, 41};
+  CFieldTyped<float> field(dims, 3);
+  std::mt19937 mt(42);
+  std::uniform_real_distribution<float> dist{};
+  for (int x = 0; x < dims[0]; ++x)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int z = 0; z < dims[2]; ++z)
+        *field.ptr(x, y, z) = dist(mt) * dist(mt) * dist(mt);
+
+  pymol::MinMaxTree tree(field);
+  const float level = 0.6f;
+  const int lo[3] = {0, 0, 0};
+  const int hi[3] = {dims[0] - 1, dims[1] - 1, dims[2] - 1};
+
+  int out_lo[3], out_hi[3];
+  bool found = tree.activeBounds(lo, hi, level, out_lo, out_hi);
+
+  int n_crossing = 0;
+  for (int x = 0; x < dims[0]; ++x)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int z = 0; z < dims[2]; ++z) {
+        const int p[3] = {x, y, z};
+        bool above = *field.ptr(x, y, z) > level;
+        for (int c = 0; c < 3; ++c) {
+          int q[3] = {x, y, z};
+          if (++q[c] == dims[c])
+            continue;
+          if ((*field.ptr(q[0], q[1], q[2]) > level) == above)
+            continue;
+          ++n_crossing;
+          REQUIRE(found);
+          REQUIRE(tree.contains(p, q, level));
+          for (int d = 0; d < 3; ++d) {
+            REQUIRE(out_lo[d] <= p[d]);
+            REQUIRE(q[d] <= out_hi[d]);
+          }
+        }
+      }
+
+  REQUIRE(n_crossing > 0);
+}
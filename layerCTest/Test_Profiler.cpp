@@ -0,0 +1,57 @@
+#include "Test.h"
+
+#include "Profiler.h"
+
+TEST_CASE("Profiler disabled records nothing", "[Profiler]")
+{
+  pymol::Profiler profiler;
+  PyMOLGlobals G{};
+  G.Profiler = &profiler;
+
+  {
+    PYMOL_PROFILE_SCOPE(&G, "Test", "outer");
+  }
+  REQUIRE(profiler.size() == 0);
+
+  // no profiler at all
+  G.Profiler = nullptr;
+  {
+    PYMOL_PROFILE_SCOPE(&G, "Test", "outer");
+  }
+}
+
+TEST_CASE("Profiler nested scopes", "[Profiler]")
+{
+  pymol::Profiler profiler;
+  PyMOLGlobals G{};
+  G.Profiler = &profiler;
+
+  profiler.start();
+  for (int i = 0; i < 2; ++i) {
+    PYMOL_PROFILE_SCOPE(&G, "Test", "outer");
+    PYMOL_PROFILE_SCOPE(&G, "Test", "inner");
+  }
+  profiler.stop();
+
+  REQUIRE(profiler.size() == 4);
+
+  auto nodes = profiler.summary();
+  REQUIRE(nodes.size() == 2);
+  REQUIRE(nodes[0].path == "outer");
+  REQUIRE(nodes[0].depth == 0);
+  REQUIRE(nodes[0].count == 2);
+  REQUIRE(nodes[1].path == "outer/inner");
+  REQUIRE(nodes[1].depth == 1);
+  REQUIRE(nodes[1].count == 2);
+  REQUIRE(nodes[0].total >= nodes[1].total);
+  REQUIRE(nodes[0].self == Approx(nodes[0].total - nodes[1].total));
+
+  auto trace = profiler.chromeTrace();
+  REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+  REQUIRE(trace.find("\"name\":\"inner\",\"cat\":\"Test\",\"ph\":\"X\"") !=
+          std::string::npos);
+
+  profiler.clear();
+  REQUIRE(profiler.size() == 0);
+  REQUIRE(profiler.summary().empty());
+}
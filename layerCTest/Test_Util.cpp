@@ -76,3 +76,19 @@ TEST_CASE("StartsWith", "[Util]")
   std::string str3 = "_Fello";
   REQUIRE(!pymol::starts_with(str2, "F"));
 }
+
+TEST_CASE("format_fixed", "[Util]")
+{
+  const float values[] = {0.f, -0.f, 1.f, -1.f, 0.0625f, -0.0625f, 0.1875f,
+      2.5f, -0.0001f, 0.0005f, 12.3456f, -999.9995f, 123456.789f, 1e-7f,
+      3e9f};
+
+  for (auto value : values) {
+    for (int precision = 0; precision <= 7; ++precision) {
+      char expected[64], actual[64];
+      int n = sprintf(expected, "%8.*f", precision, value);
+      REQUIRE(pymol::format_fixed(actual, value, 8, precision) == n);
+      REQUIRE(std::string(actual) == expected);
+    }
+  }
+}
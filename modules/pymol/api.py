@@ -13,6 +13,7 @@ from .importing import \
       load_coordset,      \
       load_embedded,      \
       load_map,           \
+      load_map_region,    \
       load_model,         \
       load_mtz,           \
       load_object,        \
@@ -43,6 +44,7 @@ from .creating import \
       isomesh,            \
       isosurface,         \
       join_states,        \
+      map_from_reflections, \
       map_generate,        \
       map_new,            \
       pseudoatom,         \
@@ -124,6 +126,7 @@ from .querying import \
       get_extent,         \
       get_gltf,           \
       get_idtf,           \
+      get_map_values,     \
       get_modal_draw,     \
       get_model,          \
       get_movie_locked,   \
@@ -138,6 +141,7 @@ from .querying import \
       get_phipsi,         \
       get_position,       \
       get_povray,         \
+      get_profile,        \
       get_raw_alignment,  \
       get_renderer,       \
       get_selection_state,\
@@ -153,7 +157,8 @@ from .querying import \
       index,              \
       overlap,            \
       pi_interactions,    \
-      phi_psi
+      phi_psi,            \
+      profile
 
 #--------------------------------------------------------------------
 from .selecting import \
@@ -199,6 +204,7 @@ from .editing import \
       fix_chemistry,      \
       flag,               \
       fuse,               \
+      get_dss,            \
       get_editor_scheme,  \
       h_add,              \
       h_fill,             \
@@ -40,6 +40,7 @@ if True:
         'coulomb_neutral' : 3,
         'coulomb_local' : 4,
         'gaussian_max' : 5, # gaussian maximum contributor
+        'coulomb_mesh' : 6, # particle-mesh (FFT) long-range coulomb
         }
 
     map_type_sc = Shortcut(map_type_dict.keys())
@@ -173,6 +174,66 @@ SEE ALSO
         with _self.lockcm:
             return _cmd.group(_self._COb, "", str(members), 7, int(quiet))
 
+    def map_from_reflections(name, hkl, amplitudes, phases, cell, space_group,
+                             weights=None, zoom=-1, quiet=1, _self=cmd):
+        '''
+
+DESCRIPTION
+
+    "map_from_reflections" computes an electron density map from map
+    coefficients, for example FWT/PHWT columns read from a reflection file
+    with an external library.
+
+USAGE
+
+    map_from_reflections name, hkl, amplitudes, phases, cell, space_group
+        [, weights ]
+
+ARGUMENTS
+
+    name = string: name of the map object to create
+
+    hkl = list of (h, k, l) Miller indices
+
+    amplitudes = list of floats: amplitudes
+
+    phases = list of floats: phases in degrees
+
+    cell = list of 6 floats: a, b, c, alpha, beta, gamma
+
+    space_group = string: space group symbol, e.g. "P 21 21 21"
+
+    weights = list of floats: amplitude weights (figure of merit)
+    {default: None}
+
+NOTES
+
+    Reflections are expanded by the space group symmetry and Friedel's law,
+    the first of several equivalent reflections is used. The map covers one
+    unit cell and is normalized if "normalize_ccp4_maps" is set. This is the
+    same transform which is used to load mmCIF structure factor files.
+
+PYMOL API
+
+    cmd.map_from_reflections(str name, list hkl, list amplitudes,
+        list phases, list cell, str space_group, list weights=None)
+
+SEE ALSO
+
+    map_generate, load
+        '''
+        hkl = [int(i) for row in hkl for i in row]
+        amplitudes = [float(f) for f in amplitudes]
+        phases = [float(f) for f in phases]
+        cell = [float(f) for f in cell]
+        if weights is not None:
+            weights = [float(f) for f in weights]
+
+        with _self.lockcm:
+            return _cmd.map_from_reflections(_self._COb, str(name), hkl,
+                    amplitudes, phases, weights, cell, str(space_group),
+                    int(zoom), int(quiet))
+
     def map_generate(name, reflection_file, amplitudes, phases, weights="None",
                      reso_low=50.0, reso_high=1.0,quiet=1,zoom=1,_self=cmd):
         '''
@@ -307,7 +368,8 @@ ARGUMENTS
 
     name = string: name of the map object to create or modify
 	
-    type = vdw, gaussian, gaussian_max, coulomb, coulomb_neutral, coulomb_local
+    type = vdw, gaussian, gaussian_max, coulomb, coulomb_neutral, coulomb_local,
+    coulomb_mesh
 
     grid = float: grid spacing
 
@@ -922,6 +984,12 @@ NOTES
     The newly objects are labeled using the prefix provided along with
     their crystallographic symmetry operation and translation.
 
+    With "symmetry_instancing" on, a single object named by the prefix
+    is created instead. It holds one copy of the atoms and draws it once
+    per symmetry mate, so the representations are only built once.
+    Atom level operations (selecting, measuring, saving) see the
+    untransformed coordinates.
+
 SEE ALSO
 
     load
@@ -1423,6 +1423,55 @@ PYMOL API
         if _self._raising(r,_self): raise pymol.CmdException
         return r
 
+    def get_dss(selection="(all)", state=0, context=None, quiet=1, *,
+                _self=cmd):
+        '''
+DESCRIPTION
+
+    "get_dss" runs the "dss" secondary structure assignment without
+    modifying any atoms and returns the result for every state.
+
+USAGE
+
+    get_dss [ selection [, state [, context ]]]
+
+ARGUMENTS
+
+    selection = string: {default: (all)}
+
+    state = integer: {default: 0 -- all states}
+
+    context = string: atoms considered for hydrogen bonding {default:
+    same as selection}
+
+NOTES
+
+    Returns one string per state, with one character (H, S or L) per
+    complete amino acid residue (N, CA, C, O) in selection. Residues
+    which don't have coordinates in a state are reported as "-".
+
+    States are evaluated independently (in parallel, if PyMOL was built
+    with OpenMP), so this is suitable for assigning secondary structure
+    to every frame of a trajectory.
+
+EXAMPLE
+
+    ss_per_state = cmd.get_dss("polymer.protein")
+
+PYMOL API
+
+    cmd.get_dss(string selection, int state, string context)
+
+SEE ALSO
+
+    dss
+        '''
+        selection = selector.process(selection)
+        context = "" if context is None else selector.process(context)
+        with _self.lockcm:
+            return _cmd.get_dss(_self._COb, selection, int(state) - 1,
+                                context, int(quiet))
+
     def alter(selection, expression, quiet=1, space=None, _self=cmd):
 
         '''
@@ -2353,6 +2402,9 @@ NOTES
 
     source_state = 0 means all states
     target_state = -1 means current state
+
+    Operands are resampled onto the target grid. Points outside of an
+    operand map are not affected by that operand.
     
     experimental
     
@@ -520,13 +520,15 @@ ARGUMENTS
 
     dpi = float: dots-per-inch {default -1.0 (unspecified)}
 
-    ray = 0 or 1: should ray be run first {default: 0 (no)}
+    ray = 0, 1 or 2: should ray be run first, 2 uses the CPU rasterizer
+    instead of the ray tracer (fast, no shadows) {default: 0 (no)}
 
 EXAMPLES
 
     png image.png
     png image.png, dpi=300
     png image.png, 10cm, dpi=300, ray=1
+    png thumb.png, 256, 256, ray=2
 
 NOTES
 
@@ -644,15 +646,11 @@ ARGUMENTS
         if format not in ('pdb', 'cif'):
             raise pymol.CmdException(format + ' format not supported with multisave')
 
-        s = _self.get_str(format, pattern, state, '', -1, 1, quiet)
-
-        if s is None:
-            raise QuietException
-
         filename = _self.exp_path(filename)
 
-        with open(filename, 'a' if int(append) else 'w') as handle:
-            handle.write(s)
+        with _self.lockcm:
+            _cmd.save_molecules(_self._COb, str(filename), str(format),
+                    str(pattern), int(state) - 1, '', -1, 1, int(append))
 
         return DEFAULT_SUCCESS
 
@@ -809,7 +807,7 @@ NOTES
     The file format is automatically chosen if the extesion is one of
     the supported output formats: pdb, pqr, mol, sdf, pkl, pkla, mmd, out,
     dat, mmod, cif, pov, png, pse, psw, aln, fasta, obj, mtl, wrl, dae, idtf,
-    or mol2.
+    mol2, dcd, dtr, trr, or xtc.
 
     If the file format is not recognized, then a PDB file is written
     by default.
@@ -819,6 +817,10 @@ NOTES
     * if state = -1 (default), then only the current state is written.
 
     * if state = 0, then a multi-state output file is written.
+
+    Trajectory formats (dcd, dtr, trr, xtc) write one frame per state
+    (all states if state = -1 or 0, otherwise only the given state) and
+    require the selection to be within a single object.
     
 SEE ALSO
 
@@ -858,7 +860,16 @@ SEE ALSO
 
         contents = None
 
-        if format in savefunctions:
+        if format in _streamed_formats and not zipped:
+            # molecular formats are written directly to the file, without
+            # building the complete output string in memory
+            with _self.lockcm:
+                _cmd.save_molecules(_self._COb, str(filename), str(format),
+                        str(selection), int(state) - 1, str(ref),
+                        int(ref_state), -1, 0)
+            r = DEFAULT_SUCCESS
+
+        elif format in savefunctions:
             # generic forwarding to format specific save functions
             func = savefunctions[format]
             func = _eval_func(func)
@@ -978,6 +989,15 @@ SEE ALSO
         session = _self.get_session(selection, partial, quiet)
         return cPickle.dumps(session, 1)
 
+    def _save_traj(filename, selection, state, format, quiet, _self):
+        # binary trajectory, written by the molfile plugin for "format"
+        if int(state) == -1:
+            state = 0
+        with _self.lockcm:
+            _cmd.save_traj(_self._COb, str(filename), str(selection),
+                    int(state) - 1, str(format), int(quiet))
+        return DEFAULT_SUCCESS
+
     def _get_mtl_obj(format, _self):
         # TODO mtl not implemented, always returns empty string
         if format == 'mtl':
@@ -985,6 +1005,9 @@ SEE ALSO
         i = {'mtl': 0, 'obj': 1}.get(format)
         return _self.get_mtl_obj()[i]
 
+    # formats which MoleculeExporterSaveFile can stream to disk
+    _streamed_formats = ('cif', 'xyz', 'pdb', 'pqr', 'sdf', 'mol2', 'mae', 'mol')
+
     savefunctions = {
         'cif': get_str, # mmCIF
         'xyz': get_str,
@@ -1007,6 +1030,11 @@ SEE ALSO
 
         'png': png,
 
+        'dcd': _save_traj,
+        'dtr': _save_traj,
+        'trr': _save_traj,
+        'xtc': _save_traj,
+
         # no arguments (some have a "version" argument)
         'dae': 'pymol.querying:get_collada',
         'gltf': 'pymol.querying:get_gltf',
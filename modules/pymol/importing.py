@@ -313,6 +313,9 @@ DESCRIPTION
     actually a list of floating point numbers built using the constants
     in the $PYMOL_PATH/modules/pymol/cgo.py file.
 
+    A NumPy array with the same content is loaded in bulk, without
+    conversion to a Python list.
+
 PYMOL API
 
     cmd.load_cgo(object,name,state,finish,discrete)
@@ -320,7 +323,7 @@ PYMOL API
     '''
         lst = [loadable.cgo]
         lst.extend(list(arg))
-        if not is_list(lst[1]):
+        if not is_list(lst[1]) and not hasattr(lst[1], '__array_interface__'):
            lst[1] = list(lst[1])
         return _self.load_object(*lst, **kw)
 
@@ -899,6 +902,63 @@ NOTES
         return _self.load_raw(''.join(list[1]), list[0], name, state,
                 finish, discrete, quiet, multiplex, zoom)
 
+    def load_map_region(filename, selection, buffer=2.0, object='', state=0,
+                        format='', sele_state=0, quiet=1, *, _self=cmd):
+        '''
+DESCRIPTION
+
+    "load_map_region" loads only the part of a CCP4 or MRC map file
+    which covers a selection. The file is read from disk on demand, so
+    this works for maps which are larger than the available memory.
+
+USAGE
+
+    load_map_region filename, selection [, buffer [, object [, state
+        [, format [, sele_state ]]]]]
+
+ARGUMENTS
+
+    filename = str: path to an uncompressed CCP4 or MRC map file
+
+    selection = str: atom selection which defines the region
+
+    buffer = float: padding around the selection extent {default: 2.0}
+
+    object = str: name of the map object {default: filename prefix}
+
+    state = int: map state to load into, or 0 to append {default: 0}
+
+    format = ccp4, mrc or map {default: use file extension}
+
+    sele_state = int: state of the selection {default: 0 (current)}
+
+EXAMPLE
+
+    load 6xyz.cif
+    load_map_region emd_1234.map, chain A, buffer=5
+
+SEE ALSO
+
+    load, isomesh, map_trim
+        '''
+        filename = _self.exp_path(unquote(filename))
+        noext, ext, format_guessed, zipped = filename_to_format(filename)
+
+        format = str(format) or format_guessed
+        ftype = getattr(loadable, format, -1)
+
+        if ftype not in (loadable.ccp4, loadable.mrc, loadable.map):
+            raise pymol.CmdException('region loading requires a CCP4 or MRC map')
+        if zipped:
+            raise pymol.CmdException('region loading requires an uncompressed file')
+
+        object = str(object).strip() or noext
+
+        with _self.lockcm:
+            return _cmd.load_map_region(_self._COb, str(object), filename,
+                    int(ftype), str(selection), float(buffer), int(state) - 1,
+                    int(sele_state) - 1, int(quiet))
+
     def load_raw(content, format, object='', state=0, finish=1,
                  discrete=-1, quiet=1, multiplex=None, zoom=-1, *, _self=cmd):
         '''
@@ -343,6 +343,23 @@ def download_chem_comp(resn, quiet=1, _self=cmd):
 
     return filename
 
+# formats which are memory-mapped from disk by the C layer
+_mapped_types = (loadable.ccp4, loadable.mrc, loadable.map)
+
+def _is_plain_file(finfo):
+    '''
+    True if finfo is a local, uncompressed file name.
+    '''
+    if not is_string(finfo) or '://' in finfo or not os.path.isfile(finfo):
+        return False
+    try:
+        with open(finfo, 'rb') as handle:
+            magic = handle.read(10)
+    except IOError:
+        return False
+    return not (magic[:2] == b'\x1f\x8b' or
+                magic[:2] == b'BZ' and magic[4:10] == b'1AY&SY')
+
 def _load(oname,finfo,state,ftype,finish,discrete,
           quiet=1,multiplex=0,zoom=-1,mimic=1,
           plugin='',
@@ -356,7 +373,8 @@ def _load(oname,finfo,state,ftype,finish,discrete,
     size = 0
     if ftype not in (loadable.model,loadable.brick):
         if True:
-            if ftype in _load2str:
+            if ftype in _load2str and not (ftype in _mapped_types and
+                                           _is_plain_file(finfo)):
                 contents = _self.file_read(finfo)
                 ftype = _load2str[ftype]
         return _cmd.load(_self._COb, str(oname), str(finfo), contents,
@@ -106,8 +106,10 @@ def get_command_keywords(self_cmd=cmd):
         'get_clip'      : [ self_cmd.get_clip          , 0 , 0 , ''  , parsing.STRICT ],
         'get_dihedral'  : [ self_cmd.get_dihedral      , 0 , 0 , ''  , parsing.STRICT ],
         'get_distance'  : [ self_cmd.get_distance      , 0 , 0 , ''  , parsing.STRICT ],
+        'get_dss'       : [ self_cmd.get_dss           , 0 , 0 , ''  , parsing.STRICT ],
         'get_extent'    : [ self_cmd.get_extent        , 0 , 0 , ''  , parsing.STRICT ],
         'get_position'  : [ self_cmd.get_position      , 0 , 0 , ''  , parsing.STRICT ],
+        'get_profile'   : [ self_cmd.get_profile       , 0 , 0 , ''  , parsing.STRICT ],
         'get_sasa_relative' : [ self_cmd.get_sasa_relative , 0 , 0 , ''  , parsing.STRICT ],
         'get_symmetry'  : [ self_cmd.get_symmetry      , 0 , 0 , ''  , parsing.STRICT ],
         'get_renderer'  : [ self_cmd.get_renderer      , 0 , 0 , ''  , parsing.STRICT ],
@@ -147,6 +149,7 @@ def get_command_keywords(self_cmd=cmd):
         'loadall'       : [ self_cmd.loadall           , 0 , 0 , ''  , parsing.STRICT ],
         'space'         : [ self_cmd.space             , 0 , 0 , ''  , parsing.STRICT ],
         'load_embedded' : [ self_cmd.load_embedded     , 0 , 0 , ''  , parsing.STRICT ],
+        'load_map_region': [ self_cmd.load_map_region  , 0 , 0 , ''  , parsing.STRICT ],
         'load_mtz'      : [ self_cmd.load_mtz          , 0 , 0 , ''  , parsing.STRICT ],
         'load_png'      : [ self_cmd.load_png          , 0 , 0 , ''  , parsing.STRICT ],
         'load_traj'     : [ self_cmd.load_traj         , 0 , 0 , ''  , parsing.STRICT ],
@@ -201,6 +204,7 @@ def get_command_keywords(self_cmd=cmd):
         'phi_psi'       : [ self_cmd.phi_psi           , 0 , 0 , ''  , parsing.STRICT ],
         'pi_interactions': [ self_cmd.pi_interactions  , 0,  0 , ''  , parsing.STRICT ],
         'pop'           : [ self_cmd.pop               , 0 , 0 , ''  , parsing.STRICT ],
+        'profile'       : [ self_cmd.profile           , 0 , 0 , ''  , parsing.STRICT ],
         'protect'       : [ self_cmd.protect           , 0 , 0 , ''  , parsing.STRICT ],
         'pseudoatom'    : [ self_cmd.pseudoatom        , 0 , 0 , ''  , parsing.STRICT ],
         'pwd'           : [ self_cmd.pwd               , 0 , 0 , ''  , parsing.STRICT ],
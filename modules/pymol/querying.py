@@ -59,6 +59,35 @@ ARGUMENTS
             r = _self._cmd.get_volume_field(_self._COb, objName, int(state) - 1, int(copy))
         return r
 
+    def get_map_values(name, points, state=1, outside=float('nan'), *, _self=cmd):
+        '''
+DESCRIPTION
+
+    API only. Get map values at many points (trilinear interpolation).
+
+ARGUMENTS
+
+    name = str: map object name
+
+    points = array-like with shape (N, 3): model space coordinates
+
+    state = int: map state {default: 1}
+
+    outside = float: value for points outside of the map {default: nan}
+
+RETURNS
+
+    numpy float32 array with shape (N,)
+        '''
+        import numpy
+        points = numpy.ascontiguousarray(points, dtype=numpy.float32)
+        if points.ndim != 2 or points.shape[1] != 3:
+            points = points.reshape(-1, 3)
+        with _self.lockcm:
+            r = _self._cmd.get_map_values(_self._COb, str(name), points,
+                    int(state) - 1, float(outside))
+        return numpy.frombuffer(r, dtype=numpy.float32)
+
     def get_volume_histogram(objName, bins=64, range=None, *, _self=cmd):
         '''
 DESCRIPTION
@@ -1607,3 +1636,61 @@ DESCRIPTION
         if r and not int(quiet):
             print(" Assembly IDs: %s" % ', '.join(r))
         return r
+
+    def profile(action='report', filename='', quiet=1, *, _self=cmd):
+        '''
+DESCRIPTION
+
+    "profile" controls the built-in profiler, which records the time spent
+    in scene updates, representation building, CGO optimization, rendering
+    passes, ray tracing phases, selections and loading.
+
+    Recording is off by default and has negligible overhead while off.
+
+USAGE
+
+    profile [ action [, filename ]]
+
+ARGUMENTS
+
+    action = start | stop | clear | report | save {default: report}
+
+        start: start recording
+        stop: stop recording, recorded events are kept
+        clear: discard recorded events
+        report: print inclusive and exclusive times per scope
+        save: write recorded events as Chrome trace JSON to filename
+
+    filename = str: output file for "save"
+
+EXAMPLE
+
+    profile start
+    show surface
+    ray
+    profile stop
+    profile report
+    profile save, frame.json
+
+SEE ALSO
+
+    get_profile
+        '''
+        with _self.lockcm:
+            return _cmd.profile(_self._COb, str(action), str(filename),
+                                int(quiet))
+
+    def get_profile(*, _self=cmd):
+        '''
+DESCRIPTION
+
+    "get_profile" returns the profiler summary as a list of
+    (path, category, count, total_seconds, self_seconds) tuples, where
+    path lists the nested scope names separated by "/".
+
+SEE ALSO
+
+    profile
+        '''
+        with _self.lockcm:
+            return _cmd.get_profile(_self._COb)
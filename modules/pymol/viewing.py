@@ -1627,9 +1627,10 @@ NOTES
     one is specified but not the other, then the missing value is
     scaled so as to preserve the current aspect ratio.
 
-    Because this feature uses the OpenGL rendering context to piece
-    together the image, it does not work when running in the
-    command-line only mode.
+    This feature uses the OpenGL rendering context to piece together
+    the image. In command-line only mode, the representations are
+    rasterized on the CPU instead (no shadows, only the nearest
+    transparent surface is blended).
 
     On certain graphics hardware, "unset opaque_background" followed
     by "draw" will produce an image with a transparent background.
@@ -1687,8 +1688,8 @@ ARGUMENTS
     shift = float: x-axis translation for stereo image generation
     {default: 0.0}
 
-    renderer = -1, 0, 1, or 2: respectively, default, built-in,
-    pov-ray, or dry-run {default: 0}
+    renderer = -1, 0, 1, 2 or 9: respectively, default, built-in,
+    pov-ray, dry-run or CPU rasterizer {default: 0}
     
     async = 0 or 1: should rendering be done in a background thread?
     
@@ -59,3 +59,17 @@ class TestCIF(testing.PyMOLTestCase):
         cmd.load(self.datafile('4m4b-minimal-w-assembly.cif'))
         self.assertEqual(cmd.count_states(), 2)
         self.assertEqual(cmd.get_chains(), ['B'])
+
+    @testing.requires_version('3.2')
+    def test_assembly_instancing(self):
+        cmd.set('assembly', '1')
+        cmd.load(self.datafile('4m4b-minimal-w-assembly.cif'), 'm1')
+        extent = cmd.get_extent('m1')
+
+        cmd.set('symmetry_instancing')
+        cmd.load(self.datafile('4m4b-minimal-w-assembly.cif'), 'm2')
+
+        # one coordinate set with two instances covers both copies
+        self.assertEqual(cmd.count_states('m2'), 1)
+        self.assertEqual(cmd.get_chains('m2'), ['B'])
+        self.assertArrayEqual(cmd.get_extent('m2'), extent, delta=1e-2)
@@ -35,3 +35,51 @@ class TestColorramping(testing.PyMOLTestCase):
         self._sample_data()
         cmd.volume('vol', 'map')
         cmd.volume_panel('vol')
+
+    def _volume_image(self):
+        return self.get_imagearray(width=100, height=100)
+
+    @testing.requires('gui', 'shaders')
+    @testing.requires_version('3.2')
+    def testVolumeRecolor(self):
+        self._sample_data()
+        cmd.bg_color('black')
+        cmd.volume('vol', 'map', '2fofc')
+        cmd.orient('vol')
+        levels = cmd.volume_color('vol')[0::5]
+        red = [x for v in levels for x in (v, 'red', .5)]
+        blue = [x for v in levels for x in (v, 'blue', .5)]
+
+        cmd.volume_color('vol', red)
+        img = self._volume_image()
+        self.assertTrue(img[..., 0].sum() > img[..., 2].sum())
+
+        # ramp edit of an already rendered volume
+        cmd.volume_color('vol', blue)
+        img = self._volume_image()
+        self.assertTrue(img[..., 2].sum() > img[..., 0].sum())
+
+        # same as a volume which was created with that ramp
+        cmd.volume('vol2', 'map', '2fofc')
+        cmd.volume_color('vol2', blue)
+        cmd.disable('vol')
+        self.assertImageEqual(img, self._volume_image(), delta=2)
+
+    @testing.requires('gui', 'shaders')
+    @testing.requires_version('3.2')
+    def testVolumeLayers(self):
+        self._sample_data()
+        cmd.bg_color('black')
+        cmd.volume('vol', 'map', '2fofc')
+        cmd.orient('vol')
+        self._volume_image()
+
+        # color table alpha depends on volume_layers
+        cmd.set('volume_layers', 32, 'vol')
+        img = self._volume_image()
+        self.assertTrue(img[..., :3].any())
+
+        cmd.volume('vol2', 'map', '2fofc')
+        cmd.set('volume_layers', 32, 'vol2')
+        cmd.disable('vol')
+        self.assertImageEqual(img, self._volume_image(), delta=2)
@@ -103,6 +103,76 @@ class TestCreating(testing.PyMOLTestCase):
             self.assertEqual(cmd.get_state(), 2)
             self.assertImageHasColor(meshcolor)
 
+    @testing.requires_version('3.2')
+    @testing.requires('no_edu') # ray
+    def testIsomeshViewEdit(self):
+        def count_segments(name):
+            cmd.disable('*')
+            cmd.enable(name)
+            cmd.zoom(name)
+            return cmd.get_povray()[1].count('cylinder{')
+
+        def edit(field):
+            # small cube in the empty corner of the map
+            field[:] = 0.0
+            field[2:6, 2:6, 2:6] = 1.0
+
+        cmd.fragment('gly', 'm1')
+        cmd.map_new('map', 'gaussian', 0.5, 'm1', 6.0)
+        cmd.map_new('ref', 'gaussian', 0.5, 'm1', 6.0)
+
+        # contouring builds the min/max hierarchy of the map
+        cmd.isomesh('mesh1', 'map', 0.5)
+        self.assertTrue(count_segments('mesh1') > 0)
+
+        edit(cmd.get_volume_field('map', copy=0))
+        edit(cmd.get_volume_field('ref', copy=0))
+        cmd.isomesh('mesh2', 'map', 0.5)
+        cmd.isomesh('mesh3', 'ref', 0.5)
+
+        n_segments = count_segments('mesh3')
+        self.assertTrue(n_segments > 0)
+        self.assertEqual(count_segments('mesh2'), n_segments)
+
+    @testing.requires_version('3.2')
+    def testMapFromReflections(self):
+        filename = self.datafile("cif_map.cif")
+        cmd.load(filename, 'cif_map')
+
+        hkl, amplitudes, phases, weights = [], [], [], []
+        with open(filename) as handle:
+            for line in handle:
+                row = line.split()
+                if len(row) == 6 and not row[0].startswith('_'):
+                    hkl.append([int(i) for i in row[:3]])
+                    amplitudes.append(float(row[3]))
+                    phases.append(float(row[4]))
+                    weights.append(float(row[5]))
+
+        cmd.map_from_reflections('map', hkl, amplitudes, phases,
+                [20., 20., 20., 90., 90., 90.], 'P 1', weights)
+
+        field = cmd.get_volume_field('map')
+        self.assertEqual(field.shape, (12, 12, 12))
+        self.assertArrayEqual(field, cmd.get_volume_field('cif_map'), delta=1e-5)
+
+        with self.assertRaises(pymol.CmdException):
+            cmd.map_from_reflections('map2', hkl, amplitudes[1:], phases,
+                    [20., 20., 20., 90., 90., 90.], 'P 1')
+
+    @testing.requires_version('3.2')
+    def testMapNewCoulombMesh(self):
+        cmd.fragment('arg', 'm1')
+        cmd.map_new('direct', 'coulomb', 0.5, 'm1', 3.0)
+        cmd.map_new('mesh', 'coulomb_mesh', 0.5, 'm1', 3.0)
+
+        direct = cmd.get_volume_field('direct')
+        mesh = cmd.get_volume_field('mesh')
+        self.assertEqual(direct.shape, mesh.shape)
+
+        rms = ((direct - mesh) ** 2).mean() ** 0.5
+        self.assertTrue(rms < 0.05 * (direct ** 2).mean() ** 0.5)
+
     def testIsosurface(self):
         cmd.viewport(100, 100)
 
@@ -168,6 +238,32 @@ class TestCreating(testing.PyMOLTestCase):
             self.assertImageHasColor("blue", img)
             self.assertImageHasNotColor("red", img)
 
+    @testing.requires_version('3.2')
+    def testIsosurfaceMapRamp(self):
+        import numpy
+        from chempy.brick import Brick
+
+        self.ambientOnly()
+
+        # sphere, colored by a gradient along x
+        x, y, z = numpy.mgrid[-8:9, -8:9, -8:9].astype(float)
+        spacing, origin = (1., 1., 1.), (-8., -8., -8.)
+        cmd.load_brick(Brick.from_numpy(numpy.sqrt(x**2 + y**2 + z**2),
+                                        spacing, origin), 'sphere')
+        cmd.load_brick(Brick.from_numpy(x, spacing, origin), 'gradient')
+        cmd.ramp_new('xramp', 'gradient', [-5, 5], ['blue', 'red'])
+
+        cmd.disable('*')
+        cmd.isosurface('surf', 'sphere', 6.0)
+        cmd.color('xramp', 'surf')
+        cmd.reset()
+        cmd.zoom('surf')
+
+        img = self.get_imagearray(width=100, height=100)
+        left, right = img[:, :40, :3], img[:, 60:, :3]
+        self.assertTrue(left[..., 2].sum() > 2 * left[..., 0].sum())
+        self.assertTrue(right[..., 0].sum() > 2 * right[..., 2].sum())
+
     def testIsodot(self):
         cmd.viewport(100, 100)
 
@@ -318,6 +414,24 @@ class TestCreating(testing.PyMOLTestCase):
         self.assertEqual(segis["s03000000"], set(["D000" if segi else ""]))
         self.assertEqual(segis["s04000000"], set(["E000" if segi else ""]))
 
+    @testing.requires_version('3.2')
+    def testSymexpInstancing(self):
+        cmd.set("symmetry_instancing")
+        cmd.load(self.datafile('1oky.pdb.gz'), 'm1')
+        n = cmd.count_atoms()
+        cmd.symexp('s', 'm1', '%m1 & resi 283', 20.0)
+
+        # one copy of the atoms, rendered with three instances
+        self.assertEqual(cmd.get_object_list(), ['m1', 's'])
+        self.assertEqual(n * 2, cmd.count_atoms())
+
+        extent = [[40.8978, -8.901, -47.0803], [162.085, 108.416, 31.309]]
+        self.assertArrayEqual(cmd.get_extent(), extent, delta=1e-2)
+
+        # instances are saved with the session
+        cmd.set_session(cmd.get_session())
+        self.assertArrayEqual(cmd.get_extent(), extent, delta=1e-2)
+
     def testFragment(self):
         frag_name = "ala"
         cmd.fragment(frag_name)
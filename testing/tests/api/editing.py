@@ -237,6 +237,43 @@ class TestEditing(testing.PyMOLTestCase):
         cmd.iterate('2-5/CA', 'ss_list.append(ss)', space=locals())
         self.assertEqual(ss_list, ['H', 'H', 'H', 'H'])
 
+    @testing.requires_version('3.2')
+    def test_get_dss(self):
+        cmd.fab('A' * 6, 'm1', ss=1)
+        cmd.fab('A' * 6, 'm2', ss=3)
+        cmd.create('m1', 'm2', 1, 2)
+        cmd.delete('m2')
+        cmd.alter('m1', 'ss = ""')
+
+        ss_states = cmd.get_dss('m1')
+        self.assertEqual(len(ss_states), 2)
+        self.assertEqual(ss_states[0][1:5], 'HHHH')
+
+        # atoms are not modified
+        self.assertEqual(cmd.count_atoms('m1 & ss H+S+L'), 0)
+
+        # same as dss, state by state
+        for state in (1, 2):
+            ss_list = []
+            cmd.dss('m1', state=state)
+            cmd.iterate('m1 & guide', 'ss_list.append(ss)', space=locals())
+            self.assertEqual(''.join(ss_list), ss_states[state - 1])
+            self.assertEqual(cmd.get_dss('m1', state=state),
+                             [ss_states[state - 1]])
+
+    @testing.requires_version('3.2')
+    def test_dss_first_last(self):
+        # state=-4 (-5 internally) evaluates only the first and last state
+        cmd.fab('A' * 6, 'm1', ss=1)
+        cmd.alter('m1', 'ss = ""')
+        cmd.dss('m1', state=-4)
+        self.assertEqual(cmd.count_atoms('m1 & guide & ss H'), 4)
+        self.assertEqual(len(cmd.get_dss('m1', state=-4)), 1)
+
+        for state in (2, 3):
+            cmd.create('m1', 'm1', 1, state)
+        self.assertEqual(len(cmd.get_dss('m1', state=-4)), 2)
+
     def test_edit(self):
         cmd.fragment('gly')
         cmd.edit('ID 0', 'ID 1', 'ID 2','ID 3')
@@ -485,17 +522,97 @@ class TestEditing(testing.PyMOLTestCase):
         self.assertEqual(xyzfix, get_coord_list('ID 1-7'))
         self.assertNotEqual(xyzmov, get_coord_list('ID 0+8+9'))
 
+    def _load_test_maps(self):
+        import numpy
+        from chempy.brick import Brick
+        a, b, c = numpy.mgrid[0:10, 0:12, 0:8]
+        data = numpy.sin(a) * b + .1 * c ** 2
+        cmd.load_brick(Brick.from_numpy(data, (.5, .5, .5), (3., 4., 5.)), 'brick')
+        cmd.load(self.datafile('h2o-elf-nstart.ccp4'), 'xtal')
+        return ['brick', 'xtal']
+
+    @staticmethod
+    def _doubled_field(field):
+        # reference: linear interpolation at half the grid spacing
+        import numpy
+        for axis in range(3):
+            f = numpy.moveaxis(field, axis, 0)
+            out = numpy.empty((2 * f.shape[0] - 1,) + f.shape[1:], f.dtype)
+            out[0::2] = f
+            out[1::2] = (f[:-1] + f[1:]) / 2.
+            field = numpy.moveaxis(out, 0, axis)
+        return field
+
+    @testing.requires_version('3.2')
     def test_map_double(self):
-        cmd.map_double
-        self.skipTest("TODO")
-
+        for name in self._load_test_maps():
+            field = cmd.get_volume_field(name)
+            extent = cmd.get_extent(name)
+            cmd.map_double(name)
+            doubled = cmd.get_volume_field(name)
+            self.assertEqual(doubled.shape,
+                             tuple(2 * n - 1 for n in field.shape))
+            self.assertArrayEqual(doubled, self._doubled_field(field),
+                                  delta=1e-5 * abs(field).max())
+            self.assertArrayEqual(cmd.get_extent(name), extent, delta=1e-3)
+
+    @testing.requires_version('3.2')
     def test_map_halve(self):
-        cmd.map_halve
-        self.skipTest("TODO")
-
+        names = self._load_test_maps()
+
+        # non-crystallographic: every other grid point
+        field = cmd.get_volume_field('brick')
+        cmd.map_halve('brick')
+        self.assertArrayEqual(cmd.get_volume_field('brick'),
+                              field[::2, ::2, ::2], delta=1e-6)
+
+        # crystallographic: halving a doubled map restores the original
+        field = cmd.get_volume_field('xtal')
+        cmd.map_double('xtal')
+        cmd.map_halve('xtal', smooth=0)
+        self.assertArrayEqual(cmd.get_volume_field('xtal'), field,
+                              delta=1e-5 * abs(field).max())
+
+        # smoothing changes the values, but not the grid
+        cmd.map_double('xtal')
+        cmd.map_halve('xtal', smooth=1)
+        smoothed = cmd.get_volume_field('xtal')
+        self.assertEqual(smoothed.shape, field.shape)
+        self.assertTrue(smoothed.max() <= field.max() + 1e-6)
+        self.assertTrue(smoothed.min() >= field.min() - 1e-6)
+
+    @testing.requires_version('3.2')
     def test_map_set(self):
-        cmd.map_set
-        self.skipTest("TODO")
+        import numpy
+        from chempy.brick import Brick
+
+        spacing = (.5, .5, .5)
+        origin = (3., 4., 5.)
+        a, b, c = numpy.mgrid[0:10, 0:12, 0:8]
+        data = 2. * a - b + .5 * c + 1.
+        cmd.load_brick(Brick.from_numpy(data, spacing, origin), 'map1')
+        cmd.load_brick(Brick.from_numpy(data * 2., spacing, origin), 'map2')
+
+        # same grid as operands
+        cmd.map_set('copy', 'copy', 'map1')
+        self.assertArrayEqual(cmd.get_volume_field('copy'),
+                              cmd.get_volume_field('map1'))
+
+        # union grid, resampled
+        cmd.map_set('diff', 'difference', 'map2 map1')
+        cmd.map_set('sum', 'sum', 'map1 map2')
+        cmd.map_set('avg', 'average', 'map1 map2')
+        points = numpy.array(origin) + .5 + numpy.random.rand(100, 3) * [3.5, 4.5, 2.5]
+        expected = cmd.get_map_values('map1', points)
+        self.assertArrayEqual(cmd.get_map_values('diff', points),
+                              expected, delta=1e-3)
+        self.assertArrayEqual(cmd.get_map_values('sum', points),
+                              expected * 3., delta=1e-3)
+        self.assertArrayEqual(cmd.get_map_values('avg', points),
+                              expected * 1.5, delta=1e-3)
+
+        # points outside of all operands don't get edge values
+        self.assertEqual(cmd.get_volume_field('sum')[0, 0, 0], 0.)
 
     def test_map_set_border(self):
         cmd.map_set_border
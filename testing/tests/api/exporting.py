@@ -64,6 +64,26 @@ class TestExporting(testing.PyMOLTestCase):
         self.assertEqual(cmd.get_setting_int('pse_binary_dump'), 1)
         self.assertEqual(cmd.get_setting_float('pse_export_version'), 1.2)
 
+    @testing.requires_version('3.2')
+    def testGetSessionMapPrecision(self):
+        cmd.load(self.datafile('emd_1155.ccp4'), 'map1')
+        full = cmd.get_volume_field('map1')
+        cmd.set('map_session_precision', 16)
+        s = cmd.get_session()
+        cmd.set_session(s)
+        field = cmd.get_volume_field('map1')
+        self.assertEqual(field.shape, full.shape)
+        delta = (full.max() - full.min()) / 65535.
+        self.assertArrayEqual(field, full, delta=delta)
+
+        # unsupported precision, or a session for an older version
+        for precision, version in [(12, -1), (16, 3.1)]:
+            cmd.delete('*')
+            cmd.load(self.datafile('emd_1155.ccp4'), 'map1')
+            cmd.set('map_session_precision', precision)
+            cmd.set_session(cmd.get_session(version=version))
+            self.assertArrayEqual(cmd.get_volume_field('map1'), full, delta=1e-6)
+
     @testing.requires_version('1.8.4')
     def testMultisave(self):
         names = ['ala', 'gly', 'his', 'arg']
@@ -154,6 +174,29 @@ class TestExporting(testing.PyMOLTestCase):
         self.assertEqual(img.shape[:2], (nrow, ncol))
         self.assertImageHasColor('yellow', img)
 
+    @testing.requires_version('3.2')
+    @testing.foreach('spheres', 'sticks', 'cartoon', 'surface')
+    def testPngRaster(self, rep):
+        self.ambientOnly()
+        cmd.set('bg_rgb', 'black')
+        cmd.fragment('trp')
+        cmd.show_as(rep)
+        cmd.color('yellow')
+        cmd.zoom(complete=1)
+
+        ncol, nrow = 120, 80
+        buf = cmd.png(None, ncol, nrow, ray=2)
+        import io
+        img = self.get_imagearray(Image.open(io.BytesIO(buf)))
+        self.assertEqual(img.shape[:2], (nrow, ncol))
+        self.assertImageHasColor('yellow', img)
+        self.assertImageHasColor('black', img)
+
+        # same coverage as the ray tracer, up to the silhouette
+        ref = self.get_imagearray(Image.open(io.BytesIO(
+            cmd.png(None, ncol, nrow, ray=1))))
+        self.assertImageEqual(ref, img, delta=2, count=ncol * nrow // 20)
+
     # not supported in older versions: xyz (no ref)
     @testing.foreach('pdb', 'sdf', 'mol', 'mol2')
     def testSaveRef(self, format):
@@ -278,6 +321,73 @@ class TestExporting(testing.PyMOLTestCase):
         self.assertEqual(n_N, cmd.count_atoms('elem N'))
         self.assertEqual(n_O + n_N, cmd.count_atoms())
 
+    @testing.foreach('pdb', 'pqr', 'cif', 'sdf', 'mol', 'mol2', 'xyz', 'mae')
+    @testing.requires_version('3.2')
+    def testSaveStreamed(self, format):
+        # file written by save_molecules must match the in-memory export,
+        # including multi-state and multi-object output
+        cmd.fragment('trp', 'm1')
+        cmd.fragment('glu', 'm2')
+        cmd.create('m1', 'm1', 1, 2)
+        cmd.translate([1, 2, 3], 'm1', state=2)
+
+        for state in (-1, 0):
+            expected = cmd.get_str(format, 'all', state)
+            with testing.mktemp('.' + format) as filename:
+                cmd.save(filename, 'all', state)
+                with open(filename) as handle:
+                    self.assertEqual(handle.read(), expected)
+
+    @testing.foreach(('dcd', 1e-4), ('trr', 1e-4), ('xtc', 1e-2))
+    @testing.requires_version('3.2')
+    def testSaveTraj(self, format, delta):
+        cmd.load(self.datafile("sampletrajectory.pdb"), 'm1')
+        cmd.load_traj(self.datafile("sampletrajectory.dcd"), 'm1', state=0)
+        n_states = cmd.count_states('m1')
+
+        with testing.mktemp('.' + format) as filename:
+            cmd.save(filename, 'm1', state=0)
+            cmd.load(self.datafile("sampletrajectory.pdb"), 'm2')
+            cmd.load_traj(filename, 'm2', state=0)
+
+        self.assertEqual(cmd.count_states('m2'), n_states + 1)
+
+        for state in range(1, n_states + 1):
+            self.assertArrayEqual(cmd.get_coords('m2', state + 1),
+                    cmd.get_coords('m1', state), delta=delta)
+
+        # default state writes all states
+        with testing.mktemp('.' + format) as filename:
+            cmd.save(filename, 'm1')
+            cmd.load(self.datafile("sampletrajectory.pdb"), 'm3')
+            cmd.load_traj(filename, 'm3', state=0)
+
+        self.assertEqual(cmd.count_states('m3'), n_states + 1)
+
+    @testing.requires_version('3.2')
+    def testSaveStreamedFailureKeepsFile(self):
+        # a failed export must not truncate an existing file
+        cmd.fragment('gly', 'm1')
+        with testing.mktemp('.pdb') as filename:
+            with open(filename, 'w') as handle:
+                handle.write('original')
+            with self.assertRaises(pymol.CmdException):
+                cmd.save(filename, 'm1 and (')
+            with self.assertRaises(pymol.CmdException):
+                cmd.multisave(filename, 'm1 and (', append=1)
+            with open(filename) as handle:
+                self.assertEqual(handle.read(), 'original')
+            self.assertFalse(os.path.exists(filename + '.tmp'))
+
+            # append
+            cmd.multisave(filename, 'm1', append=1)
+            with open(filename) as handle:
+                content = handle.read()
+            self.assertTrue(content.startswith('original'))
+            lines = content[len('original'):].splitlines()
+            self.assertEqual(cmd.count_atoms('m1'),
+                             sum(1 for line in lines if line.startswith('ATOM')))
+
     @testing.foreach('pdb', 'cif', 'mmtf')
     @testing.requires_version('2.5')
     def testSave_symmetry(self, format):
@@ -244,6 +244,36 @@ class TestImporting(testing.PyMOLTestCase):
             extent = cmd.get_extent('map1')
             self.assertArrayEqual(extent, [[0.0, 0.0, 0.0], [2296.0, 1476.0, 4592.0]], delta=1e-2)
 
+    @testing.requires_version('3.2')
+    def testLoadMapRegion(self):
+        filename = self.datafile('emd_1155.ccp4')
+        cmd.set('normalize_ccp4_maps', 0)
+        cmd.load(filename, 'map1')
+        full = cmd.get_volume_field('map1')
+
+        # half way between grid points 30/42/60 and 31/43/61
+        cmd.pseudoatom('p1', pos=(500.2, 697.0, 992.2))
+        cmd.load_map_region(filename, 'p1', buffer=30., object='map2')
+        part = cmd.get_volume_field('map2')
+        self.assertEqual(part.shape, (6, 6, 6))
+
+        # orthogonal cell with origin at zero and 16.4 Angstrom spacing
+        lo = [int(round(v / 16.4)) for v in cmd.get_extent('map2')[0]]
+        self.assertEqual(lo, [28, 40, 58])
+        self.assertArrayEqual(part, full[28:34, 40:46, 58:64], delta=1e-6)
+
+        # no overlap
+        cmd.pseudoatom('p2', pos=(-500., 0., 0.))
+        with self.assertRaises(pymol.CmdException):
+            cmd.load_map_region(filename, 'p2', object='map3')
+
+        # a failed region load leaves an existing object unchanged
+        for state in (1, 0):
+            with self.assertRaises(pymol.CmdException):
+                cmd.load_map_region(filename, 'p2', object='map2', state=state)
+            self.assertEqual(cmd.count_states('map2'), 1)
+            self.assertArrayEqual(cmd.get_volume_field('map2'), part, delta=1e-6)
+
     @testing.requires_version('1.7.3.0')
     def testLoad_cube(self):
         cmd.load(self.datafile('h2o-elf.cube'))
@@ -361,6 +391,48 @@ class TestImporting(testing.PyMOLTestCase):
         self.assertEqual(3, cmd.count_states())
         cmd.delete('*')
 
+    @testing.foreach(['.pdb', '.dcd'], ['.gro', '.xtc'])
+    @testing.requires_version('3.2')
+    def testLoadTrajSkippedFrames(self, topext, trjext):
+        # skipped frames are seeked over, loaded frames must be unaffected
+        topfile = self.datafile("sampletrajectory" + topext)
+        trjfile = self.datafile("sampletrajectory" + trjext)
+
+        cmd.load(topfile, 'm1')
+        cmd.load_traj(trjfile, 'm1', state=1)
+        cmd.load(topfile, 'm2')
+        cmd.load_traj(trjfile, 'm2', state=1, start=2, interval=3)
+
+        self.assertEqual(cmd.count_states('m2'), 3)
+        for state, frame in enumerate([4, 7, 10], 1):
+            self.assertArrayEqual(cmd.get_coords('m2', state),
+                    cmd.get_coords('m1', frame), delta=1e-4)
+
+    @testing.requires_version('3.2')
+    def testLoadTrajSkippedFramesNoSeek(self):
+        # rst7 plugin doesn't accept a null timestep, skipped frames must be
+        # read into the regular timestep instead
+        cmd.load(self.datafile("sampletrajectory.pdb"), 'm1')
+        coords = cmd.get_coords('m1', 1) + 1.0
+        n_states = cmd.count_states('m1')
+
+        with testing.mktemp('.rst7') as filename:
+            with open(filename, 'w') as handle:
+                handle.write('title\n%5d\n' % len(coords))
+                for i, xyz in enumerate(coords.reshape(-1)):
+                    handle.write('%12.7f' % xyz)
+                    if i % 6 == 5:
+                        handle.write('\n')
+                handle.write('\n')
+
+            cmd.load_traj(filename, 'm1', state=0, interval=2, plugin='rst7')
+            self.assertEqual(cmd.count_states('m1'), n_states)
+
+            cmd.load_traj(filename, 'm1', state=0, plugin='rst7')
+            self.assertEqual(cmd.count_states('m1'), n_states + 1)
+            self.assertArrayEqual(cmd.get_coords('m1', n_states + 1), coords,
+                    delta=1e-4)
+
     # Changed in PyMOL 2.5: Default is now state=1 instead of state=0
     @testing.requires_version('2.5')
     def testLoadTraj_default_state_1(self):
@@ -718,3 +790,18 @@ class TestImporting(testing.PyMOLTestCase):
         cmd.load(filename, 'cif_map')
         field = cmd.get_volume_field('cif_map')
         self.assertEqual(field.shape, (12, 12, 12))
+
+        # reference values from the complex-to-complex transform (PyMOL 3.1),
+        # sigma scaled with normalize_ccp4_maps=1
+        self.assertAlmostEqual(field.min(), -0.795681, delta=1e-4)
+        self.assertAlmostEqual(field.max(), 3.916699, delta=1e-4)
+        self.assertAlmostEqual(field.mean(), 0.0, delta=1e-4)
+        for idx, value in [
+            ((0, 0, 0), -0.406845),
+            ((1, 2, 3), -0.408045),
+            ((6, 6, 6), 2.259506),
+            ((11, 5, 2), -0.373611),
+            ((8, 8, 8), 3.916699),
+            ((2, 8, 8), -0.795681),
+        ]:
+            self.assertAlmostEqual(field[idx], value, delta=1e-4)
@@ -1,3 +1,4 @@
+import json
 from pymol import cmd, testing, stored, CmdException
 
 class TestQuerying(testing.PyMOLTestCase):
@@ -187,6 +188,39 @@ class TestQuerying(testing.PyMOLTestCase):
         self.assertTrue('MODEL_POSITION_LIST' in r[1])
         self.assertTrue('MODEL_NORMAL_LIST' in r[1])
 
+    @testing.requires_version('3.2')
+    def testGetMapValues(self):
+        import numpy
+        from chempy.brick import Brick
+
+        spacing = (.5, .25, .5)
+        origin = (3., 4., 5.)
+        a, b, c = numpy.mgrid[0:10, 0:12, 0:8]
+        data = 2. * a - b + .5 * c
+        cmd.load_brick(Brick.from_numpy(data, spacing, origin), 'map')
+
+        # trilinear interpolation is exact for linear functions
+        points = numpy.array(origin) + numpy.random.rand(1000, 3) * [4.5, 2.75, 3.5]
+        index = (points - origin) / spacing
+        expected = 2. * index[:, 0] - index[:, 1] + .5 * index[:, 2]
+        values = cmd.get_map_values('map', points)
+        self.assertEqual(values.shape, (1000,))
+        self.assertArrayEqual(values, expected, delta=1e-3)
+
+        values = cmd.get_map_values('map', [[0., 0., 0.], [3., 4., 5.]])
+        self.assertTrue(numpy.isnan(values[0]))
+        self.assertAlmostEqual(values[1], 0.)
+        values = cmd.get_map_values('map', [0., 0., 0.], outside=-1.)
+        self.assertArrayEqual(values, [-1.])
+
+        # state matrix
+        cmd.transform_object('map', [1., 0., 0., 1.,
+                                     0., 1., 0., 0.,
+                                     0., 0., 1., 0.,
+                                     0., 0., 0., 1.], homogenous=1)
+        values = cmd.get_map_values('map', points + [1., 0., 0.])
+        self.assertArrayEqual(values, expected, delta=1e-3)
+
     def testGetLegalName(self):
         self.assertEqual(cmd.get_legal_name("foo bar baz"), "foo_bar_baz")
 
@@ -539,6 +573,26 @@ class TestQuerying(testing.PyMOLTestCase):
         hist2 = cmd.get_volume_histogram('map1', 2, (0.3, 0.7))
         self.assertArrayEqual(hist2, [0.3, 0.7, 0.0692, 0.172, 62263.0, 1737.0], delta=1e-4)
 
+    @testing.requires_version('3.2')
+    def testGetVolumeHistogramViewEdit(self):
+        cmd.load(self.datafile('h2o-elf.cube'), 'map1')
+        hist = cmd.get_volume_histogram('map1', 2)
+        self.assertAlmostEqual(hist[1], 0.9292, delta=1e-4)
+
+        # edits through a copy=0 view must not leave stale statistics
+        field = cmd.get_volume_field('map1', copy=0)
+        field[:] = 1.0
+        field[0, 0, 0] = 3.0
+        hist = cmd.get_volume_histogram('map1', 2)
+        self.assertArrayEqual(hist[:2], [1.0, 3.0], delta=1e-4)
+        self.assertEqual(hist[4:], [field.size - 1, 1])
+
+        # the view stays writable
+        field[0, 0, 0] = -1.0
+        hist = cmd.get_volume_histogram('map1', 2)
+        self.assertArrayEqual(hist[:2], [-1.0, 1.0], delta=1e-4)
+        self.assertEqual(hist[4:], [1, field.size - 1])
+
     def testGetVrml(self):
         cmd.fragment('gly')
         cmd.show_as('sticks')
@@ -646,3 +700,32 @@ class TestQuerying(testing.PyMOLTestCase):
         # ostate-level
         s = cmd.get_object_settings("m1", state=1)
         self.assertEqual(s, [[19, 2, 9], [750, 2, 7]])
+
+    @testing.requires_version('3.2')
+    @testing.requires('no_edu') # ray
+    def testProfile(self):
+        cmd.profile('clear')
+        cmd.fragment('ala')
+        self.assertEqual(cmd.get_profile(), [])
+
+        cmd.profile('start')
+        cmd.show_as('sticks')
+        cmd.rebuild()
+        cmd.ray(20, 20)
+        cmd.profile('stop')
+
+        paths = [p[0].split('/') for p in cmd.get_profile()]
+        self.assertTrue(any(p[0] == 'ExecutiveRay' for p in paths))
+        self.assertTrue(any(p[-1] == 'RayRender' for p in paths))
+        self.assertTrue(any(p[-2:] == ['CoordSet::update', 'RepCylBondNew']
+                            for p in paths))
+
+        with testing.mktemp('.json') as filename:
+            cmd.profile('save', filename)
+            with open(filename) as handle:
+                events = json.load(handle)['traceEvents']
+        self.assertTrue(events)
+        self.assertEqual(events[0]['ph'], 'X')
+
+        cmd.profile('clear')
+        self.assertEqual(cmd.get_profile(), [])
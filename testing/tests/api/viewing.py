@@ -411,6 +411,30 @@ class TestViewing(testing.PyMOLTestCase):
         self.ambientOnly()
         self.assertImageEqual("viewing-ref/cartoon.png", delta=1)
 
+    @testing.requires_version('3.2')
+    def testCartoonSegmentRanges(self):
+        # 7 GroES chains with 97 guide atoms each: the combined object is
+        # generated in several segment ranges, each single chain in one pass
+        cmd.load(self.datafile("1aon.pdb.gz"), "m0")
+        chains = "OPQRSTU"
+        cmd.create("whole", "m0 and chain " + "+".join(chains))
+        for c in chains:
+            cmd.create("c" + c, "m0 and chain " + c)
+        cmd.delete("m0")
+        cmd.show_as("cartoon")
+        cmd.orient("whole")
+
+        cmd.disable("*")
+        cmd.enable("whole")
+        whole = sorted(cmd.get_povray()[1].splitlines())
+
+        cmd.disable("whole")
+        cmd.enable("c*")
+        parts = sorted(cmd.get_povray()[1].splitlines())
+
+        self.assertTrue(len(whole) > 1000)
+        self.assertEqual(whole, parts)
+
     def testCapture(self):
         cmd.capture
         self.skipTest('TODO')
@@ -481,6 +505,64 @@ class TestViewing(testing.PyMOLTestCase):
         cmd.recolor()
         self.assertImageHasColor('red')
 
+    @testing.requires_version('3.2')
+    @testing.foreach("spheres", "sticks", "lines")
+    def testRecoord(self, rep):
+        self.ambientOnly()
+        cmd.viewport(100, 100)
+        cmd.fragment("gly")
+        cmd.set("line_width", 5)
+        cmd.zoom()
+        cmd.color("blue")
+        cmd.show_as(rep)
+        cmd.set("valence", 0)
+        self.assertImageHasColor('blue')
+
+        # translate_atom is a coordinate-only change (cRepInvCoord), which
+        # must be patched in place without rebuilding the rep
+        cmd.profile('clear')
+        cmd.profile('start')
+        n_atoms = cmd.count_atoms()
+        for i in range(1, n_atoms + 1):
+            cmd.translate_atom('index %d' % i, 100, 0, 0, mode=1)
+        self.assertImageHasNotColor('blue')
+        for i in range(1, n_atoms + 1):
+            cmd.translate_atom('index %d' % i, -100, 0, 0, mode=1)
+        self.assertImageHasColor('blue')
+        cmd.profile('stop')
+
+        scopes = [path.split('/')[-1] for (path, *_) in cmd.get_profile()]
+        self.assertIn('Rep::update', scopes)
+        self.assertNotIn('Rep::rebuild', scopes)
+
+        # alter_state rebuilds (cRepInvRep)
+        cmd.profile('clear')
+        cmd.profile('start')
+        cmd.alter_state(1, "all", "x += 100")
+        self.assertImageHasNotColor('blue')
+        cmd.profile('stop')
+        scopes = [path.split('/')[-1] for (path, *_) in cmd.get_profile()]
+        self.assertIn('Rep::rebuild', scopes)
+
+    @testing.requires_version('3.2')
+    @testing.foreach('spheres', 'sticks', 'cartoon')
+    def testLevelOfDetail(self, rep):
+        self.ambientOnly()
+        cmd.viewport(100, 100)
+        cmd.set('lod_atom_count', 1)
+        cmd.set('lod_pixel_size', 1000)
+        cmd.load(self.datafile('1oky-frag.pdb'))
+        cmd.orient()
+        cmd.color('blue')
+        cmd.show_as(rep)
+        # coarse proxies
+        self.assertImageHasColor('blue')
+        # full detail
+        cmd.set('lod_pixel_size', 0)
+        self.assertImageHasColor('blue')
+        cmd.set('lod_atom_count', 0)
+        self.assertImageHasColor('blue')
+
     def testColor(self):
         cmd.fragment('ala')
         cmd.color(3)
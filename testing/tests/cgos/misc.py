@@ -26,3 +26,31 @@ class Test(testing.PyMOLTestCase):
 
         self.assertEqual([objname], cmd.get_names())
         self.assertImageHasColor('red')
+
+    @testing.foreach(0, 1)
+    @testing.requires_version('3.2')
+    def test_pse_binary_dump(self, binary_dump):
+        obj = [cgo.SPHERE, 1., 2., 3., 1.5,
+               cgo.CYLINDER, 0., 0., 0., 4., 5., 6., .5, 1., 0., 0., 0., 1., 0.]
+        cmd.load_cgo(obj, 'm1')
+        extent = cmd.get_extent('m1')
+        cmd.set('pse_binary_dump', binary_dump)
+        s = cmd.get_session()
+        cmd.set_session(s)
+        self.assertArrayEqual(cmd.get_extent('m1'), extent, delta=1e-4)
+
+    @testing.requires_version('3.2')
+    def test_load_numpy(self):
+        import numpy
+        obj = [cgo.BEGIN, cgo.TRIANGLES]
+        for i in range(1000):
+            obj.extend([cgo.VERTEX, i, 0., 0.,
+                        cgo.VERTEX, i, 1., 0.,
+                        cgo.VERTEX, i, 0., 1.])
+        obj.append(cgo.END)
+        cmd.load_cgo(obj, 'm1')
+        cmd.load_cgo(numpy.array(obj, dtype=numpy.float32), 'm2')
+        cmd.load_cgo(numpy.array(obj).reshape((-1, 1)), 'm3')
+        extent = cmd.get_extent('m1')
+        self.assertArrayEqual(cmd.get_extent('m2'), extent, delta=1e-4)
+        self.assertArrayEqual(cmd.get_extent('m3'), extent, delta=1e-4)
@@ -0,0 +1,51 @@
+'''
+Stress testing for representation building on million-atom objects
+'''
+
+from pymol import cmd, testing
+
+@testing.requires('no_run_all', 'gui')
+class StressRepresentations(testing.PyMOLTestCase):
+
+    def load_million_atoms(self):
+        # 58674 atoms, 17 copies (997458 atoms)
+        cmd.load(self.datafile('1aon.pdb.gz'), 'm0')
+        for i in range(1, 17):
+            cmd.copy('m%d' % i, 'm0')
+        cmd.create('big', 'm*')
+        cmd.delete('m*')
+        self.assertTrue(cmd.count_atoms() > 10**6 - 10**5)
+
+    def testRepBuilding(self):
+        self.load_million_atoms()
+
+        with self.timing('sticks'):
+            cmd.show_as('sticks')
+            cmd.draw()
+
+        with self.timing('spheres'):
+            cmd.show_as('spheres')
+            cmd.draw()
+
+    def testCartoon(self):
+        self.load_million_atoms()
+
+        with self.timing('cartoon'):
+            cmd.show_as('cartoon')
+            cmd.draw()
+
+    def testCartoonExtrude(self):
+        self.load_million_atoms()
+        cmd.set('cartoon_sampling', 14)
+        cmd.set('cartoon_loop_quality', 12)
+        cmd.set('cartoon_oval_quality', 20)
+
+        with self.timing('cartoon extrude'):
+            cmd.show_as('cartoon')
+            cmd.draw()
+
+        cmd.cartoon('tube')
+
+        with self.timing('cartoon tube extrude'):
+            cmd.rebuild()
+            cmd.draw()
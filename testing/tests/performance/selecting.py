@@ -0,0 +1,39 @@
+'''
+Stress testing for selections on million-atom objects
+'''
+
+from pymol import cmd, testing
+
+@testing.requires('no_run_all')
+class StressSelecting(testing.PyMOLTestCase):
+
+    def load_million_atoms(self):
+        # 58674 atoms, 17 copies (997458 atoms)
+        cmd.load(self.datafile('1aon.pdb.gz'), 'm0')
+        for i in range(1, 17):
+            cmd.copy('m%d' % i, 'm0')
+        cmd.create('big', 'm*')
+        cmd.delete('m*')
+        self.assertTrue(cmd.count_atoms() > 10**6 - 10**5)
+
+    def testHotFieldSelections(self):
+        self.load_million_atoms()
+        cmd.color('red', 'chain A')
+
+        with self.timing('rep/color/flag/hydro x 10'):
+            for _ in range(10):
+                cmd.count_atoms('rep cartoon')
+                cmd.count_atoms('color red')
+                cmd.count_atoms('flag 8')
+                cmd.count_atoms('polymer.protein')
+                cmd.count_atoms('hydro')
+
+        # columns must reflect in-place modifications
+        n_red = cmd.count_atoms('color red')
+        cmd.alter('chain B', 'color = %d' % cmd.get_color_index('red'))
+        self.assertEqual(cmd.count_atoms('color red'),
+                n_red + cmd.count_atoms('chain B'))
+        cmd.flag(8, 'chain C')
+        self.assertEqual(cmd.count_atoms('flag 8'), cmd.count_atoms('chain C'))
+        cmd.hide('everything', 'chain D')
+        self.assertEqual(cmd.count_atoms('chain D & rep cartoon'), 0)
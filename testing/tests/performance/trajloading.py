@@ -0,0 +1,33 @@
+'''
+Stress testing for compressed trajectory loading
+'''
+
+from pymol import cmd, testing
+
+@testing.requires('no_run_all')
+class StressTrajLoading(testing.PyMOLTestCase):
+
+    def testXTCLoad(self):
+        # 58674 atoms, 200 frames
+        cmd.load(self.datafile('1aon.pdb.gz'), 'm1')
+        for i in range(1, 200):
+            cmd.create('m1', 'm1', 1, i + 1)
+            cmd.translate([0.01, 0.0, 0.0], 'm1', state=i + 1)
+
+        with testing.mktemp('.xtc') as filename:
+            cmd.save(filename, 'm1', state=0)
+            cmd.create('m2', 'm1', 1, 1)
+
+            with self.timing('load_traj xtc, all frames'):
+                cmd.load_traj(filename, 'm2', state=1)
+            self.assertEqual(cmd.count_states('m2'), 200)
+
+            cmd.delete('m2')
+            cmd.create('m2', 'm1', 1, 1)
+
+            with self.timing('load_traj xtc, frames 190-200'):
+                cmd.load_traj(filename, 'm2', state=1, start=190)
+            self.assertEqual(cmd.count_states('m2'), 11)
+
+        self.assertArrayEqual(cmd.get_coords('m2', 11),
+                cmd.get_coords('m1', 200), delta=1e-2)